@@ -0,0 +1,733 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TNN.dir/source/tnn/core/abstract_device.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/core/abstract_device.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/core/abstract_layer_acc.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/core/abstract_layer_acc.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/core/abstract_network.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/core/abstract_network.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/core/blob.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/core/blob.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/core/blob_impl.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/core/blob_impl.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/core/blob_int8.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/core/blob_int8.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/core/blob_manager.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/core/blob_manager.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/core/const_folder.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/core/const_folder.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/core/context.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/core/context.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/core/default_network.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/core/default_network.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/core/instance.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/core/instance.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/core/layer_type.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/core/layer_type.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/core/mat.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/core/mat.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/core/profile.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/core/profile.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/core/status.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/core/status.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/core/tnn.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/core/tnn.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/core/tnn_impl.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/core/tnn_impl.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/core/tnn_impl_default.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/core/tnn_impl_default.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/extern_wrapper/base_layer_builder.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/extern_wrapper/base_layer_builder.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/extern_wrapper/foreign_blob.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/extern_wrapper/foreign_blob.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/abstract_model_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/abstract_model_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/default_model_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/default_model_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/default_model_packer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/default_model_packer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/layer_resource_generator.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/layer_resource_generator.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/batch_norm_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/batch_norm_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/binary_op_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/binary_op_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/clip_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/clip_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/concat_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/concat_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/conv_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/conv_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/crop_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/crop_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/deconv_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/deconv_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/default_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/default_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/detection_output_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/detection_output_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/eltwise_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/eltwise_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/elu_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/elu_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/hard_sigmoid_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/hard_sigmoid_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/hard_swish_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/hard_swish_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/inner_product_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/inner_product_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/instance_norm_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/instance_norm_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/interp_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/interp_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/lrn_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/lrn_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/memory_data_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/memory_data_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/normalize_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/normalize_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/pad_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/pad_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/permute_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/permute_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/pooling_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/pooling_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/prelu_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/prelu_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/prior_box_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/prior_box_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/reduce_op_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/reduce_op_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/relu_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/relu_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/reorg_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/reorg_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/reshape_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/reshape_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/roi_pooling_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/roi_pooling_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/scale_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/scale_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/selu_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/selu_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/shuffle_channel_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/shuffle_channel_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/slice_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/slice_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/softmax_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/softmax_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/unary_op_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/layer_interpreter/unary_op_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/ncnn_layer_type.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/ncnn_layer_type.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/ncnn_model_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/ncnn_model_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/ncnn_param_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/ncnn_param_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/optimizer/expand_slice_optimizer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/optimizer/expand_slice_optimizer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/optimizer/memory_data_optimizer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/optimizer/memory_data_optimizer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/optimizer/ncnn_optimizer_manager.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/ncnn/optimizer/ncnn_optimizer_manager.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/net_resource.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/net_resource.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/net_structure.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/net_structure.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/raw_buffer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/raw_buffer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/add_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/add_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/and_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/and_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/arg_max_or_min_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/arg_max_or_min_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/batch_norm_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/batch_norm_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/bias_add_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/bias_add_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/bitshift_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/bitshift_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/blob_scale_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/blob_scale_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/cast_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/cast_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/clip_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/clip_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/concat_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/concat_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/const_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/const_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/constantofshape_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/constantofshape_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/conv_1d_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/conv_1d_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/conv_3d_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/conv_3d_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/conv_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/conv_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/detection_output_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/detection_output_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/detection_post_process_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/detection_post_process_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/div_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/div_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/effective_transformer_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/effective_transformer_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/einsum_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/einsum_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/elu_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/elu_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/expand_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/expand_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/flatten_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/flatten_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/gather_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/gather_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/gathernd_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/gathernd_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/glu_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/glu_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/greater_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/greater_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/gridsample_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/gridsample_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/group_norm_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/group_norm_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/gru_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/gru_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/hard_sigmoid_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/hard_sigmoid_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/hard_swish_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/hard_swish_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/hdrguide_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/hdrguide_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/histogram_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/histogram_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/inner_product_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/inner_product_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/instance_norm_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/instance_norm_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/kv_cache_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/kv_cache_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/layer_norm_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/layer_norm_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/less_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/less_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/log_softmax_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/log_softmax_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/lrn_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/lrn_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/lstm_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/lstm_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/mat_mul_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/mat_mul_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/max_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/max_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/min_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/min_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/mul_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/mul_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/non_max_suppression_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/non_max_suppression_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/normalize_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/normalize_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/onehot_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/onehot_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/pad_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/pad_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/padv2_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/padv2_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/permute_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/permute_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/pixel_shuffle_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/pixel_shuffle_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/pooling_1d_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/pooling_1d_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/pooling_3d_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/pooling_3d_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/pooling_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/pooling_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/pow_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/pow_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/prelu_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/prelu_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/prior_box_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/prior_box_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/range_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/range_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/reduce_op_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/reduce_op_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/reformat_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/reformat_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/reorg_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/reorg_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/reshape_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/reshape_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/roi_pooling_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/roi_pooling_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/roialign_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/roialign_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/scale_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/scale_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/scatter_elements_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/scatter_elements_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/scatter_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/scatter_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/scatter_nd_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/scatter_nd_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/selu_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/selu_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/shape_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/shape_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/shuffle_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/shuffle_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/signed_mul_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/signed_mul_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/size_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/size_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/softmax_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/softmax_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/splitv_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/splitv_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/squared_difference_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/squared_difference_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/squeeze_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/squeeze_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/stride_slice_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/stride_slice_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/stride_slice_v2_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/stride_slice_v2_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/sub_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/sub_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/tile_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/tile_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/topk_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/topk_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/unary_op_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/unary_op_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/unsqueeze_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/unsqueeze_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/upsample_layer_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/layer_interpreter/upsample_layer_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/model_interpreter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/model_interpreter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/model_packer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/interpreter/tnn/model_packer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/abs_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/abs_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/acos_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/acos_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/add_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/add_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/and_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/and_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/arg_max_or_min_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/arg_max_or_min_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/asin_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/asin_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/atan_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/atan_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/base_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/base_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/batch_norm_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/batch_norm_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/bias_add_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/bias_add_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/bitshift_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/bitshift_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/cast_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/cast_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/cbam_fused_pooling_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/cbam_fused_pooling_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/cbam_fused_reduce_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/cbam_fused_reduce_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/ceil_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/ceil_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/clip_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/clip_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/concat_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/concat_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/constantofshape_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/constantofshape_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/conv1d_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/conv1d_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/conv3d_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/conv3d_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/conv_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/conv_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/cos_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/cos_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/deconv_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/deconv_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/detection_output_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/detection_output_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/detection_post_process_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/detection_post_process_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/div_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/div_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/effective_transformer_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/effective_transformer_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/einsum_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/einsum_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/elementwise_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/elementwise_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/elu_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/elu_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/equal_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/equal_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/erf_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/erf_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/exp_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/exp_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/expand_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/expand_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/flatten_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/flatten_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/floor_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/floor_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/gather_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/gather_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/gathernd_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/gathernd_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/gelu_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/gelu_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/glu_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/glu_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/greater_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/greater_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/gridsample_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/gridsample_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/group_norm_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/group_norm_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/gru_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/gru_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/hard_sigmoid_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/hard_sigmoid_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/hard_swish_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/hard_swish_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/hdrguide_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/hdrguide_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/histogram_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/histogram_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/inner_product_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/inner_product_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/instance_norm_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/instance_norm_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/inverse_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/inverse_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/kv_cache_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/kv_cache_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/layer_norm_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/layer_norm_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/less_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/less_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/log_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/log_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/log_sigmoid_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/log_sigmoid_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/log_softmax_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/log_softmax_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/lrn_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/lrn_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/lstm_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/lstm_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/mat_mul_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/mat_mul_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/max_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/max_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/min_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/min_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/mul_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/mul_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/multidir_broadcast_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/multidir_broadcast_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/neg_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/neg_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/non_max_suppression_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/non_max_suppression_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/nonzero_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/nonzero_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/normalize_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/normalize_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/not_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/not_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/onehot_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/onehot_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/pad_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/pad_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/padv2_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/padv2_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/permute_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/permute_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/pixel_shuffle_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/pixel_shuffle_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/pooling_1d_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/pooling_1d_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/pooling_3d_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/pooling_3d_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/pooling_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/pooling_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/pow_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/pow_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/prelu_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/prelu_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/prior_box_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/prior_box_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/range_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/range_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reciprocal_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reciprocal_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_l1_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_l1_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_l2_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_l2_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_log_sum_exp_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_log_sum_exp_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_log_sum_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_log_sum_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_max_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_max_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_mean_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_mean_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_min_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_min_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_prod_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_prod_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_sum_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_sum_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_sum_square_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reduce_sum_square_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reformat_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reformat_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/relu6_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/relu6_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/relu_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/relu_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reorg_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reorg_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reshape_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/reshape_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/roi_pooling_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/roi_pooling_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/roialign_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/roialign_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/rsqrt_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/rsqrt_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/scale_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/scale_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/scatter_elements_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/scatter_elements_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/scatter_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/scatter_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/scatter_nd_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/scatter_nd_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/selu_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/selu_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/shape_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/shape_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/shuffle_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/shuffle_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/sigmoid_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/sigmoid_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/sign_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/sign_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/signed_mul_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/signed_mul_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/sin_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/sin_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/size_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/size_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/softmax_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/softmax_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/softplus_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/softplus_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/softsign_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/softsign_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/split_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/split_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/splitv_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/splitv_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/sqrt_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/sqrt_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/squared_difference_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/squared_difference_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/squeeze_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/squeeze_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/stride_slice_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/stride_slice_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/stride_slice_v2_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/stride_slice_v2_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/sub_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/sub_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/swish_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/swish_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/tan_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/tan_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/tanh_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/tanh_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/tile_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/tile_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/topk_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/topk_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/unsqueeze_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/unsqueeze_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/upsample_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/upsample_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/layer/where_layer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/layer/where_layer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/blob_1d_memory.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/blob_1d_memory.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/blob_1d_memory_pool.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/blob_1d_memory_pool.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/blob_2d_memory.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/blob_2d_memory.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/blob_2d_memory_pool.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/blob_2d_memory_pool.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/blob_memory.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/blob_memory.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/blob_memory_pool.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/blob_memory_pool.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/blob_memory_pool_factory.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/blob_memory_pool_factory.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/blob_memory_size_info.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/blob_memory_size_info.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/memory_mode_state.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/memory_mode_state.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/memory_mode_state_factory.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/memory_mode_state_factory.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/memory_seperate_assign_strategy.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/memory_seperate_assign_strategy.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/memory_unify_assign_strategy.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/memory_unify_assign_strategy.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/others_memory_mode_state.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/others_memory_mode_state.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/share_one_thread_memory_mode_state.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/share_one_thread_memory_mode_state.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/shared_memory_manager.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/memory_manager/shared_memory_manager.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/graph_matcher/common.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/graph_matcher/common.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/graph_matcher/graph_matcher.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/graph_matcher/graph_matcher.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/graph_matcher/graph_parser.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/graph_matcher/graph_parser.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/graph_matcher/graph_registry.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/graph_matcher/graph_registry.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/graph_matcher/graph_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/graph_matcher/graph_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/graph_matcher/ir.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/graph_matcher/ir.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/graph_matcher/lexer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/graph_matcher/lexer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/graph_matcher/logger.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/graph_matcher/logger.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/graph_matcher/text_graph_parser.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/graph_matcher/text_graph_parser.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_cbam_fused_pooling.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_cbam_fused_pooling.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_cbam_fused_reduce.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_cbam_fused_reduce.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_convert_matmul_to_conv.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_convert_matmul_to_conv.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_dynamic_range_dequant.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_dynamic_range_dequant.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_effective_transformer.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_effective_transformer.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_fuse_conv_activation.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_fuse_conv_activation.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_fuse_conv_add.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_fuse_conv_add.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_fuse_conv_post.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_fuse_conv_post.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_fuse_int8_reformat.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_fuse_int8_reformat.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_insert_fp16_reformat.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_insert_fp16_reformat.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_insert_int8_reformat.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_insert_int8_reformat.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_insert_layout_reformat.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_insert_layout_reformat.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_kv_cache.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_kv_cache.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_manager.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_manager.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_remove_layers.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/net_optimizer_remove_layers.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/optimizer_const.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/optimizer/optimizer_const.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/async_task_queue.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/async_task_queue.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/bbox_util.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/bbox_util.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/bfp16_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/bfp16_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/blob_converter_default.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/blob_converter_default.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/blob_converter_internal.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/blob_converter_internal.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/blob_dump_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/blob_dump_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/blob_memory_size_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/blob_memory_size_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/blob_transfer_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/blob_transfer_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/cpu_info.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/cpu_info.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/cpu_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/cpu_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/data_flag_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/data_flag_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/data_format_converter.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/data_format_converter.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/data_type_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/data_type_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/detection_post_process_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/detection_post_process_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/dims_function_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/dims_function_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/dims_offset_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/dims_offset_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/dims_vector_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/dims_vector_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/exclusive_file.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/exclusive_file.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/half_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/half_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/mat_converter_acc.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/mat_converter_acc.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/mat_converter_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/mat_converter_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/mat_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/mat_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/md5.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/md5.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/naive_compute.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/naive_compute.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/nms_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/nms_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/npu_common_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/npu_common_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/pribox_generator_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/pribox_generator_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/random_data_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/random_data_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/split_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/split_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/string_format.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/string_format.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/string_utils.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/string_utils.cc.o.d"
+  "CMakeFiles/TNN.dir/source/tnn/utils/winograd_generator.cc.o"
+  "CMakeFiles/TNN.dir/source/tnn/utils/winograd_generator.cc.o.d"
+  "libTNN.pdb"
+  "libTNN.so"
+  "libTNN.so.0"
+  "libTNN.so.0.3.0.0"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TNN.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_x86_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("source/tnn/device/x86")
+subdirs("source/tnn/device/cpu")
+subdirs("tools/quantization")
+subdirs("third_party/gflags")
+subdirs("tools/model_check")
+subdirs("test")
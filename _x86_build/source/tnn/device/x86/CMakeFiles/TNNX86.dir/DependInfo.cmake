@@ -0,0 +1,33 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/source/tnn/device/x86/acc/compute/jit/cblas_driver.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/cblas_driver.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/cblas_driver.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/jit/conv_data_packing.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/conv_data_packing.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/conv_data_packing.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/jit/conv_gemm_config.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/conv_gemm_config.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/conv_gemm_config.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/jit/conv_sgemm_driver.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/conv_sgemm_driver.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/conv_sgemm_driver.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/jit/data_packing.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/data_packing.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/data_packing.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/jit/gemm_config.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/gemm_config.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/gemm_config.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/jit/sgemm_driver.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/sgemm_driver.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/sgemm_driver.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/compute/jit/utils/cpu_isa.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/utils/cpu_isa.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/compute/jit/utils/cpu_isa.cc.o.d"
+  "/root/repo/source/tnn/device/x86/acc/x86_unary2_layer_register.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_unary2_layer_register.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/acc/x86_unary2_layer_register.cc.o.d"
+  "/root/repo/source/tnn/device/x86/x86_blob_converter.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_blob_converter.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_blob_converter.cc.o.d"
+  "/root/repo/source/tnn/device/x86/x86_context.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_context.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_context.cc.o.d"
+  "/root/repo/source/tnn/device/x86/x86_device.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_device.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_device.cc.o.d"
+  "/root/repo/source/tnn/device/x86/x86_mat_converter.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_mat_converter.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_mat_converter.cc.o.d"
+  "/root/repo/source/tnn/device/x86/x86_mat_util.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_mat_util.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_mat_util.cc.o.d"
+  "/root/repo/source/tnn/device/x86/x86_util.cc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_util.cc.o" "gcc" "source/tnn/device/x86/CMakeFiles/TNNX86.dir/x86_util.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,37 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TNNX86.dir/acc/compute/jit/cblas_driver.cc.o"
+  "CMakeFiles/TNNX86.dir/acc/compute/jit/cblas_driver.cc.o.d"
+  "CMakeFiles/TNNX86.dir/acc/compute/jit/conv_data_packing.cc.o"
+  "CMakeFiles/TNNX86.dir/acc/compute/jit/conv_data_packing.cc.o.d"
+  "CMakeFiles/TNNX86.dir/acc/compute/jit/conv_gemm_config.cc.o"
+  "CMakeFiles/TNNX86.dir/acc/compute/jit/conv_gemm_config.cc.o.d"
+  "CMakeFiles/TNNX86.dir/acc/compute/jit/conv_sgemm_driver.cc.o"
+  "CMakeFiles/TNNX86.dir/acc/compute/jit/conv_sgemm_driver.cc.o.d"
+  "CMakeFiles/TNNX86.dir/acc/compute/jit/data_packing.cc.o"
+  "CMakeFiles/TNNX86.dir/acc/compute/jit/data_packing.cc.o.d"
+  "CMakeFiles/TNNX86.dir/acc/compute/jit/gemm_config.cc.o"
+  "CMakeFiles/TNNX86.dir/acc/compute/jit/gemm_config.cc.o.d"
+  "CMakeFiles/TNNX86.dir/acc/compute/jit/sgemm_driver.cc.o"
+  "CMakeFiles/TNNX86.dir/acc/compute/jit/sgemm_driver.cc.o.d"
+  "CMakeFiles/TNNX86.dir/acc/compute/jit/utils/cpu_isa.cc.o"
+  "CMakeFiles/TNNX86.dir/acc/compute/jit/utils/cpu_isa.cc.o.d"
+  "CMakeFiles/TNNX86.dir/acc/x86_unary2_layer_register.cc.o"
+  "CMakeFiles/TNNX86.dir/acc/x86_unary2_layer_register.cc.o.d"
+  "CMakeFiles/TNNX86.dir/x86_blob_converter.cc.o"
+  "CMakeFiles/TNNX86.dir/x86_blob_converter.cc.o.d"
+  "CMakeFiles/TNNX86.dir/x86_context.cc.o"
+  "CMakeFiles/TNNX86.dir/x86_context.cc.o.d"
+  "CMakeFiles/TNNX86.dir/x86_device.cc.o"
+  "CMakeFiles/TNNX86.dir/x86_device.cc.o.d"
+  "CMakeFiles/TNNX86.dir/x86_mat_converter.cc.o"
+  "CMakeFiles/TNNX86.dir/x86_mat_converter.cc.o.d"
+  "CMakeFiles/TNNX86.dir/x86_mat_util.cc.o"
+  "CMakeFiles/TNNX86.dir/x86_mat_util.cc.o.d"
+  "CMakeFiles/TNNX86.dir/x86_util.cc.o"
+  "CMakeFiles/TNNX86.dir/x86_util.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TNNX86.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
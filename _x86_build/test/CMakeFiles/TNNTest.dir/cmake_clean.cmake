@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/TNNTest.dir/flags.cc.o"
+  "CMakeFiles/TNNTest.dir/flags.cc.o.d"
+  "CMakeFiles/TNNTest.dir/test.cc.o"
+  "CMakeFiles/TNNTest.dir/test.cc.o.d"
+  "CMakeFiles/TNNTest.dir/test_utils.cc.o"
+  "CMakeFiles/TNNTest.dir/test_utils.cc.o.d"
+  "CMakeFiles/TNNTest.dir/timer.cc.o"
+  "CMakeFiles/TNNTest.dir/timer.cc.o.d"
+  "TNNTest"
+  "TNNTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TNNTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
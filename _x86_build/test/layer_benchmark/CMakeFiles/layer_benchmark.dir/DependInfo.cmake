@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/flags.cc" "test/layer_benchmark/CMakeFiles/layer_benchmark.dir/__/flags.cc.o" "gcc" "test/layer_benchmark/CMakeFiles/layer_benchmark.dir/__/flags.cc.o.d"
+  "/root/repo/test/test_utils.cc" "test/layer_benchmark/CMakeFiles/layer_benchmark.dir/__/test_utils.cc.o" "gcc" "test/layer_benchmark/CMakeFiles/layer_benchmark.dir/__/test_utils.cc.o.d"
+  "/root/repo/test/timer.cc" "test/layer_benchmark/CMakeFiles/layer_benchmark.dir/__/timer.cc.o" "gcc" "test/layer_benchmark/CMakeFiles/layer_benchmark.dir/__/timer.cc.o.d"
+  "/root/repo/test/unit_test/unit_test_common.cc" "test/layer_benchmark/CMakeFiles/layer_benchmark.dir/__/unit_test/unit_test_common.cc.o" "gcc" "test/layer_benchmark/CMakeFiles/layer_benchmark.dir/__/unit_test/unit_test_common.cc.o.d"
+  "/root/repo/test/layer_benchmark/layer_benchmark.cc" "test/layer_benchmark/CMakeFiles/layer_benchmark.dir/layer_benchmark.cc.o" "gcc" "test/layer_benchmark/CMakeFiles/layer_benchmark.dir/layer_benchmark.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_x86_build/CMakeFiles/TNN.dir/DependInfo.cmake"
+  "/root/repo/_x86_build/third_party/gflags/CMakeFiles/gflags_nothreads_static.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
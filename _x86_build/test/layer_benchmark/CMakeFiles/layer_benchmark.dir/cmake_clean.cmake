@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/layer_benchmark.dir/__/flags.cc.o"
+  "CMakeFiles/layer_benchmark.dir/__/flags.cc.o.d"
+  "CMakeFiles/layer_benchmark.dir/__/test_utils.cc.o"
+  "CMakeFiles/layer_benchmark.dir/__/test_utils.cc.o.d"
+  "CMakeFiles/layer_benchmark.dir/__/timer.cc.o"
+  "CMakeFiles/layer_benchmark.dir/__/timer.cc.o.d"
+  "CMakeFiles/layer_benchmark.dir/__/unit_test/unit_test_common.cc.o"
+  "CMakeFiles/layer_benchmark.dir/__/unit_test/unit_test_common.cc.o.d"
+  "CMakeFiles/layer_benchmark.dir/layer_benchmark.cc.o"
+  "CMakeFiles/layer_benchmark.dir/layer_benchmark.cc.o.d"
+  "layer_benchmark"
+  "layer_benchmark.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/layer_benchmark.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
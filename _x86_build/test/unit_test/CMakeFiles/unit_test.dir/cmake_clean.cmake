@@ -0,0 +1,207 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/unit_test.dir/__/flags.cc.o"
+  "CMakeFiles/unit_test.dir/__/flags.cc.o.d"
+  "CMakeFiles/unit_test.dir/__/test_utils.cc.o"
+  "CMakeFiles/unit_test.dir/__/test_utils.cc.o.d"
+  "CMakeFiles/unit_test.dir/__/timer.cc.o"
+  "CMakeFiles/unit_test.dir/__/timer.cc.o.d"
+  "CMakeFiles/unit_test.dir/blob_converter_test.cc.o"
+  "CMakeFiles/unit_test.dir/blob_converter_test.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/layer_test.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/layer_test.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/layer_test_utils.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/layer_test_utils.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_abs_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_abs_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_acos_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_acos_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_add_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_add_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_arg_max_or_min_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_arg_max_or_min_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_asin_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_asin_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_atan_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_atan_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_batch_norm_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_batch_norm_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_binary_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_binary_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_ceil_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_ceil_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_clip_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_clip_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_concat_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_concat_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_conv1d_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_conv1d_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_conv_3d_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_conv_3d_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_conv_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_conv_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_conv_quant_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_conv_quant_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_conv_quant_reformat_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_conv_quant_reformat_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_cos_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_cos_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_deconv_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_deconv_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_detection_output_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_detection_output_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_div_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_div_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_effective_transformer_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_effective_transformer_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_elu_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_elu_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_exp_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_exp_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_floor_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_floor_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_gelu_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_gelu_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_glu_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_glu_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_grid_sample_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_grid_sample_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_group_norm_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_group_norm_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_gru_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_gru_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_hard_sigmoid_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_hard_sigmoid_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_hard_swish_broadcast_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_hard_swish_broadcast_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_hard_swish_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_hard_swish_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_hdrguide_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_hdrguide_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_innerproduct_int8_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_innerproduct_int8_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_innerproduct_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_innerproduct_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_instance_norm_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_instance_norm_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_inverse_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_inverse_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_kv_cache_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_kv_cache_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_layer_norm_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_layer_norm_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_log_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_log_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_log_sigmoid_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_log_sigmoid_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_log_softmax_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_log_softmax_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_lstm_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_lstm_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_matmul_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_matmul_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_max_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_max_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_min_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_min_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_mul_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_mul_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_neg_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_neg_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_non_max_suppression_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_non_max_suppression_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_normalize_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_normalize_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_pad_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_pad_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_padv2_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_padv2_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_permute_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_permute_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_pixel_shuffle_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_pixel_shuffle_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_pooling_3d_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_pooling_3d_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_pooling_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_pooling_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_pow_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_pow_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_prelu_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_prelu_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_priox_box_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_priox_box_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_reciprocal_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_reciprocal_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_reduce_op_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_reduce_op_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_reformat_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_reformat_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_relu6_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_relu6_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_relu_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_relu_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_reorg_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_reorg_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_reshape_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_reshape_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_roialign_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_roialign_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_selu_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_selu_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_shuffle_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_shuffle_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_sigmoid_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_sigmoid_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_sign_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_sign_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_signed_mul_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_signed_mul_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_sin_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_sin_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_softmax_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_softmax_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_softplus_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_softplus_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_splitv_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_splitv_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_sqrt_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_sqrt_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_squeeze_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_squeeze_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_stride_slice_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_stride_slice_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_stride_slice_v2_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_stride_slice_v2_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_sub_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_sub_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_swish_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_swish_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_tan_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_tan_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_tanh_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_tanh_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_tile_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_tile_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_unary_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_unary_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_unsqueeze_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_unsqueeze_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/layer_test/test_upsample_layer.cc.o"
+  "CMakeFiles/unit_test.dir/layer_test/test_upsample_layer.cc.o.d"
+  "CMakeFiles/unit_test.dir/mat_converter_test.cc.o"
+  "CMakeFiles/unit_test.dir/mat_converter_test.cc.o.d"
+  "CMakeFiles/unit_test.dir/model_packer_test.cc.o"
+  "CMakeFiles/unit_test.dir/model_packer_test.cc.o.d"
+  "CMakeFiles/unit_test.dir/unit_test.cc.o"
+  "CMakeFiles/unit_test.dir/unit_test.cc.o.d"
+  "CMakeFiles/unit_test.dir/unit_test_common.cc.o"
+  "CMakeFiles/unit_test.dir/unit_test_common.cc.o.d"
+  "CMakeFiles/unit_test.dir/utils/network_helpers.cc.o"
+  "CMakeFiles/unit_test.dir/utils/network_helpers.cc.o.d"
+  "unit_test"
+  "unit_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/unit_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tools/common/file_reader.cc" "tools/model_check/CMakeFiles/model_check.dir/__/common/file_reader.cc.o" "gcc" "tools/model_check/CMakeFiles/model_check.dir/__/common/file_reader.cc.o.d"
+  "/root/repo/tools/model_check/flags.cc" "tools/model_check/CMakeFiles/model_check.dir/flags.cc.o" "gcc" "tools/model_check/CMakeFiles/model_check.dir/flags.cc.o.d"
+  "/root/repo/tools/model_check/main.cc" "tools/model_check/CMakeFiles/model_check.dir/main.cc.o" "gcc" "tools/model_check/CMakeFiles/model_check.dir/main.cc.o.d"
+  "/root/repo/tools/model_check/model_checker.cc" "tools/model_check/CMakeFiles/model_check.dir/model_checker.cc.o" "gcc" "tools/model_check/CMakeFiles/model_check.dir/model_checker.cc.o.d"
+  "/root/repo/tools/model_check/precision_searcher.cc" "tools/model_check/CMakeFiles/model_check.dir/precision_searcher.cc.o" "gcc" "tools/model_check/CMakeFiles/model_check.dir/precision_searcher.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_x86_build/CMakeFiles/TNN.dir/DependInfo.cmake"
+  "/root/repo/_x86_build/third_party/gflags/CMakeFiles/gflags_nothreads_static.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "../../model_check"
+  "../../model_check.pdb"
+  "CMakeFiles/model_check.dir/__/common/file_reader.cc.o"
+  "CMakeFiles/model_check.dir/__/common/file_reader.cc.o.d"
+  "CMakeFiles/model_check.dir/flags.cc.o"
+  "CMakeFiles/model_check.dir/flags.cc.o.d"
+  "CMakeFiles/model_check.dir/main.cc.o"
+  "CMakeFiles/model_check.dir/main.cc.o.d"
+  "CMakeFiles/model_check.dir/model_checker.cc.o"
+  "CMakeFiles/model_check.dir/model_checker.cc.o.d"
+  "CMakeFiles/model_check.dir/precision_searcher.cc.o"
+  "CMakeFiles/model_check.dir/precision_searcher.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/model_check.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/tools/common/file_reader.cc" "tools/quantization/CMakeFiles/quantization_cmd.dir/__/common/file_reader.cc.o" "gcc" "tools/quantization/CMakeFiles/quantization_cmd.dir/__/common/file_reader.cc.o.d"
+  "/root/repo/tools/quantization/calibration.cc" "tools/quantization/CMakeFiles/quantization_cmd.dir/calibration.cc.o" "gcc" "tools/quantization/CMakeFiles/quantization_cmd.dir/calibration.cc.o.d"
+  "/root/repo/tools/quantization/quantize.cc" "tools/quantization/CMakeFiles/quantization_cmd.dir/quantize.cc.o" "gcc" "tools/quantization/CMakeFiles/quantization_cmd.dir/quantize.cc.o.d"
+  "/root/repo/tools/quantization/scale_calculator.cc" "tools/quantization/CMakeFiles/quantization_cmd.dir/scale_calculator.cc.o" "gcc" "tools/quantization/CMakeFiles/quantization_cmd.dir/scale_calculator.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_x86_build/CMakeFiles/TNN.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "../../quantization_cmd"
+  "../../quantization_cmd.pdb"
+  "CMakeFiles/quantization_cmd.dir/__/common/file_reader.cc.o"
+  "CMakeFiles/quantization_cmd.dir/__/common/file_reader.cc.o.d"
+  "CMakeFiles/quantization_cmd.dir/calibration.cc.o"
+  "CMakeFiles/quantization_cmd.dir/calibration.cc.o.d"
+  "CMakeFiles/quantization_cmd.dir/quantize.cc.o"
+  "CMakeFiles/quantization_cmd.dir/quantize.cc.o.d"
+  "CMakeFiles/quantization_cmd.dir/scale_calculator.cc.o"
+  "CMakeFiles/quantization_cmd.dir/scale_calculator.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/quantization_cmd.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
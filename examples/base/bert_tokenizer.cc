@@ -18,6 +18,7 @@
 #include <cstring>
 #include <time.h>
 #include <set>
+#include <thread>
 // #include "utf8.h"
 #ifdef _WIN32
     #include <windows.h>
@@ -40,15 +41,22 @@ const int kMaxCharsPerWords = 100;
 const int MaxSeqCount = 256;
 const size_t maxAns = 3;
 
+static inline bool IsPunctChar(char cp) {
+    return (cp >= 33 && cp <= 47) || (cp >= 58 && cp <= 64) ||
+           (cp >= 91 && cp <= 96) || (cp >= 123 && cp <= 126);
+}
+
+// the whitespace of StripStringASCIIWhole
+static inline bool IsSpaceChar(char cp) {
+    return cp == ' ' || cp == '\t' || cp == '\r' || cp == '\n';
+}
+
+static inline unsigned char ToLowerChar(char cp) {
+    return (cp <= 'Z' && cp >= 'A') ? cp + 32 : cp;
+}
+
 bool BertTokenizer::is_punct_char(char cp) {
-  if ((cp >= 33 && cp <= 47) || (cp >= 58 && cp <= 64) ||
-      (cp >= 91 && cp <= 96) || (cp >= 123 && cp <= 126)) {
-    return true;
-  }
-  if (cp == ' ') {
-    return false;
-  }
-  return false;
+    return IsPunctChar(cp);
 }
 
 std::string BertTokenizer::toLower(std::string s) {
@@ -143,6 +151,7 @@ Status BertTokenizer::InitByFileContent(std::string content) {
     SplitString(content.c_str(), content.size(), '\n', lines);
 
     InitFromLines(lines);
+    BuildTrie();
     if (token_2_id_map_.find(kPadToken) == token_2_id_map_.end()) {
         return Status(TNNERR_INVALID_INPUT, "The vocab file is invalid, [PAD] needed.");
     }
@@ -187,6 +196,192 @@ Status BertTokenizer::InitFromLines(const std::vector<std::string>& lines) {
     return TNN_OK;
 }
 
+void BertTokenizer::BuildTrie() {
+    // a node per prefix while inserting, then the edges are flattened by node
+    std::vector<std::map<unsigned char, int>> children(2);
+    std::vector<int> token_ids(2, -1);
+    for (size_t i = 0; i < tokens_.size(); i++) {
+        const std::string& token = tokens_[i];
+        int node                 = trie_word_root_;
+        size_t start             = 0;
+        if (token.size() > 2 && token[0] == '#' && token[1] == '#') {
+            node  = trie_piece_root_;
+            start = 2;
+        }
+        for (size_t k = start; k < token.size(); k++) {
+            unsigned char label = token[k];
+            auto it             = children[node].find(label);
+            if (it == children[node].end()) {
+                children[node][label] = static_cast<int>(children.size());
+                node                  = static_cast<int>(children.size());
+                children.emplace_back();
+                token_ids.push_back(-1);
+            } else {
+                node = it->second;
+            }
+        }
+        // the first one of duplicated tokens, the same as token_2_id_map_
+        token_ids[node] = token_2_id_map_.at(token);
+    }
+
+    trie_edge_begin_.clear();
+    trie_edge_label_.clear();
+    trie_edge_child_.clear();
+    for (const auto& node_children : children) {
+        trie_edge_begin_.push_back(static_cast<int>(trie_edge_label_.size()));
+        for (const auto& edge : node_children) {
+            trie_edge_label_.push_back(edge.first);
+            trie_edge_child_.push_back(edge.second);
+        }
+    }
+    trie_edge_begin_.push_back(static_cast<int>(trie_edge_label_.size()));
+    trie_token_id_ = token_ids;
+}
+
+size_t BertTokenizer::MatchLongest(int root, const char* begin, const char* end, int& id) const {
+    size_t matched = 0;
+    int node       = root;
+    for (const char* p = begin; p < end; p++) {
+        // the lookup of max_seg_ is in lower case
+        unsigned char label = ToLowerChar(*p);
+        auto first          = trie_edge_label_.begin() + trie_edge_begin_[node];
+        auto last           = trie_edge_label_.begin() + trie_edge_begin_[node + 1];
+        auto it             = std::lower_bound(first, last, label);
+        if (it == last || *it != label) {
+            break;
+        }
+        node = trie_edge_child_[it - trie_edge_label_.begin()];
+        if (trie_token_id_[node] >= 0) {
+            id      = trie_token_id_[node];
+            matched = p - begin + 1;
+        }
+    }
+    return matched;
+}
+
+size_t BertTokenizer::EncodeWord(const char* begin, const char* end, int* ids, size_t pos, size_t limit) const {
+    int root = trie_word_root_;
+    const char* p = begin;
+    while (p < end && pos < limit) {
+        int id       = 0;
+        size_t count = MatchLongest(root, p, end, id);
+        if (count == 0) {
+            // the same as max_seg_: unknown if nothing matches, the rest is dropped after a match
+            if (p == begin) {
+                ids[pos++] = token_2_id_map_.at(kUnkToken);
+            }
+            break;
+        }
+        ids[pos++] = id;
+        p += count;
+        root = trie_piece_root_;
+    }
+    return pos;
+}
+
+size_t BertTokenizer::EncodeText(const std::string& text, int* ids, size_t pos, size_t limit) const {
+    // the words of StripStringASCIIWhole and basic_separate: runs of non punctuate characters and single
+    // punctuate characters, split by whitespace
+    const char* str = text.c_str();
+    const size_t len = text.size();
+    size_t i = 0;
+    while (i < len && pos < limit) {
+        if (IsSpaceChar(str[i])) {
+            i++;
+            continue;
+        }
+        if (IsPunctChar(str[i])) {
+            pos = EncodeWord(str + i, str + i + 1, ids, pos, limit);
+            i++;
+            continue;
+        }
+        size_t start = i;
+        while (i < len && !IsSpaceChar(str[i]) && !IsPunctChar(str[i])) {
+            i++;
+        }
+        // basic_separate puts "##" before a word right after a punctuate character, it counts in the length
+        size_t word_len = i - start + ((start > 0 && IsPunctChar(str[start - 1])) ? 2 : 0);
+        if (word_len > static_cast<size_t>(kMaxCharsPerWords)) {
+            ids[pos++] = token_2_id_map_.at(kUnkToken);
+        } else {
+            pos = EncodeWord(str + start, str + i, ids, pos, limit);
+        }
+    }
+    return pos;
+}
+
+void BertTokenizer::BuildDocumentInput(const std::string& paragraph, const std::string& question,
+                                       size_t max_seq_len, int* input_ids, int* input_masks, int* segments) const {
+    // [CLS] question [SEP] paragraph [SEP], the paragraph and the last [SEP] are segment 1
+    size_t pos = 0;
+    if (pos < max_seq_len) {
+        input_ids[pos++] = token_2_id_map_.at(kClsToken);
+    }
+    pos = EncodeText(question, input_ids, pos, max_seq_len);
+    if (pos < max_seq_len) {
+        input_ids[pos++] = token_2_id_map_.at(kSepToken);
+    }
+    size_t segment_start = pos;
+    pos = EncodeText(paragraph, input_ids, pos, max_seq_len);
+    if (pos < max_seq_len) {
+        input_ids[pos++] = token_2_id_map_.at(kSepToken);
+    }
+
+    for (size_t i = 0; i < max_seq_len; i++) {
+        if (i >= pos) {
+            input_ids[i] = 0;
+        }
+        input_masks[i] = i < pos ? 1 : 0;
+        segments[i]    = (i >= segment_start && i < pos) ? 1 : 0;
+    }
+}
+
+Status BertTokenizer::BuildBatchInput(const std::vector<std::string>& paragraphs,
+                                      const std::vector<std::string>& questions, int max_seq_len, int* input_ids,
+                                      int* input_masks, int* segments, int num_threads) const {
+    if (paragraphs.size() != questions.size()) {
+        return Status(TNNERR_INVALID_INPUT, "The numbers of paragraphs and questions are different.");
+    }
+    if (trie_token_id_.empty()) {
+        return Status(TNNERR_INVALID_INPUT, "The vocabulary is not initialized.");
+    }
+    if (max_seq_len <= 0 || !input_ids || !input_masks || !segments) {
+        return Status(TNNERR_INVALID_INPUT, "The batch input buffers are invalid.");
+    }
+
+    const int batch = static_cast<int>(paragraphs.size());
+    auto worker = [&](int thread_id, int thread_count) {
+        for (int b = thread_id; b < batch; b += thread_count) {
+            size_t offset = static_cast<size_t>(b) * max_seq_len;
+            BuildDocumentInput(paragraphs[b], questions[b], max_seq_len, input_ids + offset,
+                               input_masks + offset, segments + offset);
+        }
+    };
+
+    // the documents are independent, each thread writes its own rows
+    num_threads = std::max(1, std::min(num_threads, batch));
+    std::vector<std::thread> workers;
+    for (int t = 1; t < num_threads; t++) {
+        workers.push_back(std::thread(worker, t, num_threads));
+    }
+    worker(0, num_threads);
+    for (auto& thread : workers) {
+        thread.join();
+    }
+    return TNN_OK;
+}
+
+Status BertTokenizer::BuildBatchInput(const std::vector<std::string>& paragraphs,
+                                      const std::vector<std::string>& questions,
+                                      std::shared_ptr<BertTokenizerInput> input, int num_threads) const {
+    if (!input || static_cast<size_t>(input->batch) != paragraphs.size()) {
+        return Status(TNNERR_INVALID_INPUT, "The batch of the input is different from the documents.");
+    }
+    return BuildBatchInput(paragraphs, questions, input->maxSeqLen, reinterpret_cast<int*>(input->inputIds),
+                           reinterpret_cast<int*>(input->inputMasks), reinterpret_cast<int*>(input->segments),
+                           num_threads);
+}
+
 size_t BertTokenizer::Word2Id(std::string word) {
     if (word.size() > kMaxCharsPerWords) {
         return token_2_id_map_.at(kUnkToken);
@@ -341,11 +536,16 @@ Status BertTokenizer::buildInput(std::string paragraph, std::string question, st
 }
 
 BertTokenizerInput::BertTokenizerInput(DeviceType device_type, const std::string& input_id_name,
-    const std::string& mask_name, const std::string& segment_name) {
-    inputIds = (void*)malloc(sizeof(float) * MaxSeqCount);
-    inputMasks = (void*)malloc(sizeof(float) * MaxSeqCount);
-    segments = (void*)malloc(sizeof(float) * MaxSeqCount);
-    DimsVector nchw = {1, MaxSeqCount};
+    const std::string& mask_name, const std::string& segment_name) :
+    BertTokenizerInput(device_type, input_id_name, mask_name, segment_name, 1, MaxSeqCount) {}
+
+BertTokenizerInput::BertTokenizerInput(DeviceType device_type, const std::string& input_id_name,
+    const std::string& mask_name, const std::string& segment_name, int batch, int max_seq_len) :
+    batch(batch), maxSeqLen(max_seq_len) {
+    inputIds = (void*)malloc(sizeof(int) * batch * max_seq_len);
+    inputMasks = (void*)malloc(sizeof(int) * batch * max_seq_len);
+    segments = (void*)malloc(sizeof(int) * batch * max_seq_len);
+    DimsVector nchw = {batch, max_seq_len};
 
     mat_map_.insert(std::pair<std::string, std::shared_ptr<Mat>>(input_id_name.c_str(), 
         std::make_shared<TNN_NS::Mat>(device_type, NC_INT32, nchw, inputIds)));
@@ -415,8 +615,10 @@ Status BertTokenizer::ConvertResult(std::shared_ptr<TNNSDKOutput> output, const
     float *start_logits, *end_logits;
     start_logits = reinterpret_cast<float*>(output->GetMat(start_logits_name.c_str())->GetData());
     end_logits   = reinterpret_cast<float*>(output->GetMat(end_logits_name.c_str())->GetData());
-    start_index = _get_best_indexes(start_logits, MaxSeqCount, 20);
-    end_index   = _get_best_indexes(end_logits, MaxSeqCount, 20);
+    // only the tokens of the input, the logits of the padding are 0 if the network skips it
+    size_t num_tokens = std::min(features_.size(), (size_t)MaxSeqCount);
+    start_index = _get_best_indexes(start_logits, num_tokens, 20);
+    end_index   = _get_best_indexes(end_logits, num_tokens, 20);
 
     std::vector<std::shared_ptr<struct prelim_prediction>> prelim_predictions;
 
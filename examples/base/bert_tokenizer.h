@@ -37,10 +37,15 @@ class BertTokenizerInput : public TNNSDKInput {
 public:
     BertTokenizerInput(DeviceType device_type, const std::string& input_id_name,
             const std::string& mask_name, const std::string& segment_name);
+    // @brief inputs of [batch, max_seq_len] for BertTokenizer::BuildBatchInput
+    BertTokenizerInput(DeviceType device_type, const std::string& input_id_name,
+            const std::string& mask_name, const std::string& segment_name, int batch, int max_seq_len);
     virtual ~BertTokenizerInput();
     void* inputIds;
     void* inputMasks;
     void* segments;
+    int batch;
+    int maxSeqLen;
 };
 
 class BertTokenizer {
@@ -69,6 +74,16 @@ public:
     // build inputBert with paragraph and question
     Status buildInput(std::string paragraph, std::string question, std::shared_ptr<BertTokenizerInput> input);
 
+    // @brief build the inputs of a batch of paragraphs and questions, the documents are tokenized by num_threads
+    // threads. the ids are the same as buildInput, the features for ConvertResult are not kept.
+    Status BuildBatchInput(const std::vector<std::string>& paragraphs, const std::vector<std::string>& questions,
+                           std::shared_ptr<BertTokenizerInput> input, int num_threads = 1) const;
+
+    // @brief build the inputs of a batch into int32 buffers of [batch, max_seq_len], e.g. the input blobs
+    Status BuildBatchInput(const std::vector<std::string>& paragraphs, const std::vector<std::string>& questions,
+                           int max_seq_len, int* input_ids, int* input_masks, int* segments,
+                           int num_threads = 1) const;
+
     // @brief get indexes from result
     std::vector<size_t> _get_best_indexes(float* logits, size_t size, size_t n_best_size);
 
@@ -100,10 +115,36 @@ private:
     // @brief split string ASCII
     std::string StripStringASCIIWhole(const std::string str);
 
+    // @brief build the vocabulary trie from tokens_
+    void BuildTrie();
+
+    // @brief length of the longest token at the head of [begin, end) from the root node, 0 if none
+    size_t MatchLongest(int root, const char* begin, const char* end, int& id) const;
+
+    // @brief write the ids of the word pieces of a word from ids[pos], return the next pos
+    size_t EncodeWord(const char* begin, const char* end, int* ids, size_t pos, size_t limit) const;
+
+    // @brief write the ids of a text from ids[pos] as Encode does, return the next pos
+    size_t EncodeText(const std::string& text, int* ids, size_t pos, size_t limit) const;
+
+    // @brief build the inputs of one document in rows of max_seq_len
+    void BuildDocumentInput(const std::string& paragraph, const std::string& question, size_t max_seq_len,
+                            int* input_ids, int* input_masks, int* segments) const;
+
     // @param map between token and id in vocabulary
     std::map<std::string, int> token_2_id_map_;
     std::vector<std::string> tokens_;
 
+    // @param vocabulary trie in flat arrays, the edges of node n are [trie_edge_begin_[n], trie_edge_begin_[n + 1])
+    // sorted by label. the words are under trie_word_root_, the "##" pieces without "##" under trie_piece_root_.
+    std::vector<int> trie_edge_begin_;
+    std::vector<unsigned char> trie_edge_label_;
+    std::vector<int> trie_edge_child_;
+    // @param token id of each node, -1 if no token ends at the node
+    std::vector<int> trie_token_id_;
+    int trie_word_root_  = 0;
+    int trie_piece_root_ = 1;
+
     // signs needed by vocabulary
     // @param [Unk] for Unknown
     static std::string kUnkToken;
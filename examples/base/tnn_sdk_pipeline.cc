@@ -0,0 +1,290 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn_sdk_pipeline.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace TNN_NS {
+
+static double GetCurrentTimeMs() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::microseconds>(now).count() / 1000.0;
+}
+
+struct TNNPipelineFrame {
+    int64_t id = 0;
+    // TNNSDKInput before the first stage, TNNSDKOutput of the previous stage after
+    std::shared_ptr<TNNSDKInput> data = nullptr;
+    Status status                     = TNN_OK;
+    double enqueue_time               = 0;
+};
+
+// bounded queue which hands out frames in id order. the frame with the next id is always accepted even if the
+// queue is full, otherwise producers holding later frames could block it forever.
+class TNNPipelineQueue {
+public:
+    explicit TNNPipelineQueue(int capacity) : capacity_(std::max(capacity, 1)) {}
+
+    // @brief blocks while full, returns false after Stop
+    bool Push(TNNPipelineFrame frame) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [&] { return stopped_ || frame.id == next_id_ || (int)frames_.size() < capacity_; });
+        if (stopped_) {
+            return false;
+        }
+        frame.enqueue_time = GetCurrentTimeMs();
+        frames_[frame.id]  = frame;
+        max_size_          = std::max(max_size_, (int)frames_.size());
+        cond_.notify_all();
+        return true;
+    }
+
+    // @brief blocks until the next frame arrives, returns false after Stop, or after Close once empty
+    bool Pop(TNNPipelineFrame &frame) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cond_.wait(lock, [&] { return stopped_ || (closed_ && frames_.empty()) || frames_.count(next_id_) > 0; });
+        if (stopped_ || frames_.count(next_id_) == 0) {
+            return false;
+        }
+        auto iter = frames_.find(next_id_);
+        frame     = iter->second;
+        frames_.erase(iter);
+        next_id_++;
+        cond_.notify_all();
+        return true;
+    }
+
+    // @brief producers are done
+    void Close() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        closed_ = true;
+        cond_.notify_all();
+    }
+
+    void Stop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stopped_ = true;
+        cond_.notify_all();
+    }
+
+    int Size() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return (int)frames_.size();
+    }
+
+    int MaxSize() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return max_size_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::map<int64_t, TNNPipelineFrame> frames_;
+    int64_t next_id_ = 0;
+    int capacity_    = 1;
+    int max_size_    = 0;
+    bool closed_     = false;
+    bool stopped_    = false;
+};
+
+struct TNNSDKPipeline::Stage {
+    TNNPipelineStageOption option;
+    std::shared_ptr<TNNPipelineQueue> queue = nullptr;
+
+    std::mutex mutex;
+    int active_workers  = 0;
+    int frames          = 0;
+    double process_time = 0;
+    double wait_time    = 0;
+};
+
+TNNSDKPipeline::TNNSDKPipeline() : frames_out_(0) {}
+
+TNNSDKPipeline::~TNNSDKPipeline() {
+    Stop();
+}
+
+Status TNNSDKPipeline::AddStage(TNNPipelineStageOption option) {
+    if (started_) {
+        return Status(TNNERR_PARAM_ERR, "TNNSDKPipeline::AddStage must be called before Start");
+    }
+    if (!option.func) {
+        if (option.sdks.empty()) {
+            return Status(TNNERR_PARAM_ERR, "TNNSDKPipeline stage has neither sdks nor func");
+        }
+        option.func = [](TNNSDKSample *sdk, std::shared_ptr<TNNSDKInput> input,
+                         std::shared_ptr<TNNSDKOutput> &output) { return sdk->Predict(input, output); };
+    }
+    for (auto sdk : option.sdks) {
+        if (!sdk) {
+            return Status(TNNERR_PARAM_ERR, "TNNSDKPipeline stage has null sdk");
+        }
+    }
+    if (option.sdks.empty() && option.num_workers < 1) {
+        return Status(TNNERR_PARAM_ERR, "TNNSDKPipeline stage has no worker");
+    }
+    if (option.name.empty()) {
+        option.name = "stage" + std::to_string(stages_.size());
+    }
+
+    auto stage    = std::make_shared<Stage>();
+    stage->option = option;
+    stage->queue  = std::make_shared<TNNPipelineQueue>(option.queue_capacity);
+    stages_.push_back(stage);
+    return TNN_OK;
+}
+
+Status TNNSDKPipeline::Start() {
+    if (started_) {
+        return Status(TNNERR_PARAM_ERR, "TNNSDKPipeline is already started");
+    }
+    if (stages_.empty()) {
+        return Status(TNNERR_PARAM_ERR, "TNNSDKPipeline has no stage");
+    }
+    // the output queue only limits how far finished frames run ahead of Pop
+    output_queue_ = std::make_shared<TNNPipelineQueue>(stages_.back()->option.queue_capacity);
+    start_time_   = GetCurrentTimeMs();
+    started_      = true;
+
+    for (int i = 0; i < (int)stages_.size(); i++) {
+        auto &option = stages_[i]->option;
+        auto sdks    = option.sdks;
+        if (sdks.empty()) {
+            sdks.resize(option.num_workers, nullptr);
+        }
+        stages_[i]->active_workers = (int)sdks.size();
+        for (auto sdk : sdks) {
+            workers_.push_back(std::thread(&TNNSDKPipeline::RunWorker, this, i, sdk));
+        }
+    }
+    return TNN_OK;
+}
+
+void TNNSDKPipeline::RunWorker(int stage_index, std::shared_ptr<TNNSDKSample> sdk) {
+    auto stage      = stages_[stage_index];
+    auto next_queue = stage_index + 1 < (int)stages_.size() ? stages_[stage_index + 1]->queue : output_queue_;
+
+    TNNPipelineFrame frame;
+    while (stage->queue->Pop(frame)) {
+        double begin_time = GetCurrentTimeMs();
+        // a failed frame still goes through the stages to keep the order, it is reported by Pop
+        if (frame.status == TNN_OK) {
+            std::shared_ptr<TNNSDKOutput> output = nullptr;
+            frame.status = stage->option.func(sdk.get(), frame.data, output);
+            frame.data   = output;
+        }
+        double end_time = GetCurrentTimeMs();
+        {
+            std::unique_lock<std::mutex> lock(stage->mutex);
+            stage->frames++;
+            stage->process_time += end_time - begin_time;
+            stage->wait_time += begin_time - frame.enqueue_time;
+        }
+        if (!next_queue->Push(frame)) {
+            break;
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(stage->mutex);
+    if (--stage->active_workers == 0) {
+        next_queue->Close();
+    }
+}
+
+Status TNNSDKPipeline::Push(std::shared_ptr<TNNSDKInput> input) {
+    if (!started_ || stages_.empty()) {
+        return Status(TNNERR_PARAM_ERR, "TNNSDKPipeline is not started");
+    }
+    if (!input) {
+        return Status(TNNERR_PARAM_ERR, "TNNSDKPipeline input is null");
+    }
+    TNNPipelineFrame frame;
+    frame.id   = next_frame_id_++;
+    frame.data = input;
+    if (!stages_[0]->queue->Push(frame)) {
+        return Status(TNNERR_PARAM_ERR, "TNNSDKPipeline is stopped");
+    }
+    return TNN_OK;
+}
+
+Status TNNSDKPipeline::Pop(std::shared_ptr<TNNSDKOutput> &output) {
+    output = nullptr;
+    if (!output_queue_) {
+        return Status(TNNERR_PARAM_ERR, "TNNSDKPipeline is not started");
+    }
+    TNNPipelineFrame frame;
+    if (!output_queue_->Pop(frame)) {
+        return Status(TNNERR_NO_RESULT, "TNNSDKPipeline has no more frame");
+    }
+    frames_out_++;
+    output = std::dynamic_pointer_cast<TNNSDKOutput>(frame.data);
+    return frame.status;
+}
+
+void TNNSDKPipeline::Finish() {
+    if (!stages_.empty()) {
+        stages_[0]->queue->Close();
+    }
+}
+
+void TNNSDKPipeline::Stop() {
+    for (auto stage : stages_) {
+        stage->queue->Stop();
+    }
+    if (output_queue_) {
+        output_queue_->Stop();
+    }
+    for (auto &worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+}
+
+std::vector<TNNPipelineStageStat> TNNSDKPipeline::GetStageStats() {
+    std::vector<TNNPipelineStageStat> stats;
+    double elapsed = started_ ? GetCurrentTimeMs() - start_time_ : 0;
+    for (auto stage : stages_) {
+        TNNPipelineStageStat stat;
+        stat.name            = stage->option.name;
+        stat.num_workers     = stage->option.sdks.empty() ? stage->option.num_workers : (int)stage->option.sdks.size();
+        stat.queue_depth     = stage->queue->Size();
+        stat.max_queue_depth = stage->queue->MaxSize();
+        {
+            std::unique_lock<std::mutex> lock(stage->mutex);
+            stat.frames = stage->frames;
+            if (stage->frames > 0) {
+                stat.avg_process_time = stage->process_time / stage->frames;
+                stat.avg_wait_time    = stage->wait_time / stage->frames;
+            }
+            if (stage->process_time > 0) {
+                stat.max_fps = stat.num_workers * stage->frames * 1000.0 / stage->process_time;
+            }
+        }
+        stat.fps = elapsed > 0 ? stat.frames * 1000.0 / elapsed : 0;
+        stats.push_back(stat);
+    }
+    return stats;
+}
+
+double TNNSDKPipeline::GetFPS() {
+    double elapsed = started_ ? GetCurrentTimeMs() - start_time_ : 0;
+    return elapsed > 0 ? frames_out_ * 1000.0 / elapsed : 0;
+}
+
+}  // namespace TNN_NS
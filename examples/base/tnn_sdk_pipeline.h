@@ -0,0 +1,120 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_EXAMPLES_BASE_TNN_SDK_PIPELINE_H_
+#define TNN_EXAMPLES_BASE_TNN_SDK_PIPELINE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tnn_sdk_sample.h"
+
+namespace TNN_NS {
+
+// @brief process one frame in a stage. sdk is the sample owned by the calling worker, it may be null for
+// stages without model (decode, pre/post process). the output of a stage is the input of the next stage.
+typedef std::function<Status(TNNSDKSample *sdk, std::shared_ptr<TNNSDKInput> input,
+                             std::shared_ptr<TNNSDKOutput> &output)>
+    TNNPipelineStageFunc;
+
+struct TNNPipelineStageOption {
+    std::string name = "";
+    // one worker thread per sample, a sample is never used by two workers. a stage with model
+    // needs its own samples (instances), they must not be shared with other stages.
+    std::vector<std::shared_ptr<TNNSDKSample>> sdks = {};
+    // worker count of stages without model, ignored if sdks is not empty
+    int num_workers = 1;
+    // capacity of the queue in front of the stage
+    int queue_capacity = 4;
+    // default calls sdk->Predict
+    TNNPipelineStageFunc func = nullptr;
+};
+
+struct TNNPipelineStageStat {
+    std::string name = "";
+    int num_workers  = 0;
+    int frames       = 0;
+    // frames per second of the stage since Start
+    double fps = 0;
+    // frames per second the workers could do without waiting, the smallest one bounds the pipeline
+    double max_fps = 0;
+    // average time in ms a worker spent on one frame
+    double avg_process_time = 0;
+    // average time in ms a frame waited in the queue in front of the stage
+    double avg_wait_time = 0;
+    int queue_depth     = 0;
+    int max_queue_depth = 0;
+};
+
+class TNNPipelineQueue;
+
+// @brief streaming executor of multi-stage samples. frames pass the stages through bounded queues, each
+// stage runs on its own workers, so the stages of different frames overlap and the throughput goes to the one
+// of the slowest stage. frames enter each stage and leave the pipeline in Push order.
+class TNNSDKPipeline {
+public:
+    TNNSDKPipeline();
+    virtual ~TNNSDKPipeline();
+
+    // @brief append a stage, must be called before Start
+    Status AddStage(TNNPipelineStageOption option);
+
+    // @brief start the workers of all stages
+    Status Start();
+
+    // @brief feed a frame, blocks while the first queue is full
+    Status Push(std::shared_ptr<TNNSDKInput> input);
+
+    // @brief get the output of the next frame in Push order, blocks until it is done.
+    // status is the first error of the frame in the stages; returns TNNERR_NO_RESULT once all frames
+    // are taken after Finish, or at once after Stop.
+    Status Pop(std::shared_ptr<TNNSDKOutput> &output);
+
+    // @brief no more Push, the frames in flight still finish and can be Popped
+    void Finish();
+
+    // @brief stop and join the workers, frames in flight are dropped
+    void Stop();
+
+    // @brief stat of each stage, in stage order
+    std::vector<TNNPipelineStageStat> GetStageStats();
+
+    // @brief frames per second of the whole pipeline since Start
+    double GetFPS();
+
+private:
+    struct Stage;
+
+    void RunWorker(int stage_index, std::shared_ptr<TNNSDKSample> sdk);
+
+    std::vector<std::shared_ptr<Stage>> stages_ = {};
+    // output queue after the last stage
+    std::shared_ptr<TNNPipelineQueue> output_queue_ = nullptr;
+    std::vector<std::thread> workers_               = {};
+    int64_t next_frame_id_                          = 0;
+    std::atomic<int64_t> frames_out_;
+    double start_time_                              = 0;
+    bool started_                                   = false;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_EXAMPLES_BASE_TNN_SDK_PIPELINE_H_
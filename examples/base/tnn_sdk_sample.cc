@@ -15,6 +15,7 @@
 #include "tnn_sdk_sample.h"
 #include "sample_timer.h"
 #include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/nms_utils.h"
 #include <algorithm>
 #include <cstring>
 #include <float.h>
@@ -611,6 +612,7 @@ TNN_NS::Status TNNSDKSample::Init(std::shared_ptr<TNNSDKOption> option) {
         network_config.device_type  = device_type_;
         network_config.precision = option->precision;
         network_config.cache_path = option->cache_path;
+        network_config.ragged_batch_mask = option->ragged_batch_mask;
         if(device_type_ == TNN_NS::DEVICE_HUAWEI_NPU){
             network_config.network_type = NETWORK_TYPE_HUAWEI_NPU;
         }
@@ -954,7 +956,20 @@ void NMS(std::vector<ObjectInfo> &input, std::vector<ObjectInfo> &output, float
 
     int box_num = input.size();
 
+    // boxes in pixel coordinates, the right and bottom edges are inclusive
+    BoxSoA boxes;
+    boxes.offset = 1.f;
+    boxes.Resize(box_num);
+    for (int i = 0; i < box_num; i++) {
+        boxes.x1[i] = input[i].x1;
+        boxes.y1[i] = input[i].y1;
+        boxes.x2[i] = input[i].x2;
+        boxes.y2[i] = input[i].y2;
+    }
+    boxes.ComputeArea();
+
     std::vector<int> merged(box_num, 0);
+    std::vector<float> iou(box_num);
 
     for (int i = 0; i < box_num; i++) {
         if (merged[i])
@@ -964,39 +979,12 @@ void NMS(std::vector<ObjectInfo> &input, std::vector<ObjectInfo> &output, float
         buf.push_back(input[i]);
         merged[i] = 1;
 
-        float h0 = input[i].y2 - input[i].y1 + 1;
-        float w0 = input[i].x2 - input[i].x1 + 1;
-
-        float area0 = h0 * w0;
-
+        NMSUtils::IoU(boxes, i, i + 1, box_num, iou.data());
         for (int j = i + 1; j < box_num; j++) {
             if (merged[j])
                 continue;
 
-            float inner_x0 = input[i].x1 > input[j].x1 ? input[i].x1 : input[j].x1;
-            float inner_y0 = input[i].y1 > input[j].y1 ? input[i].y1 : input[j].y1;
-
-            float inner_x1 = input[i].x2 < input[j].x2 ? input[i].x2 : input[j].x2;
-            float inner_y1 = input[i].y2 < input[j].y2 ? input[i].y2 : input[j].y2;
-
-            float inner_h = inner_y1 - inner_y0 + 1;
-            float inner_w = inner_x1 - inner_x0 + 1;
-
-            if (inner_h <= 0 || inner_w <= 0)
-                continue;
-
-            float inner_area = inner_h * inner_w;
-
-            float h1 = input[j].y2 - input[j].y1 + 1;
-            float w1 = input[j].x2 - input[j].x1 + 1;
-
-            float area1 = h1 * w1;
-
-            float score;
-
-            score = inner_area / (area0 + area1 - inner_area);
-
-            if (score > iou_threshold) {
+            if (iou[j - i - 1] > iou_threshold) {
                 merged[j] = 1;
                 buf.push_back(input[j]);
             }
@@ -172,6 +172,8 @@ public:
     Precision precision = PRECISION_AUTO;
     InputShapesMap input_shapes = {};
     InputShapesMap max_input_shapes = {};
+    // attention mask input of a transformer, the position-wise layers skip its padding on x86 and naive
+    std::string ragged_batch_mask = "";
 };
 
 typedef enum {
@@ -78,6 +78,8 @@ int main(int argc, char **argv) {
         #ifdef _CUDA_
             option->compute_units = TNN_NS::TNNComputeUnitsGPU;
         #endif
+        // the input is padded to 256 tokens, skip the padding in the position-wise layers
+        option->ragged_batch_mask = "input_mask_0";
         
     }
 
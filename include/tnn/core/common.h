@@ -167,6 +167,18 @@ struct PUBLIC NetworkConfig {
     // network init or reshape may cost more time to select opt kernel implement if enable tune kernel
     // cache_path can set to store tune kernel info.
     bool enable_tune_kernel = false;
+
+    // name of the [batch, seq_len] attention mask input of a transformer, non zero for the tokens and 0 for the
+    // padding. if set on x86 and naive, the position-wise layers (MatMul with constant weight, LayerNorm, Gelu,
+    // ...) run on the tokens of all sequences packed together and skip the padding, the attention still runs on
+    // [batch, seq_len]. the outputs at the padding are 0.
+    std::string ragged_batch_mask = "";
+
+    // the number of positions of the key/value cache of an autoregressive decoder. if non zero on x86 and naive,
+    // the past key/value inputs concatenated with the new positions into the present key/value outputs are
+    // replaced by caches held by the instance: each Forward takes the new positions only and appends them to the
+    // caches, Instance::ResetState empties the caches for the next sequence.
+    int kv_cache_max_length = 0;
 };
 
 struct PUBLIC ModelConfig {
@@ -194,6 +206,10 @@ struct PUBLIC ModelConfig {
     // set Conv_1 layer to use fp32 inference
     // in OpenCL, the result of conv is incorrect on some chips, you can use the unoptimized conv with following config,
     // "ExtraConfig:Conv_0:opencl_use_unoptimized_conv;"
+    // on x86 and naive cpu, "ExtraConfig:LSTM_0:lstm_stateful" keeps the final hidden and cell state of LSTM_0
+    // as the initial state of the next Forward, for streaming input in chunks. Instance::ResetState starts over.
+    // tnn model packed with section index decodes the layer resources on multiple threads, the number of threads
+    // can be set by "LoadThreadNum:4", the default is the number of cpu cores.
 };
 
 typedef enum {
@@ -220,6 +236,20 @@ typedef union {
     float f;
 } RangeData;
 
+//@brief time and memory cost of one init phase, see TNN::GetInitProfile and Instance::GetInitProfile
+struct PUBLIC InitProfilingData {
+    // init phase, nested phases are joined with '/', eg. const_folder/init_layers
+    std::string phase = "";
+    // optimizer or layer name inside the phase, empty for the whole phase
+    std::string name = "";
+    // wall time in ms
+    double wall_time = 0;
+    // cpu time of the process in ms, it is larger than wall time if the phase runs on several threads
+    double cpu_time = 0;
+    // bytes of raw buffers and blob memory allocated in the phase
+    long long allocated_bytes = 0;
+};
+
 }  // namespace TNN_NS
 
 #pragma warning(pop)
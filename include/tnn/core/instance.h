@@ -89,6 +89,8 @@ public:
 
     // tnn instance network infer async.
     // device gpu, all layer infer complete will call Callback.
+    // device naive/x86, infer runs on the command queue and returns at once; Callback is called on the
+    // queue thread after infer, errors are reported by the next sync call (Forward, ConvertToMat, ...).
     Status ForwardAsync(Callback call_back);
 
     // get all input blobs
@@ -100,6 +102,13 @@ public:
     // set threads run on cpu
     Status SetCpuNumThreads(int num_threads);
 
+    // clear the state kept between forwards by stateful layers, eg. lstm layers with the extra config
+    // lstm_stateful, the next Forward starts from the initial state again.
+    Status ResetState();
+
+    // return time and memory cost of each phase of Init, eg. optimize, init_layers and each layer in them.
+    Status GetInitProfile(std::vector<InitProfilingData>& data);
+
 #if TNN_PROFILE
 public:
     /**start to profile each layer, dont call this func if you only want to profile the whole mode*/
@@ -114,6 +123,7 @@ private:
     std::shared_ptr<AbstractNetwork> const_folder_ = nullptr;
     NetworkConfig net_config_;
     ModelConfig model_config_;
+    std::vector<InitProfilingData> init_profile_ = {};
     
     AbstractNetwork *GetNetwork();
     
@@ -130,7 +140,20 @@ public:
                         std::string output_name = "",
                         DeviceType device = DEVICE_ARM, MatType mat_type = NCHW_FLOAT);
     
+    // bind a caller-owned Mat as the memory of an input blob, Forward reads it without a copy.
+    // the blob must be NCHW fp32 (set NetworkConfig.data_format to DATA_FORMAT_NCHW on devices using packed
+    // formats), the mat must be NCHW_FLOAT with the blob dims on the device memory. the instance holds the
+    // mat until it is unbound with nullptr. bind again after Reshape if the blob dims change.
+    Status BindInputMat(std::shared_ptr<Mat> mat, std::string input_name = "");
+
+    // bind a caller-owned Mat as the memory of an output blob, Forward writes the result into it.
+    // same requirements as BindInputMat.
+    Status BindOutputMat(std::shared_ptr<Mat> mat, std::string output_name = "");
+
 private:
+    Status BindMat(std::shared_ptr<Mat> mat, std::string name, bool is_input);
+    Status CheckBoundMats();
+
     // input converter
     std::map<std::string, std::shared_ptr<BlobConverter>> input_converters_ = {};
 
@@ -141,6 +164,8 @@ private:
     std::map<std::string, std::shared_ptr<Mat>> output_mats_ = {};
     // output mat convert status
     std::map<std::string, int> output_mats_convert_status_ = {};
+    // caller-owned mats bound as blob memory
+    std::map<std::string, std::shared_ptr<Mat>> bound_mats_ = {};
 };
 
 }  // namespace TNN_NS
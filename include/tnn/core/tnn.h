@@ -62,8 +62,12 @@ public:
         NetworkConfig& config, Status& status,
         InputShapesMap min_inputs_shape, InputShapesMap max_inputs_shape);
 
+    // return time and memory cost of each phase of the last Init, eg. interpret_proto, interpret_model.
+    Status GetInitProfile(std::vector<InitProfilingData>& data);
+
 private:
     std::shared_ptr<TNNImpl> impl_ = nullptr;
+    std::vector<InitProfilingData> init_profile_ = {};
 };
 
 }  // namespace TNN_NS
@@ -15,9 +15,14 @@
 #ifndef TNN_INCLUDE_TNN_UTILS_MAT_UTILS_H_
 #define TNN_INCLUDE_TNN_UTILS_MAT_UTILS_H_
 
+#include <vector>
+
 #include "tnn/core/status.h"
 #include "tnn/core/mat.h"
 
+#pragma warning(push)
+#pragma warning(disable : 4251)
+
 namespace TNN_NS {
 
 typedef enum {
@@ -73,6 +78,16 @@ struct PUBLIC CopyMakeBorderParam {
     float border_val       = 0.0f;
 };
 
+//formular: dst = scale * resize(crop(src)) + bias, computed per dst channel
+struct PUBLIC PreprocessParam {
+    // roi in src, width or height 0 means the whole src image
+    CropParam crop;
+    InterpType interp_type   = INTERP_TYPE_LINEAR;
+    std::vector<float> scale = {1.0f, 1.0f, 1.0f, 1.0f};
+    std::vector<float> bias  = {0.0f, 0.0f, 0.0f, 0.0f};
+    bool reverse_channel     = false;
+};
+
 class PUBLIC MatUtils {
 public:
     //copy cpu <-> device, cpu<->cpu, device<->device, src and dst dims must be equal.
@@ -94,8 +109,24 @@ public:
 
     //src and dst device type must be same. param top, bottom, left and right must be non-negative.
     static Status CopyMakeBorder(Mat& src, Mat& dst, CopyMakeBorderParam param, void* command_queue);
+
+    //crop, color convert, resize and normalize in one pass. src must be N8UC3, N8UC4, NGRAY, NNV12 or NNV21,
+    //dst must be NCHW_FLOAT with dims set, its data can be the memory of a nchw float input blob.
+    //NNV12 and NNV21 src are converted to bgr first, dst channel must not be larger than src channel.
+    static Status Preprocess(Mat& src, Mat& dst, PreprocessParam param, void* command_queue);
+
+    //run Preprocess for every param on the same src image and write the results into consecutive batches of dst,
+    //src batch must be 1 and dst batch must be equal to params size. rois are processed in parallel.
+    static Status PreprocessBatch(Mat& src, Mat& dst, std::vector<PreprocessParam> params, void* command_queue);
+
+    //run WarpAffine for every param on the same src image and write the results into consecutive batches of dst,
+    //src and dst mat type must be same, src batch must be 1 and dst batch must be equal to params size.
+    //when dst data is null, dst is allocated with src size. rois are processed in parallel.
+    static Status WarpAffineBatch(Mat& src, Mat& dst, std::vector<WarpAffineParam> params, void* command_queue);
 };
 
 }  // namespace TNN_NS
 
+#pragma warning(pop)
+
 #endif  // TNN_INCLUDE_TNN_UTILS_MAT_UTILS_H_
@@ -0,0 +1,69 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_INCLUDE_TNN_UTILS_NMS_UTILS_H_
+#define TNN_INCLUDE_TNN_UTILS_NMS_UTILS_H_
+
+#include <vector>
+
+#include "tnn/core/macro.h"
+
+namespace TNN_NS {
+
+// boxes in structure of arrays layout, box i spans [x1[i], x2[i]] x [y1[i], y2[i]]
+struct PUBLIC BoxSoA {
+    std::vector<float> x1;
+    std::vector<float> y1;
+    std::vector<float> x2;
+    std::vector<float> y2;
+    std::vector<float> area;
+    // added to width and height in area and intersection, use 1 for inclusive pixel coordinates
+    float offset = 0.f;
+
+    // @brief resize all arrays
+    void Resize(int count);
+
+    // @brief number of boxes
+    int Size() const;
+
+    // @brief compute the area of all boxes, boxes with non positive width or height get 0
+    void ComputeArea();
+};
+
+class NMSUtils {
+public:
+    // @brief indices of the scores above threshold, sorted by descending score and ascending index on ties.
+    // @param top_k only the top_k highest scores are selected and sorted if top_k >= 0
+    PUBLIC static void TopK(const float* scores, int count, float threshold, int top_k, std::vector<int>& indices);
+
+    // @brief iou of boxes[index] against boxes [begin, end), written to iou[0, end - begin).
+    // iou is 0 if the boxes do not intersect or either box has no area.
+    PUBLIC static void IoU(const BoxSoA& boxes, int index, int begin, int end, float* iou);
+
+    // @brief greedy nms, a candidate is kept if its iou with every kept box is not above iou_threshold.
+    // @param candidates box indices in descending score order
+    // @param max_keep stop after max_keep boxes are kept if max_keep >= 0
+    // @param eta the threshold is multiplied by eta after each kept box while it is above 0.5, as in caffe ssd
+    PUBLIC static void NMS(const BoxSoA& boxes, const std::vector<int>& candidates, float iou_threshold,
+                           std::vector<int>& keep, int max_keep = -1, float eta = 1.f);
+
+    // @brief greedy nms over the scores above score_threshold, at most top_k highest if top_k >= 0. when max_keep
+    // stops the nms early, only the candidates it reaches are sorted.
+    PUBLIC static void NMS(const BoxSoA& boxes, const float* scores, float score_threshold, int top_k,
+                           float iou_threshold, std::vector<int>& keep, int max_keep = -1, float eta = 1.f);
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_INCLUDE_TNN_UTILS_NMS_UTILS_H_
@@ -82,6 +82,22 @@ Status AbstractLayerAcc::AfterForward(const std::vector<Blob *> &inputs, const s
     return TNN_OK;
 }
 
+Status AbstractLayerAcc::ResetState() {
+    return TNN_OK;
+}
+
+size_t AbstractLayerAcc::GetWorkspaceSize(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return 0;
+}
+
+void AbstractLayerAcc::SetWorkspace(Blob *workspace) {
+    workspace_ = workspace;
+}
+
+BlobAliasType AbstractLayerAcc::GetOutputAlias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return BLOB_ALIAS_NONE;
+}
+
 void AbstractLayerAcc::SetRuntimeBlobMemoryPool(BlobMemoryPool *runtime_blob_pool) {
     runtime_blob_pool_ = runtime_blob_pool;
 }
@@ -35,6 +35,19 @@ enum BlobType {
     BLOB_OUTPUT = 1
 };
 
+// @brief how the first output of a layer may share memory with the inputs
+enum BlobAliasType {
+    // the output gets its own memory
+    BLOB_ALIAS_NONE    = 0,
+    // the output is the input data with other dims, eg. reshape. the memory is shared while either is alive.
+    BLOB_ALIAS_VIEW    = 1,
+    // the output may overwrite the input elementwise, shared only if the layer is the last reader of the input
+    BLOB_ALIAS_INPLACE = 2,
+    // the inputs are consecutive regions of the output, eg. concat with all dims before the axis 1. the inputs
+    // read by this layer only are planned inside the output, so that their producers write the output directly.
+    BLOB_ALIAS_INPUT_REGIONS = 3,
+};
+
 // @brief AbstractLayerAcc define the layer acc interface
 class AbstractLayerAcc {
 public:
@@ -85,6 +98,20 @@ public:
     // Note: this func may cost much time, call this func only when necessary。
     virtual Status ReloadConstantBlobs(const std::vector<Blob *> &inputs, bool only_reload_shape_differ_blob = false);
     
+    // @brief clear the state kept between forwards, eg. the hidden state of a stateful lstm
+    virtual Status ResetState();
+
+    // @brief scratch bytes Forward needs at the current blob shapes, queried after Reshape and planned into
+    // the forward memory. 0 if the acc does not declare its workspace.
+    virtual size_t GetWorkspaceSize(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+    // @brief set the workspace blob planned for the acc, nullptr if none
+    void SetWorkspace(Blob *workspace);
+
+    // @brief whether outputs[0] may share memory with the inputs, queried after Reshape. Forward must still
+    // work if the blob manager gives the blobs their own memory.
+    virtual BlobAliasType GetOutputAlias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
     // @brief after layer acc forward
     // @param inputs    input blobs
     // @param outputs   output blobs
@@ -124,6 +151,7 @@ protected:
     
     std::map<std::string, std::shared_ptr<Blob> > const_blob_map_ = {};
     RuntimeMode runtime_model_ = RUNTIME_MODE_NORMAL;
+    Blob *workspace_ = nullptr;
 };
 
 // @brief LayerAccCreator define create layer acc interface
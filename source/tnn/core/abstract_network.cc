@@ -33,6 +33,15 @@ Status AbstractNetwork::SetCpuNumThreads(int num_threads) {
     return TNN_OK;
 }
 
+Status AbstractNetwork::SetExternalBlobMemory(std::string name, void *memory) {
+    LOGE("Subclass of AbstractNetwork must implement this func SetExternalBlobMemory\n");
+    return Status(TNNERR_COMMON_ERROR, "Subclass of AbstractNetwork must implement this func SetExternalBlobMemory");
+}
+
+Status AbstractNetwork::ResetState() {
+    return TNN_OK;
+}
+
 #if TNN_PROFILE
 void AbstractNetwork::StartProfile() {
     LOGI("warning: to make profiling work, subclass should implement the func: StartProfile\n");
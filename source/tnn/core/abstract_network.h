@@ -93,6 +93,14 @@ public:
     // @brief set threads run on device
     virtual Status SetCpuNumThreads(int num_threads);
 
+    // @brief bind caller-owned memory to an input or output blob, nullptr to unbind
+    // @param name blob name
+    // @param memory device memory with the blob layout, must be valid until unbound
+    virtual Status SetExternalBlobMemory(std::string name, void *memory);
+
+    // @brief clear the state kept between forwards by stateful layers
+    virtual Status ResetState();
+
 #if TNN_PROFILE
 public:
     virtual void StartProfile();
@@ -17,6 +17,7 @@
 
 #include "tnn/core/blob_impl.h"
 #include "tnn/core/abstract_device.h"
+#include "tnn/core/profile.h"
 #include "tnn/memory_manager/blob_memory_size_info.h"
 #include "tnn/utils/data_flag_utils.h"
 
@@ -35,6 +36,7 @@ BlobImpl::BlobImpl(BlobDesc desc, bool alloc_memory) {
         if(device != NULL) {
             BlobMemorySizeInfo size_info = device->Calculate(desc);
             device->Allocate(&handle_.base, size_info);
+            InitProfileCollector::AddAllocatedBytes(GetBlobMemoryBytesSize(size_info));
         }
     }
 }
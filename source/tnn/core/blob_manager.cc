@@ -15,6 +15,8 @@
 #include "tnn/core/blob_manager.h"
 
 #include <algorithm>
+#include <climits>
+#include <cstdint>
 #include <cstring>
 #include <set>
 
@@ -28,6 +30,10 @@
 
 namespace TNN_NS {
 
+static const int WORKSPACE_ALIGNMENT = 32;
+// regions start at the alignment the simd kernels expect of a blob
+static const int REGION_ALIGNMENT = 32;
+
 BlobManager::BlobManager(AbstractDevice *device) {
     device_            = device;
     // create 1d memory pool
@@ -160,7 +166,8 @@ Status BlobManager::AllocateBlobMemory(int flag) {
         std::string current_blob_name = iter.first;
         Blob *current_blob            = blobs_[current_blob_name];
         if (current_blob->NeedAllocateInForward() ||
-            DataFlagUtils::ChangeStatus(current_blob->GetFlag()) != DataFlagUtils::ChangeStatus(flag)) {
+            DataFlagUtils::ChangeStatus(current_blob->GetFlag()) != DataFlagUtils::ChangeStatus(flag) ||
+            external_blob_memory_.count(current_blob) > 0) {
             continue;
         }
         // todo. need refactor
@@ -174,6 +181,10 @@ Status BlobManager::AllocateBlobMemory(int flag) {
         blob_memory_mapping_.insert(std::make_pair(current_blob, blob_memory));
     }
 
+    if (DataFlagUtils::ChangeStatus(flag) == DATA_FLAG_CHANGE_ALWAYS) {
+        PlanInputRegions();
+    }
+
     /*
      *  We reuse blob memory of the previous layers if it is not referenced.
      *  So, a use_count is calculated here.
@@ -184,7 +195,8 @@ Status BlobManager::AllocateBlobMemory(int flag) {
         for (auto current_blob_name : layer_info->outputs) {
             Blob *current_blob = blobs_[current_blob_name];
             if (current_blob->NeedAllocateInForward() ||
-                DataFlagUtils::ChangeStatus(current_blob->GetFlag()) != DataFlagUtils::ChangeStatus(flag)) {
+                DataFlagUtils::ChangeStatus(current_blob->GetFlag()) != DataFlagUtils::ChangeStatus(flag) ||
+                external_blob_memory_.count(current_blob) > 0) {
                 continue;
             }
             
@@ -194,25 +206,80 @@ Status BlobManager::AllocateBlobMemory(int flag) {
                 return Status(TNNERR_LAYER_ERR, "blob dims is invaid");
             }
 
+            auto region_iter = blob_regions_.find(current_blob);
+            if (region_iter != blob_regions_.end()) {
+                // the parent memory is borrowed when its first region is produced
+                const BlobRegion &region = region_iter->second;
+                Blob *parent_blob        = blobs_[region.parent_name];
+                if (blob_memory_mapping_.find(parent_blob) == blob_memory_mapping_.end()) {
+                    int use_count           = GetBlobUseCount(region.layer_index, region.parent_name);
+                    BlobMemorySizeInfo info = device_->Calculate(parent_blob->GetBlobDesc());
+                    BlobMemory *blob_memory = blob_memory_pool_map_[info.dims.size()]->BorrowBlobMemory(use_count, info, false);
+                    blob_memory_mapping_.insert(std::make_pair(parent_blob, blob_memory));
+                }
+                blob_memory_mapping_.insert(std::make_pair(current_blob, blob_memory_mapping_[parent_blob]));
+                continue;
+            }
+
             if (blob_memory_mapping_.find(current_blob) == blob_memory_mapping_.end()) {
                 // calculate the use count of this blob
                 int use_count = GetBlobUseCount(layer_index, current_blob_name);
 
                 BlobMemorySizeInfo info = device_->Calculate(current_blob->GetBlobDesc());
-                // find an available BlobMemory
-                BlobMemory *blob_memory = blob_memory_pool_map_[info.dims.size()]->BorrowBlobMemory(use_count, info, false);
+                BlobMemory *blob_memory = NULL;
+                if (DataFlagUtils::ChangeStatus(flag) == DATA_FLAG_CHANGE_ALWAYS) {
+                    blob_memory = GetAliasBlobMemory(layer_info, current_blob, info);
+                }
+                if (blob_memory != NULL) {
+                    // the shared memory lives until both the input and the output are no longer used
+                    blob_memory->SetUseCount(blob_memory->GetUseCount() + use_count);
+                } else {
+                    // find an available BlobMemory
+                    blob_memory = blob_memory_pool_map_[info.dims.size()]->BorrowBlobMemory(use_count, info, false);
+                }
                 blob_memory_mapping_.insert(std::make_pair(current_blob, blob_memory));
             }
         }
 
+        // the workspace is only used while the layer runs, it must not overlap the inputs and outputs
+        BlobMemory *workspace_memory = NULL;
+        auto workspace_iter          = workspace_size_.find(layer_info->name);
+        if (DataFlagUtils::ChangeStatus(flag) == DATA_FLAG_CHANGE_ALWAYS && workspace_iter != workspace_size_.end() &&
+            workspace_iter->second > 0) {
+            if (workspace_iter->second > INT_MAX - WORKSPACE_ALIGNMENT) {
+                return Status(TNNERR_LAYER_ERR, "layer workspace is too large");
+            }
+            BlobDesc desc;
+            desc.device_type = config_.device_type;
+            desc.data_type   = DATA_TYPE_INT8;
+            desc.data_format = DATA_FORMAT_NCHW;
+            desc.dims        = {static_cast<int>(workspace_iter->second)};
+            desc.name        = layer_info->name + "_workspace_";
+            Blob *&workspace_blob = workspace_blobs_[layer_info->name];
+            delete workspace_blob;
+            workspace_blob = new Blob(desc);
+
+            // spare bytes to align the workspace in BindBlobMemory
+            BlobMemorySizeInfo info;
+            info.data_type   = DATA_TYPE_INT8;
+            info.dims        = {desc.dims[0] + WORKSPACE_ALIGNMENT};
+            workspace_memory = blob_memory_pool_map_[1]->BorrowBlobMemory(1, info, false);
+            blob_memory_mapping_.insert(std::make_pair(workspace_blob, workspace_memory));
+        }
+
         // refund the input blob memory
         for (auto current_blob_name : layer_info->inputs) {
             Blob *current_blob = blobs_[current_blob_name];
             if (current_blob->NeedAllocateInForward() ||
-                DataFlagUtils::ChangeStatus(current_blob->GetFlag()) != DataFlagUtils::ChangeStatus(flag)) {
+                DataFlagUtils::ChangeStatus(current_blob->GetFlag()) != DataFlagUtils::ChangeStatus(flag) ||
+                external_blob_memory_.count(current_blob) > 0) {
                 continue;
             }
-            
+            // a region takes no count of the parent memory
+            if (blob_regions_.count(current_blob) > 0) {
+                continue;
+            }
+
             if (input_shapes_map.count(current_blob_name) == 0) {
                 std::map<Blob *, BlobMemory *>::const_iterator blob_memory_iter =
                     blob_memory_mapping_.find(current_blob);
@@ -224,6 +291,11 @@ Status BlobManager::AllocateBlobMemory(int flag) {
                 }
             }
         }
+
+        if (workspace_memory != NULL) {
+            workspace_memory->DecrementUseCount();
+            blob_memory_pool_map_[1]->RefundBlobMemory(workspace_memory);
+        }
     }
 
     Status status = TNN_OK;
@@ -260,6 +332,141 @@ Status BlobManager::AllocateBlobMemory(int flag) {
     return status;
 }
 
+// the data format of the blobs whose layers only use nchw may be left as auto
+static bool IsPlainDataFormat(DataFormat data_format) {
+    return data_format == DATA_FORMAT_NCHW || data_format == DATA_FORMAT_AUTO;
+}
+
+/*
+ * The output shares the memory of the input if the layer declared an alias and both blobs are planned
+ * by the pool in the same layout and size. The memory of a network input is kept across forwards, so
+ * it is never shared. In-place also needs the input to have no reader after this layer.
+ */
+BlobMemory *BlobManager::GetAliasBlobMemory(LayerInfo *layer_info, Blob *output_blob, BlobMemorySizeInfo &info) {
+    auto alias_iter = output_alias_.find(layer_info->name);
+    if (alias_iter == output_alias_.end() ||
+        (alias_iter->second != BLOB_ALIAS_VIEW && alias_iter->second != BLOB_ALIAS_INPLACE) || layer_info->inputs.empty() ||
+        layer_info->outputs.empty() || blobs_[layer_info->outputs[0]] != output_blob) {
+        return NULL;
+    }
+    const std::string &input_name = layer_info->inputs[0];
+    if (net_structure_->inputs_shape_map.count(input_name) > 0) {
+        return NULL;
+    }
+    Blob *input_blob = blobs_[input_name];
+    auto memory_iter = blob_memory_mapping_.find(input_blob);
+    if (input_blob == NULL || memory_iter == blob_memory_mapping_.end() ||
+        DataFlagUtils::ChangeStatus(input_blob->GetFlag()) != DATA_FLAG_CHANGE_ALWAYS ||
+        external_blob_memory_.count(input_blob) > 0) {
+        return NULL;
+    }
+
+    auto &input_desc        = input_blob->GetBlobDesc();
+    const auto &output_desc = output_blob->GetBlobDesc();
+    if (input_desc.data_type != output_desc.data_type || !IsPlainDataFormat(input_desc.data_format) ||
+        !IsPlainDataFormat(output_desc.data_format)) {
+        return NULL;
+    }
+    BlobMemorySizeInfo input_info = device_->Calculate(input_desc);
+    if (info.dims.size() != 1 || input_info.dims.size() != 1 ||
+        GetBlobMemoryBytesSize(info) != GetBlobMemoryBytesSize(input_info)) {
+        return NULL;
+    }
+
+    BlobMemory *blob_memory = memory_iter->second;
+    if (alias_iter->second == BLOB_ALIAS_INPLACE && blob_memory->GetUseCount() != 1) {
+        return NULL;
+    }
+    return blob_memory;
+}
+
+/*
+ * The inputs of an input regions layer are planned at their offsets inside the memory of the output,
+ * so that the producers write the output directly and the layer has nothing to copy. An input must be
+ * produced by a layer, read by this layer only and not be a network output; the others keep their own
+ * memory and are copied. The output must not be a region itself.
+ */
+void BlobManager::PlanInputRegions() {
+    blob_regions_.clear();
+    const auto &layers           = net_structure_->layers;
+    const auto &input_shapes_map = net_structure_->inputs_shape_map;
+    auto is_pool_blob            = [&](const std::string &name) {
+        Blob *blob = blobs_[name];
+        return blob != NULL && !blob->NeedAllocateInForward() &&
+               DataFlagUtils::ChangeStatus(blob->GetFlag()) == DATA_FLAG_CHANGE_ALWAYS &&
+               external_blob_memory_.count(blob) == 0 && input_shapes_map.count(name) == 0 &&
+               IsPlainDataFormat(blob->GetBlobDesc().data_format);
+    };
+
+    std::map<std::string, int> read_count;
+    std::map<std::string, int> producer_index;
+    for (size_t layer_index = 0; layer_index < layers.size(); layer_index++) {
+        for (auto &name : layers[layer_index]->inputs) {
+            read_count[name]++;
+        }
+        for (auto &name : layers[layer_index]->outputs) {
+            producer_index[name] = (int)layer_index;
+        }
+    }
+
+    for (size_t layer_index = 0; layer_index < layers.size(); layer_index++) {
+        LayerInfo *layer_info = layers[layer_index].get();
+        auto alias_iter       = output_alias_.find(layer_info->name);
+        if (alias_iter == output_alias_.end() || alias_iter->second != BLOB_ALIAS_INPUT_REGIONS ||
+            layer_info->outputs.empty()) {
+            continue;
+        }
+        const std::string &output_name = layer_info->outputs[0];
+        Blob *output_blob              = blobs_[output_name];
+        if (!is_pool_blob(output_name) || blob_regions_.count(output_blob) > 0) {
+            continue;
+        }
+        BlobMemorySizeInfo output_info = device_->Calculate(output_blob->GetBlobDesc());
+        if (output_info.dims.size() != 1) {
+            continue;
+        }
+
+        std::vector<std::pair<Blob *, int64_t>> offsets;
+        int64_t offset = 0;
+        for (auto &input_name : layer_info->inputs) {
+            Blob *input_blob              = blobs_[input_name];
+            BlobMemorySizeInfo input_info = device_->Calculate(input_blob->GetBlobDesc());
+            offsets.push_back(std::make_pair(input_blob, offset));
+            offset += GetBlobMemoryBytesSize(input_info);
+        }
+        if (offset != GetBlobMemoryBytesSize(output_info)) {
+            continue;
+        }
+
+        for (size_t i = 0; i < layer_info->inputs.size(); i++) {
+            const std::string &input_name = layer_info->inputs[i];
+            Blob *input_blob              = offsets[i].first;
+            auto producer_iter            = producer_index.find(input_name);
+            if (!is_pool_blob(input_name) || read_count[input_name] != 1 ||
+                net_structure_->outputs.count(input_name) > 0 || producer_iter == producer_index.end() ||
+                producer_iter->second >= (int)layer_index ||
+                input_blob->GetBlobDesc().data_type != output_blob->GetBlobDesc().data_type ||
+                device_->Calculate(input_blob->GetBlobDesc()).dims.size() != 1 ||
+                offsets[i].second % REGION_ALIGNMENT != 0) {
+                continue;
+            }
+            // a parent of earlier regions keeps its own memory
+            bool is_parent = false;
+            for (auto &iter : blob_regions_) {
+                is_parent = is_parent || iter.second.parent_name == input_name;
+            }
+            if (is_parent) {
+                continue;
+            }
+            BlobRegion region;
+            region.parent_name  = output_name;
+            region.layer_index  = (int)layer_index;
+            region.bytes_offset = (int)offsets[i].second;
+            blob_regions_[input_blob] = region;
+        }
+    }
+}
+
 /*
  * This function calculate the use count of the given blob.
  * output layer is regarded as an additional reference.
@@ -291,6 +498,10 @@ Status BlobManager::DeInit() {
     for (auto blob : blobs_) {
         delete blob.second;
     }
+    for (auto blob : workspace_blobs_) {
+        delete blob.second;
+    }
+    workspace_blobs_.clear();
 
     if (memory_mode_state_ != NULL) {
         delete memory_mode_state_;
@@ -339,6 +550,25 @@ void BlobManager::BindBlobMemory() {
             iter.first->SetBlobDesc(desc);
         }
     }
+    for (auto iter : blob_regions_) {
+        if (blob_memory_mapping_.count(iter.first) > 0) {
+            BlobHandle handle = iter.first->GetHandle();
+            handle.bytes_offset += iter.second.bytes_offset;
+            iter.first->SetHandle(handle);
+        }
+    }
+    for (auto iter : external_blob_memory_) {
+        BlobHandle handle;
+        handle.base = iter.second;
+        iter.first->SetHandle(handle);
+    }
+    // the unified forward memory packs blobs without padding, workspaces are aligned for simd loads
+    for (auto iter : workspace_blobs_) {
+        BlobHandle handle = iter.second->GetHandle();
+        uintptr_t address = reinterpret_cast<uintptr_t>(handle.base) + handle.bytes_offset;
+        handle.bytes_offset += (WORKSPACE_ALIGNMENT - address % WORKSPACE_ALIGNMENT) % WORKSPACE_ALIGNMENT;
+        iter.second->SetHandle(handle);
+    }
 }
 
 int BlobManager::GetAllBlobMemorySize() {
@@ -383,6 +613,62 @@ void BlobManager::ReplaceBlob(std::string name, Blob *new_blob) {
         output_blobs_[name] = new_blob;
 }
 
+Status BlobManager::SetExternalBlobMemory(std::string name, void *memory, bool &plan_changed) {
+    plan_changed = false;
+    if (input_blobs_.count(name) == 0 && output_blobs_.count(name) == 0) {
+        LOGE("blob %s is not an input or output of the network\n", name.c_str());
+        return Status(TNNERR_PARAM_ERR, "only input or output blob can be bound to external memory");
+    }
+    Blob *blob = blobs_[name];
+    auto desc  = blob->GetBlobDesc();
+    if (desc.data_format != DATA_FORMAT_NCHW || desc.data_type != DATA_TYPE_FLOAT ||
+        blob->NeedAllocateInForward()) {
+        LOGE("blob %s is not nchw fp32, data format: %d data type: %d\n", name.c_str(), desc.data_format,
+             desc.data_type);
+        return Status(TNNERR_PARAM_ERR, "only nchw fp32 blob can be bound to external memory");
+    }
+
+    bool was_bound = external_blob_memory_.count(blob) > 0;
+    if (memory != nullptr) {
+        external_blob_memory_[blob] = memory;
+        BlobHandle handle;
+        handle.base = memory;
+        blob->SetHandle(handle);
+    } else {
+        external_blob_memory_.erase(blob);
+        auto iter = blob_memory_mapping_.find(blob);
+        blob->SetHandle(iter != blob_memory_mapping_.end() ? iter->second->GetHandle() : BlobHandle());
+    }
+
+    plan_changed = was_bound != (memory != nullptr) && config_.share_memory_mode == SHARE_MEMORY_MODE_DEFAULT;
+    return TNN_OK;
+}
+
+void BlobManager::SetWorkspaceSize(std::string layer_name, size_t size) {
+    workspace_size_[layer_name] = size;
+}
+
+Blob *BlobManager::GetWorkspaceBlob(std::string layer_name) {
+    auto iter = workspace_blobs_.find(layer_name);
+    return iter != workspace_blobs_.end() ? iter->second : nullptr;
+}
+
+void BlobManager::SetOutputAlias(std::string layer_name, BlobAliasType alias) {
+    output_alias_[layer_name] = alias;
+}
+
+void BlobManager::ReleaseBlobMemory() {
+    blob_memory_mapping_.clear();
+    blob_regions_.clear();
+    for (auto iter : workspace_blobs_) {
+        delete iter.second;
+    }
+    workspace_blobs_.clear();
+    for (auto blob_memory_pool_iter : blob_memory_pool_map_) {
+        blob_memory_pool_iter.second->ClearBlobMemoryPool();
+    }
+}
+
 Status BlobManager::CheckBlobMemoryState() {
     return memory_mode_state_->GetStatus();
 }
@@ -79,9 +79,41 @@ public:
     // @brief replace blob with new_blob, and delete the original blob if exist
     void ReplaceBlob(std::string name, Blob *new_blob);
 
+    // @brief bind caller-owned memory to an nchw fp32 input or output blob, nullptr to unbind.
+    // @param plan_changed true if the set of bound blobs changed and the blob memory must be planned again,
+    // bound blobs take no memory from the pool. only in SHARE_MEMORY_MODE_DEFAULT, the other modes keep
+    // the forward memory size.
+    Status SetExternalBlobMemory(std::string name, void *memory, bool &plan_changed);
+
+    // @brief release the blob memory planned by AllocateBlobMemory
+    void ReleaseBlobMemory();
+
+    // @brief set the scratch bytes a layer needs while it runs. AllocateBlobMemory plans them into the
+    // forward memory, so they count in GetAllBlobMemorySize and are reused by the later layers.
+    void SetWorkspaceSize(std::string layer_name, size_t size);
+
+    // @brief get the workspace blob planned for a layer, nullptr if the layer has no workspace
+    Blob *GetWorkspaceBlob(std::string layer_name);
+
+    // @brief set whether the first output of a layer may share memory with its inputs. AllocateBlobMemory
+    // shares it if the blobs are planned by the pool with matching sizes, the input is not a network input, and
+    // for in-place the layer is the last reader of the input. Input regions are planned for the inputs that
+    // are read by this layer only.
+    void SetOutputAlias(std::string layer_name, BlobAliasType alias);
+
 protected:
+    // a blob planned at bytes_offset inside the memory of its parent blob
+    struct BlobRegion {
+        std::string parent_name;
+        // the layer producing the parent
+        int layer_index;
+        int bytes_offset;
+    };
+
     void BindBlobMemory();
     int GetBlobUseCount(int layer_index, std::string current_blob_name);
+    BlobMemory *GetAliasBlobMemory(LayerInfo *layer_info, Blob *output_blob, BlobMemorySizeInfo &info);
+    void PlanInputRegions();
 
     NetworkConfig config_;
     NetStructure *net_structure_;
@@ -93,6 +125,14 @@ protected:
     std::shared_ptr<MemoryAssignStrategy> strategy_;
     std::map<std::string, Blob *> blobs_;
     std::map<Blob *, BlobMemory *> blob_memory_mapping_;
+    // caller-owned memory of input/output blobs
+    std::map<Blob *, void *> external_blob_memory_;
+    // scratch bytes of the layers and the workspace blobs planned for them
+    std::map<std::string, size_t> workspace_size_;
+    std::map<std::string, Blob *> workspace_blobs_;
+    // layers whose first output may share memory with the inputs
+    std::map<std::string, BlobAliasType> output_alias_;
+    std::map<Blob *, BlobRegion> blob_regions_;
     bool shared_memory_allocated_;
 
     std::thread::id init_thread_id_;
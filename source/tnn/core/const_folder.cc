@@ -74,9 +74,11 @@ Status ConstFolder::Init(NetworkConfig &net_config, ModelConfig &model_config, A
 
         if (runtime_model_ == RUNTIME_MODE_CONST_FOLD && net_config.network_type != NETWORK_TYPE_COREML) {
             std::unique_lock<std::mutex> lck(optimize_mtx_);
+            InitProfileScope scope("optimize");
             for (const auto &iter : const_fold_optimizers) {
                 auto optimizer = optimizer::NetOptimizerManager::GetNetOptimizerByName(iter);
                 if (optimizer && optimizer->IsSupported(net_config)) {
+                    InitProfileScope pass_scope("", iter);
                     RETURN_ON_NEQ(optimizer->Optimize(net_structure, net_resource), TNN_OK);
                 }
             }
@@ -88,6 +90,7 @@ Status ConstFolder::Init(NetworkConfig &net_config, ModelConfig &model_config, A
         return ret;
     }
     
+    InitProfileScope scope("forward");
     return Forward();
 }
 
@@ -38,6 +38,17 @@ Status Context::ShareCommandQueue(Context* context) {
     return Status(TNNERR_COMMON_ERROR, "Subclass of Context must implement this func SetCommandQueue");
 }
 
+Status Context::RunAsync(std::function<Status(void)> task, Callback call_back) {
+    Status status = task();
+    RETURN_ON_NEQ(status, TNN_OK);
+    if (call_back) {
+        status = Synchronize();
+        RETURN_ON_NEQ(status, TNN_OK);
+        call_back();
+    }
+    return status;
+}
+
 /*
  * Implement by the actual context such as ArmContext etc.
  * Not implemented for this default context.
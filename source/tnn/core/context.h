@@ -15,6 +15,7 @@
 #ifndef TNN_SOURCE_TNN_CORE_CONTEXT_H_
 #define TNN_SOURCE_TNN_CORE_CONTEXT_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -56,6 +57,11 @@ public:
     // @brief wait for jobs in the current context to complete
     virtual Status Synchronize() = 0;
 
+    // @brief run task after the jobs already submitted to the command queue, call_back is called when it is done.
+    // the default runs task in place and waits for the device before call_back,
+    // devices with a host side task queue run it on the queue and return at once.
+    virtual Status RunAsync(std::function<Status(void)> task, Callback call_back);
+
     // @brief set threads run on device
     virtual Status SetNumThreads(int num_threads);
 
@@ -109,24 +109,35 @@ Status DefaultNetwork::Init(NetworkConfig &net_config, ModelConfig &model_config
     if (runtime_model_ == RUNTIME_MODE_NORMAL) {
         // use mutex to protect net_resource and net_structure in multi-thread
         std::unique_lock<std::mutex> lck(optimize_mtx_);
+        InitProfileScope scope("optimize");
         ret = optimizer::NetOptimizerManager::Optimize(net_structure, net_resource, net_config);
         RETURN_ON_NEQ(ret, TNN_OK);
     }
 
     blob_manager_ = new BlobManager(device_);
 
-    ret = blob_manager_->Init(net_config, net_structure, max_inputs_shape, GetNetResourceDataType(net_resource));
-    RETURN_ON_NEQ(ret, TNN_OK);
+    {
+        InitProfileScope scope("init_blobs");
+        ret = blob_manager_->Init(net_config, net_structure, max_inputs_shape, GetNetResourceDataType(net_resource));
+        RETURN_ON_NEQ(ret, TNN_OK);
+    }
 
-    ret = InitLayers(net_structure, net_resource);
-    RETURN_ON_NEQ(ret, TNN_OK);
+    {
+        InitProfileScope scope("init_layers");
+        ret = InitLayers(net_structure, net_resource);
+        RETURN_ON_NEQ(ret, TNN_OK);
+    }
 
-    ret = AllocateBlobMemory();
-    RETURN_ON_NEQ(ret, TNN_OK);
+    {
+        InitProfileScope scope("allocate_blob_memory");
+        ret = AllocateBlobMemory();
+        RETURN_ON_NEQ(ret, TNN_OK);
+    }
 
     net_structure_ = net_structure;
     net_resource_ = net_resource;
     
+    InitProfileScope scope("reshape_layers");
     ret = context_->OnInstanceReshapeBegin();
     RETURN_ON_NEQ(ret, TNN_OK);
 
@@ -228,6 +239,7 @@ Status DefaultNetwork::InitLayers(NetStructure *net_structure, NetResource *net_
             if (net_resource->resource_map.count(layer_name) == 0) {
                 LayerParam *layer_param  = layer_info->param.get();
                 LayerResource *layer_res = nullptr;
+                InitProfileScope scope("generate_resource", layer_name);
                 GenerateRandomResource(type, layer_param, &layer_res, inputs, &net_resource->constant_map);
                 net_resource->resource_map[layer_name] = std::shared_ptr<LayerResource>(layer_res);
             }
@@ -316,7 +328,10 @@ Status DefaultNetwork::InitLayers(NetStructure *net_structure, NetResource *net_
         cur_layer->SetRuntimeMode(runtime_model_);
         cur_layer->SetConstantResource(&net_resource->constant_map);
         cur_layer->SetConstantResourceFlag(&net_resource->constant_blob_flags);
-        ret = cur_layer->Init(context_, layer_info->param.get(), layer_resource, inputs, outputs, device_);
+        {
+            InitProfileScope scope("", layer_name);
+            ret = cur_layer->Init(context_, layer_info->param.get(), layer_resource, inputs, outputs, device_);
+        }
         if (ret != TNN_OK) {
             LOGE("Error Init layer %s (err: %d or 0x%X)\n", cur_layer->GetLayerName().c_str(), (int)ret, (int)ret);
             // release layer if Init failed
@@ -330,8 +345,20 @@ Status DefaultNetwork::InitLayers(NetStructure *net_structure, NetResource *net_
     return ret;
 }
 
+/*
+ * The layer workspaces are planned together with the blobs, so they are part of the forward memory
+ * and shared the same way. View and in-place layers let their output reuse the input memory.
+ */
 Status DefaultNetwork::AllocateBlobMemory() {
-    return blob_manager_->AllocateBlobMemory(DATA_FLAG_CHANGE_ALWAYS);
+    for (auto layer : layers_) {
+        blob_manager_->SetWorkspaceSize(layer->GetLayerName(), layer->GetWorkspaceSize());
+        blob_manager_->SetOutputAlias(layer->GetLayerName(), layer->GetOutputAlias());
+    }
+    RETURN_ON_NEQ(blob_manager_->AllocateBlobMemory(DATA_FLAG_CHANGE_ALWAYS), TNN_OK);
+    for (auto layer : layers_) {
+        layer->SetWorkspace(blob_manager_->GetWorkspaceBlob(layer->GetLayerName()));
+    }
+    return TNN_OK;
 }
 
 Status DefaultNetwork::GenerateInt8Blob(const std::string &name, NetResource *net_resource, Blob **blob) {
@@ -376,6 +403,12 @@ Status DefaultNetwork::UpdateBlobPrecision(std::shared_ptr<LayerInfo> layer_info
             auto int8_blob = dynamic_cast<BlobInt8*>(*blob);
             if (layer_info->param->quantized && int8_blob == nullptr) {
                 RETURN_ON_NEQ(GenerateInt8Blob(name, net_resource, blob), TNN_OK);
+                // the int8 layer quantizes its input or dequantizes its output itself, the scale is kept
+                const auto &extra_config = layer_info->param->extra_config;
+                if ((is_input && name == layer_info->inputs[0] && extra_config.count("x86_int8_float_input")) ||
+                    (!is_input && name == layer_info->outputs[0] && extra_config.count("x86_int8_float_output"))) {
+                    (*blob)->GetBlobDesc().data_type = DATA_TYPE_FLOAT;
+                }
             }
         } else {
             // update blob of non-quantized network by precision
@@ -449,6 +482,36 @@ Status DefaultNetwork::GetAllOutputBlobs(BlobMap &blobs) {
     return TNN_OK;
 }
 
+/*
+ * Bound blobs read and write the caller memory directly. With SHARE_MEMORY_MODE_DEFAULT,
+ * binding or unbinding a blob plans the pool again, bound blobs take no pool memory.
+ */
+Status DefaultNetwork::SetExternalBlobMemory(std::string name, void *memory) {
+    // async jobs of the command queue may still use the blob memory
+    if (context_ != NULL) {
+        RETURN_ON_NEQ(context_->Synchronize(), TNN_OK);
+    }
+
+    bool plan_changed = false;
+    RETURN_ON_NEQ(blob_manager_->SetExternalBlobMemory(name, memory, plan_changed), TNN_OK);
+    if (!plan_changed) {
+        return TNN_OK;
+    }
+    blob_manager_->ReleaseBlobMemory();
+    return AllocateBlobMemory();
+}
+
+Status DefaultNetwork::ResetState() {
+    // async jobs of the command queue may still use the state
+    if (context_ != NULL) {
+        RETURN_ON_NEQ(context_->Synchronize(), TNN_OK);
+    }
+    for (auto layer : layers_) {
+        RETURN_ON_NEQ(layer->ResetState(), TNN_OK);
+    }
+    return TNN_OK;
+}
+
 /*
  * Reshape function is called when the input shape changes.
  * Memory allocation may be involved in Reshape function.
@@ -500,6 +563,11 @@ Status DefaultNetwork::DoReshape() {
 }
 
 Status DefaultNetwork::DeInit() {
+    // async jobs of the command queue may still use the layers and blobs
+    if (context_ != NULL && !layers_.empty()) {
+        context_->Synchronize();
+    }
+
     for (size_t i = 0; i < layers_.size(); i++) {
         if (layers_[i] != NULL) {
             delete layers_[i];
@@ -568,6 +636,7 @@ Status DefaultNetwork::Forward() {
     RETURN_ON_NEQ(status, TNN_OK);
     
     int cnt = 0;
+    std::set<Blob *> runtime_shape_blobs;
     for (auto layer : layers_) {
         std::vector<Blob *> inputs  = layer->GetInputBlobs();
         std::vector<Blob *> outputs = layer->GetOutputBlobs();
@@ -596,7 +665,7 @@ Status DefaultNetwork::Forward() {
             }
 #endif  // DUMP_INPUT_BLOB
             
-            status = layer->Forward();
+            status = ForwardLayer(layer, runtime_shape_blobs);
             LOGD("layer name: %s, forward result: %d \n", layer->GetLayerName().c_str(), (int)status);
             LOGD("Output Shape: [%s]\n", layer->GetOutputBlobs()[0]->GetBlobDesc().description().c_str());
             if (status != TNN_OK) {
@@ -644,6 +713,7 @@ Status DefaultNetwork::ForwardWithCallback(BlobStatisticCallback before, BlobSta
 
     context_->OnInstanceForwardBegin();
     int cnt = 0;
+    std::set<Blob *> runtime_shape_blobs;
     for (auto layer : layers_) {
         std::vector<Blob *> inputs  = layer->GetInputBlobs();
         std::vector<Blob *> outputs = layer->GetOutputBlobs();
@@ -652,7 +722,7 @@ Status DefaultNetwork::ForwardWithCallback(BlobStatisticCallback before, BlobSta
         if (before != nullptr)
             before(inputs, layer_info.get());
 
-        result = layer->Forward();
+        result = ForwardLayer(layer, runtime_shape_blobs);
         if (result != TNN_OK) {
             LOGE("Forward error %s, exit\n", result.description().c_str());
             return result;
@@ -670,6 +740,7 @@ Status DefaultNetwork::ForwardWithCallback(BlobStatisticCallback before, BlobSta
 #endif  // end of FORWARD_CALLBACK_ENABLE
 
 // @brief tnn instance network infer, it will not wait
+// the layers run on the device command queue, call_back is called after all layers finish.
 // blob dump is not implement in this funciton.
 Status DefaultNetwork::ForwardAsync(Callback call_back) {
     Status result = TNN_OK;
@@ -678,13 +749,50 @@ Status DefaultNetwork::ForwardAsync(Callback call_back) {
         return result;
     }
 
-    context_->OnInstanceForwardBegin();
-    for (auto layer : layers_) {
-        result = layer->Forward();
-        RETURN_ON_NEQ(result, TNN_OK);
+    return context_->RunAsync(
+        [this]() -> Status {
+            Status status = context_->OnInstanceForwardBegin();
+            RETURN_ON_NEQ(status, TNN_OK);
+            std::set<Blob *> runtime_shape_blobs;
+            for (auto layer : layers_) {
+                status = ForwardLayer(layer, runtime_shape_blobs);
+                if (status != TNN_OK) {
+                    LOGE("Forward error %s, exit\n", status.description().c_str());
+                    return status;
+                }
+            }
+            return context_->OnInstanceForwardEnd();
+        },
+        call_back);
+}
+
+// Some layers decide the shapes of their outputs in forward, e.g. the tokens of a ragged batch or the boxes kept by
+// nms. Only the layers reading such outputs are reshaped before their forward, the network is not reshaped as a
+// whole. The memory is planned for the shapes of the last reshape, so the runtime shapes must not be larger.
+Status DefaultNetwork::ForwardLayer(BaseLayer *layer, std::set<Blob *> &runtime_shape_blobs) {
+    auto outputs = layer->GetOutputBlobs();
+    std::vector<DimsVector> output_dims;
+    for (auto blob : outputs) {
+        output_dims.push_back(blob->GetBlobDesc().dims);
     }
-    context_->OnInstanceForwardEnd();
-    return result;
+
+    for (auto blob : layer->GetInputBlobs()) {
+        if (runtime_shape_blobs.find(blob) != runtime_shape_blobs.end()) {
+            auto status = layer->Reshape();
+            RETURN_ON_NEQ(status, TNN_OK);
+            break;
+        }
+    }
+
+    auto status = layer->Forward();
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    for (int i = 0; i < outputs.size(); ++i) {
+        if (!DimsVectorUtils::Equal(output_dims[i], outputs[i]->GetBlobDesc().dims)) {
+            runtime_shape_blobs.insert(outputs[i]);
+        }
+    }
+    return TNN_OK;
 }
 
 #if TNN_PROFILE
@@ -15,6 +15,7 @@
 #ifndef TNN_SOURCE_TNN_CORE_DEFAULT_NETWORK_H_
 #define TNN_SOURCE_TNN_CORE_DEFAULT_NETWORK_H_
 
+#include <set>
 #include <vector>
 
 #include "tnn/core/abstract_device.h"
@@ -92,6 +93,12 @@ public:
     // @brief set threads run on device
     virtual Status SetCpuNumThreads(int num_threads);
 
+    // @brief bind caller-owned memory to an input or output blob, nullptr to unbind
+    virtual Status SetExternalBlobMemory(std::string name, void *memory);
+
+    // @brief clear the state kept between forwards by stateful layers
+    virtual Status ResetState();
+
 #if TNN_PROFILE
 public:
     virtual void StartProfile();
@@ -112,6 +119,10 @@ protected:
     Status PrepareDoReshape(const InputShapesMap &inputs, bool& shape_changed);
     Status DoReshape();
 
+    // @brief forward a layer, reshape it first if its inputs are in runtime_shape_blobs. its outputs whose shapes
+    // change in the forward are added to runtime_shape_blobs.
+    Status ForwardLayer(BaseLayer *layer, std::set<Blob *> &runtime_shape_blobs);
+
     AbstractDevice *device_ = nullptr;
     Context *context_       = nullptr;
     Context *GetContext();
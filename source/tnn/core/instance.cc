@@ -46,7 +46,10 @@ Status Instance::Init(std::shared_ptr<AbstractModelInterpreter> interpreter, Inp
 }
 
 Status Instance::Init(std::shared_ptr<AbstractModelInterpreter> interpreter, InputShapesMap min_inputs_shape, InputShapesMap max_inputs_shape) {
-    
+    init_profile_.clear();
+    InitProfileCollector collector(&init_profile_);
+    InitProfileScope scope("create_instance");
+
     auto type = net_config_.device_type;
     if(type == DEVICE_APPLE_NPU) {
         //use DEVICE_ARM OR DEVICE_X86 according to hardware
@@ -62,6 +65,7 @@ Status Instance::Init(std::shared_ptr<AbstractModelInterpreter> interpreter, Inp
     RETURN_VALUE_ON_NEQ(device != NULL, true, TNNERR_DEVICE_NOT_SUPPORT);
     
     if (interpreter) {
+        InitProfileScope copy_scope("copy_interpreter");
         interpreter_ = interpreter->Copy();
         if (nullptr == interpreter_) {
             // The ModelInterpreter not implement Copy API, just use interpreter
@@ -96,6 +100,7 @@ Status Instance::Init(std::shared_ptr<AbstractModelInterpreter> interpreter, Inp
     if (default_interpreter && default_interpreter->GetNetStructure() &&
         (NeedDoConstantFolding(default_interpreter->GetNetStructure()) || net_config_.device_type == DEVICE_CUDA ||
          net_config_.device_type == DEVICE_APPLE_NPU || net_config_.device_type == DEVICE_ARM)) {
+        InitProfileScope const_folder_scope("const_folder");
         auto const_folder = std::make_shared<ConstFolder>();
         auto folder_net_config = net_config_;
         folder_net_config.share_memory_mode = SHARE_MEMORY_MODE_DEFAULT;
@@ -121,6 +126,7 @@ Status Instance::Init(std::shared_ptr<AbstractModelInterpreter> interpreter, Inp
     }
 
     network_ = NetworkImplManager::GetNetworkImpl(network_type);
+    InitProfileScope network_scope("network");
     auto ret = network_->Init(net_config_, model_config_, interpreter_.get(), min_inputs_shape, max_inputs_shape, true);
     RETURN_ON_NEQ(ret, TNN_OK);
 
@@ -129,6 +135,12 @@ Status Instance::Init(std::shared_ptr<AbstractModelInterpreter> interpreter, Inp
 
 Status Instance::DeInit() {
     network_ = nullptr;
+    bound_mats_.clear();
+    return TNN_OK;
+}
+
+Status Instance::GetInitProfile(std::vector<InitProfilingData> &data) {
+    data = init_profile_;
     return TNN_OK;
 }
 
@@ -165,12 +177,14 @@ AbstractNetwork *Instance::GetNetwork() {
 
 Status Instance::Forward() {
     output_mats_convert_status_.clear();
+    RETURN_ON_NEQ(CheckBoundMats(), TNN_OK);
     return network_->Forward();
 }
 
 #ifdef FORWARD_CALLBACK_ENABLE
 Status Instance::ForwardWithCallback(BlobStatisticCallback before, BlobStatisticCallback after) {
     output_mats_convert_status_.clear();
+    RETURN_ON_NEQ(CheckBoundMats(), TNN_OK);
     return network_->ForwardWithCallback(before, after);
 }
 #endif  // end of FORWARD_CALLBACK_ENABLE
@@ -184,6 +198,7 @@ std::shared_ptr<AbstractModelInterpreter> Instance::GetInterpreter() {
 
 Status Instance::ForwardAsync(Callback call_back) {
     output_mats_convert_status_.clear();
+    RETURN_ON_NEQ(CheckBoundMats(), TNN_OK);
     return (Status)network_->ForwardAsync(call_back);
 }
 
@@ -199,6 +214,10 @@ Status Instance::SetCpuNumThreads(int num_threads) {
     return network_->SetCpuNumThreads(num_threads);
 }
 
+Status Instance::ResetState() {
+    return network_->ResetState();
+}
+
 // set input Mat
 Status Instance::SetInputMat(std::shared_ptr<Mat> mat, MatConvertParam param, std::string input_name) {
     if (!mat) {
@@ -318,6 +337,79 @@ Status Instance::GetOutputMat(std::shared_ptr<Mat> &mat, MatConvertParam param,
     return status;
 }
 
+Status Instance::BindInputMat(std::shared_ptr<Mat> mat, std::string input_name) {
+    return BindMat(mat, input_name, true);
+}
+
+Status Instance::BindOutputMat(std::shared_ptr<Mat> mat, std::string output_name) {
+    return BindMat(mat, output_name, false);
+}
+
+static bool IsHostMemoryDevice(DeviceType type) {
+    return type == DEVICE_NAIVE || type == DEVICE_X86 || type == DEVICE_ARM;
+}
+
+Status Instance::BindMat(std::shared_ptr<Mat> mat, std::string name, bool is_input) {
+    BlobMap blobs;
+    auto status = is_input ? network_->GetAllInputBlobs(blobs) : network_->GetAllOutputBlobs(blobs);
+    if (status != TNN_OK || blobs.size() <= 0) {
+        LOGE("instance.GetAllBlobs Error: %s\n", status.description().c_str());
+        return status;
+    }
+
+    // insure name is valid, take the first blob name for default
+    if (name.length() <= 0) {
+        name = blobs.begin()->first;
+    } else if (blobs.find(name) == blobs.end()) {
+        LOGE("instance dont have the blob with name: %s\n", name.c_str());
+        return Status(TNNERR_MODEL_ERR, "instance dont have the blob with name");
+    }
+
+    if (!mat) {
+        status = network_->SetExternalBlobMemory(name, nullptr);
+        RETURN_ON_NEQ(status, TNN_OK);
+        bound_mats_.erase(name);
+        return TNN_OK;
+    }
+
+    auto desc = blobs[name]->GetBlobDesc();
+    if (mat->GetMatType() != NCHW_FLOAT || mat->GetData() == nullptr) {
+        LOGE("bound mat must be NCHW_FLOAT with data, mat type: %d\n", mat->GetMatType());
+        return Status(TNNERR_PARAM_ERR, "bound mat must be NCHW_FLOAT with data");
+    }
+    if (mat->GetDeviceType() != desc.device_type &&
+        !(IsHostMemoryDevice(mat->GetDeviceType()) && IsHostMemoryDevice(desc.device_type))) {
+        LOGE("bound mat device %d can not be used by blob on device %d\n", mat->GetDeviceType(), desc.device_type);
+        return Status(TNNERR_PARAM_ERR, "bound mat device dont match the blob device");
+    }
+    if (!DimsVectorUtils::Equal(mat->GetDims(), desc.dims)) {
+        LOGE("bound mat dims dont match the blob %s\n", name.c_str());
+        return Status(TNNERR_PARAM_ERR, "bound mat dims dont match the blob");
+    }
+
+    status = network_->SetExternalBlobMemory(name, mat->GetData());
+    RETURN_ON_NEQ(status, TNN_OK);
+    bound_mats_[name] = mat;
+    return TNN_OK;
+}
+
+Status Instance::CheckBoundMats() {
+    if (bound_mats_.empty()) {
+        return TNN_OK;
+    }
+    BlobMap input_blobs, output_blobs;
+    network_->GetAllInputBlobs(input_blobs);
+    network_->GetAllOutputBlobs(output_blobs);
+    for (auto iter : bound_mats_) {
+        auto blob = input_blobs.count(iter.first) > 0 ? input_blobs[iter.first] : output_blobs[iter.first];
+        if (!blob || !DimsVectorUtils::Equal(iter.second->GetDims(), blob->GetBlobDesc().dims)) {
+            LOGE("bound mat dims dont match the blob %s, bind it again after Reshape\n", iter.first.c_str());
+            return Status(TNNERR_PARAM_ERR, "bound mat dims dont match the blob, bind it again after Reshape");
+        }
+    }
+    return TNN_OK;
+}
+
 #if TNN_PROFILE
 void Instance::StartProfile() {
     network_->StartProfile();
@@ -238,6 +238,9 @@ static std::map<std::string, LayerType> global_layer_type_map = {
     {"ConstantOfShape", LAYER_CONSTANT_OF_SHAPE},
     {"NonZero", LAYER_NONZERO},
     {"LSTMONNX", LAYER_LSTMONNX},
+    {"GRUONNX", LAYER_GRUONNX},
+    {"EffectiveTransformer", LAYER_EFFECTIVE_TRANSFORMER},
+    {"KVCache", LAYER_KV_CACHE},
     {"QuantizedSigmoid", LAYER_SIGMOID},
     {"StridedSliceV2", LAYER_STRIDED_SLICE_V2},
     {"Erf", LAYER_ERF},
@@ -254,6 +257,7 @@ static std::map<std::string, LayerType> global_layer_type_map = {
     {"LogSoftmax", LAYER_LOGSOFTMAX},
     {"QuantizedReshape", LAYER_RESHAPE},
     {"QuantizedPermute", LAYER_PERMUTE},
+    {"QuantizedMatMul", LAYER_MATMUL},
     {"Swish", LAYER_SWISH},
     {"GLU", LAYER_GLU},
 
@@ -227,6 +227,9 @@ enum LayerType {
     LAYER_LESS                                              = 334,
     LAYER_NON_MAX_SUPPRESSION                               = 335,
     LAYER_SCATTER                                           = 336,
+    LAYER_GRUONNX                                           = 337,
+    LAYER_EFFECTIVE_TRANSFORMER                             = 338,
+    LAYER_KV_CACHE                                          = 339,
     LAYER_SWISH                                             = 401,
     LAYER_GLU                                               = 402,
 
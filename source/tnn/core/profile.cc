@@ -14,6 +14,8 @@
 
 #include "tnn/core/profile.h"
 #include <time.h>
+#include <chrono>
+#include <ctime>
 #include <iomanip>
 #include <sstream>
 
@@ -65,6 +67,66 @@ void ProfilingData::Add(ProfilingData* data) {
     }
 }
 
+static thread_local std::vector<InitProfilingData> *g_init_profile_data = nullptr;
+static thread_local std::vector<std::string> g_init_profile_phases;
+static thread_local long long g_init_profile_bytes = 0;
+
+InitProfileCollector::InitProfileCollector(std::vector<InitProfilingData> *data) {
+    last_data_          = g_init_profile_data;
+    g_init_profile_data = data;
+}
+
+InitProfileCollector::~InitProfileCollector() {
+    g_init_profile_data = last_data_;
+}
+
+void InitProfileCollector::AddAllocatedBytes(size_t bytes) {
+    g_init_profile_bytes += bytes;
+}
+
+static double GetWallTimeMs() {
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count() / 1000.0;
+}
+
+InitProfileScope::InitProfileScope(const std::string &phase, const std::string &name) {
+    enable_ = g_init_profile_data != nullptr;
+    if (!enable_) {
+        return;
+    }
+    std::string parent = g_init_profile_phases.empty() ? "" : g_init_profile_phases.back();
+    data_.phase        = phase.empty() ? parent : (parent.empty() ? phase : parent + "/" + phase);
+    data_.name  = name;
+    is_phase_   = name.empty();
+    if (is_phase_) {
+        g_init_profile_phases.push_back(data_.phase);
+    }
+    // reserve the slot, so a phase is listed before the items inside it
+    index_ = g_init_profile_data->size();
+    g_init_profile_data->push_back(data_);
+    collector_data_ = g_init_profile_data;
+
+    bytes_start_ = g_init_profile_bytes;
+    cpu_start_   = std::clock() * 1000.0 / CLOCKS_PER_SEC;
+    wall_start_  = GetWallTimeMs();
+}
+
+InitProfileScope::~InitProfileScope() {
+    if (!enable_) {
+        return;
+    }
+    data_.wall_time       = GetWallTimeMs() - wall_start_;
+    data_.cpu_time        = std::clock() * 1000.0 / CLOCKS_PER_SEC - cpu_start_;
+    data_.allocated_bytes = g_init_profile_bytes - bytes_start_;
+    if (is_phase_) {
+        g_init_profile_phases.pop_back();
+    }
+    // the collector may be gone if the scope outlives it
+    if (g_init_profile_data == collector_data_ && index_ < collector_data_->size()) {
+        (*collector_data_)[index_] = data_;
+    }
+}
+
 #if TNN_PROFILE
 ProfileResult::~ProfileResult() {}
 
@@ -19,6 +19,7 @@
 #include <string>
 #include <vector>
 
+#include "tnn/core/common.h"
 #include "tnn/core/macro.h"
 
 #pragma warning(push)
@@ -56,6 +57,38 @@ struct ProfilingData {
     bool IsSameID(ProfilingData *data);
 };
 
+// @brief collect the InitProfilingData of the calling thread into data during the lifetime of the collector
+class InitProfileCollector {
+public:
+    explicit InitProfileCollector(std::vector<InitProfilingData> *data);
+    ~InitProfileCollector();
+
+    // @brief count bytes allocated on the calling thread, called by RawBuffer and blob memory allocation
+    static void AddAllocatedBytes(size_t bytes);
+
+private:
+    std::vector<InitProfilingData> *last_data_ = nullptr;
+};
+
+// @brief record the time and memory cost from construction to destruction as one InitProfilingData.
+// a scope without name is a phase, the phases inside it get it as prefix. a scope with name is an item of
+// the current phase if phase is empty, eg. InitProfileScope("", layer_name).
+class InitProfileScope {
+public:
+    InitProfileScope(const std::string &phase, const std::string &name = "");
+    ~InitProfileScope();
+
+private:
+    bool enable_           = false;
+    bool is_phase_         = false;
+    InitProfilingData data_;
+    std::vector<InitProfilingData> *collector_data_ = nullptr;
+    size_t index_          = 0;
+    double wall_start_     = 0;
+    double cpu_start_      = 0;
+    long long bytes_start_ = 0;
+};
+
 #if TNN_PROFILE
 class ProfileResult {
 public:
@@ -14,6 +14,7 @@
 
 #include "tnn/core/tnn.h"
 
+#include "tnn/core/profile.h"
 #include "tnn/core/tnn_impl.h"
 
 namespace TNN_NS {
@@ -24,6 +25,10 @@ TNN::~TNN() {
 }
 
 Status TNN::Init(ModelConfig& config) {
+    init_profile_.clear();
+    InitProfileCollector collector(&init_profile_);
+    InitProfileScope scope("init");
+
     impl_ = TNNImplManager::GetTNNImpl(config.model_type);
     if (!impl_) {
         LOGE("Error: not support mode type: %d. If TNN is a static library, link it with option -Wl,--whole-archive tnn -Wl,--no-whole-archive on android or add -force_load on iOS\n", config.model_type);
@@ -72,4 +77,9 @@ std::shared_ptr<Instance> TNN::CreateInst(NetworkConfig& config, Status& status,
     return impl_->CreateInst(config, status, min_inputs_shape, max_inputs_shape);
 }
 
+Status TNN::GetInitProfile(std::vector<InitProfilingData>& data) {
+    data = init_profile_;
+    return TNN_OK;
+}
+
 }  // namespace TNN_NS
@@ -0,0 +1,114 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <cstring>
+
+#include "cpu_layer_acc.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_CPU_ACC(EffectiveTransformer, LAYER_EFFECTIVE_TRANSFORMER);
+
+Status CpuEffectiveTransformerLayerAcc::Reshape(const std::vector<Blob *> &inputs,
+                                                const std::vector<Blob *> &outputs) {
+    return TNN_OK;
+}
+
+Status CpuEffectiveTransformerLayerAcc::Forward(const std::vector<Blob *> &inputs,
+                                                const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<EffectiveTransformerLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+    if (inputs.size() < 2) {
+        return Status(TNNERR_PARAM_ERR, "EffectiveTransformer has invalid inputs");
+    }
+
+    auto token_dims = inputs[1]->GetBlobDesc().dims;
+    int batch       = token_dims[0];
+    int seq_len     = token_dims[1];
+    int count       = batch * seq_len;
+    auto data_dims  = inputs[0]->GetBlobDesc().dims;
+    int row_bytes   = DimsVectorUtils::Count(data_dims, 2) * DataTypeUtils::GetBytesSize(inputs[0]->GetBlobDesc().data_type);
+
+    if (!param->is_remove_padding) {
+        int *token_index = (int *)((char *)inputs[1]->GetHandle().base + inputs[1]->GetHandle().bytes_offset);
+        char *src        = (char *)inputs[0]->GetHandle().base + inputs[0]->GetHandle().bytes_offset;
+        char *dst        = (char *)outputs[0]->GetHandle().base + outputs[0]->GetHandle().bytes_offset;
+        for (int i = 0; i < count; ++i) {
+            if (token_index[i] >= 0) {
+                memcpy(dst + i * row_bytes, src + token_index[i] * row_bytes, row_bytes);
+            } else {
+                memset(dst + i * row_bytes, 0, row_bytes);
+            }
+        }
+        return TNN_OK;
+    }
+
+    // the packed index of each token, -1 for the padding
+    int *token_index = nullptr;
+    int num_tokens   = 0;
+    if (outputs.size() >= 2) {
+        token_index    = (int *)((char *)outputs[1]->GetHandle().base + outputs[1]->GetHandle().bytes_offset);
+        auto mask_type = inputs[1]->GetBlobDesc().data_type;
+        void *mask     = (char *)inputs[1]->GetHandle().base + inputs[1]->GetHandle().bytes_offset;
+        for (int i = 0; i < count; ++i) {
+            bool valid = false;
+            if (mask_type == DATA_TYPE_INT32) {
+                valid = ((int *)mask)[i] != 0;
+            } else if (mask_type == DATA_TYPE_FLOAT) {
+                valid = ((float *)mask)[i] != 0;
+            } else {
+                return Status(TNNERR_LAYER_ERR, "EffectiveTransformer only supports int32 or float mask");
+            }
+            token_index[i] = valid ? num_tokens++ : -1;
+        }
+        if (num_tokens == 0 && count > 0) {
+            token_index[0] = num_tokens++;
+        }
+    } else {
+        token_index = (int *)((char *)inputs[1]->GetHandle().base + inputs[1]->GetHandle().bytes_offset);
+        for (int i = 0; i < count; ++i) {
+            if (token_index[i] >= 0) {
+                num_tokens++;
+            }
+        }
+    }
+
+    if (data_dims.size() < 2 || (data_dims[0] != batch && data_dims[0] != 1) ||
+        (data_dims[1] != seq_len && data_dims[1] != 1)) {
+        return Status(TNNERR_LAYER_ERR, "EffectiveTransformer remove padding needs data of [batch, seq_len, ...]");
+    }
+    DimsVector output_dims = {1, num_tokens};
+    output_dims.insert(output_dims.end(), data_dims.begin() + 2, data_dims.end());
+    outputs[0]->GetBlobDesc().dims = output_dims;
+
+    char *src = (char *)inputs[0]->GetHandle().base + inputs[0]->GetHandle().bytes_offset;
+    char *dst = (char *)outputs[0]->GetHandle().base + outputs[0]->GetHandle().bytes_offset;
+    for (int b = 0; b < batch; ++b) {
+        for (int s = 0; s < seq_len; ++s) {
+            int index = token_index[b * seq_len + s];
+            if (index >= 0) {
+                int b_src = data_dims[0] == 1 ? 0 : b;
+                int s_src = data_dims[1] == 1 ? 0 : s;
+                memcpy(dst + index * row_bytes, src + (b_src * data_dims[1] + s_src) * row_bytes, row_bytes);
+            }
+        }
+    }
+    return TNN_OK;
+}
+
+REGISTER_CPU_ACC(EffectiveTransformer, LAYER_EFFECTIVE_TRANSFORMER);
+
+}  // namespace TNN_NS
@@ -19,12 +19,18 @@
 
 namespace TNN_NS {
 
-DECLARE_CPU_ACC(Flatten, LAYER_FLATTEN);
+DECLARE_CPU_ACC_WITH_FUNC(Flatten, LAYER_FLATTEN,
+                          virtual BlobAliasType GetOutputAlias(const std::vector<Blob *> &inputs,
+                                                               const std::vector<Blob *> &outputs););
 
 Status CpuFlattenLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     return TNN_OK;
 }
 
+BlobAliasType CpuFlattenLayerAcc::GetOutputAlias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return BLOB_ALIAS_VIEW;
+}
+
 Status CpuFlattenLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto param = dynamic_cast<FlattenLayerParam *>(param_);
     if (!param) {
@@ -34,11 +40,13 @@ Status CpuFlattenLayerAcc::Forward(const std::vector<Blob *> &inputs, const std:
     auto input  = inputs[0];
     auto output = outputs[0];
 
-    if (output->GetHandle().base != input->GetHandle().base) {
+    char *input_data  = static_cast<char *>(input->GetHandle().base) + input->GetHandle().bytes_offset;
+    char *output_data = static_cast<char *>(output->GetHandle().base) + output->GetHandle().bytes_offset;
+    if (output_data != input_data) {
         auto dims_input    = input->GetBlobDesc().dims;
         int data_byte_size = DataTypeUtils::GetBytesSize(output->GetBlobDesc().data_type);
         auto size_in_bytes = DimsVectorUtils::Count(dims_input) * data_byte_size;
-        memcpy(output->GetHandle().base, input->GetHandle().base, size_in_bytes);
+        memcpy(output_data, input_data, size_in_bytes);
     }
 
     return TNN_OK;
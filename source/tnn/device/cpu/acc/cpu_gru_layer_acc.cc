@@ -0,0 +1,257 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <cmath>
+
+#include "cpu_layer_acc.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+class CpuGRUONNXLayerAcc : public CpuLayerAcc {
+public:
+    virtual ~CpuGRUONNXLayerAcc(){};
+    virtual Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                        const std::vector<Blob *> &outputs);
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual Status Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+private:
+    std::shared_ptr<float> w_ = nullptr;
+    std::shared_ptr<float> r_ = nullptr;
+    std::shared_ptr<float> b_ = nullptr;
+};
+
+static Status GRU_Single(const float *x, float *y, const float *w, const float *r, const float *b, float *h_t,
+                         const int T, const int batch_size, const int input_size, const int hidden_size,
+                         int linear_before_reset, int reverse) {
+    //num_directions = 1 for all below
+    //X shape [sequence batch_size input_size]
+    const int x_page_size = batch_size * input_size;
+
+    //Y shape [sequence batch_size num_directions * hidden_size]
+    const int y_page_size = batch_size * hidden_size;
+
+    //W[zrh], weight tensor for the gates, shape [num_directions, 3*hidden_size, input_size]
+    const int w_page_size = hidden_size * input_size;
+    auto w_x_Z = w;
+    auto w_x_R = w_x_Z + w_page_size;
+    auto w_x_H = w_x_R + w_page_size;
+
+    //R[zrh], recurrence weight tensor, shape [num_directions, 3*hidden_size, hidden_size]
+    int r_page_size = hidden_size * hidden_size;
+    auto r_x_Z = r;
+    auto r_x_R = r_x_Z + r_page_size;
+    auto r_x_H = r_x_R + r_page_size;
+
+    //B[zrh] Concatenation of [Wb[zrh], Rb[zrh]], [num_directions, 6*hidden_size]
+    int b_page_size = hidden_size;
+    auto b_w_Z = b;
+    auto b_w_R = b_w_Z + b_page_size;
+    auto b_w_H = b_w_R + b_page_size;
+
+    auto b_r_Z = b_w_H + b_page_size;
+    auto b_r_R = b_r_Z + b_page_size;
+    auto b_r_H = b_r_R + b_page_size;
+
+    //temp gates z and r, and the reset hidden, shape [3, hidden_size]
+    auto gates   = std::shared_ptr<float>(new float[hidden_size * 3], [](float *p) { delete[] p; });
+    auto gate_z  = gates.get();
+    auto gate_r  = gates.get() + hidden_size;
+    auto reset_h = gates.get() + 2 * hidden_size;
+
+    for (int t = 0; t < T; t++) {
+        int ti = reverse ? T - 1 - t : t;
+
+        const float *x_t = x + ti * x_page_size;
+        float *y_t       = y + ti * y_page_size;
+
+        for (int b = 0; b < batch_size; b++) {
+            const float *x_t_b = x_t + b * input_size;
+            float *h_t_b       = h_t + b * hidden_size;
+
+            for (int q = 0; q < hidden_size; q++) {
+                float Z = b_w_Z[q] + b_r_Z[q];
+                float R = b_w_R[q] + b_r_R[q];
+                for (int i = 0; i < input_size; i++) {
+                    Z += w_x_Z[q * input_size + i] * x_t_b[i];
+                    R += w_x_R[q * input_size + i] * x_t_b[i];
+                }
+                for (int i = 0; i < hidden_size; i++) {
+                    Z += r_x_Z[q * hidden_size + i] * h_t_b[i];
+                    R += r_x_R[q * hidden_size + i] * h_t_b[i];
+                }
+                gate_z[q] = 1.f / (1.f + exp(-Z));
+                gate_r[q] = 1.f / (1.f + exp(-R));
+            }
+
+            for (int q = 0; q < hidden_size; q++) {
+                reset_h[q] = gate_r[q] * h_t_b[q];
+            }
+
+            float *output_data = y_t + b * hidden_size;
+            for (int q = 0; q < hidden_size; q++) {
+                float H = b_w_H[q];
+                for (int i = 0; i < input_size; i++) {
+                    H += w_x_H[q * input_size + i] * x_t_b[i];
+                }
+
+                float RH = b_r_H[q];
+                if (linear_before_reset) {
+                    // r * (Rh * h + Rbh)
+                    for (int i = 0; i < hidden_size; i++) {
+                        RH += r_x_H[q * hidden_size + i] * h_t_b[i];
+                    }
+                    H += gate_r[q] * RH;
+                } else {
+                    // Rh * (r * h) + Rbh
+                    for (int i = 0; i < hidden_size; i++) {
+                        RH += r_x_H[q * hidden_size + i] * reset_h[i];
+                    }
+                    H += RH;
+                }
+                output_data[q] = tanh(H);
+            }
+
+            // h_t is read by the gates above, update it after all of them
+            for (int q = 0; q < hidden_size; q++) {
+                float h        = (1.f - gate_z[q]) * output_data[q] + gate_z[q] * h_t_b[q];
+                h_t_b[q]       = h;
+                output_data[q] = h;
+            }
+        }
+    }
+
+    return TNN_OK;
+}
+
+Status CpuGRUONNXLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                                const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto status = CpuLayerAcc::Init(context, param, resource, inputs, outputs);
+
+    if (runtime_model_ == RUNTIME_MODE_CONST_FOLD) {
+        return TNN_OK;
+    }
+
+    auto get_blob_data = [&](Blob *blob, std::shared_ptr<float> &result) -> Status {
+        if (blob->GetBlobDesc().data_type != DATA_TYPE_HALF) {
+            return TNN_OK;
+        }
+        const int data_size = DimsVectorUtils::Count(blob->GetBlobDesc().dims);
+        result = std::shared_ptr<float>(new float[data_size], [](float *p) { delete[] p; });
+        fp16_t *src_ptr = (fp16_t *)((char *)(blob->GetHandle().base) + blob->GetHandle().bytes_offset);
+        ConvertFromHalfToFloat(src_ptr, result.get(), data_size);
+        return TNN_OK;
+    };
+
+    RETURN_ON_NEQ(get_blob_data(inputs[1], w_), TNN_OK);
+    RETURN_ON_NEQ(get_blob_data(inputs[2], r_), TNN_OK);
+    RETURN_ON_NEQ(get_blob_data(inputs[3], b_), TNN_OK);
+
+    return TNN_OK;
+}
+
+Status CpuGRUONNXLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return TNN_OK;
+}
+
+Status CpuGRUONNXLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param = dynamic_cast<GRUONNXLayerParam *>(param_);
+    int num_directions = layer_param->direction >= 2 ? 2 : 1;
+
+    if (inputs.size() < 4) {
+        return Status(TNNERR_LAYER_ERR, "GRU has invalid inputs");
+    }
+    Blob *blob_h0 = inputs.size() >= 5 ? inputs[4] : nullptr;
+
+    const auto input_dims  = inputs[0]->GetBlobDesc().dims;
+    const auto T           = input_dims[0];                        // length of sequence
+    const auto batch       = input_dims[1];                        // batch_size
+    const auto input_size  = DimsVectorUtils::Count(input_dims, 2);  // input dimension
+    const auto hidden_size = layer_param->hidden_size;               // output dimension
+
+    float *h_t = nullptr;
+    std::shared_ptr<float> temp_h_t = nullptr;
+    if (outputs.size() >= 2) {
+        h_t = (float *)((char *)(outputs[1]->GetHandle().base) + outputs[1]->GetHandle().bytes_offset);
+    } else {
+        temp_h_t = std::shared_ptr<float>(new float[num_directions * batch * hidden_size], [](float *p) { delete[] p; });
+        h_t = temp_h_t.get();
+    }
+
+    //X shape [sequence batch_size input_size]
+    float *x = (float *)((char *)(inputs[0]->GetHandle().base) + inputs[0]->GetHandle().bytes_offset);
+
+    //Y shape [sequence batch_size num_directions *hidden_size]
+    float *y = (float *)((char *)(outputs[0]->GetHandle().base) + outputs[0]->GetHandle().bytes_offset);
+
+    //W[zrh], weight tensor for the gates, shape [num_directions, 3*hidden_size, input_size]
+    float *w = inputs[1]->GetBlobDesc().data_type != DATA_TYPE_HALF
+                   ? (float *)((char *)(inputs[1]->GetHandle().base) + inputs[1]->GetHandle().bytes_offset)
+                   : w_.get();
+
+    //R[zrh], recurrence weight tensor, shape [num_directions, 3*hidden_size, hidden_size]
+    float *r = inputs[2]->GetBlobDesc().data_type != DATA_TYPE_HALF
+                   ? (float *)((char *)(inputs[2]->GetHandle().base) + inputs[2]->GetHandle().bytes_offset)
+                   : r_.get();
+
+    //B[zrh] Concatenation of [Wb[zrh], Rb[zrh]], [num_directions, 6*hidden_size]
+    float *b = inputs[3]->GetBlobDesc().data_type != DATA_TYPE_HALF
+                   ? (float *)((char *)(inputs[3]->GetHandle().base) + inputs[3]->GetHandle().bytes_offset)
+                   : b_.get();
+
+    //initial_h, initial value of the hidden, If not specified - assumed to be 0. shape [num_directions, batch_size, hidden_size]
+    if (blob_h0 != nullptr) {
+        auto h_0 = (float *)((char *)(blob_h0->GetHandle().base) + blob_h0->GetHandle().bytes_offset);
+        memcpy((void *)h_t, h_0, num_directions * batch * hidden_size * sizeof(float));
+    } else {
+        memset(h_t, 0, num_directions * batch * hidden_size * sizeof(float));
+    }
+
+    const int lbr = layer_param->linear_before_reset;
+    if (layer_param->direction == 0 || layer_param->direction == 1) {
+        return GRU_Single(x, y, w, r, b, h_t, T, batch, input_size, hidden_size, lbr, layer_param->direction);
+    } else if (layer_param->direction == 2) {
+        //Y shape [num_directions sequence batch_size hidden_size]
+        auto y_temp = std::shared_ptr<float>(new float[num_directions * T * batch * hidden_size],
+                                             [](float *p) { delete[] p; });
+        auto y0 = y_temp.get();
+        auto y1 = y0 + T * batch * hidden_size;
+        GRU_Single(x, y0, w, r, b, h_t, T, batch, input_size, hidden_size, lbr, 0);
+
+        auto w1   = w + 3 * hidden_size * input_size;
+        auto r1   = r + 3 * hidden_size * hidden_size;
+        auto b1   = b + 6 * hidden_size;
+        auto h_t1 = h_t + batch * hidden_size;
+        GRU_Single(x, y1, w1, r1, b1, h_t1, T, batch, input_size, hidden_size, lbr, 1);
+
+        //transpose [num_directions sequence batch_size hidden_size] to [sequence batch_size num_directions*hidden_size]
+        for (int i = 0; i < T * batch; i++) {
+            auto y0_data = y0 + i * hidden_size;
+            auto y1_data = y1 + i * hidden_size;
+            auto y_data  = y + i * num_directions * hidden_size;
+
+            memcpy(y_data, y0_data, hidden_size * sizeof(float));
+            memcpy(y_data + hidden_size, y1_data, hidden_size * sizeof(float));
+        }
+    } else {
+        return Status(TNNERR_PARAM_ERR, "GRUONNX has invalid direction param");
+    }
+
+    return TNN_OK;
+}
+
+REGISTER_CPU_ACC(GRUONNX, LAYER_GRUONNX);
+}  // namespace TNN_NS
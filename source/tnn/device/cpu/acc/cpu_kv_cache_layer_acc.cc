@@ -0,0 +1,89 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <cstring>
+
+#include "cpu_layer_acc.h"
+#include "tnn/interpreter/raw_buffer.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+class CpuKVCacheLayerAcc : public CpuLayerAcc {
+public:
+    virtual ~CpuKVCacheLayerAcc(){};
+    virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual Status Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual Status ResetState();
+
+private:
+    // [outer, max_length, inner], the first length_ positions are cached
+    RawBuffer cache_;
+    int length_         = 0;
+    int outer_          = 0;
+    size_t inner_bytes_ = 0;
+};
+
+Status CpuKVCacheLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return TNN_OK;
+}
+
+Status CpuKVCacheLayerAcc::ResetState() {
+    length_ = 0;
+    return TNN_OK;
+}
+
+Status CpuKVCacheLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<KVCacheLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+
+    auto input_dims    = inputs[0]->GetBlobDesc().dims;
+    int axis           = param->axis < 0 ? param->axis + (int)input_dims.size() : param->axis;
+    int max_length     = param->max_length;
+    int outer          = DimsVectorUtils::Count(input_dims, 0, axis);
+    int step           = input_dims[axis];
+    size_t inner_bytes = DimsVectorUtils::Count(input_dims, axis + 1) *
+                         DataTypeUtils::GetBytesSize(inputs[0]->GetBlobDesc().data_type);
+
+    if (outer != outer_ || inner_bytes != inner_bytes_) {
+        cache_       = RawBuffer(outer * max_length * inner_bytes);
+        outer_       = outer;
+        inner_bytes_ = inner_bytes;
+        length_      = 0;
+    }
+    if (length_ + step > max_length) {
+        LOGE("KVCache is full: %d positions cached, %d new, max_length %d\n", length_, step, max_length);
+        return Status(TNNERR_LAYER_ERR, "KVCache is full, Instance::ResetState is needed for a new sequence");
+    }
+
+    char *src   = (char *)inputs[0]->GetHandle().base + inputs[0]->GetHandle().bytes_offset;
+    char *dst   = (char *)outputs[0]->GetHandle().base + outputs[0]->GetHandle().bytes_offset;
+    char *cache = cache_.force_to<char *>();
+    for (int o = 0; o < outer; ++o) {
+        memcpy(cache + (o * max_length + length_) * inner_bytes, src + o * step * inner_bytes, step * inner_bytes);
+    }
+    length_ += step;
+
+    input_dims[axis]               = length_;
+    outputs[0]->GetBlobDesc().dims = input_dims;
+    for (int o = 0; o < outer; ++o) {
+        memcpy(dst + o * length_ * inner_bytes, cache + o * max_length * inner_bytes, length_ * inner_bytes);
+    }
+    return TNN_OK;
+}
+
+REGISTER_CPU_ACC(KVCache, LAYER_KV_CACHE);
+
+}  // namespace TNN_NS
@@ -25,11 +25,18 @@ public:
                         const std::vector<Blob *> &outputs);
     virtual Status Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
     virtual Status Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual Status ResetState();
 
 private:
     std::shared_ptr<float> w_ = nullptr;
     std::shared_ptr<float> r_ = nullptr;
     std::shared_ptr<float> b_ = nullptr;
+
+    // with the extra config lstm_stateful, the final h_t and c_t are the initial state of the next forward
+    bool stateful_    = false;
+    bool state_valid_ = false;
+    RawBuffer state_h_;
+    RawBuffer state_c_;
 };
 
 static Status LSTM_Single(const float *x, float *y, const float *w, const float *r, const float *b,
@@ -157,6 +164,8 @@ Status CpuLSTMONNXLayerAcc::Init(Context *context, LayerParam *param, LayerResou
         return TNN_OK;
     }
 
+    stateful_ = param->extra_config.count("lstm_stateful") > 0;
+
     auto get_blob_data = [&](Blob *blob, float *result) -> Status {
         const int data_size = DimsVectorUtils::Count(blob->GetBlobDesc().dims);
         if (blob->GetBlobDesc().data_type == DATA_TYPE_FLOAT) {
@@ -203,6 +212,11 @@ Status CpuLSTMONNXLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std
     return TNN_OK;
 }
 
+Status CpuLSTMONNXLayerAcc::ResetState() {
+    state_valid_ = false;
+    return TNN_OK;
+}
+
 Status CpuLSTMONNXLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto layer_param = dynamic_cast<LSTMONNXLayerParam *>(param_);
     int num_directions = layer_param->direction >=2 ? 2 : 1;
@@ -278,9 +292,17 @@ Status CpuLSTMONNXLayerAcc::Forward(const std::vector<Blob *> &inputs, const std
     } else {
         memset(c_t, 0, num_directions * batch * hidden_size * sizeof(float));
     }
-    
+
+    const int state_bytes = num_directions * batch * hidden_size * sizeof(float);
+    // a stateful lstm continues from the state of the last forward, a different batch size starts over
+    if (stateful_ && state_valid_ && state_h_.GetBytesSize() == state_bytes) {
+        memcpy((void *)h_t, state_h_.force_to<float *>(), state_bytes);
+        memcpy((void *)c_t, state_c_.force_to<float *>(), state_bytes);
+    }
+
     if (layer_param->direction == 0 || layer_param->direction == 1) {
-        return LSTM_Single(x, y, w, r, b, h_t, c_t, T, batch, input_size, hidden_size, layer_param->direction);
+        RETURN_ON_NEQ(LSTM_Single(x, y, w, r, b, h_t, c_t, T, batch, input_size, hidden_size, layer_param->direction),
+                      TNN_OK);
     } else if (layer_param->direction == 2) {
         //Y shape [num_directions sequence batch_size hidden_size]
         auto y_temp = std::shared_ptr<float>(new float[num_directions*T*batch*hidden_size], [](float* p) { delete[] p; });
@@ -308,7 +330,15 @@ Status CpuLSTMONNXLayerAcc::Forward(const std::vector<Blob *> &inputs, const std
         return Status(TNNERR_PARAM_ERR, "LSTMONNX has invalid direction param");
     }
 
-  
+    if (stateful_) {
+        if (state_h_.GetBytesSize() != state_bytes) {
+            state_h_ = RawBuffer(state_bytes);
+            state_c_ = RawBuffer(state_bytes);
+        }
+        memcpy(state_h_.force_to<float *>(), h_t, state_bytes);
+        memcpy(state_c_.force_to<float *>(), c_t, state_bytes);
+        state_valid_ = true;
+    }
     return TNN_OK;
 }
 
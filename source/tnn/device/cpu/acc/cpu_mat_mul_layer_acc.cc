@@ -13,8 +13,10 @@
 // specific language governing permissions and limitations under the License.
 
 #include "cpu_layer_acc.h"
+#include "tnn/core/blob_int8.h"
 #include "tnn/device/cpu/acc/cpu_unary_layer_acc.h"
 #include "tnn/utils/dims_utils.h"
+#include "tnn/utils/naive_compute.h"
 
 namespace TNN_NS {
 //DECLARE_CPU_ACC(MatMul, LAYER_MATMUL);
@@ -48,6 +50,14 @@ Status CpuMatMulLayerAcc::Init(Context *context, LayerParam *param, LayerResourc
     } else if (layer_res->weight.GetDataType() == DATA_TYPE_HALF) {
         auto src_ptr = layer_res->weight.force_to<fp16_t *>();
         ConvertFromHalfToFloat(src_ptr, weight.get(), data_size);
+    } else if (layer_res->weight.GetDataType() == DATA_TYPE_INT8 && layer_res->scale_handle.GetDataCount() > 0) {
+        // int8 quantized weight with per tensor scale
+        auto src_ptr = layer_res->weight.force_to<int8_t *>();
+        auto scale   = layer_res->scale_handle;
+        if (scale.GetDataType() == DATA_TYPE_HALF) {
+            scale = ConvertHalfHandle(scale);
+        }
+        NaiveDequant(src_ptr, scale.force_to<float *>(), 1, weight.get(), {data_size});
     } else {
         return Status(TNNERR_PARAM_ERR, "MatMul has invalid direction param");
     }
@@ -74,18 +84,41 @@ Status CpuMatMulLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::
     }
     DataType data_type       = inputs[0]->GetBlobDesc().data_type;
     auto matrix_c_dims       = outputs[0]->GetBlobDesc().dims;
-    if (data_type == DATA_TYPE_FLOAT) {
+    if (data_type == DATA_TYPE_FLOAT || data_type == DATA_TYPE_INT8) {
+        // int8 blobs are dequantized to float, the result is quantized back to the output blob
+        std::vector<std::vector<float>> dequant_inputs(inputs.size());
+        std::vector<float *> input_ptrs;
+        for (int i = 0; i < inputs.size(); ++i) {
+            if (data_type == DATA_TYPE_INT8) {
+                auto dims     = inputs[i]->GetBlobDesc().dims;
+                auto int8_res = reinterpret_cast<BlobInt8 *>(inputs[i])->GetIntResource();
+                dequant_inputs[i].resize(DimsVectorUtils::Count(dims));
+                NaiveDequantBias(static_cast<int8_t *>(inputs[i]->GetHandle().base),
+                                 int8_res->scale_handle.force_to<float *>(),
+                                 int8_res->zero_point_handle.force_to<int8_t *>(),
+                                 int8_res->scale_handle.GetDataCount(), dequant_inputs[i].data(), dims);
+                input_ptrs.push_back(dequant_inputs[i].data());
+            } else {
+                input_ptrs.push_back(static_cast<float *>(inputs[i]->GetHandle().base));
+            }
+        }
+        std::vector<float> dequant_output;
+        if (data_type == DATA_TYPE_INT8) {
+            dequant_output.resize(DimsVectorUtils::Count(matrix_c_dims));
+        }
+
         float *matrix_a;
         float *matrix_b;
 
         if (inputs.size() == 2) {
-            matrix_a = static_cast<float *>(inputs[0]->GetHandle().base);
-            matrix_b = static_cast<float *>(inputs[1]->GetHandle().base);
+            matrix_a = input_ptrs[0];
+            matrix_b = input_ptrs[1];
         } else {
-            matrix_a    = param->weight_position == 0 ? weight_.get() : static_cast<float *>(inputs[0]->GetHandle().base);
-            matrix_b    = param->weight_position == 1 ? weight_.get() : static_cast<float *>(inputs[0]->GetHandle().base);
+            matrix_a    = param->weight_position == 0 ? weight_.get() : input_ptrs[0];
+            matrix_b    = param->weight_position == 1 ? weight_.get() : input_ptrs[0];
         }
-        auto matrix_c = static_cast<float *>(outputs[0]->GetHandle().base);
+        auto matrix_c = data_type == DATA_TYPE_INT8 ? dequant_output.data()
+                                                    : static_cast<float *>(outputs[0]->GetHandle().base);
         int M         = matrix_a_dims[matrix_a_dims.size() - 2];
         int N         = matrix_a_dims[matrix_a_dims.size() - 1];
         int K         = matrix_b_dims[matrix_b_dims.size() - 1];
@@ -111,6 +144,13 @@ Status CpuMatMulLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::
                 }
             }
         }
+
+        if (data_type == DATA_TYPE_INT8) {
+            auto int8_res = reinterpret_cast<BlobInt8 *>(outputs[0])->GetIntResource();
+            NaiveQuantBias(matrix_c, int8_res->scale_handle.force_to<float *>(),
+                           int8_res->zero_point_handle.force_to<int8_t *>(), int8_res->scale_handle.GetDataCount(),
+                           static_cast<int8_t *>(outputs[0]->GetHandle().base), matrix_c_dims);
+        }
     }
 
     return TNN_OK;
@@ -21,7 +21,9 @@ namespace TNN_NS {
 
 DECLARE_CPU_ACC_WITH_FUNC(Reshape, LAYER_RESHAPE,
                           virtual Status InferRuntimeOutputShape(const std::vector<Blob *> &inputs,
-                                                                 const std::vector<Blob *> &outputs););
+                                                                 const std::vector<Blob *> &outputs);
+                          virtual BlobAliasType GetOutputAlias(const std::vector<Blob *> &inputs,
+                                                               const std::vector<Blob *> &outputs););
 
 Status CpuReshapeLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     return TNN_OK;
@@ -92,6 +94,11 @@ Status CpuReshapeLayerAcc::InferRuntimeOutputShape(const std::vector<Blob *> &in
     return TNN_OK;
 }
 
+BlobAliasType CpuReshapeLayerAcc::GetOutputAlias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<ReshapeLayerParam *>(param_);
+    return (param && param->reshape_type == 0) ? BLOB_ALIAS_VIEW : BLOB_ALIAS_NONE;
+}
+
 Status CpuReshapeLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto &input  = inputs[0];
     auto &output = outputs[0];
@@ -99,11 +106,13 @@ Status CpuReshapeLayerAcc::Forward(const std::vector<Blob *> &inputs, const std:
     ASSERT(param != nullptr);
     if (param->reshape_type == 0) {
         // handle float and int8
-        if (output->GetHandle().base != input->GetHandle().base) {
+        char *input_data  = static_cast<char *>(input->GetHandle().base) + input->GetHandle().bytes_offset;
+        char *output_data = static_cast<char *>(output->GetHandle().base) + output->GetHandle().bytes_offset;
+        if (output_data != input_data) {
             auto dims_input    = input->GetBlobDesc().dims;
             int data_byte_size = DataTypeUtils::GetBytesSize(output->GetBlobDesc().data_type);
             auto size_in_bytes = DimsVectorUtils::Count(dims_input) * data_byte_size;
-            memcpy(output->GetHandle().base, input->GetHandle().base, size_in_bytes);
+            memcpy(output_data, input_data, size_in_bytes);
         }
     } else if (param->reshape_type == 1) {
         const auto dims_output = output->GetBlobDesc().dims;
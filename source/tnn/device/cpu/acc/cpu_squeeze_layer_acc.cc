@@ -18,15 +18,21 @@
 
 namespace TNN_NS {
 
-DECLARE_CPU_ACC(Squeeze, LAYER_SQUEEZE);
+DECLARE_CPU_ACC_WITH_FUNC(Squeeze, LAYER_SQUEEZE,
+                          virtual BlobAliasType GetOutputAlias(const std::vector<Blob *> &inputs,
+                                                               const std::vector<Blob *> &outputs););
 
 Status CpuSqueezeLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     return TNN_OK;
 }
 
+BlobAliasType CpuSqueezeLayerAcc::GetOutputAlias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return BLOB_ALIAS_VIEW;
+}
+
 Status CpuSqueezeLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    void *input_data  = inputs[0]->GetHandle().base;
-    void *output_data = outputs[0]->GetHandle().base;
+    char *input_data  = static_cast<char *>(inputs[0]->GetHandle().base) + inputs[0]->GetHandle().bytes_offset;
+    char *output_data = static_cast<char *>(outputs[0]->GetHandle().base) + outputs[0]->GetHandle().bytes_offset;
     auto input_dims   = outputs[0]->GetBlobDesc().dims;
     auto count        = DimsVectorUtils::Count(input_dims);
     auto ele_size     = DataTypeUtils::GetBytesSize(outputs[0]->GetBlobDesc().data_type);
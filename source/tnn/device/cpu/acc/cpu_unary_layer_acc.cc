@@ -39,6 +39,10 @@ Status CpuUnaryLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::v
     return TNN_OK;
 }
 
+BlobAliasType CpuUnaryLayerAcc::GetOutputAlias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return BLOB_ALIAS_INPLACE;
+}
+
 Status CpuUnaryLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     if (inputs.size() < 1) {
         LOGE("Error: invalid inputs count\n");
@@ -67,6 +67,8 @@ public:
 
     virtual Status Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    virtual BlobAliasType GetOutputAlias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
 protected:
     std::shared_ptr<UNARY_OP> op_;
 };
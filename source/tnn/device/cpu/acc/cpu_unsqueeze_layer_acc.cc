@@ -18,15 +18,21 @@
 
 namespace TNN_NS {
 
-DECLARE_CPU_ACC(Unsqueeze, LAYER_UNSQUEEZE);
+DECLARE_CPU_ACC_WITH_FUNC(Unsqueeze, LAYER_UNSQUEEZE,
+                          virtual BlobAliasType GetOutputAlias(const std::vector<Blob *> &inputs,
+                                                               const std::vector<Blob *> &outputs););
 
 Status CpuUnsqueezeLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     return TNN_OK;
 }
 
+BlobAliasType CpuUnsqueezeLayerAcc::GetOutputAlias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return BLOB_ALIAS_VIEW;
+}
+
 Status CpuUnsqueezeLayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
-    void *input_data  = inputs[0]->GetHandle().base;
-    void *output_data = outputs[0]->GetHandle().base;
+    char *input_data  = static_cast<char *>(inputs[0]->GetHandle().base) + inputs[0]->GetHandle().bytes_offset;
+    char *output_data = static_cast<char *>(outputs[0]->GetHandle().base) + outputs[0]->GetHandle().bytes_offset;
     auto dims         = outputs[0]->GetBlobDesc().dims;
     auto count        = DimsVectorUtils::Count(dims);
     auto ele_size     = DataTypeUtils::GetBytesSize(outputs[0]->GetBlobDesc().data_type);
@@ -22,6 +22,35 @@ class CpuBlobConverterAcc : public DefaultBlobConverterAcc {
 public:
     CpuBlobConverterAcc(Blob *blob) : DefaultBlobConverterAcc(blob) {}
     ~CpuBlobConverterAcc() {}
+
+    virtual Status ConvertToMat(Mat& image, MatConvertParam param, void* command_queue = NULL) override {
+        return RunOnHostTaskQueue([&]() { return DefaultBlobConverterAcc::ConvertToMatAsync(image, param, NULL); },
+                                  false, command_queue);
+    }
+
+    virtual Status ConvertToMatAsync(Mat& image, MatConvertParam param, void* command_queue = NULL) override {
+        if (image.GetData() == nullptr) {
+            return ConvertToMat(image, param, command_queue);
+        }
+        auto self = std::static_pointer_cast<CpuBlobConverterAcc>(shared_from_this());
+        Mat mat   = image;
+        return RunOnHostTaskQueue(
+            [self, mat, param]() mutable { return self->DefaultBlobConverterAcc::ConvertToMatAsync(mat, param, NULL); },
+            true, command_queue);
+    }
+
+    virtual Status ConvertFromMat(Mat& image, MatConvertParam param, void* command_queue = NULL) override {
+        return RunOnHostTaskQueue([&]() { return DefaultBlobConverterAcc::ConvertFromMatAsync(image, param, NULL); },
+                                  false, command_queue);
+    }
+
+    virtual Status ConvertFromMatAsync(Mat& image, MatConvertParam param, void* command_queue = NULL) override {
+        auto self = std::static_pointer_cast<CpuBlobConverterAcc>(shared_from_this());
+        Mat mat   = image;
+        return RunOnHostTaskQueue(
+            [self, mat, param]() mutable { return self->DefaultBlobConverterAcc::ConvertFromMatAsync(mat, param, NULL); },
+            true, command_queue);
+    }
 };
 
 DECLARE_BLOB_CONVERTER_CREATER(Cpu);
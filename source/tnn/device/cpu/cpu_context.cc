@@ -22,15 +22,24 @@ Status CpuContext::LoadLibrary(std::vector<std::string> path) {
 }
 
 Status CpuContext::GetCommandQueue(void** command_queue) {
+    *command_queue = task_queue_.get();
     return TNN_OK;
 }
 
 Status CpuContext::ShareCommandQueue(Context* context) {
+    auto context_target = dynamic_cast<CpuContext *>(context);
+    if (!context_target) {
+        return Status(TNNERR_DEVICE_CONTEXT_CREATE, "inpute context is not CpuContext");
+    }
+
+    task_queue_ = context_target->task_queue_;
     return TNN_OK;
 }
 
 Status CpuContext::OnInstanceForwardBegin() {
     Context::OnInstanceForwardBegin();
+    // jobs enqueued before, e.g. async input conversion, must finish first
+    RETURN_ON_NEQ(task_queue_->Wait(), TNN_OK);
     OMP_SET_THREADS_(GetNumThreads());
     return TNN_OK;
 }
@@ -48,7 +57,22 @@ Status CpuContext::OnInstanceForwardEnd() {
     return TNN_OK;
 }
 
+Status CpuContext::OnInstanceReshapeBegin() {
+    return task_queue_->Wait();
+}
+
 Status CpuContext::Synchronize() {
+    return task_queue_->Wait();
+}
+
+Status CpuContext::RunAsync(std::function<Status(void)> task, Callback call_back) {
+    task_queue_->Enqueue([task, call_back]() -> Status {
+        Status status = task();
+        if (call_back) {
+            call_back();
+        }
+        return status;
+    });
     return TNN_OK;
 }
 
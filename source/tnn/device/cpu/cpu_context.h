@@ -15,10 +15,12 @@
 #ifndef TNN_SOURCE_TNN_DEVICE_CPU_CPU_CONTEXT_H_
 #define TNN_SOURCE_TNN_DEVICE_CPU_CPU_CONTEXT_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "tnn/core/context.h"
+#include "tnn/utils/async_task_queue.h"
 
 namespace TNN_NS {
 
@@ -40,9 +42,15 @@ public:
     // @brief after instance forward
     virtual Status OnInstanceForwardEnd() override;
 
+    // @brief before instance Reshape
+    virtual Status OnInstanceReshapeBegin() override;
+
     // @brief wait for jobs in the current context to complete
     virtual Status Synchronize() override;
 
+    // @brief run task on the task queue and return at once
+    virtual Status RunAsync(std::function<Status(void)> task, Callback call_back) override;
+
     // @brief set threads run on device
     virtual Status SetNumThreads(int num_threads) override;
     
@@ -51,6 +59,7 @@ public:
 
 private:
     int num_threads_ = 1;
+    std::shared_ptr<AsyncTaskQueue> task_queue_ = std::make_shared<AsyncTaskQueue>();
 };
 
 }  // namespace TNN_NS
@@ -259,6 +259,107 @@ Status CpuMatConverterAcc::CopyMakeBorder(Mat& src, Mat& dst, CopyMakeBorderPara
     return ret;
 }
 
+Status CpuMatConverterAcc::Preprocess(Mat& src, Mat& dst, PreprocessParam param, void* command_queue) {
+    Status ret = TNN_OK;
+
+    ret = CheckMatConverterParams(src, dst, true);
+    if (ret != TNN_OK)
+        return ret;
+
+    // naive implementation, run crop, cvtcolor and resize one by one
+    Mat image = src;
+    if (param.crop.width != src.GetWidth() || param.crop.height != src.GetHeight()) {
+        Mat cropped(DEVICE_NAIVE, src.GetMatType(), {src.GetBatch(), src.GetChannel(), param.crop.height, param.crop.width});
+        ret = Crop(image, cropped, param.crop, command_queue);
+        if (ret != TNN_OK)
+            return ret;
+        image = cropped;
+    }
+
+    if (image.GetMatType() == NNV12 || image.GetMatType() == NNV21) {
+        Mat bgr(DEVICE_NAIVE, N8UC3, {image.GetBatch(), 3, image.GetHeight(), image.GetWidth()});
+        auto type = image.GetMatType() == NNV12 ? COLOR_CONVERT_NV12TOBGR : COLOR_CONVERT_NV21TOBGR;
+        for (int b = 0; b < image.GetBatch(); ++b) {
+            Mat yuv_b(DEVICE_NAIVE, image.GetMatType(), {1, 3, image.GetHeight(), image.GetWidth()},
+                      GET_OFFSET_PTR(image.GetData(), b * image.GetHeight() * image.GetWidth() * 3 / 2));
+            Mat bgr_b(DEVICE_NAIVE, N8UC3, {1, 3, image.GetHeight(), image.GetWidth()},
+                      GET_OFFSET_PTR(bgr.GetData(), b * image.GetHeight() * image.GetWidth() * 3));
+            ret = CvtColor(yuv_b, bgr_b, type, command_queue);
+            if (ret != TNN_OK)
+                return ret;
+        }
+        image = bgr;
+    }
+
+    if (image.GetWidth() != dst.GetWidth() || image.GetHeight() != dst.GetHeight()) {
+        Mat resized(DEVICE_NAIVE, image.GetMatType(), {image.GetBatch(), image.GetChannel(), dst.GetHeight(), dst.GetWidth()});
+        ResizeParam resize_param;
+        resize_param.scale_w = dst.GetWidth() * 1.0 / image.GetWidth();
+        resize_param.scale_h = dst.GetHeight() * 1.0 / image.GetHeight();
+        resize_param.type    = param.interp_type;
+        ret = Resize(image, resized, resize_param, command_queue);
+        if (ret != TNN_OK)
+            return ret;
+        image = resized;
+    }
+
+    int src_channel = image.GetMatType() == NGRAY ? 1 : (image.GetMatType() == N8UC3 ? 3 : 4);
+    int dst_channel = dst.GetChannel();
+    int hw          = dst.GetHeight() * dst.GetWidth();
+    for (int b = 0; b < dst.GetBatch(); ++b) {
+        auto src_ptr = (uint8_t*)image.GetData() + b * hw * src_channel;
+        auto dst_ptr = (float*)dst.GetData() + b * hw * dst_channel;
+        for (int c = 0; c < dst_channel; ++c) {
+            int sc = (param.reverse_channel && c < 3 && src_channel >= 3) ? 2 - c : c;
+            for (int i = 0; i < hw; ++i) {
+                dst_ptr[c * hw + i] = param.scale[c] * src_ptr[i * src_channel + sc] + param.bias[c];
+            }
+        }
+    }
+
+    return ret;
+}
+
+// naive implementation, run Preprocess on every roi one by one
+Status CpuMatConverterAcc::PreprocessBatch(Mat& src, Mat& dst, std::vector<PreprocessParam>& params,
+                                           void* command_queue) {
+    Status ret = TNN_OK;
+
+    ret = CheckMatConverterParams(src, dst, true);
+    if (ret != TNN_OK)
+        return ret;
+
+    DimsVector dst_dims = {1, dst.GetChannel(), dst.GetHeight(), dst.GetWidth()};
+    for (int n = 0; n < params.size(); ++n) {
+        Mat dst_n(DEVICE_NAIVE, dst.GetMatType(), dst_dims, GET_OFFSET_PTR(dst.GetData(), n * GetMatBatchBytes(&dst)));
+        ret = Preprocess(src, dst_n, params[n], command_queue);
+        if (ret != TNN_OK)
+            return ret;
+    }
+
+    return ret;
+}
+
+// naive implementation, run WarpAffine on every roi one by one
+Status CpuMatConverterAcc::WarpAffineBatch(Mat& src, Mat& dst, std::vector<WarpAffineParam>& params,
+                                           void* command_queue) {
+    Status ret = TNN_OK;
+
+    ret = CheckMatConverterParams(src, dst, true);
+    if (ret != TNN_OK)
+        return ret;
+
+    DimsVector dst_dims = {1, dst.GetChannel(), dst.GetHeight(), dst.GetWidth()};
+    for (int n = 0; n < params.size(); ++n) {
+        Mat dst_n(DEVICE_NAIVE, dst.GetMatType(), dst_dims, GET_OFFSET_PTR(dst.GetData(), n * GetMatBatchBytes(&dst)));
+        ret = WarpAffine(src, dst_n, params[n], command_queue);
+        if (ret != TNN_OK)
+            return ret;
+    }
+
+    return ret;
+}
+
 void CpuMatConverterAcc::MatMemcpy2D(void* src, void* dst, int width, int height, int src_stride, int dst_stride) {
     auto src_ptr = reinterpret_cast<uint8_t*>(src);
     auto dst_ptr = reinterpret_cast<uint8_t*>(dst);
@@ -149,9 +149,10 @@ struct Float8 {
         Float8 tmp;
         tmp.value = _mm256_hadd_ps(v.value, v.value);
         tmp.value = _mm256_hadd_ps(tmp.value, tmp.value);
+        // hadd works in each 128-bit lane
         float rst[8];
-        _mm256_store_ps(rst, tmp.value);
-        return rst[0];
+        _mm256_storeu_ps(rst, tmp.value);
+        return rst[0] + rst[4];
     }
     static Float8 neg(const Float8 &v) {
         Float8 dst;
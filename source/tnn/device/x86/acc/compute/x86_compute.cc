@@ -900,6 +900,153 @@ void X86Sgemv(float* dst, const float* src, const float* weight, float *bias, Di
 template void X86Sgemv<Float4, 4>(float* dst, const float* src, const float* weight, float *bias, DimsVector dims_input, DimsVector dims_output);
 template void X86Sgemv<Float8, 8>(float* dst, const float* src, const float* weight, float *bias, DimsVector dims_input, DimsVector dims_output);
 
+// dequantize one row of int8 weight to fp32, the scale is folded into the result
+static inline void X86DequantInt8WeightRow(float *dst, const int8_t *src, float scale, long len) {
+    __m128 scale_v = _mm_set1_ps(scale);
+    long i = 0;
+    for (; i + 3 < len; i += 4) {
+        int32_t v;
+        memcpy(&v, src + i, sizeof(int32_t));
+        __m128 dst_v = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(v)));
+        _mm_storeu_ps(dst + i, _mm_mul_ps(dst_v, scale_v));
+    }
+    for (; i < len; i++) {
+        dst[i] = scale * src[i];
+    }
+}
+
+// weight tile of int8 weight gemm, dequantized weights of one tile stay in L1
+#define INT8_WEIGHT_TILE_K 256
+
+template <typename VEC, int pack, int tile_m>
+static void X86GemmInt8WeightNTTile(float *dst, const float *src, const float *w_tile, long len) {
+    VEC acc[tile_m];
+    for (int i = 0; i < tile_m; i++) {
+        acc[i] = VEC(0.f);
+    }
+    long k = 0;
+    for (; k + pack - 1 < len; k += pack) {
+        VEC src_v = VEC::loadu(src + k);
+        for (int i = 0; i < tile_m; i++) {
+            VEC::mla(acc[i], VEC::loadu(w_tile + i * INT8_WEIGHT_TILE_K + k), src_v);
+        }
+    }
+    for (int i = 0; i < tile_m; i++) {
+        float sum = VEC::reduce_add(acc[i]);
+        for (long kk = k; kk < len; kk++) {
+            sum += w_tile[i * INT8_WEIGHT_TILE_K + kk] * src[kk];
+        }
+        dst[i] += sum;
+    }
+}
+
+template <typename VEC, int pack>
+void X86GemmInt8WeightNT(float *dst, long ldd, const float *src, long lds, const int8_t *weight, const float *scale,
+                         const float *bias, long M, long N, long K, bool accumulate) {
+    const int tile_m = 4;
+    long m_tiles     = UP_DIV(M, tile_m);
+
+    OMP_PARALLEL_FOR_GUIDED_
+    for (long mt = 0; mt < m_tiles; mt++) {
+        float w_tile[tile_m * INT8_WEIGHT_TILE_K];
+        long m  = mt * tile_m;
+        long mr = MIN(tile_m, M - m);
+
+        for (long n = 0; n < N; n++) {
+            auto dst_n = dst + n * ldd + m;
+            for (long i = 0; i < mr; i++) {
+                dst_n[i] = (accumulate ? dst_n[i] : 0.f) + (bias ? bias[m + i] : 0.f);
+            }
+        }
+
+        for (long k = 0; k < K; k += INT8_WEIGHT_TILE_K) {
+            long kr = MIN(INT8_WEIGHT_TILE_K, K - k);
+            for (long i = 0; i < mr; i++) {
+                X86DequantInt8WeightRow(w_tile + i * INT8_WEIGHT_TILE_K, weight + (m + i) * K + k, scale[m + i], kr);
+            }
+            for (long n = 0; n < N; n++) {
+                auto dst_n = dst + n * ldd + m;
+                auto src_n = src + n * lds + k;
+                if (mr == tile_m) {
+                    X86GemmInt8WeightNTTile<VEC, pack, tile_m>(dst_n, src_n, w_tile, kr);
+                } else {
+                    for (long i = 0; i < mr; i++) {
+                        X86GemmInt8WeightNTTile<VEC, pack, 1>(dst_n + i, src_n, w_tile + i * INT8_WEIGHT_TILE_K, kr);
+                    }
+                }
+            }
+        }
+    }
+}
+template void X86GemmInt8WeightNT<Float4, 4>(float *dst, long ldd, const float *src, long lds, const int8_t *weight,
+                                             const float *scale, const float *bias, long M, long N, long K,
+                                             bool accumulate);
+template void X86GemmInt8WeightNT<Float8, 8>(float *dst, long ldd, const float *src, long lds, const int8_t *weight,
+                                             const float *scale, const float *bias, long M, long N, long K,
+                                             bool accumulate);
+
+template <typename VEC, int pack>
+void X86GemmInt8WeightNN(float *dst, long ldd, const float *src, long lds, const int8_t *weight, const float *scale,
+                         const float *bias, long M, long N, long K) {
+    const int tile_m = 8;
+    long m_tiles     = UP_DIV(M, tile_m);
+
+    OMP_PARALLEL_FOR_GUIDED_
+    for (long mt = 0; mt < m_tiles; mt++) {
+        float w_tile[tile_m * INT8_WEIGHT_TILE_K];
+        long m  = mt * tile_m;
+        long mr = MIN(tile_m, M - m);
+
+        for (long i = 0; i < mr; i++) {
+            auto dst_m = dst + (m + i) * ldd;
+            float b    = bias ? bias[m + i] : 0.f;
+            for (long n = 0; n < N; n++) {
+                dst_m[n] = b;
+            }
+        }
+
+        for (long k = 0; k < K; k += INT8_WEIGHT_TILE_K) {
+            long kr = MIN(INT8_WEIGHT_TILE_K, K - k);
+            for (long i = 0; i < mr; i++) {
+                X86DequantInt8WeightRow(w_tile + i * INT8_WEIGHT_TILE_K, weight + (m + i) * K + k, scale[m + i], kr);
+            }
+            long n = 0;
+            if (mr == tile_m) {
+                for (; n + pack - 1 < N; n += pack) {
+                    VEC acc[tile_m];
+                    for (int i = 0; i < tile_m; i++) {
+                        acc[i] = VEC::loadu(dst + (m + i) * ldd + n);
+                    }
+                    for (long kk = 0; kk < kr; kk++) {
+                        VEC src_v = VEC::loadu(src + (k + kk) * lds + n);
+                        for (int i = 0; i < tile_m; i++) {
+                            VEC::mla(acc[i], VEC(w_tile[i * INT8_WEIGHT_TILE_K + kk]), src_v);
+                        }
+                    }
+                    for (int i = 0; i < tile_m; i++) {
+                        VEC::saveu(dst + (m + i) * ldd + n, acc[i]);
+                    }
+                }
+            }
+            for (long i = 0; i < mr; i++) {
+                auto dst_m  = dst + (m + i) * ldd;
+                auto w_tile_m = w_tile + i * INT8_WEIGHT_TILE_K;
+                for (long kk = 0; kk < kr; kk++) {
+                    auto src_k = src + (k + kk) * lds;
+                    float w    = w_tile_m[kk];
+                    for (long nn = n; nn < N; nn++) {
+                        dst_m[nn] += w * src_k[nn];
+                    }
+                }
+            }
+        }
+    }
+}
+template void X86GemmInt8WeightNN<Float4, 4>(float *dst, long ldd, const float *src, long lds, const int8_t *weight,
+                                             const float *scale, const float *bias, long M, long N, long K);
+template void X86GemmInt8WeightNN<Float8, 8>(float *dst, long ldd, const float *src, long lds, const int8_t *weight,
+                                             const float *scale, const float *bias, long M, long N, long K);
+
 template <int activation_type, typename VEC, int pack>
 void X86_Post_Exec(float *dst, const float *bias, long channel, long area) {
     for (long c = 0; c < channel; c++) {
@@ -66,6 +66,19 @@ void DepthwiseConv(float* dst, const float* src, const float* weight, const floa
 template <typename VEC, int pack>
 void X86Sgemv(float* dst, const float* src, const float* weight, float *bias, DimsVector dims_input, DimsVector dims_output);
 
+// @brief sgemm with the int8 weight of dynamic range quantized models, weight is dequantized tile by tile in the kernel
+// weight: int8 [M, K] row major, scale: M values, bias: M values or nullptr
+// dst[n * ldd + m] = bias[m] + scale[m] * sum_k(src[n * lds + k] * weight[m * K + k]), added to dst if accumulate
+template <typename VEC, int pack>
+void X86GemmInt8WeightNT(float *dst, long ldd, const float *src, long lds, const int8_t *weight, const float *scale,
+                         const float *bias, long M, long N, long K, bool accumulate);
+
+// @brief same as X86GemmInt8WeightNT with src of [K, N], used by conv after im2col
+// dst[m * ldd + n] = bias[m] + scale[m] * sum_k(weight[m * K + k] * src[k * lds + n])
+template <typename VEC, int pack>
+void X86GemmInt8WeightNN(float *dst, long ldd, const float *src, long lds, const int8_t *weight, const float *scale,
+                         const float *bias, long M, long N, long K);
+
 template <int activation_type, typename VEC, int pack>
 void X86_Post_Exec(float *dst, const float *bias, long channel, long area);
 
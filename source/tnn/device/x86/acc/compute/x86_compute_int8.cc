@@ -913,6 +913,173 @@ void X86GemvInt8(int8_t* dst, const int8_t* src, const int8_t* weight, const int
     }
 }
 
+static inline int32_t X86ReduceAddInt32(__m128i v) {
+    v = _mm_hadd_epi32(v, v);
+    v = _mm_hadd_epi32(v, v);
+    return _mm_cvtsi128_si32(v);
+}
+
+#ifdef __AVX2__
+static inline __m128i X86ReduceAddInt32x8(__m256i v) {
+    return _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+}
+
+// rn rows of src x 4 rows of weight share the widened operands
+template <int rn>
+static void X86AVXGemmInt8NTUnit(int8_t* dst, long ldd, const int8_t* src, long lds, const int8_t* weight, long ldw,
+                                 float scale, long M, long K) {
+    DeclareRounding();
+    __m128 scale_vec = _mm_set1_ps(scale);
+    long m = 0;
+    for (; m + 3 < M; m += 4) {
+        const int8_t* b0 = weight + m * ldw;
+        const int8_t* b1 = b0 + ldw;
+        const int8_t* b2 = b1 + ldw;
+        const int8_t* b3 = b2 + ldw;
+        __m256i acc[rn][4];
+        for (int r = 0; r < rn; ++r) {
+            acc[r][0] = acc[r][1] = acc[r][2] = acc[r][3] = _mm256_setzero_si256();
+        }
+        long k = 0;
+        for (; k + 15 < K; k += 16) {
+            __m256i b0_16 = _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i*)(b0 + k)));
+            __m256i b1_16 = _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i*)(b1 + k)));
+            __m256i b2_16 = _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i*)(b2 + k)));
+            __m256i b3_16 = _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i*)(b3 + k)));
+            for (int r = 0; r < rn; ++r) {
+                __m256i a_16 = _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i*)(src + r * lds + k)));
+                acc[r][0]    = _mm256_add_epi32(acc[r][0], _mm256_madd_epi16(a_16, b0_16));
+                acc[r][1]    = _mm256_add_epi32(acc[r][1], _mm256_madd_epi16(a_16, b1_16));
+                acc[r][2]    = _mm256_add_epi32(acc[r][2], _mm256_madd_epi16(a_16, b2_16));
+                acc[r][3]    = _mm256_add_epi32(acc[r][3], _mm256_madd_epi16(a_16, b3_16));
+            }
+        }
+        for (int r = 0; r < rn; ++r) {
+            const int8_t* a = src + r * lds;
+            int32_t tail[4] = {0, 0, 0, 0};
+            for (long kk = k; kk < K; ++kk) {
+                tail[0] += a[kk] * b0[kk];
+                tail[1] += a[kk] * b1[kk];
+                tail[2] += a[kk] * b2[kk];
+                tail[3] += a[kk] * b3[kk];
+            }
+            __m128i sum_4xi32 =
+                _mm_hadd_epi32(_mm_hadd_epi32(X86ReduceAddInt32x8(acc[r][0]), X86ReduceAddInt32x8(acc[r][1])),
+                               _mm_hadd_epi32(X86ReduceAddInt32x8(acc[r][2]), X86ReduceAddInt32x8(acc[r][3])));
+            sum_4xi32        = _mm_add_epi32(sum_4xi32, _mm_loadu_si128((__m128i*)tail));
+            __m128 dst_4xf32 = _mm_mul_ps(_mm_cvtepi32_ps(sum_4xi32), scale_vec);
+            F32X4TOI8X4(dst_4xf32, (dst + r * ldd + m));
+        }
+    }
+    for (; m < M; ++m) {
+        const int8_t* b = weight + m * ldw;
+        for (int r = 0; r < rn; ++r) {
+            const int8_t* a = src + r * lds;
+            __m256i acc     = _mm256_setzero_si256();
+            long k          = 0;
+            for (; k + 15 < K; k += 16) {
+                __m256i a_16 = _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i*)(a + k)));
+                __m256i b_16 = _mm256_cvtepi8_epi16(_mm_loadu_si128((__m128i*)(b + k)));
+                acc          = _mm256_add_epi32(acc, _mm256_madd_epi16(a_16, b_16));
+            }
+            int32_t sum = X86ReduceAddInt32(X86ReduceAddInt32x8(acc));
+            for (; k < K; ++k) {
+                sum += a[k] * b[k];
+            }
+            dst[r * ldd + m] = float2int8(sum * scale);
+        }
+    }
+}
+
+void X86AVXGemmInt8NT(int8_t* dst, long ldd, const int8_t* src, long lds, const int8_t* weight, long ldw, float scale,
+                      long M, long N, long K) {
+    long n_r2 = N / 2 * 2;
+    OMP_PARALLEL_FOR_GUIDED_
+    for (long n = 0; n < n_r2; n += 2) {
+        X86AVXGemmInt8NTUnit<2>(dst + n * ldd, ldd, src + n * lds, lds, weight, ldw, scale, M, K);
+    }
+    if (n_r2 < N) {
+        X86AVXGemmInt8NTUnit<1>(dst + n_r2 * ldd, ldd, src + n_r2 * lds, lds, weight, ldw, scale, M, K);
+    }
+}
+#endif
+
+template <int rn>
+static void X86SSEGemmInt8NTUnit(int8_t* dst, long ldd, const int8_t* src, long lds, const int8_t* weight, long ldw,
+                                 float scale, long M, long K) {
+    DeclareRounding();
+    __m128 scale_vec = _mm_set1_ps(scale);
+    long m = 0;
+    for (; m + 3 < M; m += 4) {
+        const int8_t* b0 = weight + m * ldw;
+        const int8_t* b1 = b0 + ldw;
+        const int8_t* b2 = b1 + ldw;
+        const int8_t* b3 = b2 + ldw;
+        __m128i acc[rn][4];
+        for (int r = 0; r < rn; ++r) {
+            acc[r][0] = acc[r][1] = acc[r][2] = acc[r][3] = _mm_setzero_si128();
+        }
+        long k = 0;
+        for (; k + 7 < K; k += 8) {
+            __m128i b0_16 = _mm_cvtepi8_epi16(_mm_loadl_epi64((__m128i*)(b0 + k)));
+            __m128i b1_16 = _mm_cvtepi8_epi16(_mm_loadl_epi64((__m128i*)(b1 + k)));
+            __m128i b2_16 = _mm_cvtepi8_epi16(_mm_loadl_epi64((__m128i*)(b2 + k)));
+            __m128i b3_16 = _mm_cvtepi8_epi16(_mm_loadl_epi64((__m128i*)(b3 + k)));
+            for (int r = 0; r < rn; ++r) {
+                __m128i a_16 = _mm_cvtepi8_epi16(_mm_loadl_epi64((__m128i*)(src + r * lds + k)));
+                acc[r][0]    = _mm_add_epi32(acc[r][0], _mm_madd_epi16(a_16, b0_16));
+                acc[r][1]    = _mm_add_epi32(acc[r][1], _mm_madd_epi16(a_16, b1_16));
+                acc[r][2]    = _mm_add_epi32(acc[r][2], _mm_madd_epi16(a_16, b2_16));
+                acc[r][3]    = _mm_add_epi32(acc[r][3], _mm_madd_epi16(a_16, b3_16));
+            }
+        }
+        for (int r = 0; r < rn; ++r) {
+            const int8_t* a = src + r * lds;
+            int32_t tail[4] = {0, 0, 0, 0};
+            for (long kk = k; kk < K; ++kk) {
+                tail[0] += a[kk] * b0[kk];
+                tail[1] += a[kk] * b1[kk];
+                tail[2] += a[kk] * b2[kk];
+                tail[3] += a[kk] * b3[kk];
+            }
+            __m128i sum_4xi32 = _mm_hadd_epi32(_mm_hadd_epi32(acc[r][0], acc[r][1]), _mm_hadd_epi32(acc[r][2], acc[r][3]));
+            sum_4xi32         = _mm_add_epi32(sum_4xi32, _mm_loadu_si128((__m128i*)tail));
+            __m128 dst_4xf32  = _mm_mul_ps(_mm_cvtepi32_ps(sum_4xi32), scale_vec);
+            F32X4TOI8X4(dst_4xf32, (dst + r * ldd + m));
+        }
+    }
+    for (; m < M; ++m) {
+        const int8_t* b = weight + m * ldw;
+        for (int r = 0; r < rn; ++r) {
+            const int8_t* a = src + r * lds;
+            __m128i acc     = _mm_setzero_si128();
+            long k          = 0;
+            for (; k + 7 < K; k += 8) {
+                __m128i a_16 = _mm_cvtepi8_epi16(_mm_loadl_epi64((__m128i*)(a + k)));
+                __m128i b_16 = _mm_cvtepi8_epi16(_mm_loadl_epi64((__m128i*)(b + k)));
+                acc          = _mm_add_epi32(acc, _mm_madd_epi16(a_16, b_16));
+            }
+            int32_t sum = X86ReduceAddInt32(acc);
+            for (; k < K; ++k) {
+                sum += a[k] * b[k];
+            }
+            dst[r * ldd + m] = float2int8(sum * scale);
+        }
+    }
+}
+
+void X86SSEGemmInt8NT(int8_t* dst, long ldd, const int8_t* src, long lds, const int8_t* weight, long ldw, float scale,
+                      long M, long N, long K) {
+    long n_r2 = N / 2 * 2;
+    OMP_PARALLEL_FOR_GUIDED_
+    for (long n = 0; n < n_r2; n += 2) {
+        X86SSEGemmInt8NTUnit<2>(dst + n * ldd, ldd, src + n * lds, lds, weight, ldw, scale, M, K);
+    }
+    if (n_r2 < N) {
+        X86SSEGemmInt8NTUnit<1>(dst + n_r2 * ldd, ldd, src + n_r2 * lds, lds, weight, ldw, scale, M, K);
+    }
+}
+
 static bool is_per_tensor_quant(const std::vector<Blob *> &inputs) {
     bool int8_per_tensor_flag = true;
     for (auto &blob : inputs) {
@@ -1190,67 +1357,70 @@ template void X86UpsampleBilinear2D<false>(int8_t *output_data, const int8_t *in
                                           int batch, int ih, int iw, int oh, int ow,
                                           int c_4, bool align_corners, const float *scale);
 
-void X86Int8ToFloat(float* dst, const int8_t* src, const float* scale, long batch, long channel, long hw) {
+void X86Int8ToFloatStrided(float* dst, const int8_t* src, const float* scale, long channel, long count,
+                           long dst_stride) {
     long channel_r4 = ROUND_UP(channel, 4);
-    for (long b = 0; b < batch; b++) {
-        auto dst_b = dst + b * channel * hw;
-        auto src_b = src + b * channel_r4 * hw;
-
-        long c = 0;
-        for (; c + 3 < channel; c += 4) {
-            auto dst_c_0 = dst_b + c * hw;
-            auto dst_c_1 = dst_c_0 + hw;
-            auto dst_c_2 = dst_c_1 + hw;
-            auto dst_c_3 = dst_c_2 + hw;
-            auto src_c   = src_b + c;
-
-            __m128 scale_vec = _mm_loadu_ps(scale + c);
-            long i = 0;
-            for (; i + 3 < hw; i += 4) {
-                auto src_hw = src_c + i * channel_r4;
-                int i8x4_0  = (*(int *)(src_hw));
-                int i8x4_1  = (*(int *)(src_hw + channel_r4));
-                int i8x4_2  = (*(int *)(src_hw + channel_r4 * 2));
-                int i8x4_3  = (*(int *)(src_hw + channel_r4 * 3));
-
-                __m128 f32x4_0 = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(i8x4_0)));
-                __m128 f32x4_1 = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(i8x4_1)));
-                __m128 f32x4_2 = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(i8x4_2)));
-                __m128 f32x4_3 = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(i8x4_3)));
-                f32x4_0        = _mm_mul_ps(f32x4_0, scale_vec);
-                f32x4_1        = _mm_mul_ps(f32x4_1, scale_vec);
-                f32x4_2        = _mm_mul_ps(f32x4_2, scale_vec);
-                f32x4_3        = _mm_mul_ps(f32x4_3, scale_vec);
-                _MM_TRANSPOSE4_PS(f32x4_0, f32x4_1, f32x4_2, f32x4_3);
-                _mm_storeu_ps(dst_c_0 + i, f32x4_0);
-                _mm_storeu_ps(dst_c_1 + i, f32x4_1);
-                _mm_storeu_ps(dst_c_2 + i, f32x4_2);
-                _mm_storeu_ps(dst_c_3 + i, f32x4_3);
-            }
-            float dst_tmp[4];
-            for (; i < hw; i++) {
-                int i8x4     = *((int *)(src_c + i * channel_r4));
-                __m128 f32x4 = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(i8x4)));
-                f32x4        = _mm_mul_ps(f32x4, scale_vec);
-                _mm_store_ps(dst_tmp, f32x4);
-                dst_c_0[i]   = dst_tmp[0];
-                dst_c_1[i]   = dst_tmp[1];
-                dst_c_2[i]   = dst_tmp[2];
-                dst_c_3[i]   = dst_tmp[3];
-            }
+    long c = 0;
+    for (; c + 3 < channel; c += 4) {
+        auto dst_c_0 = dst + c * dst_stride;
+        auto dst_c_1 = dst_c_0 + dst_stride;
+        auto dst_c_2 = dst_c_1 + dst_stride;
+        auto dst_c_3 = dst_c_2 + dst_stride;
+        auto src_c   = src + c;
+
+        __m128 scale_vec = _mm_loadu_ps(scale + c);
+        long i = 0;
+        for (; i + 3 < count; i += 4) {
+            auto src_hw = src_c + i * channel_r4;
+            int i8x4_0  = (*(int *)(src_hw));
+            int i8x4_1  = (*(int *)(src_hw + channel_r4));
+            int i8x4_2  = (*(int *)(src_hw + channel_r4 * 2));
+            int i8x4_3  = (*(int *)(src_hw + channel_r4 * 3));
+
+            __m128 f32x4_0 = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(i8x4_0)));
+            __m128 f32x4_1 = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(i8x4_1)));
+            __m128 f32x4_2 = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(i8x4_2)));
+            __m128 f32x4_3 = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(i8x4_3)));
+            f32x4_0        = _mm_mul_ps(f32x4_0, scale_vec);
+            f32x4_1        = _mm_mul_ps(f32x4_1, scale_vec);
+            f32x4_2        = _mm_mul_ps(f32x4_2, scale_vec);
+            f32x4_3        = _mm_mul_ps(f32x4_3, scale_vec);
+            _MM_TRANSPOSE4_PS(f32x4_0, f32x4_1, f32x4_2, f32x4_3);
+            _mm_storeu_ps(dst_c_0 + i, f32x4_0);
+            _mm_storeu_ps(dst_c_1 + i, f32x4_1);
+            _mm_storeu_ps(dst_c_2 + i, f32x4_2);
+            _mm_storeu_ps(dst_c_3 + i, f32x4_3);
         }
-        for (; c < channel; c++) {
-            auto dst_c = dst_b + c * hw;
-            auto src_c = src_b + c;
-            auto sc    = scale[c];
+        float dst_tmp[4];
+        for (; i < count; i++) {
+            int i8x4     = *((int *)(src_c + i * channel_r4));
+            __m128 f32x4 = _mm_cvtepi32_ps(_mm_cvtepi8_epi32(_mm_cvtsi32_si128(i8x4)));
+            f32x4        = _mm_mul_ps(f32x4, scale_vec);
+            _mm_store_ps(dst_tmp, f32x4);
+            dst_c_0[i]   = dst_tmp[0];
+            dst_c_1[i]   = dst_tmp[1];
+            dst_c_2[i]   = dst_tmp[2];
+            dst_c_3[i]   = dst_tmp[3];
+        }
+    }
+    for (; c < channel; c++) {
+        auto dst_c = dst + c * dst_stride;
+        auto src_c = src + c;
+        auto sc    = scale[c];
 
-            for (long i = 0; i < hw; i++) {
-                dst_c[i] = static_cast<float>(src_c[i * channel_r4]) * sc;
-            }
+        for (long i = 0; i < count; i++) {
+            dst_c[i] = static_cast<float>(src_c[i * channel_r4]) * sc;
         }
     }
 }
 
+void X86Int8ToFloat(float* dst, const int8_t* src, const float* scale, long batch, long channel, long hw) {
+    long channel_r4 = ROUND_UP(channel, 4);
+    for (long b = 0; b < batch; b++) {
+        X86Int8ToFloatStrided(dst + b * channel * hw, src + b * channel_r4 * hw, scale, channel, hw, hw);
+    }
+}
+
 void X86FloatToInt8(int8_t* dst, const float* src, const float* scale, long batch, long channel, long hw) {
     DeclareRounding();
     long channel_r4 = ROUND_UP(channel, 4);
@@ -62,6 +62,15 @@ void X86MatrixAddInt8(int8_t* dst, const int8_t* A, const int8_t* B, float* dst_
 void X86GemvInt8(int8_t* dst, const int8_t* src, const int8_t* weight, const int32_t* bias, const float* scale,
                  long ic_r4, long oc_r4);
 
+// @brief int8 gemm with both operands in plain row major layout, scale is per tensor
+// dst[n * ldd + m] = int8(scale * sum_k(src[n * lds + k] * weight[m * ldw + k]))
+#ifdef __AVX2__
+void X86AVXGemmInt8NT(int8_t* dst, long ldd, const int8_t* src, long lds, const int8_t* weight, long ldw, float scale,
+                      long M, long N, long K);
+#endif
+void X86SSEGemmInt8NT(int8_t* dst, long ldd, const int8_t* src, long lds, const int8_t* weight, long ldw, float scale,
+                      long M, long N, long K);
+
 void X86ConcatChannelInt8(Blob *output, const std::vector<Blob *> &inputs);
 void X86ConcatCommonInt8(Blob *output, const std::vector<Blob *> &inputs, int axis);
 
@@ -75,6 +84,9 @@ void X86UpsampleBilinear2D(int8_t *output_data, const int8_t *input_data,
                            int c_4, bool align_corners, const float *scale);
 
 void X86Int8ToFloat(float* dst, const int8_t* src, const float* scale, long batch, long channel, long hw);
+// @brief dequantize count pixels of nhwc4 int8 to the planes of nchw float, dst_stride is the plane size of dst
+void X86Int8ToFloatStrided(float* dst, const int8_t* src, const float* scale, long channel, long count,
+                           long dst_stride);
 void X86FloatToInt8(int8_t* dst, const float* src, const float* scale, long batch, long channel, long hw);
 
 }   // namespace TNN_NS
@@ -34,6 +34,10 @@ bool X86ConvInt8LayerCommon::isPrefered(ConvLayerParam *param, const std::vector
     if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_INT8) {
         return true;
     }
+    // float input with the quantize reformat fused
+    if (param && param->quantized) {
+        return true;
+    }
     return false;
 }
 
@@ -100,7 +104,7 @@ Status X86ConvInt8LayerCommon::allocateBufferBias(const std::vector<Blob *> &inp
             memcpy(temp_buffer.force_to<int32_t *>(), conv_res->bias_handle.force_to<int32_t *>(), bias_handle_size);
 
             buffer_bias_ = temp_buffer;
-        } else if (outputs[0]->GetBlobDesc().data_type == DATA_TYPE_INT8) {
+        } else {
             // int 8 kernel always add bias, if not, set zeros
             buffer_bias_ = RawBuffer(ROUND_UP(dims_output[1], 4) * sizeof(int32_t));
         }
@@ -194,6 +198,46 @@ Status X86ConvInt8LayerCommon::allocateBufferAddScale(const std::vector<Blob *>
     return TNN_OK;
 }
 
+/*
+the scales of the reformats fused into the conv, the same as X86ReformatLayerAcc
+*/
+Status X86ConvInt8LayerCommon::allocateBufferReformatScale(const std::vector<Blob *> &inputs,
+                                                           const std::vector<Blob *> &outputs) {
+    ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+
+    if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_FLOAT && !buffer_input_scale_.GetBytesSize()) {
+        const int channel  = inputs[0]->GetBlobDesc().dims[1];
+        auto &scale_handle = reinterpret_cast<BlobInt8 *>(inputs[0])->GetIntResource()->scale_handle;
+        const float *scale = scale_handle.force_to<float *>();
+        int scale_len      = scale_handle.GetDataCount();
+        RawBuffer temp_buffer(ROUND_UP(channel, 4) * sizeof(float));
+        float *temp_ptr = temp_buffer.force_to<float *>();
+        for (int i = 0; i < channel; i++) {
+            temp_ptr[i] = 1.0 / scale[scale_len == 1 ? 0 : i];
+        }
+        buffer_input_scale_ = temp_buffer;
+    }
+
+    if (outputs[0]->GetBlobDesc().data_type == DATA_TYPE_FLOAT && !buffer_output_scale_.GetBytesSize()) {
+        if (conv_param->group != 1) {
+            return Status(TNNERR_LAYER_ERR, "int8 conv with float output does not support group conv");
+        }
+        const int channel  = outputs[0]->GetBlobDesc().dims[1];
+        auto &scale_handle = reinterpret_cast<BlobInt8 *>(outputs[0])->GetIntResource()->scale_handle;
+        const float *scale = scale_handle.force_to<float *>();
+        int scale_len      = scale_handle.GetDataCount();
+        RawBuffer temp_buffer(ROUND_UP(channel, 4) * sizeof(float));
+        float *temp_ptr = temp_buffer.force_to<float *>();
+        for (int i = 0; i < channel; i++) {
+            temp_ptr[i] = scale[scale_len == 1 ? 0 : i];
+        }
+        buffer_output_scale_ = temp_buffer;
+    }
+
+    return TNN_OK;
+}
+
 #define DEF_IMG2COL_VAL                                                                                                \
     int x_id = (int)x_start + i;                                                                                       \
     int ox   = x_id % output_dims[3];                                                                                  \
@@ -326,6 +370,7 @@ Status X86ConvInt8LayerCommon::Init(Context *context, LayerParam *param, LayerRe
     RETURN_ON_NEQ(X86LayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
     RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
     RETURN_ON_NEQ(allocateBufferScale(inputs, outputs), TNN_OK);
+    RETURN_ON_NEQ(allocateBufferReformatScale(inputs, outputs), TNN_OK);
     RETURN_ON_NEQ(setFusionParam(inputs, outputs), TNN_OK);
 
     ConvLayerParam *conv_param = dynamic_cast<ConvLayerParam *>(param_);
@@ -444,8 +489,9 @@ Status X86ConvInt8LayerCommon::DoForward(const std::vector<Blob *> &inputs, cons
     auto output    = outputs[0];
     auto add_input = (conv_param->fusion_type == FusionType_None) ? nullptr : inputs[1];
 
-    DataType data_type = output->GetBlobDesc().data_type;
-    int data_byte_size = DataTypeUtils::GetBytesSize(data_type);
+    // the int8 reformats fused: quantize the float input, dequantize the float output
+    const bool float_input  = input->GetBlobDesc().data_type == DATA_TYPE_FLOAT;
+    const bool float_output = output->GetBlobDesc().data_type == DATA_TYPE_FLOAT;
 
     auto dims_input  = input->GetBlobDesc().dims;
     auto dims_output = output->GetBlobDesc().dims;
@@ -465,8 +511,10 @@ Status X86ConvInt8LayerCommon::DoForward(const std::vector<Blob *> &inputs, cons
     auto output_batch_stride   = output_channel_stride * oc_r4;
     auto kernel_group_stride   = oc_g_r4 * ROUND_UP(ic_g_r4 * conv_param->kernels[0] * conv_param->kernels[1], 16);
 
-    int8_t *input_data     = handle_ptr<int8_t *>(input->GetHandle());
-    int8_t *output_data    = handle_ptr<int8_t *>(output->GetHandle());
+    int8_t *input_data     = float_input ? nullptr : handle_ptr<int8_t *>(input->GetHandle());
+    int8_t *output_data    = float_output ? nullptr : handle_ptr<int8_t *>(output->GetHandle());
+    float *input_data_fp   = float_input ? handle_ptr<float *>(input->GetHandle()) : nullptr;
+    float *output_data_fp  = float_output ? handle_ptr<float *>(output->GetHandle()) : nullptr;
     int8_t *add_input_data = add_input ? handle_ptr<int8_t *>(add_input->GetHandle()) : nullptr;
 
     float *scale_ptr   = buffer_scale_.force_to<float *>();
@@ -495,15 +543,30 @@ Status X86ConvInt8LayerCommon::DoForward(const std::vector<Blob *> &inputs, cons
     }
     size_t im2col_buf_size = ROUND_UP(ic_g_r4 * conv_param->kernels[0] * conv_param->kernels[1], 16) *
                              tile_blk_ * max_num_threads + SIMD_KERNEL_EXTRA_LOAD;
-    workspace_size = src_group_buf_size + dst_group_buf_size + im2col_buf_size;
+    // the quantized image of a float input, the int8 tiles of each thread for a float output
+    size_t src_quant_buf_size = float_input ? ic_r4 * input_channel_stride : 0;
+    size_t dst_tile_buf_size  = float_output ? oc_g_r4 * tile_blk_ * max_num_threads : 0;
+    workspace_size = src_group_buf_size + dst_group_buf_size + im2col_buf_size + src_quant_buf_size +
+                     dst_tile_buf_size;
     int8_t *workspace = reinterpret_cast<int8_t *>(context_->GetSharedWorkSpace(workspace_size));
     // im2col will memset 0 by itself
     memset(workspace, 0, src_group_buf_size + dst_group_buf_size);
-    auto im2col_buf_ptr = workspace + src_group_buf_size + dst_group_buf_size;
+    auto im2col_buf_ptr    = workspace + src_group_buf_size + dst_group_buf_size;
+    auto src_quant_buf_ptr = im2col_buf_ptr + im2col_buf_size;
+    auto dst_tile_buf_ptr  = src_quant_buf_ptr + src_quant_buf_size;
 
     for (int n = 0; n < batch; ++n) {
-        auto input_batch     = input_data + n * input_batch_stride;
-        auto output_batch    = output_data + n * output_batch_stride;
+        int8_t *input_batch = nullptr;
+        if (float_input) {
+            // quantize on load: the image is quantized to nhwc4 once for all the tiles
+            X86FloatToInt8(src_quant_buf_ptr, input_data_fp + n * ic * input_channel_stride,
+                           buffer_input_scale_.force_to<float *>(), 1, ic, input_channel_stride);
+            input_batch = src_quant_buf_ptr;
+        } else {
+            input_batch = input_data + n * input_batch_stride;
+        }
+        auto output_batch    = float_output ? nullptr : output_data + n * output_batch_stride;
+        auto output_batch_fp = float_output ? output_data_fp + n * dims_output[1] * output_channel_stride : nullptr;
         auto add_input_batch = add_input_data ? add_input_data + n * output_batch_stride : nullptr;
 
         auto input_group  = input_batch;
@@ -539,7 +602,8 @@ Status X86ConvInt8LayerCommon::DoForward(const std::vector<Blob *> &inputs, cons
                 } else {
                     input_kernel = input_group + hw_start * ic_calc;
                 }
-                auto output_kernel    = output_group + hw_start * oc_g_r4;
+                auto output_kernel    = float_output ? dst_tile_buf_ptr + thread_id * tile_blk_ * oc_g_r4
+                                                     : output_group + hw_start * oc_g_r4;
                 // add_input not support group conv
                 auto add_input_kernel = add_input_batch ? add_input_batch + hw_start * oc_g_r4 : nullptr;
 
@@ -547,6 +611,13 @@ Status X86ConvInt8LayerCommon::DoForward(const std::vector<Blob *> &inputs, cons
                          real_hw_tile, crs_div8, crs_div8 * 8, oc_g_r4, relu_,
                          add_input_kernel, buffer_add_scale_.force_to<float *>(),
                          relu6_max_g, arch_);
+
+                // dequantize epilogue: the int8 tile goes to the float planes while it is still in cache
+                if (float_output) {
+                    X86Int8ToFloatStrided(output_batch_fp + hw_start, output_kernel,
+                                          buffer_output_scale_.force_to<float *>(), dims_output[1], real_hw_tile,
+                                          output_channel_stride);
+                }
             }
 
             if (conv_param->group > 1) {
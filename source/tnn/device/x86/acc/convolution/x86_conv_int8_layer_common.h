@@ -45,6 +45,8 @@ public:
 
     virtual Status allocateBufferAddScale(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
+    virtual Status allocateBufferReformatScale(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
     virtual Status setFusionParam(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
 protected:
@@ -53,6 +55,9 @@ protected:
     RawBuffer buffer_bias_;
     RawBuffer buffer_scale_;
     RawBuffer buffer_add_scale_;
+    // for the fused int8 reformats, quantize the float input and dequantize the float output
+    RawBuffer buffer_input_scale_;
+    RawBuffer buffer_output_scale_;
     // for conv relu6 fusion
     RawBuffer relu6_max_;
 
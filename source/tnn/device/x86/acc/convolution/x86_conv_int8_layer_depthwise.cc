@@ -27,7 +27,8 @@ bool X86ConvInt8LayerDepthwise::isPrefered(ConvLayerParam *param, const std::vec
     if (!param) {
         return false;
     }
-    if (inputs[0]->GetBlobDesc().data_type != DATA_TYPE_INT8) {
+    if (inputs[0]->GetBlobDesc().data_type != DATA_TYPE_INT8 ||
+        outputs[0]->GetBlobDesc().data_type != DATA_TYPE_INT8) {
         return false;
     }
     if (param->fusion_type != FusionType_None) {
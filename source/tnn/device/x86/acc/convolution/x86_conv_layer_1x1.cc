@@ -50,6 +50,14 @@ bool X86ConvLayer1x1::isPrefered(ConvLayerParam *param, const std::vector<Blob *
 
 X86ConvLayer1x1::~X86ConvLayer1x1() {}
 
+size_t X86ConvLayer1x1::GetWorkspaceSize(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto dims_input     = inputs[0]->GetBlobDesc().dims;
+    int max_num_threads = OMP_MAX_THREADS_NUM_;
+    dim_t m_c           = conv_gemm_conf_.M_c_;
+    conv_ajust_m_blk_size(max_num_threads, dims_input[2] * dims_input[3], m_c);
+    return m_c * conv_gemm_conf_.K_c_ * max_num_threads * sizeof(float);
+}
+
 Status X86ConvLayer1x1::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     ConvLayerParam *param = dynamic_cast<ConvLayerParam *>(param_);
 
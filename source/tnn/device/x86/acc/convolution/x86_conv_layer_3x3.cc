@@ -636,6 +636,27 @@ Status X86ConvLayer3x3::allocateBufferWeight(const std::vector<Blob *> &inputs,
 #define TILE_NUM 6
 // #define CH_PACK 8
 
+size_t X86ConvLayer3x3::GetWorkspaceSize(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    ConvLayerParam *param = dynamic_cast<ConvLayerParam *>(param_);
+    auto dims_input       = inputs[0]->GetBlobDesc().dims;
+    auto dims_output      = outputs[0]->GetBlobDesc().dims;
+    const int CH_PACK     = arch_ == avx2 ? 8 : 4;
+    const int src_unit    = 4;
+    const int dst_unit    = 2;
+
+    int ic_8  = UP_DIV(dims_input[1], CH_PACK);
+    int oc_8  = UP_DIV(dims_output[1], CH_PACK);
+    int w_pad = dims_input[3] + param->pads[0] + param->pads[1];
+    int h_pad = dims_input[2] + param->pads[2] + param->pads[3];
+
+    size_t zero_size       = ROUND_UP(w_pad * sizeof(float), 32);
+    size_t pack_input_size = ROUND_UP(w_pad * h_pad * ROUND_UP(dims_input[1], CH_PACK) * sizeof(float), 32);
+    size_t tmp_size        = ROUND_UP((ic_8 + oc_8) * src_unit * src_unit * CH_PACK * TILE_NUM * sizeof(float), 32);
+    size_t src_trans_size  = ROUND_UP(src_unit * src_unit * CH_PACK * sizeof(float), 32);
+    size_t dst_trans_size  = ROUND_UP(dst_unit * dst_unit * CH_PACK * sizeof(float), 32);
+    return zero_size + pack_input_size + tmp_size + (src_trans_size + dst_trans_size) * OMP_MAX_THREADS_NUM_;
+}
+
 Status X86ConvLayer3x3::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     ConvLayerParam *param = dynamic_cast<ConvLayerParam *>(param_);
 
@@ -108,6 +108,23 @@ Status X86ConvLayerCommon::Init(Context *context, LayerParam *param, LayerResour
     return TNN_OK;
 }
 
+// im2col buffer of all groups and the per thread packed gemm source
+size_t X86ConvLayerCommon::GetWorkspaceSize(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param       = dynamic_cast<ConvLayerParam *>(param_);
+    auto input_dims  = inputs[0]->GetBlobDesc().dims;
+    auto output_dims = outputs[0]->GetBlobDesc().dims;
+    auto oh          = DimsFunctionUtils::GetDim(output_dims, 2);
+    auto ow          = DimsFunctionUtils::GetDim(output_dims, 3);
+
+    size_t col_offset = param->kernels[0] * param->kernels[1] * oh * ow * (input_dims[1] / param->group);
+    int max_num_threads = OMP_MAX_THREADS_NUM_;
+    dim_t m_c           = conv_gemm_conf_.M_c_;
+    conv_ajust_m_blk_size(max_num_threads, oh * ow, m_c);
+
+    size_t im2col_size = ROUND_UP(col_offset * param->group * sizeof(float), 32);
+    return im2col_size + ROUND_UP(m_c * conv_gemm_conf_.K_c_ * max_num_threads * sizeof(float), 32);
+}
+
 Status X86ConvLayerCommon::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     Blob *input_blob    = inputs[0];
     Blob *output_blob   = outputs[0];
@@ -107,6 +107,19 @@ void PackWithPad(
     memset(dst_ptr + src_h * src_pad_w_stride, 0, pads[3] * src_pad_w_stride * sizeof(float));
 }
 
+size_t X86ConvLayerDepthwise::GetWorkspaceSize(const std::vector<Blob *> &inputs,
+                                               const std::vector<Blob *> &outputs) {
+    ConvLayerParam *param = dynamic_cast<ConvLayerParam *>(param_);
+    auto dims_input       = inputs[0]->GetBlobDesc().dims;
+    auto dims_output      = outputs[0]->GetBlobDesc().dims;
+    int c_pack            = arch_ == sse42 ? 4 : 8;
+
+    int src_pad_w       = dims_input[3] + param->pads[0] + param->pads[1];
+    size_t src_pad_size = ROUND_UP(src_pad_w * (dims_input[2] + param->pads[2] + param->pads[3]) * c_pack * sizeof(float), 32);
+    size_t dst_tmp_size = ROUND_UP(dims_output[2] * dims_output[3] * c_pack * sizeof(float), 32);
+    return (src_pad_size + dst_tmp_size) * OMP_MAX_THREADS_NUM_;
+}
+
 Status X86ConvLayerDepthwise::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     ConvLayerParam *param = dynamic_cast<ConvLayerParam *>(param_);
 
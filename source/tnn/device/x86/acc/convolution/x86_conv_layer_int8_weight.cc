@@ -0,0 +1,167 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/convolution/x86_conv_layer_int8_weight.h"
+#include "tnn/device/x86/acc/compute/x86_compute.h"
+#include "tnn/device/x86/x86_context.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_function_utils.h"
+
+namespace TNN_NS {
+
+bool X86ConvLayerInt8Weight::isPrefered(ConvLayerParam *param, LayerResource *resource) {
+    auto conv_res = dynamic_cast<ConvLayerResource *>(resource);
+    if (!param || !conv_res || !param->dynamic_range_quantized) {
+        return false;
+    }
+    return conv_res->filter_handle.GetDataType() == DATA_TYPE_INT8;
+}
+
+X86ConvLayerInt8Weight::~X86ConvLayerInt8Weight() {}
+
+Status X86ConvLayerInt8Weight::Init(Context *context, LayerParam *param, LayerResource *resource,
+                                    const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    RETURN_ON_NEQ(X86LayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+
+    auto conv_param = dynamic_cast<ConvLayerParam *>(param_);
+    CHECK_PARAM_NULL(conv_param);
+    auto conv_res = dynamic_cast<ConvLayerResource *>(resource_);
+    CHECK_PARAM_NULL(conv_res);
+
+    if (conv_param->activation_type != ActivationType_None && conv_param->activation_type != ActivationType_ReLU &&
+        conv_param->activation_type != ActivationType_ReLU6) {
+        LOGE("Error: activation type %d not support\n", conv_param->activation_type);
+        return Status(TNNERR_LAYER_ERR, "conv with int8 weight only supports relu and relu6 activation");
+    }
+
+    const int oc = conv_param->output_channel;
+    // weights share the int8 buffer of resource, [oc, ic / group, kh, kw]
+    buffer_weight_ = conv_res->filter_handle;
+
+    auto scale_handle = conv_res->scale_handle;
+    if (scale_handle.GetDataType() == DATA_TYPE_HALF) {
+        scale_handle = ConvertHalfHandle(scale_handle);
+    }
+    const int scale_count = scale_handle.GetDataCount();
+    if (scale_count != oc && scale_count != 1) {
+        LOGE("Error: conv weight scale count %d mismatch output channel %d\n", scale_count, oc);
+        return Status(TNNERR_MODEL_ERR, "conv weight scale count is invalid");
+    }
+    buffer_scale_ = RawBuffer(oc * sizeof(float));
+    auto scale_ptr = scale_handle.force_to<float *>();
+    for (int i = 0; i < oc; i++) {
+        buffer_scale_.force_to<float *>()[i] = scale_ptr[scale_count == 1 ? 0 : i];
+    }
+
+    buffer_bias_ = RawBuffer(oc * sizeof(float));
+    if (conv_param->bias) {
+        auto bias_handle = conv_res->bias_handle;
+        if (bias_handle.GetDataType() == DATA_TYPE_HALF) {
+            bias_handle = ConvertHalfHandle(bias_handle);
+        }
+        memcpy(buffer_bias_.force_to<float *>(), bias_handle.force_to<float *>(), oc * sizeof(float));
+    }
+
+    return TNN_OK;
+}
+
+size_t X86ConvLayerInt8Weight::GetWorkspaceSize(const std::vector<Blob *> &inputs,
+                                                const std::vector<Blob *> &outputs) {
+    auto param       = dynamic_cast<ConvLayerParam *>(param_);
+    auto input_dims  = inputs[0]->GetBlobDesc().dims;
+    auto output_dims = outputs[0]->GetBlobDesc().dims;
+    bool do_im2col = !(param->kernels[0] == 1 && param->kernels[1] == 1 && param->strides[0] == 1 &&
+                       param->strides[1] == 1 && param->pads[0] == 0 && param->pads[1] == 0 && param->pads[2] == 0 &&
+                       param->pads[3] == 0);
+    if (!do_im2col) {
+        return 0;
+    }
+    const size_t K = input_dims[1] / param->group * param->kernels[0] * param->kernels[1];
+    const size_t N = DimsFunctionUtils::GetDim(output_dims, 2) * DimsFunctionUtils::GetDim(output_dims, 3);
+    return K * param->group * N * sizeof(float);
+}
+
+Status X86ConvLayerInt8Weight::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param       = dynamic_cast<ConvLayerParam *>(param_);
+    auto input_dims  = inputs[0]->GetBlobDesc().dims;
+    auto output_dims = outputs[0]->GetBlobDesc().dims;
+    if (outputs[0]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+        return Status(TNNERR_DEVICE_ACC_DATA_FORMAT_NOT_SUPPORT, "Error: x86 device not support this data type");
+    }
+
+    auto input_data  = handle_ptr<float *>(inputs[0]->GetHandle());
+    auto output_data = handle_ptr<float *>(outputs[0]->GetHandle());
+
+    auto ih = DimsFunctionUtils::GetDim(input_dims, 2);
+    auto iw = DimsFunctionUtils::GetDim(input_dims, 3);
+    auto oh = DimsFunctionUtils::GetDim(output_dims, 2);
+    auto ow = DimsFunctionUtils::GetDim(output_dims, 3);
+
+    const int group = param->group;
+    const int K     = input_dims[1] / group * param->kernels[0] * param->kernels[1];
+    const int M     = output_dims[1] / group;
+    const int N     = oh * ow;
+
+    // 1x1 conv reads the input as the gemm src directly
+    bool do_im2col = !(param->kernels[0] == 1 && param->kernels[1] == 1 && param->strides[0] == 1 &&
+                       param->strides[1] == 1 && param->pads[0] == 0 && param->pads[1] == 0 && param->pads[2] == 0 &&
+                       param->pads[3] == 0);
+    float *col_data = nullptr;
+    if (do_im2col) {
+        col_data = reinterpret_cast<float *>(context_->GetSharedWorkSpace((size_t)K * group * N * sizeof(float)));
+    }
+
+    auto gemm_func      = X86GemmInt8WeightNN<Float4, 4>;
+    auto post_func      = X86_Post_Exec<ActivationType_None, Float4, 4>;
+    if (arch_ == avx2) {
+        gemm_func = X86GemmInt8WeightNN<Float8, 8>;
+        post_func = X86_Post_Exec<ActivationType_None, Float8, 8>;
+        if (param->activation_type == ActivationType_ReLU) {
+            post_func = X86_Post_Exec<ActivationType_ReLU, Float8, 8>;
+        } else if (param->activation_type == ActivationType_ReLU6) {
+            post_func = X86_Post_Exec<ActivationType_ReLU6, Float8, 8>;
+        }
+    } else {
+        if (param->activation_type == ActivationType_ReLU) {
+            post_func = X86_Post_Exec<ActivationType_ReLU, Float4, 4>;
+        } else if (param->activation_type == ActivationType_ReLU6) {
+            post_func = X86_Post_Exec<ActivationType_ReLU6, Float4, 4>;
+        }
+    }
+
+    auto weight_data = buffer_weight_.force_to<int8_t *>();
+    auto scale_data  = buffer_scale_.force_to<float *>();
+    auto bias_data   = buffer_bias_.force_to<float *>();
+    for (int b = 0; b < output_dims[0]; b++) {
+        auto input_b  = input_data + b * input_dims[1] * ih * iw;
+        auto output_b = output_data + b * output_dims[1] * N;
+        auto src      = input_b;
+        if (do_im2col) {
+            X86_IM2COL(input_b, input_dims[1], ih, iw, param->kernels[1], param->kernels[0], param->pads[0],
+                       param->pads[1], param->pads[2], param->pads[3], param->strides[1], param->strides[0],
+                       param->dialations[1], param->dialations[0], col_data);
+            src = col_data;
+        }
+        for (int g = 0; g < group; g++) {
+            gemm_func(output_b + g * M * N, N, src + g * K * N, N, weight_data + g * M * K, scale_data + g * M,
+                      nullptr, M, N, K);
+        }
+        // bias and activation
+        post_func(output_b, bias_data, output_dims[1], N);
+    }
+
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -135,6 +135,22 @@ Status X86DeconvLayerCommon::Init(Context *context, LayerParam *param, LayerReso
     return TNN_OK;
 }
 
+// col buffer of all groups and the per thread packed gemm source
+size_t X86DeconvLayerCommon::GetWorkspaceSize(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param       = dynamic_cast<ConvLayerParam *>(param_);
+    auto input_dims  = inputs[0]->GetBlobDesc().dims;
+    auto output_dims = outputs[0]->GetBlobDesc().dims;
+
+    size_t col_offset =
+        param->kernels[0] * param->kernels[1] * input_dims[2] * input_dims[3] * (output_dims[1] / param->group);
+    int max_num_threads = OMP_MAX_THREADS_NUM_;
+    dim_t m_c           = conv_gemm_conf_.M_c_;
+    conv_ajust_m_blk_size(max_num_threads, input_dims[2] * input_dims[3], m_c);
+
+    size_t im2col_size = ROUND_UP(col_offset * param->group * sizeof(float), 32);
+    return im2col_size + ROUND_UP(m_c * conv_gemm_conf_.K_c_ * max_num_threads * sizeof(float), 32);
+}
+
 Status X86DeconvLayerCommon::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     Blob *input_blob  = inputs[0];
     Blob *output_blob = outputs[0];
@@ -20,7 +20,22 @@
 
 namespace TNN_NS {
 
-DECLARE_X86_ACC(Concat, LAYER_CONCAT);
+DECLARE_X86_ACC_WITH_FUNC(Concat, LAYER_CONCAT,
+                          virtual BlobAliasType GetOutputAlias(const std::vector<Blob *> &inputs,
+                                                               const std::vector<Blob *> &outputs) override;);
+
+// the inputs are consecutive in the nchw output if all dims before the axis are 1
+BlobAliasType X86ConcatLayerAcc::GetOutputAlias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<ConcatLayerParam *>(param_);
+    if (!param || outputs[0]->GetBlobDesc().data_type == DATA_TYPE_INT8) {
+        return BLOB_ALIAS_NONE;
+    }
+    const auto &dims = outputs[0]->GetBlobDesc().dims;
+    if (param->axis < 0 || param->axis >= dims.size()) {
+        return BLOB_ALIAS_NONE;
+    }
+    return DimsVectorUtils::Count(dims, 0, param->axis) == 1 ? BLOB_ALIAS_INPUT_REGIONS : BLOB_ALIAS_NONE;
+}
 
 Status X86ConcatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto param = dynamic_cast<ConcatLayerParam *>(param_);
@@ -74,9 +89,13 @@ Status X86ConcatLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
         int8_t *input_data          = handle_ptr<int8_t *>(inputs[i]->GetHandle());
         const int input_concat_axis = inputs[i]->GetBlobDesc().dims[axis];
         for (int n = 0; n < num_concats; ++n) {
-            memcpy(output_data + (n * output_concat_axis + output_concat_axis_offset) * concate_size * datasize,
-                   input_data + n * input_concat_axis * concate_size * datasize,
-                   input_concat_axis * concate_size * datasize);
+            int8_t *dst = output_data + (n * output_concat_axis + output_concat_axis_offset) * concate_size * datasize;
+            int8_t *src = input_data + n * input_concat_axis * concate_size * datasize;
+            // an input planned inside the output is already in place. after a reshape to smaller dims the planned
+            // regions are moved down in order, a region never overlaps the later ones.
+            if (dst != src) {
+                memmove(dst, src, input_concat_axis * concate_size * datasize);
+            }
         }
         output_concat_axis_offset += input_concat_axis;
     }
@@ -15,6 +15,7 @@
 #include "x86_conv_layer_acc.h"
 #include "tnn/device/x86/acc/compute/x86_compute.h"
 #include "tnn/device/x86/acc/convolution/x86_conv_layer_acc_factory.h"
+#include "tnn/device/x86/acc/convolution/x86_conv_layer_int8_weight.h"
 #include "tnn/interpreter/layer_resource_generator.h"
 
 namespace TNN_NS {
@@ -27,6 +28,13 @@ Status X86ConvLayerAcc::Init(Context *context, LayerParam *param, LayerResource
     CHECK_PARAM_NULL(conv_resource);
 
     Status ret;
+    // int8 weights of dynamic range quantized models are dequantized inside the gemm
+    if (X86ConvLayerInt8Weight::isPrefered(conv_param, conv_resource)) {
+        RETURN_ON_NEQ(X86LayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+        conv_acc_impl_ = std::make_shared<X86ConvLayerInt8Weight>();
+        return conv_acc_impl_->Init(context_, param_, resource_, inputs, outputs);
+    }
+
     if (conv_resource->filter_handle.GetDataType() == DATA_TYPE_HALF ||
         conv_resource->bias_handle.GetDataType() == DATA_TYPE_HALF) {
         LayerResource *fp32_res = nullptr;
@@ -41,8 +49,9 @@ Status X86ConvLayerAcc::Init(Context *context, LayerParam *param, LayerResource
         return ret;
     }
 
+    // a quantized conv may take a float input or give a float output when its int8 reformat is fused
     auto data_type = inputs[0]->GetBlobDesc().data_type;
-    if (data_type == DATA_TYPE_INT8) {
+    if (data_type == DATA_TYPE_INT8 || conv_param->quantized) {
         X86ConvLayerAccFactory::CreateImpInt8(inputs, outputs, param_, conv_acc_impl_);
     } else {
         X86ConvLayerAccFactory::CreateImpFP(inputs, outputs, param_, conv_acc_impl_);
@@ -70,6 +79,10 @@ Status X86ConvLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::
     }
 }
 
+size_t X86ConvLayerAcc::GetWorkspaceSize(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return conv_acc_impl_ ? conv_acc_impl_->GetWorkspaceSize(inputs, outputs) : 0;
+}
+
 REGISTER_X86_ACC(Conv, LAYER_CONVOLUTION);
 
 }   // namespace TNN_NS
\ No newline at end of file
@@ -163,7 +163,10 @@ Status X86CpuAdapterAcc::ConvertBlobForAdaptorAcc(const std::vector<Blob *> &dev
         auto device_blob = device_blobs[i];
         auto cpu_blob    = cpu_blobs[i];
 
+        // most cpu accs ignore bytes_offset, it is folded into the base for blobs planned inside another memory
         auto device_handle = device_blob->GetHandle();
+        device_handle.base = static_cast<char *>(device_handle.base) + device_handle.bytes_offset;
+        device_handle.bytes_offset = 0;
         cpu_blob->SetHandle(device_handle);
     }
     return status;
@@ -63,6 +63,10 @@ Status X86DeconvLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
     }
 }
 
+size_t X86DeconvLayerAcc::GetWorkspaceSize(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return conv_acc_impl_ ? conv_acc_impl_->GetWorkspaceSize(inputs, outputs) : 0;
+}
+
 REGISTER_X86_ACC(Deconv, LAYER_DECONVOLUTION);
 
 }
\ No newline at end of file
@@ -12,17 +12,211 @@
 // CONDITIONS OF ANY KIND, either express or implied. See the License for the
 // specific language governing permissions and limitations under the License.
 
+#include <algorithm>
+#include <cstring>
+
+#include "tnn/device/x86/acc/Float4.h"
 #include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/utils/bbox_util.h"
+#include "tnn/utils/dims_vector_utils.h"
 #include "tnn/utils/naive_compute.h"
+#include "tnn/utils/nms_utils.h"
+#include "tnn/utils/omp_utils.h"
 
 namespace TNN_NS {
 
 DECLARE_X86_ACC(DetectionOutput, LAYER_DETECTION_OUTPUT);
 
+// decode the shared location predictions of one image into soa boxes, 4 priors at a time
+static void DecodeBoxes(const float *loc_data, const float *prior_data, int num_priors, CodeType code_type,
+                        bool variance_encoded_in_target, BoxSoA &boxes) {
+    const float *var_data = prior_data + num_priors * 4;
+    const Float4 one(1.f);
+    const Float4 half(0.5f);
+    int p = 0;
+    for (; p + 3 < num_priors; p += 4) {
+        Float4x4 loc   = Float4x4::ld4u(loc_data + p * 4);
+        Float4x4 prior = Float4x4::ld4u(prior_data + p * 4);
+        Float4x4 var   = Float4x4::ld4u(var_data + p * 4);
+        Float4 l0, l1, l2, l3, px1, py1, px2, py2, v0 = one, v1 = one, v2 = one, v3 = one;
+        loc.get_lane(l0, 0);
+        loc.get_lane(l1, 1);
+        loc.get_lane(l2, 2);
+        loc.get_lane(l3, 3);
+        prior.get_lane(px1, 0);
+        prior.get_lane(py1, 1);
+        prior.get_lane(px2, 2);
+        prior.get_lane(py2, 3);
+        if (!variance_encoded_in_target) {
+            var.get_lane(v0, 0);
+            var.get_lane(v1, 1);
+            var.get_lane(v2, 2);
+            var.get_lane(v3, 3);
+        }
+        Float4 x1, y1, x2, y2;
+        if (code_type == PriorBoxParameter_CodeType_CENTER_SIZE) {
+            Float4 pw = px2 - px1;
+            Float4 ph = py2 - py1;
+            Float4 cx = v0 * l0 * pw + (px1 + px2) * half;
+            Float4 cy = v1 * l1 * ph + (py1 + py2) * half;
+            Float4 hw = Float4::exp(v2 * l2) * pw * half;
+            Float4 hh = Float4::exp(v3 * l3) * ph * half;
+            x1        = cx - hw;
+            y1        = cy - hh;
+            x2        = cx + hw;
+            y2        = cy + hh;
+        } else if (code_type == PriorBoxParameter_CodeType_CORNER_SIZE) {
+            Float4 pw = px2 - px1;
+            Float4 ph = py2 - py1;
+            x1        = px1 + v0 * l0 * pw;
+            y1        = py1 + v1 * l1 * ph;
+            x2        = px2 + v2 * l2 * pw;
+            y2        = py2 + v3 * l3 * ph;
+        } else {
+            x1 = px1 + v0 * l0;
+            y1 = py1 + v1 * l1;
+            x2 = px2 + v2 * l2;
+            y2 = py2 + v3 * l3;
+        }
+        Float4::saveu(boxes.x1.data() + p, x1);
+        Float4::saveu(boxes.y1.data() + p, y1);
+        Float4::saveu(boxes.x2.data() + p, x2);
+        Float4::saveu(boxes.y2.data() + p, y2);
+    }
+    for (; p < num_priors; ++p) {
+        const float *loc   = loc_data + p * 4;
+        const float *prior = prior_data + p * 4;
+        float var[4]       = {1.f, 1.f, 1.f, 1.f};
+        if (!variance_encoded_in_target) {
+            memcpy(var, var_data + p * 4, 4 * sizeof(float));
+        }
+        if (code_type == PriorBoxParameter_CodeType_CENTER_SIZE) {
+            float pw = prior[2] - prior[0];
+            float ph = prior[3] - prior[1];
+            float cx = var[0] * loc[0] * pw + (prior[0] + prior[2]) * 0.5f;
+            float cy = var[1] * loc[1] * ph + (prior[1] + prior[3]) * 0.5f;
+            float hw = std::exp(var[2] * loc[2]) * pw * 0.5f;
+            float hh = std::exp(var[3] * loc[3]) * ph * 0.5f;
+            boxes.x1[p] = cx - hw;
+            boxes.y1[p] = cy - hh;
+            boxes.x2[p] = cx + hw;
+            boxes.y2[p] = cy + hh;
+        } else if (code_type == PriorBoxParameter_CodeType_CORNER_SIZE) {
+            float pw    = prior[2] - prior[0];
+            float ph    = prior[3] - prior[1];
+            boxes.x1[p] = prior[0] + var[0] * loc[0] * pw;
+            boxes.y1[p] = prior[1] + var[1] * loc[1] * ph;
+            boxes.x2[p] = prior[2] + var[2] * loc[2] * pw;
+            boxes.y2[p] = prior[3] + var[3] * loc[3] * ph;
+        } else {
+            boxes.x1[p] = prior[0] + var[0] * loc[0];
+            boxes.y1[p] = prior[1] + var[1] * loc[1];
+            boxes.x2[p] = prior[2] + var[2] * loc[2];
+            boxes.y2[p] = prior[3] + var[3] * loc[3];
+        }
+    }
+    boxes.ComputeArea();
+}
+
 Status X86DetectionOutputLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     DetectionOutputLayerParam *param = dynamic_cast<DetectionOutputLayerParam *>(param_);
     CHECK_PARAM_NULL(param);
-    NaiveDetectionOutput(inputs, outputs, param);
+    // refinedet inputs and per class locations are left to the reference implementation
+    if (inputs.size() != 3 || !param->share_location || param->background_label_id == -1) {
+        NaiveDetectionOutput(inputs, outputs, param);
+        return TNN_OK;
+    }
+
+    const int num         = inputs[0]->GetBlobDesc().dims[0];
+    const int num_priors  = inputs[2]->GetBlobDesc().dims[2] / 4;
+    const int num_classes = param->num_classes;
+    const float *loc_data   = handle_ptr<const float *>(inputs[0]->GetHandle());
+    const float *conf_data  = handle_ptr<const float *>(inputs[1]->GetHandle());
+    const float *prior_data = handle_ptr<const float *>(inputs[2]->GetHandle());
+    const CodeType code_type = static_cast<CodeType>(param->code_type);
+    if (code_type < PriorBoxParameter_CodeType_CORNER || code_type > PriorBoxParameter_CodeType_CORNER_SIZE) {
+        return Status(TNNERR_PARAM_ERR, "DetectionOutput has invalid code type");
+    }
+
+    BoxSoA boxes;
+    boxes.Resize(num_priors);
+    std::vector<float> scores(num_classes * num_priors);
+    std::vector<std::vector<int>> indices(num_classes);
+    // image, label, score, xmin, ymin, xmax, ymax for each detection
+    std::vector<float> detections;
+
+    for (int n = 0; n < num; ++n) {
+        DecodeBoxes(loc_data + n * num_priors * 4, prior_data, num_priors, code_type,
+                    param->variance_encoded_in_target, boxes);
+
+        // scores are transposed to class major so that each class is selected from contiguous memory
+        const float *conf = conf_data + n * num_priors * num_classes;
+        OMP_PARALLEL_FOR_
+        for (int p = 0; p < num_priors; ++p) {
+            for (int c = 0; c < num_classes; ++c) {
+                scores[c * num_priors + p] = conf[p * num_classes + c];
+            }
+        }
+
+        OMP_PARALLEL_FOR_DYNAMIC_
+        for (int c = 0; c < num_classes; ++c) {
+            indices[c].clear();
+            if (c == param->background_label_id) {
+                continue;
+            }
+            NMSUtils::NMS(boxes, scores.data() + c * num_priors, param->confidence_threshold, param->nms_param.top_k,
+                          param->nms_param.nms_threshold, indices[c], -1, param->eta);
+        }
+
+        int num_det = 0;
+        for (const auto &label_indices : indices) {
+            num_det += static_cast<int>(label_indices.size());
+        }
+        if (param->keep_top_k > -1 && num_det > param->keep_top_k) {
+            // same order and sort as the reference implementation so that ties are broken the same way
+            std::vector<std::pair<float, std::pair<int, int>>> score_index_pairs;
+            score_index_pairs.reserve(num_det);
+            for (int c = 0; c < num_classes; ++c) {
+                for (const int idx : indices[c]) {
+                    score_index_pairs.push_back(std::make_pair(scores[c * num_priors + idx], std::make_pair(c, idx)));
+                }
+            }
+            std::sort(score_index_pairs.begin(), score_index_pairs.end(), SortScorePairDescend<std::pair<int, int>>);
+            score_index_pairs.resize(param->keep_top_k);
+            std::vector<std::vector<int>> new_indices(num_classes);
+            for (const auto &pair : score_index_pairs) {
+                new_indices[pair.second.first].push_back(pair.second.second);
+            }
+            indices.swap(new_indices);
+        }
+
+        for (int c = 0; c < num_classes; ++c) {
+            for (const int idx : indices[c]) {
+                const float detection[7] = {static_cast<float>(n), static_cast<float>(c),
+                                            scores[c * num_priors + idx], boxes.x1[idx], boxes.y1[idx],
+                                            boxes.x2[idx], boxes.y2[idx]};
+                detections.insert(detections.end(), detection, detection + 7);
+            }
+        }
+    }
+
+    Blob *output_blob = outputs[0];
+    auto &output_dims = output_blob->GetBlobDesc().dims;
+    float *top_data   = handle_ptr<float *>(output_blob->GetHandle());
+    memset(top_data, 0, DimsVectorUtils::Count(output_dims) * sizeof(float));
+    const int num_kept = static_cast<int>(detections.size()) / 7;
+    if (num_kept == 0) {
+        LOGD("%s:Couldn't find any detections.", __FUNCTION__);
+        // fake results per image
+        output_dims[2] = num;
+        std::fill(top_data, top_data + DimsVectorUtils::Count(output_dims), -1.f);
+        for (int n = 0; n < num; ++n) {
+            top_data[n * 7] = static_cast<float>(n);
+        }
+    } else {
+        output_dims[2] = num_kept;
+        memcpy(top_data, detections.data(), detections.size() * sizeof(float));
+    }
     return TNN_OK;
 }
 
@@ -0,0 +1,118 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <cstring>
+
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_X86_ACC(EffectiveTransformer, LAYER_EFFECTIVE_TRANSFORMER);
+
+// the packed index of each token, -1 for the padding. returns the number of tokens.
+template <typename T>
+static int BuildTokenIndex(const T *mask, int count, int *token_index) {
+    int num_tokens = 0;
+    for (int i = 0; i < count; ++i) {
+        token_index[i] = mask[i] != T(0) ? num_tokens++ : -1;
+    }
+    // keep one token for a batch of padding only, so that the packed blobs are never empty
+    if (num_tokens == 0 && count > 0) {
+        token_index[0] = num_tokens++;
+    }
+    return num_tokens;
+}
+
+Status X86EffectiveTransformerLayerAcc::DoForward(const std::vector<Blob *> &inputs,
+                                                  const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<EffectiveTransformerLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+    if (inputs.size() < 2) {
+        return Status(TNNERR_PARAM_ERR, "EffectiveTransformer has invalid inputs");
+    }
+
+    const auto &token_dims = inputs[1]->GetBlobDesc().dims;
+    const int batch        = token_dims[0];
+    const int seq_len      = token_dims[1];
+    const int count        = batch * seq_len;
+    const auto &data_dims  = inputs[0]->GetBlobDesc().dims;
+    const size_t row_bytes =
+        DimsVectorUtils::Count(data_dims, 2) * DataTypeUtils::GetBytesSize(inputs[0]->GetBlobDesc().data_type);
+
+    if (param->is_remove_padding) {
+        int *token_index = nullptr;
+        int num_tokens   = 0;
+        if (outputs.size() >= 2) {
+            token_index    = handle_ptr<int *>(outputs[1]->GetHandle());
+            auto mask_type = inputs[1]->GetBlobDesc().data_type;
+            if (mask_type == DATA_TYPE_INT32) {
+                num_tokens = BuildTokenIndex(handle_ptr<const int *>(inputs[1]->GetHandle()), count, token_index);
+            } else if (mask_type == DATA_TYPE_FLOAT) {
+                num_tokens = BuildTokenIndex(handle_ptr<const float *>(inputs[1]->GetHandle()), count, token_index);
+            } else {
+                return Status(TNNERR_LAYER_ERR, "EffectiveTransformer only supports int32 or float mask");
+            }
+        } else {
+            token_index = handle_ptr<int *>(inputs[1]->GetHandle());
+            for (int i = 0; i < count; ++i) {
+                num_tokens += token_index[i] >= 0;
+            }
+        }
+
+        // the data may be broadcast along batch or seq_len, e.g. the position embedding
+        if (data_dims.size() < 2 || (data_dims[0] != batch && data_dims[0] != 1) ||
+            (data_dims[1] != seq_len && data_dims[1] != 1)) {
+            return Status(TNNERR_LAYER_ERR, "EffectiveTransformer remove padding needs data of [batch, seq_len, ...]");
+        }
+        const int batch_stride = data_dims[0] == 1 ? 0 : data_dims[1];
+        const int seq_stride   = data_dims[1] == 1 ? 0 : 1;
+
+        auto &output_dims = outputs[0]->GetBlobDesc().dims;
+        output_dims       = {1, num_tokens};
+        output_dims.insert(output_dims.end(), data_dims.begin() + 2, data_dims.end());
+
+        const char *src = handle_ptr<const char *>(inputs[0]->GetHandle());
+        char *dst       = handle_ptr<char *>(outputs[0]->GetHandle());
+        OMP_PARALLEL_FOR_
+        for (int i = 0; i < count; ++i) {
+            const int index = token_index[i];
+            if (index >= 0) {
+                const int b = i / seq_len;
+                const int s = i % seq_len;
+                memcpy(dst + index * row_bytes, src + (b * batch_stride + s * seq_stride) * row_bytes, row_bytes);
+            }
+        }
+    } else {
+        const int *token_index = handle_ptr<const int *>(inputs[1]->GetHandle());
+        const char *src        = handle_ptr<const char *>(inputs[0]->GetHandle());
+        char *dst              = handle_ptr<char *>(outputs[0]->GetHandle());
+        OMP_PARALLEL_FOR_
+        for (int i = 0; i < count; ++i) {
+            const int index = token_index[i];
+            if (index >= 0) {
+                memcpy(dst + i * row_bytes, src + index * row_bytes, row_bytes);
+            } else {
+                memset(dst + i * row_bytes, 0, row_bytes);
+            }
+        }
+    }
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(EffectiveTransformer, LAYER_EFFECTIVE_TRANSFORMER);
+
+}  // namespace TNN_NS
@@ -18,7 +18,14 @@
 
 namespace TNN_NS {
 
-DECLARE_X86_ACC(Flatten, LAYER_FLATTEN);
+DECLARE_X86_ACC_WITH_FUNC(Flatten, LAYER_FLATTEN,
+                          virtual BlobAliasType GetOutputAlias(const std::vector<Blob *> &inputs,
+                                                               const std::vector<Blob *> &outputs) override;);
+
+// the nchw data is the same, only the dims change
+BlobAliasType X86FlattenLayerAcc::GetOutputAlias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return BLOB_ALIAS_VIEW;
+}
 
 Status X86FlattenLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto param = dynamic_cast<FlattenLayerParam *>(param_);
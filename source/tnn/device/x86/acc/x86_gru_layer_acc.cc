@@ -0,0 +1,361 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/device/x86/acc/x86_gru_layer_acc.h"
+
+#include <cmath>
+
+#include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/x86_util.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+// gates of one batch row are [z, r, h], each of hidden_size.
+// z = sigmoid(z + bz), r = sigmoid(r + br), and reset_h = r * h_t if reset_h is not null
+static void X86GRUResetGate(float *gates, const float *b, const float *h_t, float *reset_h, int hidden_size) {
+    float *z = gates;
+    float *r = gates + hidden_size;
+    const float *bz = b;
+    const float *br = b + hidden_size;
+
+    int len_vec = hidden_size / 4 * 4;
+    for (int i = 0; i < len_vec; i += 4) {
+        Float4 Z = Float4::sigmoid(Float4::loadu(z + i) + Float4::loadu(bz + i));
+        Float4 R = Float4::sigmoid(Float4::loadu(r + i) + Float4::loadu(br + i));
+        Float4::saveu(z + i, Z);
+        Float4::saveu(r + i, R);
+        if (reset_h) {
+            Float4::saveu(reset_h + i, R * Float4::loadu(h_t + i));
+        }
+    }
+    for (int i = len_vec; i < hidden_size; i++) {
+        z[i] = 1.f / (1.f + exp(-(z[i] + bz[i])));
+        r[i] = 1.f / (1.f + exp(-(r[i] + br[i])));
+        if (reset_h) {
+            reset_h[i] = r[i] * h_t[i];
+        }
+    }
+}
+
+// n = tanh(h + bh + r * (hn + rbh)) if hn is not null, else tanh(h + bh + rbh), then h_t = n + z * (h_t - n)
+static void X86GRUUpdate(const float *gates, const float *b, const float *rb, const float *hn, float *h_t, float *y,
+                         int hidden_size) {
+    const float *z  = gates;
+    const float *r  = gates + hidden_size;
+    const float *h  = gates + 2 * hidden_size;
+    const float *bh = b + 2 * hidden_size;
+
+    int len_vec = hidden_size / 4 * 4;
+    for (int i = 0; i < len_vec; i += 4) {
+        Float4 N = Float4::loadu(h + i) + Float4::loadu(bh + i);
+        if (hn) {
+            N = N + Float4::loadu(r + i) * (Float4::loadu(hn + i) + Float4::loadu(rb + i));
+        } else {
+            N = N + Float4::loadu(rb + i);
+        }
+        N = Float4::tanh(N);
+        Float4 H = N + Float4::loadu(z + i) * (Float4::loadu(h_t + i) - N);
+        Float4::saveu(h_t + i, H);
+        Float4::saveu(y + i, H);
+    }
+    for (int i = len_vec; i < hidden_size; i++) {
+        float N = h[i] + bh[i] + (hn ? r[i] * (hn[i] + rb[i]) : rb[i]);
+        N       = tanh(N);
+        float H = N + z[i] * (h_t[i] - N);
+        h_t[i]  = H;
+        y[i]    = H;
+    }
+}
+
+void X86GRUONNXLayerAcc::GRUGemm(int M, int N, int K, const float *w, const float *x, float *gates, int ldc,
+                                 bool accumulate, float *gemm_buf) {
+    if (accumulate) {
+        conv_sgemm_tn_col_major_prepack_a(M, N, K, w, K, x, K, gates, ldc, nullptr, ActivationType_None, gemm_buf,
+                                          conv_gemm_conf_);
+    } else {
+        RawBuffer fake_bias(N * sizeof(float));
+        float *fake_bias_ptr = fake_bias.force_to<float *>();
+        conv_sgemm_tn_col_major_prepack_a(M, N, K, w, K, x, K, gates, ldc, fake_bias_ptr, ActivationType_None,
+                                          gemm_buf, conv_gemm_conf_);
+    }
+}
+
+size_t X86GRUONNXLayerAcc::GRUWorkspaceSize(int seq_len, int batch_size, int hidden_size) {
+    int k_c     = conv_gemm_conf_.K_c_;
+    int n_block = conv_gemm_conf_.n_block_;
+    int N       = seq_len * batch_size;
+    int M       = 3 * hidden_size;
+    // three temp buf: gemm_buf, gates_buf and hidden_buf
+    size_t gemm_buf_size   = ROUND_UP(k_c * ROUND_UP(N, n_block) * sizeof(float), 32);
+    size_t gates_buf_size  = ROUND_UP(N * M * sizeof(float), 32);
+    size_t hidden_buf_size = ROUND_UP(batch_size * hidden_size * sizeof(float), 32);
+    return gemm_buf_size + gates_buf_size + hidden_buf_size;
+}
+
+Status X86GRUONNXLayerAcc::GRUOneDirection(const float *x, float *y, const float *w, const float *r, const float *b,
+                                           const float *rb, float *h_t, int seq_len, int batch_size,
+                                           int input_size, int hidden_size, int reverse, float *workspace) {
+    auto layer_param               = dynamic_cast<GRUONNXLayerParam *>(param_);
+    const bool linear_before_reset = layer_param->linear_before_reset != 0;
+
+    int k_c     = conv_gemm_conf_.K_c_;
+    int n_block = conv_gemm_conf_.n_block_;
+
+    // sgemm for weight tensor, the input projection of the whole sequence in one gemm
+    // weights: [3*hidden_size, input_size]
+    // inputs: [seq_len, batch, input_size]
+    int N = seq_len * batch_size;
+    int M = 3 * hidden_size;
+
+    size_t gemm_buf_size  = ROUND_UP(k_c * ROUND_UP(N, n_block) * sizeof(float), 32);
+    size_t gates_buf_size = ROUND_UP(N * M * sizeof(float), 32);
+    float *gemm_buf       = workspace;
+    float *gates_buf      = workspace + gemm_buf_size / sizeof(float);
+    // r * h_t, or the recurrence of the hidden gate if linear_before_reset
+    float *hidden_buf = gates_buf + gates_buf_size / sizeof(float);
+
+    GRUGemm(M, N, input_size, w, x, gates_buf, M, false, gemm_buf);
+
+    const float *r_zr = r;
+    const float *r_h  = r + rzr_pack_size_;
+    for (int t = 0; t < seq_len; t++) {
+        int ti       = reverse ? seq_len - 1 - t : t;
+        auto gates_t = gates_buf + ti * batch_size * M;
+        auto y_t     = y + ti * batch_size * hidden_size;
+
+        // sgemm for recurrence weight of z and r, accumulated into the gates
+        // weights: [2*hidden_size, hidden_size]
+        // inputs: [batch, hidden_size]
+        GRUGemm(2 * hidden_size, batch_size, hidden_size, r_zr, h_t, gates_t, M, true, gemm_buf);
+
+        if (linear_before_reset) {
+            GRUGemm(hidden_size, batch_size, hidden_size, r_h, h_t, hidden_buf, hidden_size, false, gemm_buf);
+            OMP_PARALLEL_FOR_GUIDED_
+            for (int i = 0; i < batch_size; i++) {
+                auto gates_b = gates_t + i * M;
+                X86GRUResetGate(gates_b, b, h_t + i * hidden_size, nullptr, hidden_size);
+                X86GRUUpdate(gates_b, b, rb, hidden_buf + i * hidden_size, h_t + i * hidden_size,
+                             y_t + i * hidden_size, hidden_size);
+            }
+        } else {
+            OMP_PARALLEL_FOR_GUIDED_
+            for (int i = 0; i < batch_size; i++) {
+                X86GRUResetGate(gates_t + i * M, b, h_t + i * hidden_size, hidden_buf + i * hidden_size,
+                                hidden_size);
+            }
+            // recurrence of the hidden gate on the reset hidden, accumulated into the gates
+            GRUGemm(hidden_size, batch_size, hidden_size, r_h, hidden_buf, gates_t + 2 * hidden_size, M, true,
+                    gemm_buf);
+            OMP_PARALLEL_FOR_GUIDED_
+            for (int i = 0; i < batch_size; i++) {
+                X86GRUUpdate(gates_t + i * M, b, rb, nullptr, h_t + i * hidden_size, y_t + i * hidden_size,
+                             hidden_size);
+            }
+        }
+    }
+    return TNN_OK;
+}
+
+X86GRUONNXLayerAcc::~X86GRUONNXLayerAcc() {}
+
+Status X86GRUONNXLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
+                                const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto status = X86LayerAcc::Init(context, param, resource, inputs, outputs);
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    if (inputs.size() < 4) {
+        return Status(TNNERR_LAYER_ERR, "GRU has invalid inputs");
+    }
+    for (int i = 1; i < 4; i++) {
+        if (inputs[i]->GetBlobDesc().data_type != DATA_TYPE_FLOAT) {
+            return Status(TNNERR_LAYER_ERR, "GRU on x86 only supports float weights");
+        }
+    }
+
+    RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
+    RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
+
+    return TNN_OK;
+}
+
+Status X86GRUONNXLayerAcc::allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    // weights for gates, [num_direction, 3 * hidden_size, input_size]
+    auto w_dims          = inputs[1]->GetBlobDesc().dims;
+    int w_direction_size = DimsVectorUtils::Count(w_dims, 1);
+    float *w_ptr         = handle_ptr<float *>(inputs[1]->GetHandle());
+
+    // recurrence weights, [num_direction, 3 * hidden_size, hidden_size]
+    auto r_dims          = inputs[2]->GetBlobDesc().dims;
+    int r_direction_size = DimsVectorUtils::Count(r_dims, 1);
+    float *r_ptr         = handle_ptr<float *>(inputs[2]->GetHandle());
+
+    int k_c         = conv_gemm_conf_.K_c_;
+    int m_block     = conv_gemm_conf_.m_block_;
+    int hidden_size = r_dims[2];
+
+    // the rows keep the onnx order z, r, h, the gates of one timestep are contiguous per gate
+    w_pack_size_ = ROUND_UP(w_dims[2], k_c) * ROUND_UP(w_dims[1], m_block);
+    // align pointer of packed weights, since gemm use aligned load for input A
+    RawBuffer w_temp_buffer(w_dims[0] * w_pack_size_ * sizeof(float), 32);
+    for (int d = 0; d < w_dims[0]; d++) {
+        conv_pack_col_a_t(w_dims[1], w_dims[2], w_ptr + d * w_direction_size, w_dims[2],
+                          w_temp_buffer.force_to<float *>() + d * w_pack_size_, conv_gemm_conf_);
+    }
+
+    // r and z are packed apart from h, since h is multiplied after the reset gate
+    rzr_pack_size_     = ROUND_UP(hidden_size, k_c) * ROUND_UP(2 * hidden_size, m_block);
+    rh_pack_size_      = ROUND_UP(hidden_size, k_c) * ROUND_UP(hidden_size, m_block);
+    size_t r_pack_size = rzr_pack_size_ + rh_pack_size_;
+    RawBuffer r_temp_buffer(r_dims[0] * r_pack_size * sizeof(float), 32);
+    for (int d = 0; d < r_dims[0]; d++) {
+        float *r_src = r_ptr + d * r_direction_size;
+        float *r_dst = r_temp_buffer.force_to<float *>() + d * r_pack_size;
+        conv_pack_col_a_t(2 * hidden_size, hidden_size, r_src, hidden_size, r_dst, conv_gemm_conf_);
+        conv_pack_col_a_t(hidden_size, hidden_size, r_src + 2 * hidden_size * hidden_size, hidden_size,
+                          r_dst + rzr_pack_size_, conv_gemm_conf_);
+    }
+
+    w_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+    r_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+    buffer_w_ = w_temp_buffer;
+    buffer_r_ = r_temp_buffer;
+
+    return TNN_OK;
+}
+
+Status X86GRUONNXLayerAcc::allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    // bias for gate and recurrence, [num_directions, 6*hidden_size]
+    auto b_dims     = inputs[3]->GetBlobDesc().dims;
+    int hidden_size = b_dims[1] / 6;
+    RawBuffer b_temp_buffer(b_dims[0] * 3 * hidden_size * sizeof(float));
+    RawBuffer rb_temp_buffer(b_dims[0] * hidden_size * sizeof(float));
+
+    float *b_ptr = handle_ptr<float *>(inputs[3]->GetHandle());
+    for (int d = 0; d < b_dims[0]; d++) {
+        float *wb_d   = b_ptr + d * b_dims[1];
+        float *rb_d   = wb_d + 3 * hidden_size;
+        float *b_dst  = b_temp_buffer.force_to<float *>() + d * 3 * hidden_size;
+        float *rb_dst = rb_temp_buffer.force_to<float *>() + d * hidden_size;
+
+        // z and r add both bias, Rb[h] is kept apart
+        for (int i = 0; i < 2 * hidden_size; i++) {
+            b_dst[i] = wb_d[i] + rb_d[i];
+        }
+        memcpy(b_dst + 2 * hidden_size, wb_d + 2 * hidden_size, hidden_size * sizeof(float));
+        memcpy(rb_dst, rb_d + 2 * hidden_size, hidden_size * sizeof(float));
+    }
+    b_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+    rb_temp_buffer.SetDataType(DATA_TYPE_FLOAT);
+    buffer_b_  = b_temp_buffer;
+    buffer_rb_ = rb_temp_buffer;
+
+    return TNN_OK;
+}
+
+Status X86GRUONNXLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto layer_param   = dynamic_cast<GRUONNXLayerParam *>(param_);
+    int num_directions = layer_param->direction >= 2 ? 2 : 1;
+
+    const auto input_dims  = inputs[0]->GetBlobDesc().dims;
+    const auto seq_len     = input_dims[0];                          // length of sequence
+    const auto batch       = input_dims[1];                          // batch_size
+    const auto input_size  = DimsVectorUtils::Count(input_dims, 2);  // input dimension
+    const auto hidden_size = layer_param->hidden_size;               // output dimension
+
+    //X shape [sequence batch_size input_size]
+    float *x = handle_ptr<float *>(inputs[0]->GetHandle());
+    //Y shape [sequence batch_size num_directions *hidden_size]
+    float *y = handle_ptr<float *>(outputs[0]->GetHandle());
+
+    const float *w  = buffer_w_.force_to<float *>();
+    const float *r  = buffer_r_.force_to<float *>();
+    const float *b  = buffer_b_.force_to<float *>();
+    const float *rb = buffer_rb_.force_to<float *>();
+
+    // workspace of each direction, then y of both directions [num_directions sequence batch_size hidden_size],
+    // then h_t if the layer has no Y_h output
+    const size_t direction_workspace_size = GRUWorkspaceSize(seq_len, batch, hidden_size);
+    const size_t y_size = num_directions == 2 ? ROUND_UP(2 * seq_len * batch * hidden_size * sizeof(float), 32) : 0;
+    const size_t h_size = ROUND_UP(num_directions * batch * hidden_size * sizeof(float), 32);
+    char *workspace     = reinterpret_cast<char *>(
+        context_->GetSharedWorkSpace(num_directions * direction_workspace_size + y_size + h_size));
+    auto workspace0 = reinterpret_cast<float *>(workspace);
+    auto workspace1 = reinterpret_cast<float *>(workspace + direction_workspace_size);
+
+    //initial_h, initial value of the hidden, If not specified - assumed to be 0. shape [num_directions, batch_size, hidden_size]
+    float *h_t = outputs.size() >= 2
+                     ? handle_ptr<float *>(outputs[1]->GetHandle())
+                     : reinterpret_cast<float *>(workspace + num_directions * direction_workspace_size + y_size);
+    if (inputs.size() >= 5) {
+        memcpy(h_t, handle_ptr<float *>(inputs[4]->GetHandle()), num_directions * batch * hidden_size * sizeof(float));
+    } else {
+        memset(h_t, 0, num_directions * batch * hidden_size * sizeof(float));
+    }
+
+    if (layer_param->direction == 0 || layer_param->direction == 1) {
+        return GRUOneDirection(x, y, w, r, b, rb, h_t, seq_len, batch, input_size, hidden_size,
+                               layer_param->direction, workspace0);
+    } else if (layer_param->direction == 2) {
+        auto y0 = reinterpret_cast<float *>(workspace + num_directions * direction_workspace_size);
+        auto y1 = y0 + seq_len * batch * hidden_size;
+
+        auto w1   = w + w_pack_size_;
+        auto r1   = r + rzr_pack_size_ + rh_pack_size_;
+        auto b1   = b + 3 * hidden_size;
+        auto rb1  = rb + hidden_size;
+        auto h_t1 = h_t + batch * hidden_size;
+        Status status0, status1;
+        // the directions are independent, each one can run on its own thread with its own workspace.
+        // the loops inside a direction are not split any more then, so only do it when a timestep is small.
+        const bool parallel_directions = OMP_MAX_THREADS_NUM_ >= 2 && batch * 3 * hidden_size <= 16 * 1024;
+        if (parallel_directions) {
+            OMP_PARALLEL_SECTIONS_
+            {
+                OMP_SECTION_
+                {
+                    status0 = GRUOneDirection(x, y0, w, r, b, rb, h_t, seq_len, batch, input_size, hidden_size, 0,
+                                              workspace0);
+                }
+                OMP_SECTION_
+                {
+                    status1 = GRUOneDirection(x, y1, w1, r1, b1, rb1, h_t1, seq_len, batch, input_size,
+                                              hidden_size, 1, workspace1);
+                }
+            }
+        } else {
+            status0 = GRUOneDirection(x, y0, w, r, b, rb, h_t, seq_len, batch, input_size, hidden_size, 0,
+                                      workspace0);
+            status1 = GRUOneDirection(x, y1, w1, r1, b1, rb1, h_t1, seq_len, batch, input_size, hidden_size, 1,
+                                      workspace1);
+        }
+        RETURN_ON_NEQ(status0, TNN_OK);
+        RETURN_ON_NEQ(status1, TNN_OK);
+
+        //transpose [num_directions sequence batch_size hidden_size] to [sequence batch_size num_directions*hidden_size]
+        for (int i = 0; i < seq_len * batch; i++) {
+            auto y_data = y + i * num_directions * hidden_size;
+            memcpy(y_data, y0 + i * hidden_size, hidden_size * sizeof(float));
+            memcpy(y_data + hidden_size, y1 + i * hidden_size, hidden_size * sizeof(float));
+        }
+    } else {
+        return Status(TNNERR_PARAM_ERR, "GRUONNX has invalid direction param");
+    }
+
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(GRUONNX, LAYER_GRUONNX);
+}  // namespace TNN_NS
@@ -0,0 +1,60 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_SOURCE_TNN_DEVICE_X86_X86_GRU_LAYER_ACC_H_
+#define TNN_SOURCE_TNN_DEVICE_X86_X86_GRU_LAYER_ACC_H_
+
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/device/x86/acc/compute/jit/conv_sgemm_driver.h"
+
+namespace TNN_NS {
+
+class X86GRUONNXLayerAcc : public X86LayerAcc {
+public:
+    virtual ~X86GRUONNXLayerAcc();
+
+    Status Init(Context *context, LayerParam *param, LayerResource *resource, const std::vector<Blob *> &inputs,
+                const std::vector<Blob *> &outputs) override;
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+    virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual Status allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
+protected:
+    // @brief workspace of one direction: gemm buffer, gates of all timesteps and the recurrent hidden gate
+    size_t GRUWorkspaceSize(int seq_len, int batch_size, int hidden_size);
+    Status GRUOneDirection(const float *x, float *y, const float *w, const float *r, const float *b,
+                           const float *rb, float *h_t, int seq_len, int batch_size, int input_size,
+                           int hidden_size, int reverse, float *workspace);
+
+    // gates = x * w^T, gates += x * w^T if accumulate, ldc is the row stride of gates
+    void GRUGemm(int M, int N, int K, const float *w, const float *x, float *gates, int ldc, bool accumulate,
+                 float *gemm_buf);
+
+    // packed W[zrh] of each direction
+    RawBuffer buffer_w_;
+    // packed R[zr] followed by packed R[h] of each direction
+    RawBuffer buffer_r_;
+    // Wb[zr] + Rb[zr] and Wb[h] of each direction
+    RawBuffer buffer_b_;
+    // Rb[h] of each direction, it goes inside the reset gate
+    RawBuffer buffer_rb_;
+    size_t w_pack_size_   = 0;
+    size_t rzr_pack_size_ = 0;
+    size_t rh_pack_size_  = 0;
+    conv_gemm_config<float, float, float> conv_gemm_conf_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_DEVICE_X86_X86_GRU_LAYER_ACC_H_
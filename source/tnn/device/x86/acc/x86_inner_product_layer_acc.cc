@@ -56,6 +56,9 @@ Status X86InnerProductLayerAcc::Init(Context *context, LayerParam *param, LayerR
 
     auto res = dynamic_cast<InnerProductLayerResource *>(resource);
     CHECK_PARAM_NULL(res);
+    if (param->dynamic_range_quantized && res->weight_handle.GetDataType() == DATA_TYPE_INT8) {
+        impl_ = InnerProductGemmInt8Weight;
+    }
 
     Status ret;
     if (res->weight_handle.GetDataType() == DATA_TYPE_HALF) {
@@ -92,6 +95,25 @@ Status X86InnerProductLayerAcc::allocateBufferWeight(const std::vector<Blob *> &
     auto input_dims   = inputs[0]->GetBlobDesc().dims;
     auto output_dims  = outputs[0]->GetBlobDesc().dims;
 
+    if (!buffer_weight_.GetBytesSize() && impl_ == InnerProductGemmInt8Weight) {
+        // share the int8 weights of resource, [oc, ic * h * w]
+        buffer_weight_ = res->weight_handle;
+
+        auto scale_handle = res->scale_handle;
+        if (scale_handle.GetDataType() == DATA_TYPE_HALF)
+            scale_handle = ConvertHalfHandle(scale_handle);
+        int oc          = DimsVectorUtils::Count(output_dims, 1);
+        int scale_count = scale_handle.GetDataCount();
+        if (scale_count != oc && scale_count != 1) {
+            LOGE("Error: innerproduct weight scale count %d mismatch output channel %d\n", scale_count, oc);
+            return Status(TNNERR_MODEL_ERR, "innerproduct weight scale count is invalid");
+        }
+        buffer_scale_ = RawBuffer(oc * sizeof(float));
+        for (int i = 0; i < oc; i++) {
+            buffer_scale_.force_to<float *>()[i] = scale_handle.force_to<float *>()[scale_count == 1 ? 0 : i];
+        }
+    }
+
     if (!buffer_weight_.GetBytesSize()) {
         if (res->weight_handle.GetDataType() == DATA_TYPE_FLOAT) {
             if (impl_ == InnerProductSgemv) {
@@ -249,6 +271,16 @@ Status X86InnerProductLayerAcc::DoForward(const std::vector<Blob *> &inputs, con
 
         if (impl_ == InnerProductSgemv) {
             X86SgemvFunc(output_data, input_data, weight_data, bias_data, input_dims, output_dims);
+        } else if (impl_ == InnerProductGemmInt8Weight) {
+            auto X86GemmInt8WeightFunc = X86GemmInt8WeightNT<Float4, 4>;
+            if (arch_ == avx2) {
+                X86GemmInt8WeightFunc = X86GemmInt8WeightNT<Float8, 8>;
+            }
+            int K = DimsVectorUtils::Count(input_dims, 1);
+            int N = input_dims[0];
+            int M = DimsVectorUtils::Count(output_dims, 1);
+            X86GemmInt8WeightFunc(output_data, M, input_data, K, buffer_weight_.force_to<int8_t *>(),
+                                  buffer_scale_.force_to<float *>(), bias_data, M, N, K, false);
         } else {
             int k_c = conv_gemm_conf_.K_c_;
             int n_block = conv_gemm_conf_.n_block_;
@@ -21,6 +21,8 @@
 enum InnerProductCompute {
     InnerProductSgemv = 0x0000,
     InnerProductSgemm = 0x0001,
+    // int8 weight of dynamic range quantized models
+    InnerProductGemmInt8Weight = 0x0002,
 };
 
 namespace TNN_NS {
@@ -0,0 +1,94 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <cstring>
+
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/interpreter/raw_buffer.h"
+#include "tnn/utils/data_type_utils.h"
+#include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+class X86KVCacheLayerAcc : public X86LayerAcc {
+public:
+    virtual ~X86KVCacheLayerAcc(){};
+    virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+    virtual Status ResetState() override;
+
+private:
+    // [outer, max_length, inner], the first length_ positions are cached
+    RawBuffer cache_;
+    int length_         = 0;
+    int outer_          = 0;
+    size_t inner_bytes_ = 0;
+};
+
+Status X86KVCacheLayerAcc::ResetState() {
+    length_ = 0;
+    return TNN_OK;
+}
+
+Status X86KVCacheLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<KVCacheLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+
+    const auto &input_dims   = inputs[0]->GetBlobDesc().dims;
+    const int axis           = param->axis < 0 ? param->axis + (int)input_dims.size() : param->axis;
+    const int max_length     = param->max_length;
+    const int outer          = DimsVectorUtils::Count(input_dims, 0, axis);
+    const int step           = input_dims[axis];
+    const size_t inner_bytes = DimsVectorUtils::Count(input_dims, axis + 1) *
+                               DataTypeUtils::GetBytesSize(inputs[0]->GetBlobDesc().data_type);
+
+    // another batch size starts over with an empty cache
+    if (outer != outer_ || inner_bytes != inner_bytes_) {
+        cache_       = RawBuffer(outer * max_length * inner_bytes);
+        outer_       = outer;
+        inner_bytes_ = inner_bytes;
+        length_      = 0;
+    }
+    if (length_ + step > max_length) {
+        LOGE("KVCache is full: %d positions cached, %d new, max_length %d\n", length_, step, max_length);
+        return Status(TNNERR_LAYER_ERR, "KVCache is full, Instance::ResetState is needed for a new sequence");
+    }
+
+    // append the new positions in place
+    const size_t cache_stride = max_length * inner_bytes;
+    const size_t step_bytes   = step * inner_bytes;
+    const char *src           = handle_ptr<const char *>(inputs[0]->GetHandle());
+    char *cache               = cache_.force_to<char *>();
+    for (int o = 0; o < outer; ++o) {
+        memcpy(cache + o * cache_stride + length_ * inner_bytes, src + o * step_bytes, step_bytes);
+    }
+    length_ += step;
+
+    // the output holds the cached positions only, the layers after it are reshaped in the forward
+    auto &output_dims = outputs[0]->GetBlobDesc().dims;
+    output_dims       = input_dims;
+    output_dims[axis] = length_;
+
+    const size_t length_bytes = length_ * inner_bytes;
+    char *dst                 = handle_ptr<char *>(outputs[0]->GetHandle());
+    OMP_PARALLEL_FOR_
+    for (int o = 0; o < outer; ++o) {
+        memcpy(dst + o * length_bytes, cache + o * cache_stride, length_bytes);
+    }
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(KVCache, LAYER_KV_CACHE);
+
+}  // namespace TNN_NS
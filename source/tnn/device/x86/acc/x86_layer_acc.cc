@@ -60,7 +60,11 @@ Status X86LayerAcc::Forward(const std::vector<Blob *> &inputs, const std::vector
     timer.Start();
 #endif
 
+    if (workspace_ != nullptr) {
+        context_->SetWorkspace(handle_ptr<void *>(workspace_->GetHandle()), workspace_->GetBlobDesc().dims[0]);
+    }
     status = this->DoForward(inputs, outputs);
+    context_->SetWorkspace(nullptr, 0);
 
 #if TNN_PROFILE
     pdata->kernel_time = timer.TimeEclapsed();
@@ -67,6 +67,14 @@ private:
         virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;  \
     }
 
+#define DECLARE_X86_ACC_WITH_FUNC(type_string, layer_type, extra_funcs)                                             \
+    class X86##type_string##LayerAcc : public X86LayerAcc {                                                        \
+    public:                                                                                                        \
+        virtual ~X86##type_string##LayerAcc(){};                                                                   \
+        virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;  \
+        extra_funcs                                                                                                \
+    }
+
 #define REGISTER_X86_ACC(type_string, layer_type)                                                               \
     X86TypeLayerAccRegister<TypeLayerAccCreator<X86##type_string##LayerAcc>> g_x86_##layer_type##_acc_register( \
         layer_type);                                                                                            \
@@ -17,6 +17,7 @@
 #include "tnn/utils/dims_vector_utils.h"
 #include "tnn/device/x86/acc/x86_lstm_layer_acc.h"
 #include "tnn/device/x86/acc/Float4.h"
+#include "tnn/device/x86/acc/compute/x86_compute.h"
 #include "tnn/utils/omp_utils.h"
 namespace TNN_NS {
 
@@ -61,32 +62,61 @@ static void X86LSTMActivate(const float *gates, float *h_t, float *c_t, float *y
     }
 }
 
-Status X86LSTMONNXLayerAcc::LSTMOneDirection(const float *x, float *y, const float *w, const float *r,
+void X86LSTMONNXLayerAcc::LSTMGemm(int M, int N, int K, const float *w, const float *scale, const float *x,
+                                   float *gates, bool accumulate, float *gemm_buf) {
+    if (accumulate) {
+        conv_sgemm_tn_col_major_prepack_a(M, N, K, w, K, x, K, gates, M,
+                nullptr, ActivationType_None, gemm_buf, conv_gemm_conf_);
+    } else {
+        RawBuffer fake_bias(N * sizeof(float));
+        float *fake_bias_ptr = fake_bias.force_to<float *>();
+        conv_sgemm_tn_col_major_prepack_a(M, N, K, w, K, x, K, gates, M,
+                fake_bias_ptr, ActivationType_None, gemm_buf, conv_gemm_conf_);
+    }
+}
+
+void X86LSTMONNXLayerAcc::LSTMGemm(int M, int N, int K, const int8_t *w, const float *scale, const float *x,
+                                   float *gates, bool accumulate, float *gemm_buf) {
+    if (arch_ == avx2) {
+        X86GemmInt8WeightNT<Float8, 8>(gates, M, x, K, w, scale, nullptr, M, N, K, accumulate);
+    } else {
+        X86GemmInt8WeightNT<Float4, 4>(gates, M, x, K, w, scale, nullptr, M, N, K, accumulate);
+    }
+}
+
+size_t X86LSTMONNXLayerAcc::LSTMWorkspaceSize(int seq_len, int batch_size, int hidden_size) {
+    int k_c     = conv_gemm_conf_.K_c_;
+    int n_block = conv_gemm_conf_.n_block_;
+    int N       = seq_len * batch_size;
+    int M       = 4 * hidden_size;
+    // two temp buf: gemm_buf and gates_buf
+    size_t gemm_buf_size  = ROUND_UP(k_c * ROUND_UP(N, n_block) * sizeof(float), 32);
+    size_t gates_buf_size = ROUND_UP(N * M * sizeof(float), 32);
+    return gemm_buf_size + gates_buf_size;
+}
+
+template <typename T>
+Status X86LSTMONNXLayerAcc::LSTMOneDirection(const float *x, float *y, const T *w, const T *r,
                               const float *b, float *h_t, float *c_t, int seq_len, int batch_size,
-                              int input_size, int hidden_size, int reverse) {
+                              int input_size, int hidden_size, int reverse, float *workspace) {
     int k_c = conv_gemm_conf_.K_c_;
     int n_block = conv_gemm_conf_.n_block_;
 
-    // sgemm for weight tensor
+    // sgemm for weight tensor, the input projection of the whole sequence in one gemm
     // weights: [4*hidden_size, input_size]
     // inputs: [seq_len, batch, input_size]
     int K = input_size;
     int N = seq_len * batch_size;
     int M = 4 * hidden_size;
 
-    // two temp buf: gemm_buf and gates_buf
     size_t gemm_buf_size = ROUND_UP(k_c * ROUND_UP(N, n_block) * sizeof(float), 32);
-    size_t gates_buf_size = ROUND_UP(N * M * sizeof(float), 32);
-    size_t workspace_size = gemm_buf_size + gates_buf_size;
-    float *workspace = reinterpret_cast<float *>(context_->GetSharedWorkSpace(workspace_size));
     float *gemm_buf = workspace;
     float *gates_buf = workspace + gemm_buf_size / sizeof(float);
 
-    RawBuffer fake_bias(N * sizeof(float));
-    float *fake_bias_ptr = fake_bias.force_to<float *>();
-    conv_sgemm_tn_col_major_prepack_a(M, N, K, w, K, x, K, gates_buf, M,
-            fake_bias_ptr, ActivationType_None, gemm_buf, conv_gemm_conf_);
-    
+    const float *w_scale = buffer_w_scale_.force_to<float *>();
+    const float *r_scale = buffer_r_scale_.force_to<float *>();
+    LSTMGemm(M, N, K, w, w_scale, x, gates_buf, false, gemm_buf);
+
     for (int t = 0; t < seq_len; t++) {
         int ti = reverse ? seq_len - 1 - t : t;
         auto gates_t = gates_buf +  ti * batch_size * 4 * hidden_size;
@@ -109,8 +139,7 @@ Status X86LSTMONNXLayerAcc::LSTMOneDirection(const float *x, float *y, const flo
         K = hidden_size;
         N = batch_size;
         M = 4 * hidden_size;
-        conv_sgemm_tn_col_major_prepack_a(M, N, K, r, K, h_t, K, gates_t, M,
-                nullptr, ActivationType_None, gemm_buf, conv_gemm_conf_);
+        LSTMGemm(M, N, K, r, r_scale, h_t, gates_t, true, gemm_buf);
 
         // activation for h_t, c_t, output
         X86LSTMActivate(gates_t, h_t, c_t, y_t, batch_size * hidden_size);
@@ -120,6 +149,11 @@ Status X86LSTMONNXLayerAcc::LSTMOneDirection(const float *x, float *y, const flo
 
 X86LSTMONNXLayerAcc::~X86LSTMONNXLayerAcc() {}
 
+Status X86LSTMONNXLayerAcc::ResetState() {
+    state_valid_ = false;
+    return TNN_OK;
+}
+
 Status X86LSTMONNXLayerAcc::Init(Context *context, LayerParam *param, LayerResource *resource,
                                      const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto status = X86LayerAcc::Init(context, param, resource, inputs, outputs);
@@ -129,9 +163,15 @@ Status X86LSTMONNXLayerAcc::Init(Context *context, LayerParam *param, LayerResou
         return Status(TNNERR_LAYER_ERR, "LSTM has invalid inputs");
     }
 
-    RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
+    if (param_->dynamic_range_quantized && inputs[1]->GetBlobDesc().data_type == DATA_TYPE_INT8) {
+        RETURN_ON_NEQ(allocateBufferWeightInt8(inputs, outputs), TNN_OK);
+    } else {
+        RETURN_ON_NEQ(allocateBufferWeight(inputs, outputs), TNN_OK);
+    }
     RETURN_ON_NEQ(allocateBufferBias(inputs, outputs), TNN_OK);
 
+    stateful_ = param_->extra_config.count("lstm_stateful") > 0;
+
     return TNN_OK;
 }
 
@@ -206,6 +246,54 @@ Status X86LSTMONNXLayerAcc::allocateBufferWeight(const std::vector<Blob *> &inpu
     return TNN_OK;
 }
 
+Status X86LSTMONNXLayerAcc::allocateBufferWeightInt8(const std::vector<Blob *> &inputs,
+                                                     const std::vector<Blob *> &outputs) {
+    // weights keep int8 without packing, rows trans from 4 * hidden_size to hidden_size * 4 as fp32 weights
+    RawBuffer *buffers[2]       = {&buffer_w_, &buffer_r_};
+    RawBuffer *scale_buffers[2] = {&buffer_w_scale_, &buffer_r_scale_};
+    for (int idx = 0; idx < 2; idx++) {
+        auto blob = inputs[idx + 1];
+        auto dims = blob->GetBlobDesc().dims;
+        auto src  = handle_ptr<int8_t *>(blob->GetHandle());
+
+        auto scale_name = blob->GetBlobDesc().name + DynamicRangeQuantScaleSuffix;
+        if (!const_resource_ || const_resource_->find(scale_name) == const_resource_->end()) {
+            LOGE("scale is not found in constant map, its name is %s\n", scale_name.c_str());
+            return Status(TNNERR_PARAM_ERR, "scale is not found in constant map");
+        }
+        auto scale_buffer = *(*const_resource_)[scale_name];
+        if (scale_buffer.GetDataType() == DATA_TYPE_HALF) {
+            scale_buffer = ConvertHalfHandle(scale_buffer);
+        }
+
+        int direction_size = DimsVectorUtils::Count(dims, 1);
+        int hidden_size    = dims[1] / 4;
+        int K              = dims[2];
+        RawBuffer temp_buffer(dims[0] * direction_size * sizeof(int8_t));
+        for (int d = 0; d < dims[0]; d++) {
+            auto src_d = src + d * direction_size;
+            auto dst_d = temp_buffer.force_to<int8_t *>() + d * direction_size;
+            for (int i = 0; i < 4; i++) {
+                for (int j = 0; j < hidden_size; j++) {
+                    memcpy(dst_d + (j * 4 + i) * K, src_d + (i * hidden_size + j) * K, K * sizeof(int8_t));
+                }
+            }
+        }
+        temp_buffer.SetDataType(DATA_TYPE_INT8);
+        *buffers[idx] = temp_buffer;
+
+        // per tensor scale, expanded to rows of gemm
+        RawBuffer scale_temp(dims[1] * sizeof(float));
+        for (int i = 0; i < dims[1]; i++) {
+            scale_temp.force_to<float *>()[i] = scale_buffer.force_to<float *>()[0];
+        }
+        *scale_buffers[idx] = scale_temp;
+    }
+    weight_int8_ = true;
+
+    return TNN_OK;
+}
+
 Status X86LSTMONNXLayerAcc::allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     // bias for gate and recurrence, [num_directions, 8*hidden_size]
     auto b_dims = inputs[3]->GetBlobDesc().dims;
@@ -268,12 +356,10 @@ Status X86LSTMONNXLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
     float *y = (float *)((char*)(outputs[0]->GetHandle().base) + outputs[0]->GetHandle().bytes_offset);
     
     //W[iofc], weight tensor for the gates, shape [num_directions, 4*hidden_size, input_size]
-    float *w = (float *)buffer_w_.force_to<float *>();
     auto w_dims = inputs[1]->GetBlobDesc().dims;
     size_t w_pack_size = ROUND_UP(w_dims[2], k_c) * ROUND_UP(w_dims[1], m_block);
 
     //R[iofc], recurrence weight tensor, shape [num_directions, 4*hidden_size, hidden_size]
-    float *r = (float *)buffer_r_.force_to<float *>();
     auto r_dims = inputs[2]->GetBlobDesc().dims;
     size_t r_pack_size = ROUND_UP(r_dims[2], k_c) * ROUND_UP(r_dims[1], m_block);
     
@@ -285,34 +371,101 @@ Status X86LSTMONNXLayerAcc::DoForward(const std::vector<Blob *> &inputs, const s
     //initial_c, initial value of the cell, If not specified - assumed to be 0. shape [num_directions, batch_size, hidden_size]
     auto c_t = (float *)((char*)(outputs[2]->GetHandle().base) + outputs[2]->GetHandle().bytes_offset);
 
-    if (inputs.size() >= 6) {
+    const int state_bytes = num_directions * batch * hidden_size * sizeof(float);
+    // a stateful lstm continues from the state of the last forward, a different batch size starts over
+    if (stateful_ && state_valid_ && state_h_.GetBytesSize() == state_bytes) {
+        memcpy((void *)h_t, state_h_.force_to<float *>(), state_bytes);
+        memcpy((void *)c_t, state_c_.force_to<float *>(), state_bytes);
+    } else if (inputs.size() >= 6) {
         auto h_0 = (float *)((char*)(blob_h0->GetHandle().base) + blob_h0->GetHandle().bytes_offset);
         auto c_0 = (float *)((char*)(blob_c0->GetHandle().base) + blob_c0->GetHandle().bytes_offset);
-        memcpy((void *)h_t, h_0, num_directions * batch * hidden_size * sizeof(float));
-        memcpy((void *)c_t, c_0, num_directions * batch * hidden_size * sizeof(float));
+        memcpy((void *)h_t, h_0, state_bytes);
+        memcpy((void *)c_t, c_0, state_bytes);
     } else {
-        memset((void *)h_t, 0, num_directions * batch * hidden_size * sizeof(float));
-        memset((void *)c_t, 0, num_directions * batch * hidden_size * sizeof(float));
+        memset((void *)h_t, 0, state_bytes);
+        memset((void *)c_t, 0, state_bytes);
     }
-    
+
+    Status status;
+    if (weight_int8_) {
+        // int8 weights are not packed
+        status = LSTMForward(x, y, buffer_w_.force_to<int8_t *>(), buffer_r_.force_to<int8_t *>(), b, h_t, c_t,
+                             DimsVectorUtils::Count(w_dims, 1), DimsVectorUtils::Count(r_dims, 1), T, batch,
+                             input_size, hidden_size);
+    } else {
+        status = LSTMForward(x, y, buffer_w_.force_to<float *>(), buffer_r_.force_to<float *>(), b, h_t, c_t,
+                             w_pack_size, r_pack_size, T, batch, input_size, hidden_size);
+    }
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    if (stateful_) {
+        if (state_h_.GetBytesSize() != state_bytes) {
+            state_h_ = RawBuffer(state_bytes);
+            state_c_ = RawBuffer(state_bytes);
+        }
+        memcpy(state_h_.force_to<float *>(), h_t, state_bytes);
+        memcpy(state_c_.force_to<float *>(), c_t, state_bytes);
+        state_valid_ = true;
+    }
+    return TNN_OK;
+}
+
+template <typename T>
+Status X86LSTMONNXLayerAcc::LSTMForward(const float *x, float *y, const T *w, const T *r, const float *b, float *h_t,
+                                        float *c_t, size_t w_pack_size, size_t r_pack_size, int seq_len,
+                                        int batch, int input_size, int hidden_size) {
+    auto layer_param = dynamic_cast<LSTMONNXLayerParam *>(param_);
+    const int num_directions = layer_param->direction >= 2 ? 2 : 1;
+
+    const size_t direction_workspace_size = LSTMWorkspaceSize(seq_len, batch, hidden_size);
     if (layer_param->direction == 0 || layer_param->direction == 1) {
-        return LSTMOneDirection(x, y, w, r, b, h_t, c_t, T, batch, input_size, hidden_size, layer_param->direction);
+        float *workspace = reinterpret_cast<float *>(context_->GetSharedWorkSpace(direction_workspace_size));
+        return LSTMOneDirection(x, y, w, r, b, h_t, c_t, seq_len, batch, input_size, hidden_size,
+                                layer_param->direction, workspace);
     } else if (layer_param->direction == 2) {
-        //Y shape [num_directions sequence batch_size hidden_size]
-        auto y_temp = std::shared_ptr<float>(new float[num_directions*T*batch*hidden_size], [](float* p) { delete[] p; });
-        auto y0 = y_temp.get();
-        auto y1 = y0 + T * batch * hidden_size;
-        LSTMOneDirection(x, y0, w, r, b, h_t, c_t, T, batch, input_size, hidden_size, 0);
-        
+        // workspace of both directions, then y of both directions [num_directions sequence batch_size hidden_size]
+        const size_t y_size = ROUND_UP(num_directions * seq_len * batch * hidden_size * sizeof(float), 32);
+        char *workspace     = reinterpret_cast<char *>(
+            context_->GetSharedWorkSpace(num_directions * direction_workspace_size + y_size));
+        auto workspace0 = reinterpret_cast<float *>(workspace);
+        auto workspace1 = reinterpret_cast<float *>(workspace + direction_workspace_size);
+        auto y0         = reinterpret_cast<float *>(workspace + num_directions * direction_workspace_size);
+        auto y1         = y0 + seq_len * batch * hidden_size;
+
         auto w1 = w + w_pack_size;
         auto r1 = r + r_pack_size;
         auto b1 = b + 4 * hidden_size;
         auto h_t1 = h_t + batch * hidden_size;
         auto c_t1 = c_t + batch * hidden_size;
-        LSTMOneDirection(x, y1, w1, r1, b1, h_t1, c_t1, T, batch, input_size, hidden_size, 1);
+        Status status0, status1;
+        // the directions are independent, each one can run on its own thread with its own workspace.
+        // the loops inside a direction are not split any more then, so only do it when a timestep is small.
+        const bool parallel_directions = OMP_MAX_THREADS_NUM_ >= 2 && batch * 4 * hidden_size <= 16 * 1024;
+        if (parallel_directions) {
+            OMP_PARALLEL_SECTIONS_
+            {
+                OMP_SECTION_
+                {
+                    status0 = LSTMOneDirection(x, y0, w, r, b, h_t, c_t, seq_len, batch, input_size, hidden_size, 0,
+                                               workspace0);
+                }
+                OMP_SECTION_
+                {
+                    status1 = LSTMOneDirection(x, y1, w1, r1, b1, h_t1, c_t1, seq_len, batch, input_size,
+                                               hidden_size, 1, workspace1);
+                }
+            }
+        } else {
+            status0 = LSTMOneDirection(x, y0, w, r, b, h_t, c_t, seq_len, batch, input_size, hidden_size, 0,
+                                       workspace0);
+            status1 = LSTMOneDirection(x, y1, w1, r1, b1, h_t1, c_t1, seq_len, batch, input_size, hidden_size, 1,
+                                       workspace1);
+        }
+        RETURN_ON_NEQ(status0, TNN_OK);
+        RETURN_ON_NEQ(status1, TNN_OK);
         
         //transpose [num_directions sequence batch_size hidden_size] to [sequence batch_size num_directions*hidden_size]
-        for (int i = 0; i < T*batch; i++) {
+        for (int i = 0; i < seq_len*batch; i++) {
             auto y0_data = y0 + i * hidden_size;
             auto y1_data = y1 + i * hidden_size;
             auto y_data = y + i * num_directions * hidden_size;
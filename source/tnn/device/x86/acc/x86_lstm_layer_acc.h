@@ -29,15 +29,41 @@ public:
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
     virtual Status allocateBufferWeight(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
     virtual Status allocateBufferBias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+    virtual Status ResetState() override;
 protected:
-    Status LSTMOneDirection(const float *x, float *y, const float *w, const float *r,
+    // @brief workspace of one direction: gemm buffer and gates of all timesteps
+    size_t LSTMWorkspaceSize(int seq_len, int batch_size, int hidden_size);
+    template <typename T>
+    Status LSTMOneDirection(const float *x, float *y, const T *w, const T *r,
                            const float *b, float *h_t, float *c_t, int seq_len, int batch_size,
-                           int input_size, int hidden_size, int reverse);
+                           int input_size, int hidden_size, int reverse, float *workspace);
+    template <typename T>
+    Status LSTMForward(const float *x, float *y, const T *w, const T *r, const float *b, float *h_t, float *c_t,
+                       size_t w_pack_size, size_t r_pack_size, int seq_len, int batch, int input_size,
+                       int hidden_size);
+
+    // gates = x * w^T, gates += x * w^T if accumulate
+    void LSTMGemm(int M, int N, int K, const float *w, const float *scale, const float *x, float *gates,
+                  bool accumulate, float *gemm_buf);
+    void LSTMGemm(int M, int N, int K, const int8_t *w, const float *scale, const float *x, float *gates,
+                  bool accumulate, float *gemm_buf);
+
+    Status allocateBufferWeightInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
 
     RawBuffer buffer_w_;
     RawBuffer buffer_r_;
     RawBuffer buffer_b_;
+    // int8 weights of dynamic range quantized models are kept in buffer_w_ and buffer_r_
+    bool weight_int8_ = false;
+    RawBuffer buffer_w_scale_;
+    RawBuffer buffer_r_scale_;
     conv_gemm_config<float, float, float> conv_gemm_conf_;
+
+    // with the extra config lstm_stateful, the final h_t and c_t are the initial state of the next forward
+    bool stateful_     = false;
+    bool state_valid_  = false;
+    RawBuffer state_h_;
+    RawBuffer state_c_;
 };
 
 }  // namespace TNN_NS
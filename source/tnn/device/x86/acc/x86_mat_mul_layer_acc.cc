@@ -13,6 +13,10 @@
 // specific language governing permissions and limitations under the License.
 
 #include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/core/blob_int8.h"
+#include "tnn/device/x86/acc/compute/x86_compute.h"
+#include "tnn/device/x86/acc/compute/x86_compute_int8.h"
+#include "tnn/utils/data_format_converter.h"
 #include "tnn/utils/dims_vector_utils.h"
 #include "tnn/device/x86/acc/x86_mat_mul_layer_acc.h"
 #include "tnn/interpreter/layer_resource_generator.h"
@@ -33,6 +37,21 @@ Status X86MatMulLayerAcc::Init(Context *context, LayerParam *param, LayerResourc
     auto res = dynamic_cast<MatMulLayerResource *>(resource);
     CHECK_PARAM_NULL(res);
 
+    auto matmul_param = dynamic_cast<MatMulLayerParam *>(param);
+    CHECK_PARAM_NULL(matmul_param);
+    if (matmul_param->quantized) {
+        if (res->weight.GetDataType() != DATA_TYPE_INT8) {
+            return Status(TNNERR_MODEL_ERR, "quantized matmul needs int8 weight");
+        }
+        RETURN_ON_NEQ(X86LayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+        return AllocateBufferWeightInt8(res);
+    }
+    if (matmul_param->dynamic_range_quantized && matmul_param->weight_position == 1 &&
+        res->weight.GetDataType() == DATA_TYPE_INT8) {
+        RETURN_ON_NEQ(X86LayerAcc::Init(context, param, resource, inputs, outputs), TNN_OK);
+        return AllocateBufferWeightInt8(res);
+    }
+
     if (res->weight.GetDataType() == DATA_TYPE_HALF) {
         LayerResource *fp32_res = nullptr;
         RETURN_ON_NEQ(ConvertHalfResource(LAYER_MATMUL, res, &fp32_res), TNN_OK);
@@ -46,7 +65,168 @@ Status X86MatMulLayerAcc::Init(Context *context, LayerParam *param, LayerResourc
     return TNN_OK;
 }
 
+Status X86MatMulLayerAcc::AllocateBufferWeightInt8(MatMulLayerResource *res) {
+    auto param               = dynamic_cast<MatMulLayerParam *>(param_);
+    DimsVector matrix_b_dims = param->matrix_b_dims;
+    if (matrix_b_dims.size() == 1) {
+        matrix_b_dims.push_back(1);
+    }
+    const int M = matrix_b_dims[matrix_b_dims.size() - 1];
+    if (param->weight_position == 0) {
+        // weight is matrix a, its rows are already along K
+        RawBuffer weight_buffer(res->weight.GetDataCount() * sizeof(int8_t));
+        memcpy(weight_buffer.force_to<int8_t *>(), res->weight.force_to<int8_t *>(), weight_buffer.GetBytesSize());
+        weight_buffer.SetDataType(DATA_TYPE_INT8);
+        buffer_weight_int8_ = weight_buffer;
+    } else {
+        const int K     = matrix_b_dims[matrix_b_dims.size() - 2];
+        const int batch = DimsVectorUtils::Count(matrix_b_dims) / (M * K);
+
+        // the gemm reads weight by rows of output, trans [K, M] to [M, K], still int8
+        RawBuffer weight_buffer(batch * M * K * sizeof(int8_t));
+        const int8_t *src = res->weight.force_to<int8_t *>();
+        int8_t *dst       = weight_buffer.force_to<int8_t *>();
+        for (int b = 0; b < batch; b++) {
+            for (int k = 0; k < K; k++) {
+                for (int m = 0; m < M; m++) {
+                    dst[b * M * K + m * K + k] = src[b * M * K + k * M + m];
+                }
+            }
+        }
+        weight_buffer.SetDataType(DATA_TYPE_INT8);
+        buffer_weight_int8_ = weight_buffer;
+    }
+
+    auto scale_handle = res->scale_handle;
+    if (scale_handle.GetDataType() == DATA_TYPE_HALF) {
+        scale_handle = ConvertHalfHandle(scale_handle);
+    }
+    if (scale_handle.GetDataCount() < 1) {
+        return Status(TNNERR_MODEL_ERR, "matmul weight scale is empty");
+    }
+    // per tensor scale
+    buffer_scale_ = RawBuffer(M * sizeof(float));
+    for (int m = 0; m < M; m++) {
+        buffer_scale_.force_to<float *>()[m] = scale_handle.force_to<float *>()[0];
+    }
+    return TNN_OK;
+}
+
+static Status GetPerTensorScale(Blob *blob, float &scale) {
+    auto int_resource = reinterpret_cast<BlobInt8 *>(blob)->GetIntResource();
+    if (int_resource == nullptr || int_resource->scale_handle.GetDataCount() != 1) {
+        return Status(TNNERR_LAYER_ERR, "x86 int8 matmul only supports per-tensor blob scale");
+    }
+    scale = int_resource->scale_handle.force_to<float *>()[0];
+    return TNN_OK;
+}
+
+// int8 blobs are nhwc4 packed, the gemm works on plain row major matrices
+static void UnpackInt8Blob(Blob *blob, int8_t *dst) {
+    auto dims = blob->GetBlobDesc().dims;
+    DataFormatConverter::ConvertFromNHWC4ToNCHWInt8(handle_ptr<int8_t *>(blob->GetHandle()), dst, dims[0], dims[1],
+                                                    DimsVectorUtils::Count(dims, 2));
+}
+
+// [batch, K, M] -> [batch, M, K]
+static void TransposeInt8(const int8_t *src, int8_t *dst, int batch, int K, int M) {
+    for (int b = 0; b < batch; b++) {
+        for (int k = 0; k < K; k++) {
+            for (int m = 0; m < M; m++) {
+                dst[b * M * K + m * K + k] = src[b * M * K + k * M + m];
+            }
+        }
+    }
+}
+
+Status X86MatMulLayerAcc::DoForwardInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param               = dynamic_cast<MatMulLayerParam *>(param_);
+    DimsVector matrix_a_dims = param->matrix_a_dims;
+    DimsVector matrix_b_dims = param->matrix_b_dims;
+    if (matrix_a_dims.size() == 1) {
+        matrix_a_dims.insert(matrix_a_dims.begin(), 1);
+    }
+    if (matrix_b_dims.size() == 1) {
+        matrix_b_dims.push_back(1);
+    }
+    for (auto blob : inputs) {
+        if (blob->GetBlobDesc().dims.size() < 2) {
+            return Status(TNNERR_LAYER_ERR, "x86 int8 matmul needs inputs of at least 2 dims");
+        }
+    }
+    auto matrix_c_dims = outputs[0]->GetBlobDesc().dims;
+    if (matrix_c_dims.size() < 2) {
+        return Status(TNNERR_LAYER_ERR, "x86 int8 matmul needs output of at least 2 dims");
+    }
+
+    const int M       = matrix_b_dims[matrix_b_dims.size() - 1];
+    const int K       = matrix_a_dims[matrix_a_dims.size() - 1];
+    const int N       = matrix_a_dims[matrix_a_dims.size() - 2];
+    const int count_a = DimsVectorUtils::Count(matrix_a_dims);
+    const int count_b = DimsVectorUtils::Count(matrix_b_dims);
+    const int count_c = DimsVectorUtils::Count(matrix_c_dims);
+    const int batch_a = count_a / (K * N);
+    const int batch_b = count_b / (M * K);
+    const int batch_c = count_c / (M * N);
+
+    float scale_a = 1.0f, scale_b = 1.0f, scale_c = 1.0f;
+    RETURN_ON_NEQ(GetPerTensorScale(outputs[0], scale_c), TNN_OK);
+
+    // workspace: plain a, plain b, transposed b, plain c
+    const size_t a_size = ROUND_UP(count_a, 32);
+    const size_t b_size = ROUND_UP(count_b, 32);
+    const size_t c_size = ROUND_UP(count_c, 32);
+    int8_t *workspace   = reinterpret_cast<int8_t *>(context_->GetSharedWorkSpace(a_size + 2 * b_size + c_size));
+    int8_t *plain_a     = workspace;
+    int8_t *plain_b     = plain_a + a_size;
+    int8_t *trans_b     = plain_b + b_size;
+    int8_t *plain_c     = trans_b + b_size;
+
+    const int8_t *matrix_a = plain_a;
+    const int8_t *matrix_b = trans_b;
+    if (inputs.size() == 2) {
+        RETURN_ON_NEQ(GetPerTensorScale(inputs[0], scale_a), TNN_OK);
+        RETURN_ON_NEQ(GetPerTensorScale(inputs[1], scale_b), TNN_OK);
+        UnpackInt8Blob(inputs[0], plain_a);
+        UnpackInt8Blob(inputs[1], plain_b);
+        TransposeInt8(plain_b, trans_b, batch_b, K, M);
+    } else if (param->weight_position == 0) {
+        scale_a  = buffer_scale_.force_to<float *>()[0];
+        matrix_a = buffer_weight_int8_.force_to<int8_t *>();
+        RETURN_ON_NEQ(GetPerTensorScale(inputs[0], scale_b), TNN_OK);
+        UnpackInt8Blob(inputs[0], plain_b);
+        TransposeInt8(plain_b, trans_b, batch_b, K, M);
+    } else {
+        RETURN_ON_NEQ(GetPerTensorScale(inputs[0], scale_a), TNN_OK);
+        scale_b  = buffer_scale_.force_to<float *>()[0];
+        matrix_b = buffer_weight_int8_.force_to<int8_t *>();
+        UnpackInt8Blob(inputs[0], plain_a);
+    }
+
+    const float scale = scale_c == 0 ? 0.f : scale_a * scale_b / scale_c;
+    auto X86GemmInt8Func = X86SSEGemmInt8NT;
+#ifdef __AVX2__
+    if (arch_ == avx2) {
+        X86GemmInt8Func = X86AVXGemmInt8NT;
+    }
+#endif
+    for (int bc = 0; bc < batch_c; ++bc) {
+        int ba = bc < batch_a ? bc : 0;
+        int bb = bc < batch_b ? bc : 0;
+        X86GemmInt8Func(plain_c + bc * M * N, M, matrix_a + ba * K * N, K, matrix_b + bb * M * K, K, scale, M, N, K);
+    }
+
+    DataFormatConverter::ConvertFromNCHWToNHWC4Int8(plain_c, handle_ptr<int8_t *>(outputs[0]->GetHandle()),
+                                                    matrix_c_dims[0], matrix_c_dims[1],
+                                                    DimsVectorUtils::Count(matrix_c_dims, 2));
+    return TNN_OK;
+}
+
 Status X86MatMulLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    if (inputs[0]->GetBlobDesc().data_type == DATA_TYPE_INT8) {
+        return DoForwardInt8(inputs, outputs);
+    }
+
     auto param               = dynamic_cast<MatMulLayerParam *>(param_);
     auto resource            = dynamic_cast<MatMulLayerResource *>(resource_);
     DimsVector matrix_a_dims = param->matrix_a_dims;
@@ -59,7 +239,29 @@ Status X86MatMulLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std
     }
     DataType data_type       = inputs[0]->GetBlobDesc().data_type;
     auto matrix_c_dims       = outputs[0]->GetBlobDesc().dims;
-    if (data_type == DATA_TYPE_FLOAT) {
+    if (data_type == DATA_TYPE_FLOAT && buffer_weight_int8_.GetBytesSize() > 0) {
+        auto X86GemmInt8WeightFunc = X86GemmInt8WeightNT<Float4, 4>;
+        if (arch_ == avx2) {
+            X86GemmInt8WeightFunc = X86GemmInt8WeightNT<Float8, 8>;
+        }
+        auto matrix_a = handle_ptr<float *>(inputs[0]->GetHandle());
+        auto matrix_c = handle_ptr<float *>(outputs[0]->GetHandle());
+        auto weight   = buffer_weight_int8_.force_to<int8_t *>();
+        auto scale    = buffer_scale_.force_to<float *>();
+
+        int M       = matrix_b_dims[matrix_b_dims.size() - 1];
+        int K       = matrix_a_dims[matrix_a_dims.size() - 1];
+        int N       = matrix_a_dims[matrix_a_dims.size() - 2];
+        int batch_a = DimsVectorUtils::Count(matrix_a_dims) / (K * N);
+        int batch_b = DimsVectorUtils::Count(matrix_b_dims) / (M * K);
+        int batch_c = DimsVectorUtils::Count(matrix_c_dims) / (M * N);
+        for (int bc = 0; bc < batch_c; ++bc) {
+            int ba = bc < batch_a ? bc : 0;
+            int bb = bc < batch_b ? bc : 0;
+            X86GemmInt8WeightFunc(matrix_c + bc * M * N, M, matrix_a + ba * K * N, K, weight + bb * M * K, scale,
+                                  nullptr, M, N, K, false);
+        }
+    } else if (data_type == DATA_TYPE_FLOAT) {
         float *matrix_a;
         float *matrix_b;
 
@@ -29,8 +29,14 @@ public:
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
 
 protected:
+    Status AllocateBufferWeightInt8(MatMulLayerResource *res);
+    Status DoForwardInt8(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs);
+
     conv_gemm_config<float, float, float> conv_gemm_conf_;
     std::shared_ptr<LayerResource> matmul_acc_f32_resource_ = nullptr;
+    // int8 weight of dynamic range or int8 quantized models, transposed to [batch, M, K] if weight_position is 1
+    RawBuffer buffer_weight_int8_;
+    RawBuffer buffer_scale_;
 
 };
 
@@ -0,0 +1,99 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <algorithm>
+#include <limits>
+
+#include "tnn/device/x86/acc/x86_layer_acc.h"
+#include "tnn/utils/nms_utils.h"
+#include "tnn/utils/omp_utils.h"
+
+namespace TNN_NS {
+
+DECLARE_X86_ACC(NonMaxSuppression, LAYER_NON_MAX_SUPPRESSION);
+
+Status X86NonMaxSuppressionLayerAcc::DoForward(const std::vector<Blob *> &inputs,
+                                               const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<NonMaxSuppressionLayerParam *>(param_);
+    CHECK_PARAM_NULL(param);
+    if (inputs.size() < 2) {
+        return Status(TNNERR_PARAM_ERR, "NonMaxSuppression has invalid inputs");
+    }
+
+    Blob *output_blob = outputs[0];
+    if (param->max_output_boxes_per_class <= 0) {
+        output_blob->GetBlobDesc().dims = {0, 3};
+        return TNN_OK;
+    }
+    const int max_keep =
+        static_cast<int>(std::min<int64_t>(param->max_output_boxes_per_class, std::numeric_limits<int>::max()));
+
+    const auto &boxes_dims  = inputs[0]->GetBlobDesc().dims;
+    const int num_batches   = boxes_dims[0];
+    const int num_boxes     = boxes_dims[1];
+    const int num_classes   = inputs[1]->GetBlobDesc().dims[1];
+    const float *boxes_data  = handle_ptr<const float *>(inputs[0]->GetHandle());
+    const float *scores_data = handle_ptr<const float *>(inputs[1]->GetHandle());
+
+    BoxSoA boxes;
+    boxes.Resize(num_boxes);
+    std::vector<std::vector<int>> selected(num_classes);
+    // batch, class, box index for each selected box
+    std::vector<int> selected_indices;
+
+    for (int b = 0; b < num_batches; ++b) {
+        const float *batch_boxes = boxes_data + b * num_boxes * 4;
+        for (int i = 0; i < num_boxes; ++i) {
+            const float *box = batch_boxes + i * 4;
+            if (param->center_point_box == 0) {
+                // [y1, x1, y2, x2] with the corners in any order
+                boxes.x1[i] = std::min(box[1], box[3]);
+                boxes.x2[i] = std::max(box[1], box[3]);
+                boxes.y1[i] = std::min(box[0], box[2]);
+                boxes.y2[i] = std::max(box[0], box[2]);
+            } else {
+                // [x_center, y_center, width, height]
+                boxes.x1[i] = box[0] - box[2] / 2;
+                boxes.x2[i] = box[0] + box[2] / 2;
+                boxes.y1[i] = box[1] - box[3] / 2;
+                boxes.y2[i] = box[1] + box[3] / 2;
+            }
+        }
+        boxes.ComputeArea();
+
+        OMP_PARALLEL_FOR_DYNAMIC_
+        for (int c = 0; c < num_classes; ++c) {
+            NMSUtils::NMS(boxes, scores_data + (b * num_classes + c) * num_boxes, param->score_threshold, -1,
+                          param->iou_threshold, selected[c], max_keep);
+        }
+
+        for (int c = 0; c < num_classes; ++c) {
+            for (const int idx : selected[c]) {
+                selected_indices.push_back(b);
+                selected_indices.push_back(c);
+                selected_indices.push_back(idx);
+            }
+        }
+    }
+
+    const int num_selected          = static_cast<int>(selected_indices.size()) / 3;
+    output_blob->GetBlobDesc().dims = {num_selected, 3};
+    int *output_data                = handle_ptr<int *>(output_blob->GetHandle());
+    std::copy(selected_indices.begin(), selected_indices.end(), output_data);
+    return TNN_OK;
+}
+
+REGISTER_X86_ACC(NonMaxSuppression, LAYER_NON_MAX_SUPPRESSION);
+
+}  // namespace TNN_NS
@@ -54,6 +54,16 @@ Status X86PoolLayerAcc::Reshape(const std::vector<Blob *> &inputs, const std::ve
     return TNN_OK;
 }
 
+// packed source and destination planes of each thread
+size_t X86PoolLayerAcc::GetWorkspaceSize(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto dims_input      = inputs[0]->GetBlobDesc().dims;
+    auto dims_output     = outputs[0]->GetBlobDesc().dims;
+    int c_pack           = arch_ == avx2 ? 8 : 4;
+    size_t src_pack_size = ROUND_UP(dims_input[3] * dims_input[2] * c_pack * sizeof(float), 32);
+    size_t dst_pack_size = ROUND_UP(dims_output[3] * dims_output[2] * c_pack * sizeof(float), 32);
+    return (src_pack_size + dst_pack_size) * OMP_MAX_THREADS_NUM_;
+}
+
 Status X86PoolLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto param = dynamic_cast<PoolingLayerParam *>(param_);
     if (!param) {
@@ -36,6 +36,10 @@ Status X86CalculateReduceDims(Blob *input_blob, ReduceLayerParam *layer_param,
     return TNN_OK;
 }
 
+size_t X86ReduceOpLayerAcc::GetWorkspaceSize(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return DimsVectorUtils::Count(inputs[0]->GetBlobDesc().dims) * 2 * sizeof(float);
+}
+
 Status X86ReduceOpLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     
     auto input_blob = inputs[0];
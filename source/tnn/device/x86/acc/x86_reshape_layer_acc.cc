@@ -19,7 +19,15 @@
 
 namespace TNN_NS {
 
-DECLARE_X86_ACC(Reshape, LAYER_RESHAPE);
+DECLARE_X86_ACC_WITH_FUNC(Reshape, LAYER_RESHAPE,
+                          virtual BlobAliasType GetOutputAlias(const std::vector<Blob *> &inputs,
+                                                               const std::vector<Blob *> &outputs) override;);
+
+// only the onnx reshape keeps the nchw data, the tensorflow reshape reorders it
+BlobAliasType X86ReshapeLayerAcc::GetOutputAlias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    auto param = dynamic_cast<ReshapeLayerParam *>(param_);
+    return (param && param->reshape_type == 0) ? BLOB_ALIAS_VIEW : BLOB_ALIAS_NONE;
+}
 
 Status X86ReshapeLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto &input  = inputs[0];
@@ -31,6 +31,12 @@ Status X86_UNARY2_CALCULATE(DimsVector &dims, const float *src, float *dst, Laye
 
 X86Unary2LayerAcc::~X86Unary2LayerAcc() {}
 
+// the kernels read and write each element once at the same index
+BlobAliasType X86Unary2LayerAcc::GetOutputAlias(const std::vector<Blob *> &inputs,
+                                                const std::vector<Blob *> &outputs) {
+    return BLOB_ALIAS_INPLACE;
+}
+
 Status X86Unary2LayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto input  = inputs[0];
     auto output = outputs[0];
@@ -90,6 +90,9 @@ public:
 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
 
+    virtual BlobAliasType GetOutputAlias(const std::vector<Blob *> &inputs,
+                                         const std::vector<Blob *> &outputs) override;
+
     static Status RegisterUnary2Kernel(LayerType type, x86_isa_t arch, unary2_kernel_avx_func_t kernel);
     static Status GetUnary2Kernel(LayerType type, x86_isa_t arch, unary2_kernel_avx_func_t &kernel);
 
@@ -28,6 +28,11 @@ Status X86UnaryLayerAcc::Init(Context *context, LayerParam *param, LayerResource
     return op_->Init(param);
 }
 
+BlobAliasType X86UnaryLayerAcc::GetOutputAlias(const std::vector<Blob *> &inputs,
+                                               const std::vector<Blob *> &outputs) {
+    return BLOB_ALIAS_INPLACE;
+}
+
 Status X86UnaryLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     auto input  = inputs[0];
     auto output = outputs[0];
@@ -42,6 +42,9 @@ public:
                         const std::vector<Blob *> &outputs) override;
 
     virtual Status DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) override;
+
+    virtual BlobAliasType GetOutputAlias(const std::vector<Blob *> &inputs,
+                                         const std::vector<Blob *> &outputs) override;
 protected:
     std::shared_ptr<X86_UNARY_OP> op_;
 };
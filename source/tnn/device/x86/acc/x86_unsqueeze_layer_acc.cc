@@ -18,7 +18,14 @@
 
 namespace TNN_NS {
 
-DECLARE_X86_ACC(Unsqueeze, LAYER_UNSQUEEZE);
+DECLARE_X86_ACC_WITH_FUNC(Unsqueeze, LAYER_UNSQUEEZE,
+                          virtual BlobAliasType GetOutputAlias(const std::vector<Blob *> &inputs,
+                                                               const std::vector<Blob *> &outputs) override;);
+
+// the nchw data is the same, only the dims change
+BlobAliasType X86UnsqueezeLayerAcc::GetOutputAlias(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
+    return BLOB_ALIAS_VIEW;
+}
 
 Status X86UnsqueezeLayerAcc::DoForward(const std::vector<Blob *> &inputs, const std::vector<Blob *> &outputs) {
     void *input_data  = handle_ptr<void*>(inputs[0]->GetHandle());
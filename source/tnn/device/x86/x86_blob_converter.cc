@@ -53,7 +53,7 @@ Status X86BlobConverterAcc::GetBlobConvertFunc(MatType mat_type, DataType data_t
     return TNN_OK;
 }
 
-Status X86BlobConverterAcc::ConvertToMatAsync(Mat &image, MatConvertParam param, void *command_queue) {
+Status X86BlobConverterAcc::ConvertToMatImpl(Mat &image, MatConvertParam param) {
     Status ret = TNN_OK;
     if (blob_ == nullptr) {
         return Status(TNNERR_NULL_PARAM, "input/output blob is null");
@@ -88,11 +88,11 @@ Status X86BlobConverterAcc::ConvertToMatAsync(Mat &image, MatConvertParam param,
             return ret;
         }
     } else {
-        return DefaultBlobConverterAcc::ConvertToMatAsync(image, param, command_queue);
+        return DefaultBlobConverterAcc::ConvertToMatAsync(image, param, nullptr);
     }
 }
 
-Status X86BlobConverterAcc::ConvertFromMatAsync(Mat &image, MatConvertParam param, void *command_queue) {
+Status X86BlobConverterAcc::ConvertFromMatImpl(Mat &image, MatConvertParam param) {
     Status ret = TNN_OK;
     if (blob_ == nullptr) {
         return Status(TNNERR_NULL_PARAM, "input/output blob_ is null");
@@ -130,19 +130,52 @@ Status X86BlobConverterAcc::ConvertFromMatAsync(Mat &image, MatConvertParam para
         } else {
             return ret;
         }
+    } else if (desc.data_type == DATA_TYPE_FLOAT &&
+               (!param.reverse_channel || image.GetMatType() == N8UC3 || image.GetMatType() == N8UC4) &&
+               GetBlobConvertFuncMap().count(GetUniqueBlobConvertKey(image.GetMatType(), DATA_TYPE_FLOAT,
+                                                                    CVT_DIR_MAT2BLOB)) > 0) {
+        auto dims           = desc.dims;
+        auto hw             = DimsVectorUtils::Count(dims, 2);
+        auto c_r4           = ROUND_UP(DimsFunctionUtils::GetDim(dims, 1), 4);
+        auto cvt_handle_ptr = handle_ptr<char *>(blob_->GetHandle());
+
+        ret = GetBlobConvertFunc(image.GetMatType(), DATA_TYPE_FLOAT, CVT_DIR_MAT2BLOB, cvt_func_);
+        if (ret == TNN_OK) {
+            ret = cvt_func_(image, cvt_handle_ptr, param, dims, hw, c_r4, param.scale, param.bias);
+        } else {
+            return ret;
+        }
     } else {
-        return DefaultBlobConverterAcc::ConvertFromMatAsync(image, param, command_queue);
+        return DefaultBlobConverterAcc::ConvertFromMatAsync(image, param, nullptr);
     }
 
     return ret;
 }
 
 Status X86BlobConverterAcc::ConvertToMat(Mat &image, MatConvertParam param, void *command_queue) {
-    return ConvertToMatAsync(image, param, command_queue);
+    return RunOnHostTaskQueue([&]() { return ConvertToMatImpl(image, param); }, false, command_queue);
+}
+
+Status X86BlobConverterAcc::ConvertToMatAsync(Mat &image, MatConvertParam param, void *command_queue) {
+    if (image.GetData() == nullptr) {
+        // the mat is allocated by the conversion, so the caller has to see it on return
+        return ConvertToMat(image, param, command_queue);
+    }
+    auto self = std::static_pointer_cast<X86BlobConverterAcc>(shared_from_this());
+    Mat mat   = image;
+    return RunOnHostTaskQueue([self, mat, param]() mutable { return self->ConvertToMatImpl(mat, param); }, true,
+                              command_queue);
 }
 
 Status X86BlobConverterAcc::ConvertFromMat(Mat &image, MatConvertParam param, void *command_queue) {
-    return ConvertFromMatAsync(image, param, command_queue);
+    return RunOnHostTaskQueue([&]() { return ConvertFromMatImpl(image, param); }, false, command_queue);
+}
+
+Status X86BlobConverterAcc::ConvertFromMatAsync(Mat &image, MatConvertParam param, void *command_queue) {
+    auto self = std::static_pointer_cast<X86BlobConverterAcc>(shared_from_this());
+    Mat mat   = image;
+    return RunOnHostTaskQueue([self, mat, param]() mutable { return self->ConvertFromMatImpl(mat, param); }, true,
+                              command_queue);
 }
 
 DECLARE_BLOB_CONVERTER_CREATER(X86);
@@ -318,6 +351,64 @@ REGISTER_X86_BLOB_CONVERT_FUNC(NNV21,               DATA_TYPE_INT8,  CVT_DIR_MAT
 REGISTER_X86_BLOB_CONVERT_FUNC(NCHW_FLOAT,          DATA_TYPE_INT8,  CVT_DIR_MAT2BLOB, ConvertNCHWFloatToInt8Blob)
 REGISTER_X86_BLOB_CONVERT_FUNC(RESERVED_INT8_TEST,  DATA_TYPE_INT8,  CVT_DIR_MAT2BLOB, ConvertInt8MatToInt8Blob)
 
+static Status ConvertN8UC4ToFloatBlob(Mat& image, char* handle_ptr,
+                                      const MatConvertParam& param, const DimsVector& dims,
+                                      const int hw, const int c_r4,
+                                      std::vector<float>& scale, std::vector<float>& bias) {
+    for (int n = 0; n < dims[0]; n++) {
+        NormalizeToNCHW(reinterpret_cast<uint8_t *>(image.GetData()) + n * 4 * hw, 4, hw,
+                        reinterpret_cast<float *>(handle_ptr) + n * dims[1] * hw, dims[1], hw,
+                        scale.data(), bias.data(), param.reverse_channel);
+    }
+    return TNN_OK;
+}
+
+static Status ConvertN8UC3ToFloatBlob(Mat& image, char* handle_ptr,
+                                      const MatConvertParam& param, const DimsVector& dims,
+                                      const int hw, const int c_r4,
+                                      std::vector<float>& scale, std::vector<float>& bias) {
+    for (int n = 0; n < dims[0]; n++) {
+        NormalizeToNCHW(reinterpret_cast<uint8_t *>(image.GetData()) + n * 3 * hw, 3, hw,
+                        reinterpret_cast<float *>(handle_ptr) + n * 3 * hw, 3, hw,
+                        scale.data(), bias.data(), param.reverse_channel);
+    }
+    return TNN_OK;
+}
+
+static Status ConvertNGRAYToFloatBlob(Mat& image, char* handle_ptr,
+                                      const MatConvertParam& param, const DimsVector& dims,
+                                      const int hw, const int c_r4,
+                                      std::vector<float>& scale, std::vector<float>& bias) {
+    for (int n = 0; n < dims[0]; n++) {
+        NormalizeToNCHW(reinterpret_cast<uint8_t *>(image.GetData()) + n * hw, 1, hw,
+                        reinterpret_cast<float *>(handle_ptr) + n * hw, 1, hw,
+                        scale.data(), bias.data(), false);
+    }
+    return TNN_OK;
+}
+
+static Status ConvertNNV12ToFloatBlob(Mat& image, char* handle_ptr,
+                                      const MatConvertParam& param, const DimsVector& dims,
+                                      const int hw, const int c_r4,
+                                      std::vector<float>& scale, std::vector<float>& bias) {
+    Mat bgr = GetBGRFromYUV(image, dims, hw, true);
+    return ConvertN8UC3ToFloatBlob(bgr, handle_ptr, param, dims, hw, c_r4, scale, bias);
+}
+
+static Status ConvertNNV21ToFloatBlob(Mat& image, char* handle_ptr,
+                                      const MatConvertParam& param, const DimsVector& dims,
+                                      const int hw, const int c_r4,
+                                      std::vector<float>& scale, std::vector<float>& bias) {
+    Mat bgr = GetBGRFromYUV(image, dims, hw, false);
+    return ConvertN8UC3ToFloatBlob(bgr, handle_ptr, param, dims, hw, c_r4, scale, bias);
+}
+
+REGISTER_X86_BLOB_CONVERT_FUNC(N8UC4,               DATA_TYPE_FLOAT, CVT_DIR_MAT2BLOB, ConvertN8UC4ToFloatBlob)
+REGISTER_X86_BLOB_CONVERT_FUNC(N8UC3,               DATA_TYPE_FLOAT, CVT_DIR_MAT2BLOB, ConvertN8UC3ToFloatBlob)
+REGISTER_X86_BLOB_CONVERT_FUNC(NGRAY,               DATA_TYPE_FLOAT, CVT_DIR_MAT2BLOB, ConvertNGRAYToFloatBlob)
+REGISTER_X86_BLOB_CONVERT_FUNC(NNV12,               DATA_TYPE_FLOAT, CVT_DIR_MAT2BLOB, ConvertNNV12ToFloatBlob)
+REGISTER_X86_BLOB_CONVERT_FUNC(NNV21,               DATA_TYPE_FLOAT, CVT_DIR_MAT2BLOB, ConvertNNV21ToFloatBlob)
+
 template <bool reverse_channel>
 static void BlobToBGRAImpl(const int8_t *src, uint8_t *dst, const float *scale, const float *bias,
                            int hw, int channel) {
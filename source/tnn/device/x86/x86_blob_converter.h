@@ -51,6 +51,9 @@ public:
                                           X86BlobConvertFunc cvt_func);
 
 private:
+    Status ConvertToMatImpl(Mat& image, MatConvertParam param);
+    Status ConvertFromMatImpl(Mat& image, MatConvertParam param);
+
     std::vector<float> fused_int8_scale;
     std::vector<float> fused_int8_bias;
     X86BlobConvertFunc cvt_func_;
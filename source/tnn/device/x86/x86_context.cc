@@ -22,11 +22,24 @@ Status X86Context::LoadLibrary(std::vector<std::string> path) {
 }
 
 Status X86Context::GetCommandQueue(void** command_queue) {
+    *command_queue = task_queue_.get();
+    return TNN_OK;
+}
+
+Status X86Context::ShareCommandQueue(Context* context) {
+    auto context_target = dynamic_cast<X86Context *>(context);
+    if (!context_target) {
+        return Status(TNNERR_DEVICE_CONTEXT_CREATE, "inpute context is not X86Context");
+    }
+
+    task_queue_ = context_target->task_queue_;
     return TNN_OK;
 }
 
 Status X86Context::OnInstanceForwardBegin() {
     Context::OnInstanceForwardBegin();
+    // jobs enqueued before, e.g. async input conversion, must finish first
+    RETURN_ON_NEQ(task_queue_->Wait(), TNN_OK);
     OMP_SET_THREADS_(GetNumThreads());
     return TNN_OK;
 }
@@ -35,7 +48,22 @@ Status X86Context::OnInstanceForwardEnd() {
     return TNN_OK;
 }
 
+Status X86Context::OnInstanceReshapeBegin() {
+    return task_queue_->Wait();
+}
+
 Status X86Context::Synchronize() {
+    return task_queue_->Wait();
+}
+
+Status X86Context::RunAsync(std::function<Status(void)> task, Callback call_back) {
+    task_queue_->Enqueue([task, call_back]() -> Status {
+        Status status = task();
+        if (call_back) {
+            call_back();
+        }
+        return status;
+    });
     return TNN_OK;
 }
 
@@ -53,6 +81,10 @@ void* X86Context::GetSharedWorkSpace(size_t size) {
 }
 
 void* X86Context::GetSharedWorkSpace(size_t size, int index) {
+    // the lazily grown buffer is only left for shapes larger than the planned ones
+    if (index == 0 && planned_work_space_ != nullptr && size <= planned_work_space_size_) {
+        return planned_work_space_;
+    }
     while(work_space_.size() < index + 1) {
         work_space_.push_back(RawBuffer(size, 32));
     }
@@ -62,4 +94,9 @@ void* X86Context::GetSharedWorkSpace(size_t size, int index) {
     return work_space_[index].force_to<void*>();
 }
 
+void X86Context::SetWorkspace(void* workspace, size_t size) {
+    planned_work_space_      = workspace;
+    planned_work_space_size_ = workspace != nullptr ? size : 0;
+}
+
 }  // namespace TNN_NS
@@ -15,11 +15,13 @@
 #ifndef TNN_SOURCE_TNN_DEVICE_X86_X86_CONTEXT_H_
 #define TNN_SOURCE_TNN_DEVICE_X86_X86_CONTEXT_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "tnn/core/context.h"
 #include "tnn/interpreter/raw_buffer.h"
+#include "tnn/utils/async_task_queue.h"
 
 namespace TNN_NS {
 
@@ -32,15 +34,24 @@ public:
     // @param command_queue device command queue for forward
     virtual Status GetCommandQueue(void** command_queue) override;
 
+    // @brief share tnn command queue to another context
+    virtual Status ShareCommandQueue(Context* context) override;
+
     // @brief before instance forward
     virtual Status OnInstanceForwardBegin() override;
 
     // @brief after instance forward
     virtual Status OnInstanceForwardEnd() override;
 
+    // @brief before instance Reshape
+    virtual Status OnInstanceReshapeBegin() override;
+
     // @brief wait for jobs in the current context to complete
     virtual Status Synchronize() override;
 
+    // @brief run task on the task queue and return at once
+    virtual Status RunAsync(std::function<Status(void)> task, Callback call_back) override;
+
     // @brief set threads run on device
     virtual Status SetNumThreads(int num_threads) override;
 
@@ -50,9 +61,16 @@ public:
     void* GetSharedWorkSpace(size_t size);
     void* GetSharedWorkSpace(size_t size, int index);
 
+    // @brief set the workspace planned in the forward memory for the running layer, it backs
+    // GetSharedWorkSpace(size) if it is large enough. nullptr if the layer has none.
+    void SetWorkspace(void* workspace, size_t size);
+
 private:
     int num_threads_ = 1;
+    std::shared_ptr<AsyncTaskQueue> task_queue_ = std::make_shared<AsyncTaskQueue>();
     std::vector<RawBuffer> work_space_;
+    void* planned_work_space_       = nullptr;
+    size_t planned_work_space_size_ = 0;
 };
 
 }  // namespace TNN_NS
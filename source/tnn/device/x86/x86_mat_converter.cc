@@ -284,6 +284,93 @@ Status X86MatConverterAcc::CopyMakeBorder(Mat& src, Mat& dst, CopyMakeBorderPara
     return ret;
 }
 
+static Status CheckPreprocessParam(MatType mat_type, const PreprocessParam& param) {
+    if (mat_type != NGRAY && mat_type != N8UC3 && mat_type != N8UC4 && mat_type != NNV21 && mat_type != NNV12) {
+        return Status(TNNERR_PARAM_ERR, "X86MatConverterAcc::Preprocess, convert type not support yet");
+    }
+    if (mat_type == NNV21 || mat_type == NNV12) {
+        if (param.crop.top_left_x % 2 || param.crop.top_left_y % 2 || param.crop.width % 2 || param.crop.height % 2) {
+            return Status(TNNERR_PARAM_ERR, "corp param can not be odd");
+        }
+    }
+    if (param.interp_type != INTERP_TYPE_LINEAR && param.interp_type != INTERP_TYPE_NEAREST) {
+        return Status(TNNERR_PARAM_ERR, "interpolation type not support yet");
+    }
+    if (param.crop.width < 2 || param.crop.height < 2) {
+        return Status(TNNERR_PARAM_ERR, "X86MatConverterAcc::Preprocess, roi size is too small");
+    }
+
+    return TNN_OK;
+}
+
+Status X86MatConverterAcc::Preprocess(Mat& src, Mat& dst, PreprocessParam param, void* command_queue) {
+    Status ret = TNN_OK;
+
+    ret = CheckMatConverterParams(src, dst, true);
+    if (ret != TNN_OK)
+        return ret;
+
+    auto mat_type = src.GetMatType();
+    ret           = CheckPreprocessParam(mat_type, param);
+    if (ret != TNN_OK)
+        return ret;
+
+    PreprocessToNCHW((uint8_t*)src.GetData(), mat_type, src.GetBatch(), src.GetWidth(), src.GetHeight(),
+                     (float*)dst.GetData(), dst.GetChannel(), dst.GetWidth(), dst.GetHeight(), param);
+
+    return ret;
+}
+
+Status X86MatConverterAcc::PreprocessBatch(Mat& src, Mat& dst, std::vector<PreprocessParam>& params,
+                                           void* command_queue) {
+    Status ret = TNN_OK;
+
+    ret = CheckMatConverterParams(src, dst, true);
+    if (ret != TNN_OK)
+        return ret;
+
+    auto mat_type = src.GetMatType();
+    for (const auto& param : params) {
+        ret = CheckPreprocessParam(mat_type, param);
+        if (ret != TNN_OK)
+            return ret;
+    }
+
+    PreprocessBatchToNCHW((uint8_t*)src.GetData(), mat_type, src.GetWidth(), src.GetHeight(), (float*)dst.GetData(),
+                          dst.GetChannel(), dst.GetWidth(), dst.GetHeight(), params);
+
+    return ret;
+}
+
+Status X86MatConverterAcc::WarpAffineBatch(Mat& src, Mat& dst, std::vector<WarpAffineParam>& params,
+                                           void* command_queue) {
+    Status ret = TNN_OK;
+
+    ret = CheckMatConverterParams(src, dst, true);
+    if (ret != TNN_OK)
+        return ret;
+
+    if (dst.GetWidth() == 0 || dst.GetHeight() == 0) {
+        return Status(TNNERR_INVALID_INPUT, "dst size is zero");
+    }
+
+    auto mat_type = src.GetMatType();
+    if (mat_type != NGRAY && mat_type != N8UC3 && mat_type != N8UC4 && mat_type != NNV21 && mat_type != NNV12) {
+        return Status(TNNERR_PARAM_ERR, "X86MatConverterAcc::WarpAffineBatch, convert type not support yet");
+    }
+    for (const auto& param : params) {
+        if ((param.interp_type != INTERP_TYPE_LINEAR && param.interp_type != INTERP_TYPE_NEAREST) ||
+            param.border_type != BORDER_TYPE_CONSTANT) {
+            return Status(TNNERR_PARAM_ERR, "warpaffine type not support yet");
+        }
+    }
+
+    x86::WarpAffineBatch((uint8_t*)src.GetData(), mat_type, src.GetWidth(), src.GetHeight(), (uint8_t*)dst.GetData(),
+                         dst.GetWidth(), dst.GetHeight(), params);
+
+    return ret;
+}
+
 DECLARE_MAT_CONVERTER_CREATER(X86);
 REGISTER_MAT_CONVERTER(X86, DEVICE_X86);
 
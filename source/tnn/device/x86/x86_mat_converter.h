@@ -29,6 +29,11 @@ public:
     virtual Status WarpAffine(Mat& src, Mat& dst, WarpAffineParam param, void* command_queue = NULL);
     virtual Status CvtColor(Mat& src, Mat& dst, ColorConversionType type, void* command_queue = NULL);
     virtual Status CopyMakeBorder(Mat& src, Mat& dst, CopyMakeBorderParam param, void* command_queue = NULL);
+    virtual Status Preprocess(Mat& src, Mat& dst, PreprocessParam param, void* command_queue = NULL);
+    virtual Status PreprocessBatch(Mat& src, Mat& dst, std::vector<PreprocessParam>& params,
+                                   void* command_queue = NULL);
+    virtual Status WarpAffineBatch(Mat& src, Mat& dst, std::vector<WarpAffineParam>& params,
+                                   void* command_queue = NULL);
 };
 
 }  // namespace TNN_NS
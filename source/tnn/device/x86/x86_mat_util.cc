@@ -1104,6 +1104,201 @@ void ResizeNearestYUV420sp(const uint8_t* src, int batch, int src_w, int src_h,
     }
 }
 
+/*
+fused preprocess
+*/
+
+void NormalizeToNCHW(const uint8_t* src, int src_c, int count, float* dst, int dst_c, int dst_plane,
+                     const float* scale, const float* bias, bool reverse_channel) {
+    for (int c = 0; c < dst_c; ++c) {
+        int sc               = (reverse_channel && c < 3 && src_c >= 3) ? 2 - c : c;
+        const uint8_t* src_p = src + sc;
+        float* dst_p         = dst + c * dst_plane;
+        int i                = 0;
+#ifdef __SSE4_2__
+        __m128i _mask = _mm_setr_epi8(0, src_c, 2 * src_c, 3 * src_c, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+        __m128 _scale = _mm_set1_ps(scale[c]);
+        __m128 _bias  = _mm_set1_ps(bias[c]);
+        // keep the 16 bytes load inside src
+        for (; i + 4 <= count && (i * src_c + sc + 16) <= count * src_c; i += 4) {
+            __m128i _src = _mm_loadu_si128((__m128i*)(src_p + i * src_c));
+            __m128 _val  = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_shuffle_epi8(_src, _mask)));
+            _mm_storeu_ps(dst_p + i, _mm_add_ps(_mm_mul_ps(_val, _scale), _bias));
+        }
+#endif
+        for (; i < count; ++i) {
+            dst_p[i] = scale[c] * src_p[i * src_c] + bias[c];
+        }
+    }
+}
+
+// same formula as NaiveYUVToBGROrBGRA, one row at a time
+template <bool is_nv12>
+static void YUV420spRowToBGR(const uint8_t* yptr, const uint8_t* vuptr, uint8_t* bgr, int w) {
+    for (int x = 0; x < w; x += 2) {
+        int u = (vuptr[is_nv12 ? 0 : 1] > 240 ? 240 : vuptr[is_nv12 ? 0 : 1]) - 128;
+        int v = (vuptr[is_nv12 ? 1 : 0] > 240 ? 240 : vuptr[is_nv12 ? 1 : 0]) - 128;
+
+        int ruv = 102 * v;
+        int guv = -52 * v + -25 * u;
+        int buv = 129 * u;
+
+        for (int i = 0; i < 2; ++i) {
+            int y  = yptr[i] * 74 - 1135;
+            bgr[0] = (uint8_t)std::min(std::max((y + buv) >> 6, 0), 255);
+            bgr[1] = (uint8_t)std::min(std::max((y + guv) >> 6, 0), 255);
+            bgr[2] = (uint8_t)std::min(std::max((y + ruv) >> 6, 0), 255);
+            bgr += 3;
+        }
+        yptr += 2;
+        vuptr += 2;
+    }
+}
+
+// express nearest interpolation as bilinear weights of 0 and 1, so both share the same row kernel
+static void GetResizeBufNearestAsBilinear(int src_w, int src_h, int w, int h, int c, int** buf) {
+    const short coef_scale = 1 << 11;
+    int* nearest_buf       = nullptr;
+    GetResizeBufNearset(src_w, src_h, w, h, c, &nearest_buf);
+
+    *buf = new int[w + h + w + h];
+    memcpy(*buf, nearest_buf, (w + h) * sizeof(int));
+    uint8_t* mask_x = (uint8_t*)(nearest_buf + w + h);
+    uint8_t* mask_y = (uint8_t*)(nearest_buf + w + h + w);
+    short* ialpha   = (short*)(*buf + w + h);
+    short* ibeta    = (short*)(*buf + w + h + w);
+    for (int x = 0; x < w; ++x) {
+        ialpha[2 * x]     = mask_x[x] ? coef_scale : 0;
+        ialpha[2 * x + 1] = coef_scale - ialpha[2 * x];
+    }
+    for (int y = 0; y < h; ++y) {
+        ibeta[2 * y]     = mask_y[y] ? coef_scale : 0;
+        ibeta[2 * y + 1] = coef_scale - ibeta[2 * y];
+    }
+
+    delete[] nearest_buf;
+}
+
+/*
+each dst row is produced from at most two cached src rows: yuv rows are converted to bgr,
+interpolated horizontally and vertically, then scattered into the nchw planes. all intermediates
+are single rows per thread, no intermediate mat is allocated.
+*/
+template <int channel>
+static void PreprocessImpl(const uint8_t* src, MatType src_type, int batch, int src_w, int src_h, float* dst, int dst_c,
+                           int w, int h, const PreprocessParam& param) {
+    const bool is_yuv  = src_type == NNV12 || src_type == NNV21;
+    const bool is_nv12 = src_type == NNV12;
+    const auto& crop   = param.crop;
+
+    int* buf = nullptr;
+    if (param.interp_type == INTERP_TYPE_NEAREST) {
+        GetResizeBufNearestAsBilinear(crop.width, crop.height, w, h, channel, &buf);
+    } else {
+        GetResizeBuf(crop.width, crop.height, w, h, channel, &buf);
+    }
+    int* xofs     = buf;
+    int* yofs     = buf + w;
+    short* ialpha = (short*)(buf + w + h);
+    short* ibeta  = (short*)(buf + w + h + w);
+
+    int src_stride = is_yuv ? src_w : src_w * channel;
+    int src_plane  = is_yuv ? src_w * src_h * 3 / 2 : src_h * src_stride;
+    int bgr_stride = crop.width * channel;
+    int dst_plane  = w * h;
+
+    // per thread row buffers, extra space for the simd stores in ResizeGetAdjacentRows
+    int max_num_threads = OMP_MAX_THREADS_NUM_;
+    int rows_size       = w * channel + 4;
+    int row_u8_size     = w * channel + 16;
+    short* rows0        = new short[rows_size * max_num_threads];
+    short* rows1        = new short[rows_size * max_num_threads];
+    uint8_t* rows_u8    = new uint8_t[row_u8_size * max_num_threads];
+    uint8_t* rows_bgr   = is_yuv ? new uint8_t[bgr_stride * 2 * max_num_threads] : nullptr;
+    short** rows0_t     = new short*[max_num_threads];
+    short** rows1_t     = new short*[max_num_threads];
+    int* prev_sy        = new int[max_num_threads];
+
+    for (int b = 0; b < batch; ++b) {
+        const uint8_t* src_b = src + b * src_plane;
+        const uint8_t* roi   = src_b + crop.top_left_y * src_stride + crop.top_left_x * (is_yuv ? 1 : channel);
+        float* dst_b         = dst + b * dst_c * dst_plane;
+
+        for (int t = 0; t < max_num_threads; ++t) {
+            prev_sy[t] = -2;
+            rows0_t[t] = rows0 + t * rows_size;
+            rows1_t[t] = rows1 + t * rows_size;
+        }
+
+        OMP_PARALLEL_FOR_
+        for (int dy = 0; dy < h; dy++) {
+            int thread_id = OMP_TID_;
+            int sy        = yofs[dy];
+            if (is_yuv) {
+                uint8_t* bgr    = rows_bgr + thread_id * bgr_stride * 2;
+                const auto* vu  = src_b + src_w * src_h + crop.top_left_x;
+                auto cvt_row    = is_nv12 ? YUV420spRowToBGR<true> : YUV420spRowToBGR<false>;
+                if (sy == prev_sy[thread_id] + 1) {
+                    int y = crop.top_left_y + sy + 1;
+                    cvt_row(roi + (sy + 1) * src_stride, vu + (y / 2) * src_w, bgr + bgr_stride, crop.width);
+                    ResizeGetAdjacentRows<channel>(0, -1, &rows0_t[thread_id], &rows1_t[thread_id], xofs, bgr,
+                                                   bgr_stride, w, ialpha);
+                } else if (sy != prev_sy[thread_id]) {
+                    for (int i = 0; i < 2; ++i) {
+                        int y = crop.top_left_y + sy + i;
+                        cvt_row(roi + (sy + i) * src_stride, vu + (y / 2) * src_w, bgr + i * bgr_stride, crop.width);
+                    }
+                    ResizeGetAdjacentRows<channel>(0, -2, &rows0_t[thread_id], &rows1_t[thread_id], xofs, bgr,
+                                                   bgr_stride, w, ialpha);
+                }
+            } else {
+                ResizeGetAdjacentRows<channel>(sy, prev_sy[thread_id], &rows0_t[thread_id], &rows1_t[thread_id], xofs,
+                                               roi, src_stride, w, ialpha);
+            }
+            prev_sy[thread_id] = sy;
+
+            uint8_t* row_u8 = rows_u8 + thread_id * row_u8_size;
+            ResizeCalculateOneRow(rows0_t[thread_id], rows1_t[thread_id], ibeta[dy * 2], ibeta[dy * 2 + 1], w, channel,
+                                  row_u8);
+            NormalizeToNCHW(row_u8, channel, w, dst_b + dy * w, dst_c, dst_plane, param.scale.data(),
+                            param.bias.data(), param.reverse_channel);
+        }
+    }
+
+    delete[] rows0;
+    delete[] rows1;
+    delete[] rows_u8;
+    delete[] rows_bgr;
+    delete[] rows0_t;
+    delete[] rows1_t;
+    delete[] prev_sy;
+    delete[] buf;
+}
+
+void PreprocessToNCHW(const uint8_t* src, MatType src_type, int batch, int src_w, int src_h, float* dst, int dst_c,
+                      int w, int h, const PreprocessParam& param) {
+    if (src_type == NGRAY) {
+        PreprocessImpl<1>(src, src_type, batch, src_w, src_h, dst, dst_c, w, h, param);
+    } else if (src_type == N8UC4) {
+        PreprocessImpl<4>(src, src_type, batch, src_w, src_h, dst, dst_c, w, h, param);
+    } else {
+        PreprocessImpl<3>(src, src_type, batch, src_w, src_h, dst, dst_c, w, h, param);
+    }
+}
+
+/*
+the kernels called inside the roi loop open their own parallel regions, which run with one thread when nested
+in the roi loop. their row buffers are allocated per call, so rois never share buffers.
+*/
+void PreprocessBatchToNCHW(const uint8_t* src, MatType src_type, int src_w, int src_h, float* dst, int dst_c, int w,
+                           int h, const std::vector<PreprocessParam>& params) {
+    int roi_count = (int)params.size();
+    OMP_PARALLEL_FOR_DYNAMIC_
+    for (int n = 0; n < roi_count; ++n) {
+        PreprocessToNCHW(src, src_type, 1, src_w, src_h, dst + n * dst_c * w * h, dst_c, w, h, params[n]);
+    }
+}
+
 #define INTER_REMAP_COEF_BITS 15
 #define INTER_REMAP_COEF_SCALE (1 << INTER_REMAP_COEF_BITS)
 #define INTER_BITS 5
@@ -1116,12 +1311,7 @@ static short BilinearTab_i[INTER_TAB_SIZE * INTER_TAB_SIZE][KSIZE][KSIZE];
 // (1*31/32, 0*31/32, 1*1/32,  0*1/32) , ... , (1/32*31/32, 31/32*31/32, 1/32*1/32,  31/32*1/32)
 //                                       ...
 // (1*1/32,  0*1/32,  1*31/32, 0*31/32), ... , (1/32*1/32,  31/32*1/32,  1/32*31/32, 31/32*31/32)
-static void InitInterTab2D() {
-    static bool inited = false;
-    if (inited) {
-        return;
-    }
-
+static bool InitInterTab2DImpl() {
     short* itab = BilinearTab_i[0][0];
     int ksize   = KSIZE;
 
@@ -1159,6 +1349,13 @@ static void InitInterTab2D() {
     }
 
     delete[] _tab;
+    return true;
+}
+
+// the table is shared by all warp affine calls, build it only once and thread safe
+static void InitInterTab2D() {
+    static bool inited = InitInterTab2DImpl();
+    (void)inited;
 }
 
 // The buffer contains adelta and bdelta, which are used to calculate src position (src_x, src_y)
@@ -1826,7 +2023,7 @@ static void WarpAffineNearest(const uint8_t* src, int batch, int src_w, int src_
         }
     }
 
-    free(buffer);
+    x86Free(buffer);
 }
 
 void WarpAffineNearestC1(const uint8_t* src, int batch, int src_w, int src_h, uint8_t* dst, int dst_w, int dst_h,
@@ -1870,5 +2067,42 @@ void WarpAffineNearestYUV420sp(const uint8_t* src, int batch, int src_w, int src
     }
 }
 
+typedef void (*WarpAffineFunc)(const uint8_t* src, int batch, int src_w, int src_h, uint8_t* dst, int w, int h,
+                               const float (*transform)[3], const float border_val);
+
+static WarpAffineFunc GetWarpAffineFunc(MatType mat_type, InterpType interp_type) {
+    bool linear = interp_type == INTERP_TYPE_LINEAR;
+    switch (mat_type) {
+        case NGRAY:
+            return linear ? WarpAffineBilinearC1 : WarpAffineNearestC1;
+        case N8UC3:
+            return linear ? WarpAffineBilinearC3 : WarpAffineNearestC3;
+        case N8UC4:
+            return linear ? WarpAffineBilinearC4 : WarpAffineNearestC4;
+        case NNV12:
+        case NNV21:
+            return linear ? WarpAffineBilinearYUV420sp : WarpAffineNearestYUV420sp;
+        default:
+            return nullptr;
+    }
+}
+
+// same as PreprocessBatchToNCHW, the kernels run with one thread inside the roi loop
+void WarpAffineBatch(const uint8_t* src, MatType mat_type, int src_w, int src_h, uint8_t* dst, int w, int h,
+                     const std::vector<WarpAffineParam>& params) {
+    int dst_plane = w * h * (mat_type == NGRAY ? 1 : (mat_type == N8UC4 ? 4 : 3));
+    if (mat_type == NNV12 || mat_type == NNV21) {
+        dst_plane = w * h * 3 / 2;
+    }
+    int roi_count = (int)params.size();
+
+    InitInterTab2D();
+    OMP_PARALLEL_FOR_DYNAMIC_
+    for (int n = 0; n < roi_count; ++n) {
+        auto func = GetWarpAffineFunc(mat_type, params[n].interp_type);
+        func(src, 1, src_w, src_h, dst + n * dst_plane, w, h, params[n].transform, params[n].border_val);
+    }
+}
+
 }  // namespace x86
 }  // namespace TNN_NS
@@ -17,10 +17,13 @@
 
 #include <string.h>
 #include <cstdlib>
+#include <vector>
 
 #include "tnn/core/blob.h"
 #include "tnn/core/macro.h"
+#include "tnn/core/mat.h"
 #include "tnn/utils/bfp16.h"
+#include "tnn/utils/mat_utils.h"
 
 namespace TNN_NS {
 namespace x86 {
@@ -55,6 +58,18 @@ void ResizeNearestC3(const uint8_t* src, int batch, int src_w, int src_h, uint8_
 void ResizeNearestC4(const uint8_t* src, int batch, int src_w, int src_h, uint8_t* dst, int w, int h);
 void ResizeNearestYUV420sp(const uint8_t* src, int batch, int src_w, int src_h, uint8_t* dst, int w, int h);
 
+// convert interleaved uint8 pixels to nchw float planes, dst[c][i] = scale[c] * src[i][c] + bias[c]
+void NormalizeToNCHW(const uint8_t* src, int src_c, int count, float* dst, int dst_c, int dst_plane,
+                     const float* scale, const float* bias, bool reverse_channel);
+
+// fused crop + color convert + resize + normalize, param.crop must be a valid roi of src
+void PreprocessToNCHW(const uint8_t* src, MatType src_type, int batch, int src_w, int src_h, float* dst, int dst_c,
+                      int w, int h, const PreprocessParam& param);
+
+// PreprocessToNCHW for every param on one src image, the result of params[n] is written to batch n of dst
+void PreprocessBatchToNCHW(const uint8_t* src, MatType src_type, int src_w, int src_h, float* dst, int dst_c, int w,
+                           int h, const std::vector<PreprocessParam>& params);
+
 // warp affine
 void WarpAffineBilinearC1(const uint8_t* src, int batch, int src_w, int src_h, uint8_t* dst, int w, int h,
                           const float (*transform)[3], const float border_val = 0.0);
@@ -78,6 +93,10 @@ void WarpAffineNearestC4(const uint8_t* src, int batch, int src_w, int src_h, ui
 void WarpAffineNearestYUV420sp(const uint8_t* src, int batch, int src_w, int src_h, uint8_t* dst, int w, int h,
                                const float (*transform)[3], const float border_val = 0.0);
 
+// warp one src image with every param, the result of params[n] is written to batch n of dst
+void WarpAffineBatch(const uint8_t* src, MatType mat_type, int src_w, int src_h, uint8_t* dst, int w, int h,
+                     const std::vector<WarpAffineParam>& params);
+
 }  // namespace x86
 }  // namespace TNN_NS
 
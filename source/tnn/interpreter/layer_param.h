@@ -617,6 +617,34 @@ struct LSTMONNXLayerParam : public LayerParam {
     PARAM_COPY(LSTMONNXLayerParam)
 };
 
+struct GRUONNXLayerParam : public LayerParam {
+    float clip_threshold = 0;
+    int hidden_size      = 0;
+    // 0: forward 1:reverse 2:bidirection
+    int direction = 0;
+    // 1: apply the recurrence weight of the hidden gate before multiplying by the reset gate, as pytorch does
+    int linear_before_reset = 0;
+
+    PARAM_COPY(GRUONNXLayerParam)
+};
+
+struct EffectiveTransformerLayerParam : public LayerParam {
+    // true: [batch, seq_len, ...] and the mask to the tokens packed as [1, num_tokens, ...] and the token index.
+    // false: the packed tokens and the token index back to [batch, seq_len, ...] with the padding as 0.
+    bool is_remove_padding = false;
+
+    PARAM_COPY(EffectiveTransformerLayerParam)
+};
+
+struct KVCacheLayerParam : public LayerParam {
+    // the axis of the positions, the input is appended to the cache along it
+    int axis = 2;
+    // the number of positions the cache holds at most
+    int max_length = 0;
+
+    PARAM_COPY(KVCacheLayerParam)
+};
+
 struct ExpandLayerParam : public LayerParam {
     std::vector<int> shape;
 
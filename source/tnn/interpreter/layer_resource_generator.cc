@@ -531,6 +531,52 @@ class LSTMONNXLayerResourceGenerator : public LayerResourceGenerator {
     }
 };
 
+class GRUONNXLayerResourceGenerator : public LayerResourceGenerator {
+    virtual Status GenLayerConstantResource(LayerParam* param, LayerResource** resource,
+                                            std::vector<Blob*>& inputs, ConstantResource* consts) {
+        LOGD("GRUONNXLayerResourceGenerator\n");
+        auto layer_param = dynamic_cast<GRUONNXLayerParam*>(param);
+        CHECK_PARAM_NULL(layer_param);
+
+        auto fill_map_for_blob = [&](Blob *blob) {
+            if (blob == nullptr)
+                return;
+            auto blob_name = blob->GetBlobDesc().name;
+            auto data_type = blob->GetBlobDesc().data_type;
+            auto count = DimsVectorUtils::Count(blob->GetBlobDesc().dims);
+            if (consts->count(blob_name) > 0) {
+                return;
+            }
+            if (data_type == DATA_TYPE_FLOAT) {
+                auto buffer = std::make_shared<RawBuffer>(count * sizeof(float));
+                buffer->SetBufferDims(blob->GetBlobDesc().dims);
+                buffer->SetDataType(DATA_TYPE_FLOAT);
+                InitRandom(buffer->force_to<float *>(), count, 1.0f);
+                (*consts)[blob_name] = buffer;
+            } else if (data_type == DATA_TYPE_HALF) {
+                auto buffer = std::make_shared<RawBuffer>(count * sizeof(fp16_t));
+                buffer->SetBufferDims(blob->GetBlobDesc().dims);
+                buffer->SetDataType(DATA_TYPE_HALF);
+                InitRandom(buffer->force_to<fp16_t *>(), count, fp16_t(1));
+                (*consts)[blob_name] = buffer;
+            }
+        };
+
+        fill_map_for_blob(inputs[1]);
+        fill_map_for_blob(inputs[2]);
+        fill_map_for_blob(inputs[3]);
+
+        if (inputs.size() == 5) {
+            fill_map_for_blob(inputs[4]);
+        }
+        return TNN_OK;
+    }
+
+    virtual Status ConvertHalfLayerResource(LayerResource* fp16_res, LayerResource** fp32_res) {
+        return TNN_OK;
+    }
+};
+
 /*
  * Generate weights for Binary
  */
@@ -592,5 +638,6 @@ REGISTER_LAYER_RESOURCE(HdrGuide, LAYER_HDRGUIDE);
 REGISTER_LAYER_RESOURCE(MatMul, LAYER_MATMUL);
 
 REGISTER_LAYER_CONSTANT_RESOURCE(LSTMONNX, LAYER_LSTMONNX);
+REGISTER_LAYER_CONSTANT_RESOURCE(GRUONNX, LAYER_GRUONNX);
 
 }  // namespace TNN_NS
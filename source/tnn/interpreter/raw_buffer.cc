@@ -17,6 +17,7 @@
 #include <string>
 #include <typeinfo>
 #include <utility>
+#include "tnn/core/profile.h"
 #include "tnn/utils/bfp16.h"
 #include "tnn/utils/bfp16_utils.h"
 #include "tnn/utils/data_type_utils.h"
@@ -36,6 +37,7 @@ RawBuffer::RawBuffer(int bytes_size) {
     if (bytes_size > 0) {
         buff_ = shared_ptr<char>(new char[bytes_size], [](char *p) { delete[] p; });
         memset(buff_.get(), 0, bytes_size);
+        InitProfileCollector::AddAllocatedBytes(bytes_size);
     } else {
         buff_ = nullptr;
     }
@@ -51,6 +53,7 @@ RawBuffer::RawBuffer(int bytes_size, char *buffer) {
     if (bytes_size > 0) {
         buff_ = shared_ptr<char>(new char[bytes_size], [](char *p) { delete[] p; });
         memcpy(buff_.get(), buffer, bytes_size);
+        InitProfileCollector::AddAllocatedBytes(bytes_size);
     } else {
         buff_ = nullptr;
     }
@@ -96,6 +99,7 @@ RawBuffer::RawBuffer(int bytes_size, int alignment) {
     buff_ = shared_ptr<char>(static_cast<char*>(aligned_malloc(bytes_size, alignment)), &aligned_free);
     memset(buff_.get(), 0, bytes_size);
     bytes_size_ = bytes_size;
+    InitProfileCollector::AddAllocatedBytes(bytes_size);
 }
 
 template <typename T>
@@ -143,6 +147,7 @@ void RawBuffer::buffer(char *buf, int bytes_size) {
     }
     if (!buff_) {
         buff_ = shared_ptr<char>(new char[bytes_size_], [](char *p) { delete[] p; });
+        InitProfileCollector::AddAllocatedBytes(bytes_size_);
     }
     memcpy(buff_.get(), buf, bytes_size);
     // buff_ = buf;
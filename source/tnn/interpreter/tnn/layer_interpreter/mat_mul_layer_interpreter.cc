@@ -56,7 +56,7 @@ Status MatMulLayerInterpreter::SaveProto(std::ofstream& output_stream, LayerPara
 Status MatMulLayerInterpreter::SaveResource(Serializer& serializer, LayerParam* param, LayerResource* resource) {
     CAST_OR_RET_ERROR(layer_res, MatMulLayerResource, "invalid layer res to save", resource);
     serializer.PutRaw(layer_res->weight);
-    if (param->dynamic_range_quantized) {
+    if (layer_res->weight.GetDataType() == DATA_TYPE_INT8) {
         serializer.PutRaw(layer_res->scale_handle);
     }
     return TNN_OK;
@@ -14,9 +14,13 @@
 
 #include "tnn/interpreter/tnn/model_interpreter.h"
 #include <stdlib.h>
+#include <algorithm>
+#include <atomic>
 #include <sstream>
+#include <thread>
 
 #include "tnn/core/common.h"
+#include "tnn/core/profile.h"
 #include "tnn/interpreter/tnn/layer_interpreter/abstract_layer_interpreter.h"
 #include "tnn/interpreter/tnn/objseri.h"
 #include "tnn/utils/md5.h"
@@ -39,6 +43,51 @@ std::shared_ptr<Deserializer> ModelInterpreter::GetDeserializer(std::istream &is
     return std::make_shared<Deserializer>(is);
 }
 
+// read only stream buffer over the model content, seekable and without copying it
+class ModelStreamBuffer : public std::streambuf {
+public:
+    ModelStreamBuffer(const char *data, size_t size) {
+        char *begin = const_cast<char *>(data);
+        setg(begin, begin, begin + size);
+    }
+
+protected:
+    virtual pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                             std::ios_base::openmode which = std::ios_base::in) {
+        char *pos = gptr();
+        if (dir == std::ios_base::beg) {
+            pos = eback() + off;
+        } else if (dir == std::ios_base::end) {
+            pos = egptr() + off;
+        } else {
+            pos = gptr() + off;
+        }
+        if (pos < eback() || pos > egptr()) {
+            return pos_type(off_type(-1));
+        }
+        setg(eback(), pos, egptr());
+        return pos_type(pos - eback());
+    }
+
+    virtual pos_type seekpos(pos_type pos, std::ios_base::openmode which = std::ios_base::in) {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+};
+
+// join the thread on every return path
+class ThreadJoiner {
+public:
+    explicit ThreadJoiner(std::thread &thread) : thread_(thread) {}
+    ~ThreadJoiner() {
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+private:
+    std::thread &thread_;
+};
+
 ModelInterpreter::ModelInterpreter() {}
 
 ModelInterpreter::ModelInterpreter(const ModelInterpreter &interp) {
@@ -57,6 +106,7 @@ ModelInterpreter::ModelInterpreter(const ModelInterpreter &interp) {
     *(this->net_resource_) = *interp.net_resource_;
 
     this->params_md5_ = interp.params_md5_;
+    this->load_thread_num_ = interp.load_thread_num_;
 }
 
 ModelInterpreter &ModelInterpreter::operator=(ModelInterpreter interp) {
@@ -78,6 +128,7 @@ ModelInterpreter &ModelInterpreter::operator=(ModelInterpreter interp) {
     *(this->net_resource_) = *interp.net_resource_;
 
     this->params_md5_ = interp.params_md5_;
+    this->load_thread_num_ = interp.load_thread_num_;
 
     return *this;
 }
@@ -115,22 +166,58 @@ Status ModelInterpreter::Interpret(std::vector<std::string> &params) {
             break;
         }
     }
+    // len of "LoadThreadNum:" is 14
+    for (auto iter = params.begin(); iter != params.end(); iter++) {
+        if (iter->size() > 14 && iter->substr(0, 14) == "LoadThreadNum:") {
+            load_thread_num_ = atoi(iter->substr(14).c_str());
+            params.erase(iter);
+            break;
+        }
+    }
 
+    // the md5 doesn't depend on the interpretation, it runs aside while loading with threads
+    std::vector<std::string> params_md5(params.size());
+    auto md5_func = [&]() {
+        for (int i = 0; i < params.size(); ++i) {
+            params_md5[i] = md5(params[i]);
+        }
+    };
+    std::thread md5_thread;
+    ThreadJoiner md5_joiner(md5_thread);
+    if (GetLoadThreadNum() > 1) {
+        md5_thread = std::thread(md5_func);
+    }
+
+    Status status = TNN_OK;
     auto &proto_content = params.size() > 0 ? params[0] : empty_content;
-    Status status       = InterpretProto(proto_content);
-    if (status != TNN_OK) {
-        return status;
+    {
+        InitProfileScope scope("interpret_proto");
+        status = InterpretProto(proto_content);
+        if (status != TNN_OK) {
+            return status;
+        }
     }
 
     auto &model_content = params.size() > 1 ? params[1] : empty_content;
-    status              = InterpretModel(model_content);
-    if (status != TNN_OK) {
-        return status;
+    {
+        InitProfileScope scope("interpret_model");
+        status = InterpretModel(model_content);
+        if (status != TNN_OK) {
+            return status;
+        }
     }
 
-    for (const auto& item : params) {
-        params_md5_.push_back(md5(item));
-        LOGD("model params md5: %s\n", md5(item).c_str());
+    {
+        InitProfileScope scope("md5");
+        if (md5_thread.joinable()) {
+            md5_thread.join();
+        } else {
+            md5_func();
+        }
+        for (const auto& item : params_md5) {
+            params_md5_.push_back(item);
+            LOGD("model params md5: %s\n", params_md5_.back().c_str());
+        }
     }
 
     if (!config_map.empty()) {
@@ -397,6 +484,89 @@ Status ModelInterpreter::InterpretLayer(const std::string &layer_str) {
     return TNN_OK;
 }
 
+Status ModelInterpreter::InterpretLayerSection(Deserializer &deserializer, std::string &layer_name,
+                                               LayerResource **resource) {
+    layer_header ly_head;
+    ly_head.deserialize(deserializer);
+    layer_name = ly_head.name_;
+
+    auto &layer_interpreter_map = GetLayerInterpreterMap();
+    auto layer_interpreter      = layer_interpreter_map[ly_head.type_];
+    // refactor later, layer_interpreter NULL return error_code.
+    if (layer_interpreter == nullptr) {
+        LOGE(
+            "Error: layer_interpreter nil name:%s type_from_str:%s "
+            "type:%d\n",
+            ly_head.name_.c_str(), ly_head.type_str_.c_str(), ly_head.type_);
+        return Status(TNNERR_LOAD_MODEL, "Error: layer_interpreter is nil");
+    }
+    InitProfileScope scope("", ly_head.name_);
+    return layer_interpreter->InterpretResource(deserializer, resource);
+}
+
+int ModelInterpreter::GetLoadThreadNum() {
+    if (load_thread_num_ > 0) {
+        return load_thread_num_;
+    }
+    return std::max((int)std::thread::hardware_concurrency(), 1);
+}
+
+Status ModelInterpreter::InterpretIndexedResources(const std::string &model_content, const model_index &index) {
+    const int count = (int)index.offsets_.size();
+    std::vector<std::string> layer_names(count);
+    std::vector<LayerResource *> layer_resources(count, nullptr);
+
+    // the sections are independent, each thread decodes them through its own stream
+    std::atomic<int> cursor(0);
+    std::vector<Status> thread_status;
+    auto worker_func = [&](int thread_id) {
+        ModelStreamBuffer buffer(model_content.data(), model_content.size());
+        std::istream stream(&buffer);
+        auto deserializer = GetDeserializer(stream);
+        while (true) {
+            int section = cursor++;
+            if (section >= count) {
+                return;
+            }
+            stream.clear();
+            stream.seekg(index.offsets_[section], std::ios::beg);
+            auto status = InterpretLayerSection(*deserializer, layer_names[section], &layer_resources[section]);
+            if (status != TNN_OK) {
+                thread_status[thread_id] = status;
+                cursor                   = count;
+                return;
+            }
+        }
+    };
+
+    const int thread_num = std::min(GetLoadThreadNum(), count);
+    thread_status.resize(std::max(thread_num, 1), TNN_OK);
+    if (thread_num <= 1) {
+        worker_func(0);
+    } else {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < thread_num; ++i) {
+            threads.push_back(std::thread(worker_func, i));
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    }
+
+    NetResource *net_resource = GetNetResource();
+    for (int i = 0; i < count; ++i) {
+        if (layer_resources[i] != nullptr) {
+            net_resource->resource_map[layer_names[i]] = std::shared_ptr<LayerResource>(layer_resources[i]);
+        }
+    }
+    for (auto &status : thread_status) {
+        if (status != TNN_OK) {
+            return status;
+        }
+    }
+    return TNN_OK;
+}
+
 Status ModelInterpreter::InterpretModel(std::string &model_content) {
     NetResource *net_resource = GetNetResource();
 
@@ -410,8 +580,8 @@ Status ModelInterpreter::InterpretModel(std::string &model_content) {
 #endif
     }
 
-    std::istringstream content_stream;
-    content_stream.str(model_content);
+    ModelStreamBuffer content_buffer(model_content.data(), model_content.size());
+    std::istream content_stream(&content_buffer);
 
     uint32_t magic_version_number = 0;
     content_stream.read(reinterpret_cast<char *>(&magic_version_number), sizeof(g_version_magic_number));
@@ -427,36 +597,61 @@ Status ModelInterpreter::InterpretModel(std::string &model_content) {
         return Status(TNNERR_INVALID_MODEL, "Error: model is illegal");
     }
     
-    auto &layer_interpreter_map = GetLayerInterpreterMap();
-    for (int index = 0; index < header.layer_cnt_; ++index) {
-        layer_header ly_head;
-        ly_head.deserialize(*deserializer);
-
-        LayerResource *layer_resource = NULL;
-        auto layer_interpreter        = layer_interpreter_map[ly_head.type_];
-        // refactor later, layer_interpreter NULL return error_code.
-        if (layer_interpreter != nullptr) {
-            Status result = layer_interpreter->InterpretResource(*deserializer, &layer_resource);
-            if (result != TNN_OK) {
-                return result;
+    // indexed model, the layer sections are located by the index at the end of the file
+    model_index index;
+    if (header.indexed_) {
+        if (model_length < sizeof(int64_t) + sizeof(uint32_t)) {
+            return Status(TNNERR_INVALID_MODEL, "Error: model index is missing");
+        }
+        content_stream.seekg(model_length - sizeof(int64_t) - sizeof(uint32_t), std::ios::beg);
+        const int64_t index_offset = deserializer->GetLong();
+        const uint32_t index_magic = static_cast<uint32_t>(deserializer->GetInt());
+        if (index_magic != g_model_index_magic_number || index_offset <= 0 || index_offset >= (int64_t)model_length) {
+            return Status(TNNERR_INVALID_MODEL, "Error: model index is invalid");
+        }
+        content_stream.seekg(index_offset, std::ios::beg);
+        index.deserialize(*deserializer);
+        if ((int)index.offsets_.size() != header.layer_cnt_) {
+            return Status(TNNERR_INVALID_MODEL, "Error: model index does not match the layer count");
+        }
+        for (const auto offset : index.offsets_) {
+            if (offset <= 0 || offset >= index_offset) {
+                return Status(TNNERR_INVALID_MODEL, "Error: model index is invalid");
             }
-            net_resource->resource_map[ly_head.name_] = std::shared_ptr<LayerResource>(layer_resource);
-        } else {
-            LOGE(
-                "Error: layer_interpreter nil name:%s type_from_str:%s "
-                "type:%d\n",
-                ly_head.name_.c_str(), ly_head.type_str_.c_str(), ly_head.type_);
-            return Status(TNNERR_LOAD_MODEL, "Error: layer_interpreter is nil");
+        }
+    }
+
+    if (header.indexed_) {
+        auto status = InterpretIndexedResources(model_content, index);
+        if (status != TNN_OK) {
+            return status;
+        }
+    } else {
+        for (int index_id = 0; index_id < header.layer_cnt_; ++index_id) {
+            std::string layer_name;
+            LayerResource *layer_resource = nullptr;
+            auto status                   = InterpretLayerSection(*deserializer, layer_name, &layer_resource);
+            if (status != TNN_OK) {
+                return status;
+            }
+            net_resource->resource_map[layer_name] = std::shared_ptr<LayerResource>(layer_resource);
         }
     }
 
     //解析constant_map
-    const auto pos_cur = content_stream.tellg();
-    content_stream.seekg(0, std::ios::end);
-    auto pos_diff = content_stream.tellg() - pos_cur;
-    content_stream.seekg(pos_cur, std::ios::beg);
-    if (pos_diff < 4) {
-        return TNN_OK;
+    if (header.indexed_) {
+        if (index.const_map_offset_ <= 0) {
+            return TNN_OK;
+        }
+        content_stream.seekg(index.const_map_offset_, std::ios::beg);
+    } else {
+        const auto pos_cur = content_stream.tellg();
+        content_stream.seekg(0, std::ios::end);
+        auto pos_diff = content_stream.tellg() - pos_cur;
+        content_stream.seekg(pos_cur, std::ios::beg);
+        if (pos_diff < 4) {
+            return TNN_OK;
+        }
     }
 
     uint32_t magic_number_ignore = deserializer->GetInt();
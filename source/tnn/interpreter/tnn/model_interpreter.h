@@ -29,23 +29,64 @@ static const int layer_cfg_start_id    = 5;
 static const int layer_param_start_id  = 4;
 static const int input_layer_cfg_count = 2;
 
+// bit of res_header layer count, set if the layer sections are aligned and indexed
+static const int res_header_indexed_flag = 0x20000000;
+
 // refactor later
 struct res_header : public Serializable {
     int layer_cnt_;
+    bool indexed_;
 
-    res_header() : layer_cnt_(0) {}
+    res_header() : layer_cnt_(0), indexed_(false) {}
 
 public:
     virtual void serialize(Serializer& out) {
-        out.PutInt(layer_cnt_);
+        out.PutInt(indexed_ ? (layer_cnt_ | res_header_indexed_flag) : layer_cnt_);
     }
 
     virtual void deserialize(Deserializer& in) {
         layer_cnt_ = in.GetInt();
+        indexed_   = (layer_cnt_ & res_header_indexed_flag) != 0;
         layer_cnt_ = layer_cnt_ & 0x1FFFFFFF;
     }
 };
 
+// section index of an indexed tnnmodel, written after the constant map and located by the trailer
+// [index offset (int64), g_model_index_magic_number (uint32)] at the end of the file
+struct model_index : public Serializable {
+    std::vector<std::string> names_;
+    // offset of each layer section from the beginning of the model file
+    std::vector<int64_t> offsets_;
+    // 0 if the model has no constant map
+    int64_t const_map_offset_;
+
+    model_index() : const_map_offset_(0) {}
+
+public:
+    virtual void serialize(Serializer& out) {
+        out.PutInt((int)names_.size());
+        for (size_t i = 0; i < names_.size(); ++i) {
+            out.PutString(names_[i]);
+            out.PutLong(offsets_[i]);
+        }
+        out.PutLong(const_map_offset_);
+    }
+
+    virtual void deserialize(Deserializer& in) {
+        int count = in.GetInt();
+        if (count < 0 || count >= 10000) {
+            return;
+        }
+        names_.resize(count);
+        offsets_.resize(count);
+        for (int i = 0; i < count; ++i) {
+            names_[i]   = in.GetString();
+            offsets_[i] = in.GetLong();
+        }
+        const_map_offset_ = in.GetLong();
+    }
+};
+
 struct layer_header : public Serializable {
 public:
     layer_header() {
@@ -121,6 +162,12 @@ protected:
     virtual Status InterpretOutput(const std::string& outputs_content);
     virtual Status InterpretLayer(const std::string& layer_str);
 
+    // @brief decode the layer section at the current position
+    Status InterpretLayerSection(Deserializer& deserializer, std::string& layer_name, LayerResource** resource);
+    // @brief decode the layer sections of an indexed model on GetLoadThreadNum() threads
+    Status InterpretIndexedResources(const std::string& model_content, const model_index& index);
+    int GetLoadThreadNum();
+
 protected:
     virtual std::string Transfer(std::string content);
     virtual bool IsValidVersionNumber(uint32_t number);
@@ -129,6 +176,8 @@ protected:
 
 protected:
     uint32_t version_magic_number = 0;
+    // threads to decode the resources of an indexed model, 0 means the number of cpu cores
+    int load_thread_num_ = 0;
 };
 
 }  // namespace TNN_NS
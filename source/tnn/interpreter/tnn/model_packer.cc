@@ -51,6 +51,29 @@ void ModelPacker::SetVersion(int version) {
     model_version_ = version;
 }
 
+void ModelPacker::SetResourceHandler(PackResourceHandler handler) {
+    resource_handler_ = handler;
+}
+
+void ModelPacker::SetReleaseResource(bool release) {
+    release_resource_ = release;
+}
+
+void ModelPacker::SetSectionAlignment(int alignment) {
+    section_alignment_ = alignment;
+}
+
+void ModelPacker::AlignSection(std::ostream &os) {
+    if (section_alignment_ <= 1) {
+        return;
+    }
+    const int64_t pos = (int64_t)os.tellp();
+    const int padding = (int)((section_alignment_ - pos % section_alignment_) % section_alignment_);
+    for (int i = 0; i < padding; ++i) {
+        os.put(0);
+    }
+}
+
 std::shared_ptr<LayerInfo> ModelPacker::FindLayerInfo(std::string layer_name) {
     std::shared_ptr<LayerInfo> layer_info;
 
@@ -205,10 +228,12 @@ Status ModelPacker::PackModel(std::string file_path) {
 
     res_header header;
     header.layer_cnt_ = 0;
+    header.indexed_   = section_alignment_ > 0;
+    index_            = model_index();
 
     int resource_count = 0;
     auto serializer    = GetSerializer(write_stream);
-    auto ret           = PackLayers(serializer, false, resource_count);
+    auto ret           = PackLayers(write_stream, serializer, false, resource_count);
     if (ret != TNN_OK) {
         write_stream.close();
         return ret;
@@ -220,7 +245,7 @@ Status ModelPacker::PackModel(std::string file_path) {
     }
     header.serialize(*serializer);
 
-    ret = PackLayers(serializer, true, resource_count);
+    ret = PackLayers(write_stream, serializer, true, resource_count);
     if (ret != TNN_OK) {
         write_stream.close();
         return ret;
@@ -229,6 +254,10 @@ Status ModelPacker::PackModel(std::string file_path) {
     // save const_map
     auto const_map = net_resource->constant_map;
     if (const_map.size() > 0) {
+        if (header.indexed_) {
+            AlignSection(write_stream);
+            index_.const_map_offset_ = (int64_t)write_stream.tellp();
+        }
         // write magic num
         serializer->PutInt(magic_number);
         // write const map size
@@ -238,7 +267,18 @@ Status ModelPacker::PackModel(std::string file_path) {
             serializer->PutRaw(*(iter.second.get()));
         }
     }
-    
+
+    // save section index
+    if (header.indexed_) {
+        const int64_t index_offset = (int64_t)write_stream.tellp();
+        index_.serialize(*serializer);
+        serializer->PutLong(index_offset);
+        serializer->PutInt(g_model_index_magic_number);
+    }
+
+    if (!write_stream.good()) {
+        ret = Status(TNNERR_PACK_MODEL, "model file write failed");
+    }
     write_stream.close();
     if (ret != TNN_OK) {
         return ret;
@@ -247,7 +287,8 @@ Status ModelPacker::PackModel(std::string file_path) {
     return TNN_OK;
 }
 
-Status ModelPacker::PackLayers(std::shared_ptr<Serializer> &serializer, bool save_resource, int &resource_count) {
+Status ModelPacker::PackLayers(std::ostream &os, std::shared_ptr<Serializer> &serializer, bool save_resource,
+                               int &resource_count) {
     resource_count = 0;
 
     NetResource *net_resource = GetNetResource();
@@ -255,7 +296,8 @@ Status ModelPacker::PackLayers(std::shared_ptr<Serializer> &serializer, bool sav
 
     auto &layer_interpreter_map = ModelInterpreter::GetLayerInterpreterMap();
     auto layers                 = net_struct->layers;
-    auto resource_map           = net_resource->resource_map;
+    // a reference, released resources must not be kept alive by a copy
+    auto &resource_map          = net_resource->resource_map;
 
     std::set<std::string> blob_scale_set;
     Status result;
@@ -273,7 +315,7 @@ Status ModelPacker::PackLayers(std::shared_ptr<Serializer> &serializer, bool sav
                     continue;
                 }
                 if (save_resource) {
-                    result = PackResource(resource_map, blob_scale_name, serializer);
+                    result = PackResource(resource_map, blob_scale_name, os, serializer);
                     if (result != TNN_OK) {
                         return result;
                     }
@@ -285,7 +327,7 @@ Status ModelPacker::PackLayers(std::shared_ptr<Serializer> &serializer, bool sav
         // save layer resource
         if (resource_map.find(layer_name) != resource_map.end() && resource_map.find(layer_name)->second != nullptr) {
             if (save_resource) {
-                result = PackResource(resource_map, layer_name, serializer);
+                result = PackResource(resource_map, layer_name, os, serializer);
                 if (result != TNN_OK) {
                     return result;
                 }
@@ -304,7 +346,7 @@ Status ModelPacker::PackLayers(std::shared_ptr<Serializer> &serializer, bool sav
                     continue;
                 }
                 if (save_resource) {
-                    result = PackResource(resource_map, blob_scale_name, serializer);
+                    result = PackResource(resource_map, blob_scale_name, os, serializer);
                     if (result != TNN_OK) {
                         return result;
                     }
@@ -318,7 +360,8 @@ Status ModelPacker::PackLayers(std::shared_ptr<Serializer> &serializer, bool sav
 }
 
 Status ModelPacker::PackResource(std::map<std::string, std::shared_ptr<LayerResource>> &resource_map,
-                                 std::string &layer_name, std::shared_ptr<Serializer> &serializer) {
+                                 std::string &layer_name, std::ostream &os,
+                                 std::shared_ptr<Serializer> &serializer) {
     // quantized
     auto &layer_interpreter_map = ModelInterpreter::GetLayerInterpreterMap();
     auto iter                   = resource_map.find(layer_name);
@@ -328,11 +371,24 @@ Status ModelPacker::PackResource(std::map<std::string, std::shared_ptr<LayerReso
     ly_header.type_                = layer_info->type;
     ly_header.type_str_            = layer_info->type_str;
     static int resource_pack_count = 0;
+    if (section_alignment_ > 0) {
+        AlignSection(os);
+        index_.names_.push_back(ly_header.name_);
+        index_.offsets_.push_back((int64_t)os.tellp());
+    }
     ly_header.serialize(*serializer);
-    LayerResource *layer_resource = iter->second.get();
-    auto layer_interpreter        = layer_interpreter_map[layer_info->type];
+
+    std::shared_ptr<LayerResource> layer_resource = iter->second;
+    if (resource_handler_) {
+        Status result = resource_handler_(layer_info, layer_resource);
+        if (result != TNN_OK) {
+            LOGE("Error: resource handler failed (name:%s)\n", ly_header.name_.c_str());
+            return result;
+        }
+    }
+    auto layer_interpreter = layer_interpreter_map[layer_info->type];
     if (layer_interpreter != nullptr) {
-        Status result = layer_interpreter->SaveResource(*serializer, layer_info->param.get(), layer_resource);
+        Status result = layer_interpreter->SaveResource(*serializer, layer_info->param.get(), layer_resource.get());
         if (result != TNN_OK) {
             LOGE(
                 "Error: layer interpreter save resource failed (name:%s "
@@ -347,6 +403,9 @@ Status ModelPacker::PackResource(std::map<std::string, std::shared_ptr<LayerReso
             ly_header.name_.c_str(), ly_header.type_str_.c_str(), ly_header.type_);
         return Status(TNNERR_PACK_MODEL, "unsupport layer resource type");
     }
+    if (release_resource_) {
+        resource_map.erase(iter);
+    }
     return TNN_OK;
 }
 
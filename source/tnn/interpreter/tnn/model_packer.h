@@ -15,12 +15,20 @@
 #ifndef TNN_SOURCE_TNN_INTERPRETER_TNN_TNN_MODEL_PACKER_H_
 #define TNN_SOURCE_TNN_INTERPRETER_TNN_TNN_MODEL_PACKER_H_
 
+#include <functional>
+
 #include "tnn/interpreter/default_model_packer.h"
+#include "tnn/interpreter/tnn/model_interpreter.h"
 #include "tnn/interpreter/tnn/objseri.h"
 
 using namespace TNN_NS;
 namespace TNN_NS {
 
+// @brief called on each resource right before it is written, it may replace the resource, e.g. with a half copy.
+// The replaced resource is only kept until the layer is written.
+typedef std::function<Status(std::shared_ptr<LayerInfo> layer_info, std::shared_ptr<LayerResource> &resource)>
+    PackResourceHandler;
+
 // @brief ModelPacker used to save raidnet v1 model
 class ModelPacker : public DefaultModelPacker {
 public:
@@ -32,16 +40,33 @@ public:
     // @brief set the model version to pack
     void SetVersion(int version);
 
+    // @brief convert each resource while it is written, see PackResourceHandler
+    void SetResourceHandler(PackResourceHandler handler);
+
+    // @brief drop each resource from the net resource once it is written, the memory is freed while packing
+    void SetReleaseResource(bool release);
+
+    // @brief align every layer section to alignment bytes and append a section index, so readers can seek to
+    // layers directly. 0 keeps the sequential layout, which older versions of TNN can read.
+    void SetSectionAlignment(int alignment);
+
 private:
     std::shared_ptr<LayerInfo> FindLayerInfo(std::string layer_name);
     Status PackProto(std::string file_path);
     Status PackModel(std::string file_path);
-    Status PackLayers(std::shared_ptr<Serializer> &serializer, bool save_resource, int &resource_count);
+    Status PackLayers(std::ostream &os, std::shared_ptr<Serializer> &serializer, bool save_resource,
+                      int &resource_count);
     Status PackResource(std::map<std::string, std::shared_ptr<LayerResource>> &resource_map, std::string &layer_name,
-                        std::shared_ptr<Serializer> &serializer);
+                        std::ostream &os, std::shared_ptr<Serializer> &serializer);
+    // @brief pad the stream with zeros to the section alignment
+    void AlignSection(std::ostream &os);
 
 protected:
     int model_version_ = 1;
+    PackResourceHandler resource_handler_ = nullptr;
+    bool release_resource_                = false;
+    int section_alignment_                = 0;
+    model_index index_;
 
     virtual std::string Transfer(std::string content);
     virtual uint32_t GetMagicNumber();
@@ -28,6 +28,8 @@
 namespace TNN_NS {
     static const uint32_t g_version_magic_number = 0x0FABC0002;
     static const uint32_t g_version_magic_number_v2 = 0x0FABC0004;
+    // marks the section index at the end of an indexed tnnmodel
+    static const uint32_t g_model_index_magic_number = 0x0FABC1001;
 
     class Serializer {
     public:
@@ -42,6 +44,9 @@ namespace TNN_NS {
         void PutInt(int value) {
             return put_basic_t<int>(value);
         }
+        void PutLong(int64_t value) {
+            return put_basic_t<int64_t>(value);
+        }
         void PutString(const std::string &value) {
             return PutString_t<std::string>(value);
         }
@@ -122,6 +127,9 @@ namespace TNN_NS {
         int GetInt() {
             return get_basic_t<int>();
         }
+        int64_t GetLong() {
+            return get_basic_t<int64_t>();
+        }
         std::string GetString() {
             return get_string_t<std::string>();
         }
@@ -187,6 +187,33 @@ Status BaseLayer::Reshape() {
     }
 }
 
+Status BaseLayer::ResetState() {
+    if (layer_acc_ == NULL) {
+        return TNN_OK;
+    }
+    return layer_acc_->ResetState();
+}
+
+size_t BaseLayer::GetWorkspaceSize() {
+    if (layer_acc_ == NULL) {
+        return 0;
+    }
+    return layer_acc_->GetWorkspaceSize(input_blobs_, output_blobs_);
+}
+
+void BaseLayer::SetWorkspace(Blob *workspace) {
+    if (layer_acc_) {
+        layer_acc_->SetWorkspace(workspace);
+    }
+}
+
+BlobAliasType BaseLayer::GetOutputAlias() {
+    if (layer_acc_ == NULL || input_blobs_.empty() || output_blobs_.empty()) {
+        return BLOB_ALIAS_NONE;
+    }
+    return layer_acc_->GetOutputAlias(input_blobs_, output_blobs_);
+}
+
 Status BaseLayer::Forward() {
     if (layer_acc_ != NULL) {
         if (runtime_model_ == RUNTIME_MODE_NORMAL) {
@@ -49,6 +49,18 @@ public:
     //@brief layer infer
     virtual Status Forward();
 
+    //@brief clear the state kept by the layer acc between forwards
+    virtual Status ResetState();
+
+    //@brief scratch bytes the layer acc needs in Forward at the current shapes
+    size_t GetWorkspaceSize();
+
+    //@brief set the workspace blob planned for the layer acc
+    void SetWorkspace(Blob *workspace);
+
+    //@brief whether the first output may share the memory of the first input
+    BlobAliasType GetOutputAlias();
+
     //@brief get layer name
     std::string GetLayerName();
 
@@ -21,7 +21,18 @@ namespace TNN_NS {
 DECLARE_LAYER(Conv, LAYER_CONVOLUTION);
 
 Status ConvLayer::InferOutputDataType() {
-    return BaseLayer::InferOutputDataType();
+    auto status = BaseLayer::InferOutputDataType();
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    // an int8 conv with a fused reformat quantizes its float input or dequantizes its output itself
+    auto conv_param = dynamic_cast<ConvLayerParam*>(param_);
+    if (conv_param && conv_param->quantized &&
+        (conv_param->extra_config.count("x86_int8_float_input") > 0 ||
+         conv_param->extra_config.count("x86_int8_float_output") > 0)) {
+        output_blobs_[0]->GetBlobDesc().data_type =
+            conv_param->extra_config.count("x86_int8_float_output") > 0 ? DATA_TYPE_FLOAT : DATA_TYPE_INT8;
+    }
+    return TNN_OK;
 }
 
 Status ConvLayer::InferOutputShape(bool ignore_error) {
@@ -0,0 +1,66 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "base_layer.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+DECLARE_LAYER(EffectiveTransformer, LAYER_EFFECTIVE_TRANSFORMER);
+
+Status EffectiveTransformerLayer::InferOutputDataType() {
+    auto status = BaseLayer::InferOutputDataType();
+    RETURN_ON_NEQ(status, TNN_OK);
+
+    // the token index of remove padding
+    if (output_blobs_.size() >= 2) {
+        output_blobs_[1]->GetBlobDesc().data_type = DATA_TYPE_INT32;
+    }
+    return TNN_OK;
+}
+
+Status EffectiveTransformerLayer::InferOutputShape(bool ignore_error) {
+    BaseLayer::InferOutputShape(ignore_error);
+
+    auto layer_param = dynamic_cast<EffectiveTransformerLayerParam*>(param_);
+    CHECK_PARAM_NULL(layer_param);
+    if (input_blobs_.size() < 2) {
+        return Status(TNNERR_PARAM_ERR, "EffectiveTransformerLayer has no input blob of mask or token index");
+    }
+
+    auto data_dims  = input_blobs_[0]->GetBlobDesc().dims;
+    auto token_dims = input_blobs_[1]->GetBlobDesc().dims;
+    if (data_dims.size() < 2 || token_dims.size() != 2) {
+        return Status(TNNERR_PARAM_ERR, "EffectiveTransformerLayer has invalid input dims");
+    }
+
+    DimsVector output_dims;
+    if (layer_param->is_remove_padding) {
+        // [1, batch * seq_len, ...] at most, the number of tokens is only known in forward
+        output_dims = {1, token_dims[0] * token_dims[1]};
+        output_dims.insert(output_dims.end(), data_dims.begin() + 2, data_dims.end());
+        if (output_blobs_.size() >= 2) {
+            output_blobs_[1]->GetBlobDesc().dims = token_dims;
+        }
+    } else {
+        // [batch, seq_len, ...]
+        output_dims = token_dims;
+        output_dims.insert(output_dims.end(), data_dims.begin() + 2, data_dims.end());
+    }
+    output_blobs_[0]->GetBlobDesc().dims = output_dims;
+    return TNN_OK;
+}
+
+REGISTER_LAYER(EffectiveTransformer, LAYER_EFFECTIVE_TRANSFORMER);
+
+}  // namespace TNN_NS
@@ -0,0 +1,47 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "base_layer.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+DECLARE_LAYER(KVCache, LAYER_KV_CACHE);
+
+Status KVCacheLayer::InferOutputDataType() {
+    return BaseLayer::InferOutputDataType();
+}
+
+Status KVCacheLayer::InferOutputShape(bool ignore_error) {
+    BaseLayer::InferOutputShape(ignore_error);
+
+    auto layer_param = dynamic_cast<KVCacheLayerParam*>(param_);
+    CHECK_PARAM_NULL(layer_param);
+
+    auto dims = input_blobs_[0]->GetBlobDesc().dims;
+    int axis  = layer_param->axis < 0 ? layer_param->axis + (int)dims.size() : layer_param->axis;
+    if (axis < 0 || axis >= dims.size() || layer_param->max_length < dims[axis]) {
+        LOGE_IF(!ignore_error, "KVCacheLayer has invalid axis %d or max_length %d\n", layer_param->axis,
+                layer_param->max_length);
+        return Status(TNNERR_PARAM_ERR, "KVCacheLayer has invalid axis or max_length");
+    }
+
+    // all the positions of the cache at most, the positions cached so far are only known in forward
+    dims[axis] = layer_param->max_length;
+    output_blobs_[0]->GetBlobDesc().dims = dims;
+    return TNN_OK;
+}
+
+REGISTER_LAYER(KVCache, LAYER_KV_CACHE);
+
+}  // namespace TNN_NS
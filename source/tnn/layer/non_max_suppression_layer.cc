@@ -48,6 +48,9 @@ Status NonMaxSuppressionLayer::InferOutputShape(bool ignore_error) {
         output_dim_max_box = boxes_dims[1];
     }
 
+    // every class of every batch selects up to output_dim_max_box boxes
+    output_dim_max_box *= boxes_dims[0] * scores_dims[1];
+
     int last_dim     = 3;
     auto output_dims = {(int)output_dim_max_box, last_dim};
 
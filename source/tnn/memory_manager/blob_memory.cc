@@ -14,6 +14,8 @@
 
 #include "tnn/memory_manager/blob_memory.h"
 
+#include "tnn/core/profile.h"
+
 namespace TNN_NS {
 
 BlobMemory::BlobMemory(AbstractDevice* device, BlobMemorySizeInfo& size_info, int use_count)
@@ -55,6 +57,7 @@ Status BlobMemory::AllocateHandle() {
     }
 
     need_release_memory_ = true;
+    InitProfileCollector::AddAllocatedBytes(GetBlobMemoryBytesSize(size_info_));
     return TNN_OK;
 }
 
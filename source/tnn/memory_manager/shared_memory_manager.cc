@@ -14,6 +14,8 @@
 
 #include "tnn/memory_manager/shared_memory_manager.h"
 
+#include "tnn/core/profile.h"
+
 namespace TNN_NS {
 
 bool operator<(SharedMemoryId lhs, SharedMemoryId rhs) {
@@ -47,6 +49,7 @@ SharedMemory SharedMemoryManager::GetSharedMemory(int forward_memory_size, std::
         if (status != TNN_OK) {
             return SharedMemory();
         }
+        InitProfileCollector::AddAllocatedBytes(forward_memory_size);
 
         if (share_memory.shared_memory_data != NULL) {
             device->Free(share_memory.shared_memory_data);
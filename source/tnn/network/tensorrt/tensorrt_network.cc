@@ -493,6 +493,11 @@ Status TensorRTNetwork_::SetForwardMemory(void *memory) {
     return TNN_OK;
 }
 
+Status TensorRTNetwork_::SetExternalBlobMemory(std::string name, void *memory) {
+    LOGE("Error TensorRT network dont support external blob memory\n");
+    return Status(TNNERR_DEVICE_NOT_SUPPORT, "TensorRT network dont support external blob memory");
+}
+
 Status TensorRTNetwork_::InitWithoutCache(BlobMap &inputs, BlobMap &outputs, std::string cache_file_name,
         NetResource *net_resource, const InputShapesMap &min_inputs_shape) {
     auto m_trt_builder = nvinfer1::createInferBuilder(m_trt_logger);
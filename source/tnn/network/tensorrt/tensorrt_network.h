@@ -99,6 +99,9 @@ public:
     // @brief set forward memory when share memory mode is set from external
     virtual Status SetForwardMemory(void *memory);
 
+    // @brief engine bindings are fixed at init, external blob memory is not supported
+    virtual Status SetExternalBlobMemory(std::string name, void *memory);
+
     static std::unordered_map<std::string, TensorRTPluginLayerBuilder*> GetPluginLayerNameMap();
 
     std::string GetCacheFileName(std::vector<std::string> params_md5, BlobMap input_map,
@@ -35,6 +35,8 @@ namespace optimizer {
         if (net_config.network_type == NETWORK_TYPE_COREML) {
             return false;
         }
+        // x86 accs of conv, innerproduct, matmul and lstm run with the int8 weights directly
+        keep_int8_weight_ = net_config.device_type == DEVICE_X86 && net_config.network_type != NETWORK_TYPE_OPENVINO;
         return true;
     }
 
@@ -53,6 +55,9 @@ namespace optimizer {
                 continue;
             }
             auto type = layer->type;
+            if (keep_int8_weight_ && IsInt8WeightSupported(layer)) {
+                continue;
+            }
             switch (type) {
                 case LAYER_CONVOLUTION:
                     DequantConv(layer, structure, resource);
@@ -77,6 +82,21 @@ namespace optimizer {
         return TNN_OK;
     }
 
+    bool NetOptimizerDynamicRangeDequant::IsInt8WeightSupported(std::shared_ptr<LayerInfo> &layer) {
+        switch (layer->type) {
+            case LAYER_CONVOLUTION:
+            case LAYER_INNER_PRODUCT:
+            case LAYER_LSTMONNX:
+                return true;
+            case LAYER_MATMUL: {
+                auto matmul_param = std::dynamic_pointer_cast<MatMulLayerParam>(layer->param);
+                return matmul_param && matmul_param->weight_position == 1;
+            }
+            default:
+                return false;
+        }
+    }
+
     Status NetOptimizerDynamicRangeDequant::DequantConv(std::shared_ptr<LayerInfo> &layer, NetStructure *structure,
                                                         NetResource *resource) {
         auto layer_name    = layer->name;
@@ -35,11 +35,15 @@ namespace optimizer {
         virtual Status Optimize(NetStructure *structure, NetResource *resource);
 
     private:
+        // layers whose int8 weights are kept for the device acc
+        bool IsInt8WeightSupported(std::shared_ptr<LayerInfo> &layer);
         Status DequantConv(std::shared_ptr<LayerInfo> &layer, NetStructure *structure, NetResource *resource);
         Status DequantLSTM(std::shared_ptr<LayerInfo> &layer, NetStructure *structure, NetResource *resource);
         Status DequantMatMul(std::shared_ptr<LayerInfo> &layer, NetStructure *structure, NetResource *resource);
         Status DequantInnerProduct(std::shared_ptr<LayerInfo> &layer, NetStructure *structure, NetResource *resource);
         Status DequantGatherEmbedding(std::shared_ptr<LayerInfo> &layer, NetStructure *structure, NetResource *resource);
+
+        bool keep_int8_weight_ = false;
     };
 
 }  // namespace optimizer
@@ -0,0 +1,275 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/optimizer/net_optimizer_effective_transformer.h"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "tnn/core/common.h"
+#include "tnn/core/layer_type.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+namespace optimizer {
+
+    // P2 priority: after the layer fusions, so that fused LayerNorm and Gelu are found
+    NetOptimizerRegister<NetOptimizerEffectiveTransformer> g_net_optimizer_effective_transformer(OptPriority::P2);
+
+    static const std::string PACKED_SUFFIX = "_packed";
+
+    static std::set<LayerType> global_tokenwise_unary_layer_types_set = {
+        LAYER_RELU, LAYER_RELU6, LAYER_GELU, LAYER_TANH, LAYER_SIGMOID, LAYER_ERF,
+    };
+
+    static std::set<LayerType> global_tokenwise_binary_layer_types_set = {
+        LAYER_ADD, LAYER_SUB, LAYER_MUL, LAYER_DIV,
+    };
+
+    std::string NetOptimizerEffectiveTransformer::Strategy() {
+        return kNetOptimizerEffectiveTransformer;
+    }
+
+    bool NetOptimizerEffectiveTransformer::IsSupported(const NetworkConfig &net_config) {
+        mask_name_        = net_config.ragged_batch_mask;
+        auto device       = net_config.device_type;
+        auto network_type = net_config.network_type;
+        return !mask_name_.empty() && (device == DEVICE_X86 || device == DEVICE_NAIVE) &&
+               (network_type == NETWORK_TYPE_AUTO || network_type == NETWORK_TYPE_DEFAULT);
+    }
+
+    // a constant of [..., 1, n] broadcasts to the packed tokens the same as to [batch, seq_len, n]
+    static bool IsTokenwiseConstant(const DimsVector &dims) {
+        return dims.size() <= 3 && (dims.empty() || DimsVectorUtils::Count(dims) == dims.back());
+    }
+
+    // the dynamic inputs of a layer that computes each token on its own, empty for other layers
+    static std::vector<std::string> GetTokenwiseInputs(std::shared_ptr<LayerInfo> layer, NetResource *resource) {
+        std::vector<std::string> inputs;
+        if (layer->param->quantized || layer->outputs.size() != 1) {
+            return inputs;
+        }
+        auto &constants     = resource->constant_map;
+        auto is_constant    = [&](const std::string &name) { return constants.find(name) != constants.end(); };
+        auto layer_resource = resource->resource_map.find(layer->name) != resource->resource_map.end()
+                                  ? resource->resource_map[layer->name].get()
+                                  : nullptr;
+
+        if (layer->type == LAYER_LAYER_NORM) {
+            auto param = dynamic_cast<LayerNormLayerParam *>(layer->param.get());
+            if (param && param->reduce_dims_size == 1 && layer->inputs.size() == 3 && !is_constant(layer->inputs[0]) &&
+                is_constant(layer->inputs[1]) && is_constant(layer->inputs[2])) {
+                inputs.push_back(layer->inputs[0]);
+            }
+        } else if (layer->type == LAYER_MATMUL) {
+            // [batch, seq_len, k] x [k, n] with a constant weight
+            auto param = dynamic_cast<MatMulLayerParam *>(layer->param.get());
+            if (layer->inputs.size() == 1 && param && param->weight_position == 1) {
+                auto matmul_resource = dynamic_cast<MatMulLayerResource *>(layer_resource);
+                if (matmul_resource && matmul_resource->weight.GetBufferDims().size() == 2) {
+                    inputs.push_back(layer->inputs[0]);
+                }
+            } else if (layer->inputs.size() == 2 && !is_constant(layer->inputs[0]) && is_constant(layer->inputs[1]) &&
+                       constants[layer->inputs[1]]->GetBufferDims().size() == 2) {
+                inputs.push_back(layer->inputs[0]);
+            }
+        } else if (global_tokenwise_unary_layer_types_set.count(layer->type) > 0) {
+            if (layer->inputs.size() == 1 && !is_constant(layer->inputs[0])) {
+                inputs.push_back(layer->inputs[0]);
+            }
+        } else if (global_tokenwise_binary_layer_types_set.count(layer->type) > 0) {
+            if (layer->inputs.size() == 1) {
+                auto eltwise_resource = dynamic_cast<EltwiseLayerResource *>(layer_resource);
+                if (eltwise_resource && IsTokenwiseConstant(eltwise_resource->element_shape)) {
+                    inputs.push_back(layer->inputs[0]);
+                }
+            } else if (layer->inputs.size() == 2) {
+                for (const auto &name : layer->inputs) {
+                    if (!is_constant(name)) {
+                        inputs.push_back(name);
+                    } else if (!IsTokenwiseConstant(constants[name]->GetBufferDims())) {
+                        return {};
+                    }
+                }
+            }
+        }
+        return inputs;
+    }
+
+    static std::shared_ptr<LayerInfo> CreateEffectiveTransformer(const std::string &name, bool is_remove_padding) {
+        std::shared_ptr<LayerInfo> new_layer  = std::shared_ptr<LayerInfo>(new LayerInfo());
+        new_layer->type                       = LAYER_EFFECTIVE_TRANSFORMER;
+        new_layer->type_str                   = "EffectiveTransformer";
+        new_layer->name                       = name;
+        EffectiveTransformerLayerParam *param = new EffectiveTransformerLayerParam();
+        new_layer->param                      = std::shared_ptr<LayerParam>(param);
+        new_layer->param->type                = new_layer->type_str;
+        new_layer->param->name                = new_layer->name;
+        param->is_remove_padding              = is_remove_padding;
+        return new_layer;
+    }
+
+    /*
+     * The layers computing each token on its own (MatMul with a constant weight, LayerNorm, activations and
+     * elementwise ops of them) are found from the LayerNorm inputs, and run on [1, num_tokens, ...] packed by the
+     * attention mask. The other layers, attention among them, still see [batch, seq_len, ...] with the padding
+     * rebuilt as 0.
+     * graph(%embedding, %mask):
+     *      %x = LayerNorm(%embedding)
+     *      %q = Add(MatMul(%x))
+     *      %r = Reshape(%q)
+     * becomes
+     * graph(%embedding, %mask):
+     *      %embedding_packed, %token_index = EffectiveTransformer(%embedding, %mask)
+     *      %x_packed = LayerNorm(%embedding_packed)
+     *      %q_packed = Add(MatMul(%x_packed))
+     *      %q = EffectiveTransformer(%q_packed, %token_index)
+     *      %r = Reshape(%q)
+     */
+    Status NetOptimizerEffectiveTransformer::Optimize(NetStructure *structure, NetResource *resource) {
+        if (!structure) {
+            LOGE("Error: empty NetStructure\n");
+            return Status(TNNERR_NET_ERR, "Error: empty NetStructure");
+        }
+        if (structure->inputs_shape_map.find(mask_name_) == structure->inputs_shape_map.end() ||
+            structure->inputs_shape_map[mask_name_].size() != 2) {
+            LOGE("NetOptimizerEffectiveTransformer: %s is not an input of [batch, seq_len]\n", mask_name_.c_str());
+            return Status(TNNERR_PARAM_ERR, "ragged batch mask is not an input of [batch, seq_len]");
+        }
+        if (GetQuantizedInfoFromNetStructure(structure)) {
+            return TNN_OK;
+        }
+
+        std::vector<std::shared_ptr<LayerInfo>> layers_orig = structure->layers;
+        for (const auto &layer : layers_orig) {
+            if (layer->type == LAYER_EFFECTIVE_TRANSFORMER) {
+                return TNN_OK;
+            }
+        }
+
+        std::map<LayerInfo *, std::vector<std::string>> tokenwise_inputs;
+        std::set<std::string> packed_blobs;
+        for (const auto &layer : layers_orig) {
+            auto inputs = GetTokenwiseInputs(layer, resource);
+            if (inputs.empty()) {
+                continue;
+            }
+            tokenwise_inputs[layer.get()] = inputs;
+            if (layer->type == LAYER_LAYER_NORM) {
+                packed_blobs.insert(inputs[0]);
+            }
+        }
+        if (packed_blobs.empty()) {
+            return TNN_OK;
+        }
+
+        // the tokens of one layer are packed together: its inputs and output, both ways until nothing changes
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (const auto &iter : tokenwise_inputs) {
+                auto output  = iter.first->outputs[0];
+                bool touched = packed_blobs.count(output) > 0;
+                for (const auto &name : iter.second) {
+                    touched |= packed_blobs.count(name) > 0;
+                }
+                if (!touched) {
+                    continue;
+                }
+                for (const auto &name : iter.second) {
+                    changed |= packed_blobs.insert(name).second;
+                }
+                changed |= packed_blobs.insert(output).second;
+            }
+        }
+
+        std::set<std::string> packed_producers;
+        std::set<std::string> dense_consumers(structure->outputs.begin(), structure->outputs.end());
+        for (const auto &layer : layers_orig) {
+            bool is_packed = tokenwise_inputs.count(layer.get()) > 0 && packed_blobs.count(layer->outputs[0]) > 0;
+            if (is_packed) {
+                packed_producers.insert(layer->outputs[0]);
+                continue;
+            }
+            for (const auto &name : layer->inputs) {
+                dense_consumers.insert(name);
+            }
+        }
+
+        const std::string token_index_name = mask_name_ + "_token_index";
+        bool has_token_index               = false;
+        std::set<std::string> removed_blobs;
+        std::vector<std::shared_ptr<LayerInfo>> layers_optimized;
+        for (const auto &layer : layers_orig) {
+            bool is_packed = tokenwise_inputs.count(layer.get()) > 0 && packed_blobs.count(layer->outputs[0]) > 0;
+            if (!is_packed) {
+                layers_optimized.push_back(layer);
+                continue;
+            }
+
+            for (const auto &name : tokenwise_inputs[layer.get()]) {
+                if (packed_producers.count(name) > 0 || removed_blobs.count(name) > 0) {
+                    continue;
+                }
+                auto remove_layer = CreateEffectiveTransformer(name + "_remove_padding", true);
+                remove_layer->outputs.push_back(name + PACKED_SUFFIX);
+                if (!has_token_index) {
+                    remove_layer->inputs  = {name, mask_name_};
+                    remove_layer->outputs.push_back(token_index_name);
+                    structure->blobs.insert(token_index_name);
+                    has_token_index = true;
+                } else {
+                    remove_layer->inputs = {name, token_index_name};
+                }
+                structure->blobs.insert(name + PACKED_SUFFIX);
+                removed_blobs.insert(name);
+                layers_optimized.push_back(remove_layer);
+                LOGD("Insert remove padding layer: src %s dst %s\n", name.c_str(), (name + PACKED_SUFFIX).c_str());
+            }
+
+            for (auto &name : layer->inputs) {
+                if (packed_blobs.count(name) > 0) {
+                    name = name + PACKED_SUFFIX;
+                }
+            }
+            auto output       = layer->outputs[0];
+            layer->outputs[0] = output + PACKED_SUFFIX;
+            structure->blobs.insert(layer->outputs[0]);
+            layers_optimized.push_back(layer);
+
+            if (dense_consumers.count(output) > 0) {
+                auto rebuild_layer     = CreateEffectiveTransformer(output + "_rebuild_padding", false);
+                rebuild_layer->inputs  = {layer->outputs[0], token_index_name};
+                rebuild_layer->outputs = {output};
+                layers_optimized.push_back(rebuild_layer);
+                LOGD("Insert rebuild padding layer: src %s dst %s\n", layer->outputs[0].c_str(), output.c_str());
+            } else {
+                structure->blobs.erase(output);
+            }
+        }
+        structure->layers = layers_optimized;
+
+        return TNN_OK;
+    }
+
+}  // namespace optimizer
+
+}  // namespace TNN_NS
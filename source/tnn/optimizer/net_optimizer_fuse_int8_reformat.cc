@@ -0,0 +1,149 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/optimizer/net_optimizer_fuse_int8_reformat.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "tnn/core/common.h"
+#include "tnn/core/layer_type.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+
+namespace TNN_NS {
+
+namespace optimizer {
+
+    // PLAST priority: after the int8 reformats are inserted
+    NetOptimizerRegister<NetOptimizerFuseInt8Reformat> g_net_optimizer_fuse_int8_reformat(OptPriority::PLAST);
+
+    std::string NetOptimizerFuseInt8Reformat::Strategy() {
+        return kNetOptimizerFuseInt8Reformat;
+    }
+
+    bool NetOptimizerFuseInt8Reformat::IsSupported(const NetworkConfig &net_config) {
+        return net_config.device_type == DEVICE_X86;
+    }
+
+    // X86ConvInt8LayerCommon quantizes and dequantizes in place of the reformats, group conv is not supported
+    static bool IsFusableConv(const LayerInfo *layer) {
+        auto param = dynamic_cast<ConvLayerParam *>(layer->param.get());
+        return layer->type == LAYER_CONVOLUTION && param && param->quantized && param->group == 1 &&
+               layer->outputs.size() == 1;
+    }
+
+    /*
+     * graph(%x):
+     *      %x_r = Reformat(%x)            float -> int8
+     *      %y   = Convolution(%x_r)       int8
+     *      %y_r = Reformat(%y)            int8 -> float
+     *      %z   = ReLU(%y_r)
+     * becomes
+     * graph(%x):
+     *      %y   = Convolution(%x)         float, with x86_int8_float_input and x86_int8_float_output
+     *      %z   = ReLU(%y)
+     * the blobs keep their names, so that the int8 scales of %x and %y are found as before.
+     */
+    Status NetOptimizerFuseInt8Reformat::Optimize(NetStructure *structure, NetResource *resource) {
+        if (!structure) {
+            LOGE("Error: empty NetStructure\n");
+            return Status(TNNERR_NET_ERR, "Error: empty NetStructure");
+        }
+        if (!GetQuantizedInfoFromNetStructure(structure)) {
+            return TNN_OK;
+        }
+
+        std::vector<std::shared_ptr<LayerInfo>> layers_orig = structure->layers;
+        std::map<std::string, std::vector<LayerInfo *>> consumers;
+        std::map<std::string, LayerInfo *> producers;
+        for (const auto &layer : layers_orig) {
+            for (const auto &name : layer->inputs) {
+                consumers[name].push_back(layer.get());
+            }
+            for (const auto &name : layer->outputs) {
+                producers[name] = layer.get();
+            }
+        }
+
+        std::set<LayerInfo *> removed_layers;
+        for (const auto &layer : layers_orig) {
+            auto param = dynamic_cast<ReformatLayerParam *>(layer->param.get());
+            if (layer->type != LAYER_REFORMAT || !param || layer->inputs.size() != 1 || layer->outputs.size() != 1) {
+                continue;
+            }
+            const auto src = layer->inputs[0];
+            const auto dst = layer->outputs[0];
+            if (structure->outputs.count(dst) > 0) {
+                continue;
+            }
+
+            if (param->src_type == DATA_TYPE_FLOAT && param->dst_type == DATA_TYPE_INT8) {
+                // quantize: every consumer is a fusable conv taking it as the data input
+                if (structure->inputs_shape_map.count(src) > 0 || consumers[dst].empty()) {
+                    continue;
+                }
+                bool fusable = true;
+                for (auto consumer : consumers[dst]) {
+                    fusable &= IsFusableConv(consumer) && consumer->inputs[0] == dst &&
+                               std::count(consumer->inputs.begin(), consumer->inputs.end(), dst) == 1;
+                }
+                if (!fusable) {
+                    continue;
+                }
+                for (auto consumer : consumers[dst]) {
+                    consumer->inputs[0] = src;
+                    consumer->param->extra_config.insert("x86_int8_float_input");
+                }
+            } else if (param->src_type == DATA_TYPE_INT8 && param->dst_type == DATA_TYPE_FLOAT) {
+                // dequantize: the only consumer of a fusable conv
+                auto producer = producers.count(src) > 0 ? producers[src] : nullptr;
+                if (!producer || !IsFusableConv(producer) || consumers[src].size() != 1 ||
+                    structure->outputs.count(src) > 0) {
+                    continue;
+                }
+                for (auto consumer : consumers[dst]) {
+                    std::replace(consumer->inputs.begin(), consumer->inputs.end(), dst, src);
+                }
+                producer->param->extra_config.insert("x86_int8_float_output");
+            } else {
+                continue;
+            }
+
+            structure->blobs.erase(dst);
+            removed_layers.insert(layer.get());
+            LOGD("Fuse int8 reformat layer: src %s dst %s\n", src.c_str(), dst.c_str());
+        }
+        if (removed_layers.empty()) {
+            return TNN_OK;
+        }
+
+        std::vector<std::shared_ptr<LayerInfo>> layers_fused;
+        for (const auto &layer : layers_orig) {
+            if (removed_layers.count(layer.get()) == 0) {
+                layers_fused.push_back(layer);
+            }
+        }
+        structure->layers = layers_fused;
+
+        return TNN_OK;
+    }
+
+}  // namespace optimizer
+
+}  // namespace TNN_NS
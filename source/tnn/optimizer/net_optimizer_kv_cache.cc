@@ -0,0 +1,124 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/optimizer/net_optimizer_kv_cache.h"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "tnn/core/common.h"
+#include "tnn/core/layer_type.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/optimizer/net_optimizer_manager.h"
+#include "tnn/optimizer/optimizer_const.h"
+
+namespace TNN_NS {
+
+namespace optimizer {
+
+    NetOptimizerRegister<NetOptimizerKVCache> g_net_optimizer_kv_cache(OptPriority::P2);
+
+    std::string NetOptimizerKVCache::Strategy() {
+        return kNetOptimizerKVCache;
+    }
+
+    bool NetOptimizerKVCache::IsSupported(const NetworkConfig &net_config) {
+        max_length_       = net_config.kv_cache_max_length;
+        auto device       = net_config.device_type;
+        auto network_type = net_config.network_type;
+        return max_length_ > 0 && (device == DEVICE_X86 || device == DEVICE_NAIVE) &&
+               (network_type == NETWORK_TYPE_AUTO || network_type == NETWORK_TYPE_DEFAULT);
+    }
+
+    static std::shared_ptr<LayerInfo> CreateKVCache(const std::string &name, int axis, int max_length) {
+        std::shared_ptr<LayerInfo> new_layer = std::shared_ptr<LayerInfo>(new LayerInfo());
+        new_layer->type                      = LAYER_KV_CACHE;
+        new_layer->type_str                  = "KVCache";
+        new_layer->name                      = name;
+        KVCacheLayerParam *param             = new KVCacheLayerParam();
+        new_layer->param                     = std::shared_ptr<LayerParam>(param);
+        new_layer->param->type               = new_layer->type_str;
+        new_layer->param->name               = new_layer->name;
+        param->axis                          = axis;
+        param->max_length                    = max_length;
+        return new_layer;
+    }
+
+    /*
+     * The past positions come back as inputs at every step of a decoder exported with its cache as inputs and
+     * outputs. They are kept by the instance instead, and the instance takes the new positions only.
+     * graph(%x, %past_key):
+     *      %key         = MatMul(%x)
+     *      %present_key = Concat(%past_key, %key)
+     *      %scores      = MatMul(%query, Permute(%present_key))
+     *      return %scores, %present_key
+     * becomes
+     * graph(%x):
+     *      %key         = MatMul(%x)
+     *      %present_key = KVCache(%key)
+     *      %scores      = MatMul(%query, Permute(%present_key))
+     *      return %scores
+     */
+    Status NetOptimizerKVCache::Optimize(NetStructure *structure, NetResource *resource) {
+        if (!structure) {
+            LOGE("Error: empty NetStructure\n");
+            return Status(TNNERR_NET_ERR, "Error: empty NetStructure");
+        }
+
+        std::map<std::string, int> consumer_count;
+        for (const auto &layer : structure->layers) {
+            for (const auto &name : layer->inputs) {
+                consumer_count[name]++;
+            }
+        }
+
+        auto &inputs_shape_map = structure->inputs_shape_map;
+        for (auto &layer : structure->layers) {
+            auto param = dynamic_cast<ConcatLayerParam *>(layer->param.get());
+            if (layer->type != LAYER_CONCAT || !param || param->quantized || layer->inputs.size() != 2 ||
+                layer->outputs.size() != 1) {
+                continue;
+            }
+            const auto past    = layer->inputs[0];
+            const auto present = layer->outputs[0];
+            if (inputs_shape_map.find(past) == inputs_shape_map.end() || consumer_count[past] != 1 ||
+                inputs_shape_map.find(layer->inputs[1]) != inputs_shape_map.end() ||
+                structure->outputs.find(present) == structure->outputs.end()) {
+                continue;
+            }
+            const int rank = (int)inputs_shape_map[past].size();
+            const int axis = param->axis < 0 ? param->axis + rank : param->axis;
+            if (axis < 0 || axis >= rank) {
+                continue;
+            }
+
+            auto cache_layer     = CreateKVCache(layer->name, axis, max_length_);
+            cache_layer->inputs  = {layer->inputs[1]};
+            cache_layer->outputs = {present};
+            layer                = cache_layer;
+
+            inputs_shape_map.erase(past);
+            structure->input_data_type_map.erase(past);
+            structure->blobs.erase(past);
+            structure->outputs.erase(present);
+            LOGD("Replace past input %s and present output %s by kv cache\n", past.c_str(), present.c_str());
+        }
+
+        return TNN_OK;
+    }
+
+}  // namespace optimizer
+
+}  // namespace TNN_NS
@@ -16,6 +16,8 @@
 
 #include <algorithm>
 
+#include "tnn/core/profile.h"
+
 namespace TNN_NS {
 
 namespace optimizer {
@@ -37,6 +39,7 @@ namespace optimizer {
         for (auto iter : NetOptimizerManager::GetNetOptimizerSeq()) {
             auto optimizer = optimizer_map[iter.second];
             if (optimizer->IsSupported(net_config)) {
+                InitProfileScope scope("", iter.second);
                 auto status = optimizer->Optimize(structure, resource);
                 if (status != TNN_OK) {
                     return status;
@@ -54,4 +54,13 @@ const char * kNetOptimizerDynamicRangeDequant =
 const char * kNetOptimizerConvertMatMulToConv =
     "net_optimizer_convert_matmul_to_conv";
 
+const char * kNetOptimizerEffectiveTransformer =
+    "net_optimizer_effective_transformer";
+
+const char * kNetOptimizerKVCache =
+    "net_optimizer_kv_cache";
+
+const char * kNetOptimizerFuseInt8Reformat =
+    "net_optimizer_fuse_int8_reformat";
+
 }  // namespace TNN_NS
@@ -45,6 +45,12 @@ extern const char * kNetOptimizerDynamicRangeDequant;
 
 extern const char * kNetOptimizerConvertMatMulToConv;
 
+extern const char * kNetOptimizerEffectiveTransformer;
+
+extern const char * kNetOptimizerKVCache;
+
+extern const char * kNetOptimizerFuseInt8Reformat;
+
 }
 
 #endif // TNN_SOURCE_TNN_OPTIMIZER_OPTIMIZER_CONST_H_
@@ -0,0 +1,102 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "tnn/utils/async_task_queue.h"
+
+namespace TNN_NS {
+
+AsyncTaskQueue::AsyncTaskQueue() : state_(std::make_shared<State>()) {
+    state_->status = TNN_OK;
+}
+
+AsyncTaskQueue::~AsyncTaskQueue() {
+    bool in_worker = InWorkerThread();
+    {
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        state_->stop = true;
+        if (in_worker) {
+            // released by its own task, the objects used by the remaining tasks are going away
+            state_->tasks.clear();
+        }
+    }
+    state_->task_cv.notify_all();
+    if (!worker_.joinable()) {
+        return;
+    }
+    if (in_worker) {
+        worker_.detach();
+    } else {
+        worker_.join();
+    }
+}
+
+void AsyncTaskQueue::Enqueue(Task task) {
+    {
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        state_->tasks.push_back(std::move(task));
+        state_->pending++;
+        if (!worker_.joinable()) {
+            worker_           = std::thread(&AsyncTaskQueue::Run, state_);
+            state_->worker_id = worker_.get_id();
+        }
+    }
+    state_->task_cv.notify_one();
+}
+
+Status AsyncTaskQueue::Wait() {
+    if (InWorkerThread()) {
+        return TNN_OK;
+    }
+
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    state_->done_cv.wait(lock, [this] { return state_->pending == 0; });
+    Status status  = state_->status;
+    state_->status = TNN_OK;
+    return status;
+}
+
+bool AsyncTaskQueue::InWorkerThread() {
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    return std::this_thread::get_id() == state_->worker_id;
+}
+
+void AsyncTaskQueue::Run(std::shared_ptr<State> state) {
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            // remaining tasks still run after stop, the destructor waits for them
+            state->task_cv.wait(lock, [&state] { return state->stop || !state->tasks.empty(); });
+            if (state->tasks.empty()) {
+                return;
+            }
+            task = std::move(state->tasks.front());
+            state->tasks.pop_front();
+        }
+
+        Status status = task();
+
+        {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            if (status != TNN_OK && state->status == TNN_OK) {
+                state->status = status;
+            }
+            state->pending--;
+        }
+        state->done_cv.notify_all();
+    }
+}
+
+}  // namespace TNN_NS
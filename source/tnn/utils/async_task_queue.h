@@ -0,0 +1,76 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#ifndef TNN_SOURCE_TNN_UTILS_ASYNC_TASK_QUEUE_H_
+#define TNN_SOURCE_TNN_UTILS_ASYNC_TASK_QUEUE_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "tnn/core/macro.h"
+#include "tnn/core/status.h"
+
+namespace TNN_NS {
+
+// Command queue of the host devices (naive cpu and x86). Tasks run one by one in enqueue order on a worker
+// thread, which is started on the first Enqueue. Async forward and async blob conversions of the instances
+// sharing the queue are ordered on it.
+class AsyncTaskQueue {
+public:
+    typedef std::function<Status(void)> Task;
+
+    AsyncTaskQueue();
+
+    // wait for all enqueued tasks, then stop the worker thread
+    ~AsyncTaskQueue();
+
+    // @brief append a task, it runs after all tasks enqueued before
+    void Enqueue(Task task);
+
+    // @brief wait until all enqueued tasks finish.
+    // return the first failed status of the tasks finished since last Wait.
+    // called on the worker thread (e.g. from a forward callback), it returns at once.
+    Status Wait();
+
+    // @brief whether the caller runs on the worker thread
+    bool InWorkerThread();
+
+private:
+    // shared with the worker thread, so the worker can finish safely when the queue is released by its own task
+    struct State {
+        std::mutex mutex;
+        std::condition_variable task_cv;
+        std::condition_variable done_cv;
+        std::deque<Task> tasks;
+        std::thread::id worker_id;
+        // tasks enqueued but not finished
+        int pending = 0;
+        bool stop   = false;
+        Status status;
+    };
+
+    static void Run(std::shared_ptr<State> state);
+
+    std::shared_ptr<State> state_;
+    std::thread worker_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_SOURCE_TNN_UTILS_ASYNC_TASK_QUEUE_H_
@@ -24,12 +24,27 @@
 #include "tnn/utils/bfp16_utils.h"
 #include "tnn/utils/dims_utils.h"
 #include "tnn/utils/string_utils_inner.h"
+#include "tnn/utils/async_task_queue.h"
 
 namespace TNN_NS {
 
 DefaultBlobConverterAcc::DefaultBlobConverterAcc(Blob *blob) : BlobConverterAcc(blob) {}
 DefaultBlobConverterAcc::~DefaultBlobConverterAcc() {}
 
+Status DefaultBlobConverterAcc::RunOnHostTaskQueue(std::function<Status(void)> func, bool async,
+                                                   void *command_queue) {
+    auto task_queue = static_cast<AsyncTaskQueue *>(command_queue);
+    if (task_queue == nullptr) {
+        return func();
+    }
+    if (async) {
+        task_queue->Enqueue(func);
+        return TNN_OK;
+    }
+    RETURN_ON_NEQ(task_queue->Wait(), TNN_OK);
+    return func();
+}
+
 static uint8_t saturate_cast(float data) {
     data += 0.5;
     data = std::min(std::max(data, 0.0f), 255.0f);
@@ -15,6 +15,8 @@
 #ifndef TNN_SOURCE_TNN_UTILS_BLOB_CONVERTER_DEFAULT_H_
 #define TNN_SOURCE_TNN_UTILS_BLOB_CONVERTER_DEFAULT_H_
 
+#include <functional>
+
 #include "tnn/core/macro.h"
 #include "tnn/utils/blob_converter.h"
 #include "tnn/utils/blob_converter_internal.h"
@@ -32,6 +34,11 @@ public:
     virtual Status ConvertFromMat(Mat& image, MatConvertParam param, void* command_queue = NULL);
     virtual Status ConvertFromMatAsync(Mat& image, MatConvertParam param, void* command_queue = NULL);
 
+protected:
+    // host devices (naive, x86) pass their AsyncTaskQueue as command queue: sync conversions wait for the
+    // queued jobs first, async conversions are appended to the queue behind ForwardAsync.
+    Status RunOnHostTaskQueue(std::function<Status(void)> func, bool async, void* command_queue);
+
 private:
     Status ConvertFromMatFunc(Mat& image, float* blob_data, MatConvertParam& param, BlobDesc& desc,
                               const DimsVector& dims, const int hw);
@@ -24,7 +24,7 @@
 
 namespace TNN_NS {
 
-class BlobConverterAcc {
+class BlobConverterAcc : public std::enable_shared_from_this<BlobConverterAcc> {
 public:
     BlobConverterAcc(Blob* blob) : blob_(blob){};
     virtual ~BlobConverterAcc(){};
@@ -17,7 +17,9 @@
 #include <algorithm>
 #include <cmath>
 #include <numeric>
-#include <queue>
+
+#include "tnn/utils/nms_utils.h"
+
 namespace TNN_NS {
 
 void DecodeBoxes(DetectionPostProcessLayerParam* param, DetectionPostProcessLayerResource* resource,
@@ -115,74 +117,21 @@ void NonMaxSuppressionSingleClasssImpl(Blob* decoded_boxes, const float* scores,
     ASSERT(decoded_boxes->GetBlobDesc().dims[1] == 4);
 
     const int output_num = std::min(max_detections, num_boxes);
-    std::vector<float> scores_data(num_boxes);
-    std::copy_n(scores, num_boxes, scores_data.begin());
-
-    struct Candidate {
-        int box_index;
-        float score;
-    };
-
-    auto cmp = [](const Candidate bs_i, const Candidate bs_j) { return bs_i.score < bs_j.score; };
-
-    std::priority_queue<Candidate, std::deque<Candidate>, decltype(cmp)> candidate_priority_queue(cmp);
-
-    for (int i = 0; i < scores_data.size(); ++i) {
-        if (scores_data[i] > score_threshold) {
-            candidate_priority_queue.emplace(Candidate({i, scores_data[i]}));
-        }
-    }
-
-    // std::vector<float> selectedScores;
-    Candidate next_candidate;
-    float iou, original_score;
 
+    // boxes are [ymin, xmin, ymax, xmax] with the corners in any order
     const auto boxes_ptr = static_cast<float*>(decoded_boxes->GetHandle().base);
-    while (selected->size() < output_num && !candidate_priority_queue.empty()) {
-        next_candidate = candidate_priority_queue.top();
-        original_score = next_candidate.score;
-        candidate_priority_queue.pop();
-
-        // Overlapping boxes are likely to have similar scores,
-        // therefore we iterate through the previously selected boxes backwards
-        // in order to see if `next_candidate` should be suppressed.
-        bool should_select = true;
-        for (int j = (int)selected->size() - 1; j >= 0; --j) {
-            iou = IOU(boxes_ptr, next_candidate.box_index, selected->at(j));
-            if (iou == 0.0) {
-                continue;
-            }
-            if (iou > iou_threshold) {
-                should_select = false;
-            }
-        }
-
-        if (should_select) {
-            selected->push_back(next_candidate.box_index);
-            // selectedScores.push_back(next_candidate.score);
-        }
+    BoxSoA boxes;
+    boxes.Resize(num_boxes);
+    for (int i = 0; i < num_boxes; ++i) {
+        const float* box = boxes_ptr + i * 4;
+        boxes.y1[i]      = std::min(box[0], box[2]);
+        boxes.x1[i]      = std::min(box[1], box[3]);
+        boxes.y2[i]      = std::max(box[0], box[2]);
+        boxes.x2[i]      = std::max(box[1], box[3]);
     }
-}
-static inline float IOU(const float* boxes, int i, int j) {
-    const float y_min_i = std::min<float>(boxes[i * 4 + 0], boxes[i * 4 + 2]);
-    const float x_min_i = std::min<float>(boxes[i * 4 + 1], boxes[i * 4 + 3]);
-    const float y_max_i = std::max<float>(boxes[i * 4 + 0], boxes[i * 4 + 2]);
-    const float x_max_i = std::max<float>(boxes[i * 4 + 1], boxes[i * 4 + 3]);
-    const float y_min_j = std::min<float>(boxes[j * 4 + 0], boxes[j * 4 + 2]);
-    const float x_min_j = std::min<float>(boxes[j * 4 + 1], boxes[j * 4 + 3]);
-    const float y_max_j = std::max<float>(boxes[j * 4 + 0], boxes[j * 4 + 2]);
-    const float x_max_j = std::max<float>(boxes[j * 4 + 1], boxes[j * 4 + 3]);
-    const float area_i  = (y_max_i - y_min_i) * (x_max_i - x_min_i);
-    const float area_j  = (y_max_j - y_min_j) * (x_max_j - x_min_j);
-    if (area_i <= 0 || area_j <= 0)
-        return 0.0;
-    const float intersection_y_min = std::max<float>(y_min_i, y_min_j);
-    const float intersection_x_min = std::max<float>(x_min_i, x_min_j);
-    const float intersection_y_max = std::min<float>(y_max_i, y_max_j);
-    const float intersection_x_max = std::min<float>(x_max_i, x_max_j);
-    const float intersection_area  = std::max<float>(intersection_y_max - intersection_y_min, 0.0) *
-                                    std::max<float>(intersection_x_max - intersection_x_min, 0.0);
-    return intersection_area / (area_i + area_j - intersection_area);
+    boxes.ComputeArea();
+
+    NMSUtils::NMS(boxes, scores, score_threshold, -1, iou_threshold, *selected, output_num);
 }
 
 }  // namespace TNN_NS
\ No newline at end of file
@@ -20,6 +20,20 @@
 
 namespace TNN_NS {
 
+Status MatConverterAcc::Preprocess(Mat& src, Mat& dst, PreprocessParam param, void* command_queue) {
+    return Status(TNNERR_PARAM_ERR, "MatConverterAcc::Preprocess not support yet on this device");
+}
+
+Status MatConverterAcc::PreprocessBatch(Mat& src, Mat& dst, std::vector<PreprocessParam>& params,
+                                        void* command_queue) {
+    return Status(TNNERR_PARAM_ERR, "MatConverterAcc::PreprocessBatch not support yet on this device");
+}
+
+Status MatConverterAcc::WarpAffineBatch(Mat& src, Mat& dst, std::vector<WarpAffineParam>& params,
+                                        void* command_queue) {
+    return Status(TNNERR_PARAM_ERR, "MatConverterAcc::WarpAffineBatch not support yet on this device");
+}
+
 std::shared_ptr<MatConverterManager>& MatConverterManager::Shared() {
     static std::once_flag once;
     static std::shared_ptr<MatConverterManager> g_global_blob_converter_manager;
@@ -168,4 +168,12 @@ int GetMatElementSize(Mat* mat) {
     }
 }
 
+int GetMatBatchBytes(Mat* mat) {
+    MatType mat_type = mat->GetMatType();
+    if (NNV21 == mat_type || NNV12 == mat_type) {
+        return mat->GetHeight() * mat->GetWidth() * 3 / 2;
+    }
+    return mat->GetChannel() * mat->GetHeight() * mat->GetWidth() * GetMatElementSize(mat);
+}
+
 }  // namespace TNN_NS
@@ -56,6 +56,9 @@ void WarpAffineMatrixInverse(const float (*transform)[3], double* inverse);
 
 int GetMatElementSize(Mat* mat);
 
+// bytes of one batch of the mat, yuv420sp mat takes height * width * 3 / 2 bytes
+int GetMatBatchBytes(Mat* mat);
+
 }  // namespace TNN_NS
 
 #endif
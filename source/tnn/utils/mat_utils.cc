@@ -213,6 +213,122 @@ Status MatUtils::CopyMakeBorder(Mat& src, Mat& dst, CopyMakeBorderParam param, v
     return converter->CopyMakeBorder(src, dst, param, command_queue);
 }
 
+static int GetPreprocessSrcChannel(MatType mat_type) {
+    switch (mat_type) {
+        case NGRAY:
+            return 1;
+        case N8UC3:
+        case NNV12:
+        case NNV21:
+            return 3;
+        case N8UC4:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+// check dst channel, scale and bias, and set default crop roi to the whole src image
+static Status CheckPreprocessParam(Mat& src, Mat& dst, PreprocessParam& param) {
+    int src_channel = GetPreprocessSrcChannel(src.GetMatType());
+    if (src_channel == 0) {
+        return Status(TNNERR_PARAM_ERR, "preprocess src mat type not supported");
+    }
+    if (dst.GetMatType() != NCHW_FLOAT) {
+        return Status(TNNERR_PARAM_ERR, "preprocess dst mat type must be NCHW_FLOAT");
+    }
+    if (dst.GetWidth() <= 0 || dst.GetHeight() <= 0) {
+        return Status(TNNERR_PARAM_ERR, "preprocess dst dims is invalid");
+    }
+    if (dst.GetChannel() > src_channel) {
+        return Status(TNNERR_PARAM_ERR, "preprocess dst channel is larger than src channel");
+    }
+    if (param.scale.size() < dst.GetChannel() || param.bias.size() < dst.GetChannel()) {
+        return Status(TNNERR_PARAM_ERR, "preprocess scale or bias size is smaller than dst channel");
+    }
+
+    if (param.crop.width <= 0 || param.crop.height <= 0) {
+        param.crop.top_left_x = 0;
+        param.crop.top_left_y = 0;
+        param.crop.width      = src.GetWidth();
+        param.crop.height     = src.GetHeight();
+    }
+    if (param.crop.top_left_x < 0 || param.crop.top_left_y < 0 ||
+        param.crop.top_left_x + param.crop.width > src.GetWidth() ||
+        param.crop.top_left_y + param.crop.height > src.GetHeight()) {
+        return Status(TNNERR_PARAM_ERR, "preprocess crop roi is out of src image");
+    }
+
+    return TNN_OK;
+}
+
+Status MatUtils::Preprocess(Mat& src, Mat& dst, PreprocessParam param, void* command_queue) {
+    auto ret = CheckSrcAndDstMat(src, dst, true, false, true);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+
+    if (dst.GetBatch() != src.GetBatch()) {
+        return Status(TNNERR_PARAM_ERR, "preprocess dst dims is invalid");
+    }
+    ret = CheckPreprocessParam(src, dst, param);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+
+    MAT_CONVERTER_PREPARATION(src.GetDeviceType());
+    return converter->Preprocess(src, dst, param, command_queue);
+}
+
+Status MatUtils::PreprocessBatch(Mat& src, Mat& dst, std::vector<PreprocessParam> params, void* command_queue) {
+    auto ret = CheckSrcAndDstMat(src, dst, true, false, true);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+
+    if (src.GetBatch() != 1) {
+        return Status(TNNERR_PARAM_ERR, "preprocess batch src batch must be 1");
+    }
+    if (params.empty() || dst.GetBatch() != (int)params.size()) {
+        return Status(TNNERR_PARAM_ERR, "preprocess batch dst batch is not equal to params size");
+    }
+    for (auto& param : params) {
+        ret = CheckPreprocessParam(src, dst, param);
+        if (ret != TNN_OK) {
+            return ret;
+        }
+    }
+
+    MAT_CONVERTER_PREPARATION(src.GetDeviceType());
+    return converter->PreprocessBatch(src, dst, params, command_queue);
+}
+
+Status MatUtils::WarpAffineBatch(Mat& src, Mat& dst, std::vector<WarpAffineParam> params, void* command_queue) {
+    auto ret = CheckSrcAndDstMat(src, dst, true, true, true);
+    if (ret != TNN_OK) {
+        return ret;
+    }
+
+    if (src.GetBatch() != 1) {
+        return Status(TNNERR_PARAM_ERR, "warpaffine batch src batch must be 1");
+    }
+    if (params.empty()) {
+        return Status(TNNERR_PARAM_ERR, "warpaffine batch params is empty");
+    }
+
+    if (dst.GetData() == nullptr) {
+        // set dst size to src size, one batch for each param
+        DimsVector dims = src.GetDims();
+        dims[0]         = (int)params.size();
+        dst             = Mat(dst.GetDeviceType(), dst.GetMatType(), dims);
+    } else if (dst.GetBatch() != (int)params.size()) {
+        return Status(TNNERR_PARAM_ERR, "warpaffine batch dst batch is not equal to params size");
+    }
+
+    MAT_CONVERTER_PREPARATION(src.GetDeviceType());
+    return converter->WarpAffineBatch(src, dst, params, command_queue);
+}
+
 #undef CHECK_DST_DATA_NULL
 #undef MAT_CONVERTER_PREPARATION
 
@@ -1118,11 +1118,16 @@ inline CodeType GetCodeType(const int number) {
     }
 }
 
+// the data of a blob, blobs in a shared memory start at bytes_offset
+static float *GetBlobFloatData(Blob *blob) {
+    return reinterpret_cast<float *>(static_cast<char *>(blob->GetHandle().base) + blob->GetHandle().bytes_offset);
+}
+
 void DealOutput(Blob *output_blob, const int num_kept, const int num,
                 std::vector<std::map<int, std::vector<float>>> &all_conf_scores,
                 std::vector<LabelBBox> &all_decode_bboxes, std::vector<std::map<int, std::vector<int>>> &all_indices,
                 DetectionOutputLayerParam *param) {
-    float *top_data = static_cast<float *>(output_blob->GetHandle().base);
+    float *top_data = GetBlobFloatData(output_blob);
     // clear all output to 0
     priorbox_set_value(DimsVectorUtils::Count(output_blob->GetBlobDesc().dims), 0, top_data);
 
@@ -1199,9 +1204,9 @@ void NaiveDetectionOutput(const std::vector<Blob *> &inputs, const std::vector<B
     // why defination objectness_score_ ?
     const float objectness_score_ = 0.1f;
 
-    const float *loc_data   = static_cast<const float *>(loc_blob->GetHandle().base);
-    const float *conf_data  = static_cast<const float *>(conf_blob->GetHandle().base);
-    const float *prior_data = static_cast<const float *>(prior_blob->GetHandle().base);
+    const float *loc_data   = GetBlobFloatData(loc_blob);
+    const float *conf_data  = GetBlobFloatData(conf_blob);
+    const float *prior_data = GetBlobFloatData(prior_blob);
 
     const float *arm_conf_data = nullptr;
     const float *arm_loc_data  = nullptr;
@@ -1213,10 +1218,10 @@ void NaiveDetectionOutput(const std::vector<Blob *> &inputs, const std::vector<B
 
     // TODO: differ
     if (inputs.size() >= 4) {
-        arm_conf_data = static_cast<float *>(inputs[3]->GetHandle().base);
+        arm_conf_data = GetBlobFloatData(inputs[3]);
     }
     if (inputs.size() >= 5) {
-        arm_loc_data = static_cast<float *>(inputs[4]->GetHandle().base);
+        arm_loc_data = GetBlobFloatData(inputs[4]);
         GetLocPredictions(arm_loc_data, num, num_priors, num_loc_classes, param->share_location, &all_arm_loc_preds);
     }
 
@@ -0,0 +1,176 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "tnn/utils/nms_utils.h"
+
+#include <algorithm>
+
+#if defined(__SSE__) || defined(_M_X64)
+#define TNN_NMS_USE_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace TNN_NS {
+
+void BoxSoA::Resize(int count) {
+    x1.resize(count);
+    y1.resize(count);
+    x2.resize(count);
+    y2.resize(count);
+    area.resize(count);
+}
+
+int BoxSoA::Size() const {
+    return static_cast<int>(x1.size());
+}
+
+void BoxSoA::ComputeArea() {
+    const int count = Size();
+    area.resize(count);
+    for (int i = 0; i < count; ++i) {
+        float w = x2[i] - x1[i] + offset;
+        float h = y2[i] - y1[i] + offset;
+        area[i] = (w > 0 && h > 0) ? w * h : 0.f;
+    }
+}
+
+// iou of one box against count boxes stored in soa arrays, the scalar loop is branch free so that it can be
+// vectorized by the compiler on targets without the sse path
+static void IoUKernel(float x1, float y1, float x2, float y2, float area, float offset, const float *bx1,
+                      const float *by1, const float *bx2, const float *by2, const float *barea, int count,
+                      float *iou) {
+    if (area <= 0) {
+        std::fill(iou, iou + count, 0.f);
+        return;
+    }
+    int i = 0;
+#ifdef TNN_NMS_USE_SSE
+    const __m128 v_x1   = _mm_set1_ps(x1);
+    const __m128 v_y1   = _mm_set1_ps(y1);
+    const __m128 v_x2   = _mm_set1_ps(x2);
+    const __m128 v_y2   = _mm_set1_ps(y2);
+    const __m128 v_area = _mm_set1_ps(area);
+    const __m128 v_off  = _mm_set1_ps(offset);
+    const __m128 v_zero = _mm_setzero_ps();
+    for (; i + 3 < count; i += 4) {
+        __m128 inter_w = _mm_sub_ps(_mm_min_ps(v_x2, _mm_loadu_ps(bx2 + i)), _mm_max_ps(v_x1, _mm_loadu_ps(bx1 + i)));
+        __m128 inter_h = _mm_sub_ps(_mm_min_ps(v_y2, _mm_loadu_ps(by2 + i)), _mm_max_ps(v_y1, _mm_loadu_ps(by1 + i)));
+        inter_w        = _mm_add_ps(inter_w, v_off);
+        inter_h        = _mm_add_ps(inter_h, v_off);
+        __m128 b_area  = _mm_loadu_ps(barea + i);
+        __m128 inter   = _mm_mul_ps(inter_w, inter_h);
+        __m128 uni     = _mm_sub_ps(_mm_add_ps(v_area, b_area), inter);
+        __m128 valid   = _mm_and_ps(_mm_cmpgt_ps(inter_w, v_zero), _mm_cmpgt_ps(inter_h, v_zero));
+        valid          = _mm_and_ps(valid, _mm_cmpgt_ps(b_area, v_zero));
+        _mm_storeu_ps(iou + i, _mm_and_ps(valid, _mm_div_ps(inter, uni)));
+    }
+#endif
+    for (; i < count; ++i) {
+        float inter_w = std::min(x2, bx2[i]) - std::max(x1, bx1[i]) + offset;
+        float inter_h = std::min(y2, by2[i]) - std::max(y1, by1[i]) + offset;
+        float inter   = inter_w * inter_h;
+        bool valid    = inter_w > 0 && inter_h > 0 && barea[i] > 0;
+        iou[i]        = valid ? inter / (area + barea[i] - inter) : 0.f;
+    }
+}
+
+void NMSUtils::TopK(const float *scores, int count, float threshold, int top_k, std::vector<int> &indices) {
+    indices.clear();
+    for (int i = 0; i < count; ++i) {
+        if (scores[i] > threshold) {
+            indices.push_back(i);
+        }
+    }
+    auto greater = [scores](int a, int b) { return scores[a] > scores[b] || (scores[a] == scores[b] && a < b); };
+    if (top_k >= 0 && top_k < static_cast<int>(indices.size())) {
+        std::nth_element(indices.begin(), indices.begin() + top_k, indices.end(), greater);
+        indices.resize(top_k);
+    }
+    std::sort(indices.begin(), indices.end(), greater);
+}
+
+void NMSUtils::IoU(const BoxSoA &boxes, int index, int begin, int end, float *iou) {
+    IoUKernel(boxes.x1[index], boxes.y1[index], boxes.x2[index], boxes.y2[index], boxes.area[index], boxes.offset,
+              boxes.x1.data() + begin, boxes.y1.data() + begin, boxes.x2.data() + begin, boxes.y2.data() + begin,
+              boxes.area.data() + begin, end - begin, iou);
+}
+
+void NMSUtils::NMS(const BoxSoA &boxes, const std::vector<int> &candidates, float iou_threshold,
+                   std::vector<int> &keep, int max_keep, float eta) {
+    keep.clear();
+    int capacity = static_cast<int>(candidates.size());
+    if (max_keep >= 0) {
+        capacity = std::min(capacity, max_keep);
+    }
+    // kept boxes are gathered into contiguous arrays, a candidate is checked against them block by block and
+    // stops at the first block that suppresses it
+    const int block = 16;
+    float iou[block];
+    BoxSoA kept;
+    kept.Resize(capacity);
+    int num_kept    = 0;
+    float threshold = iou_threshold;
+    for (const int idx : candidates) {
+        if (num_kept >= capacity) {
+            break;
+        }
+        bool suppressed = false;
+        for (int begin = 0; begin < num_kept && !suppressed; begin += block) {
+            const int count = std::min(block, num_kept - begin);
+            IoUKernel(boxes.x1[idx], boxes.y1[idx], boxes.x2[idx], boxes.y2[idx], boxes.area[idx], boxes.offset,
+                      kept.x1.data() + begin, kept.y1.data() + begin, kept.x2.data() + begin,
+                      kept.y2.data() + begin, kept.area.data() + begin, count, iou);
+            for (int j = 0; j < count; ++j) {
+                suppressed |= iou[j] > threshold;
+            }
+        }
+        if (suppressed) {
+            continue;
+        }
+        kept.x1[num_kept]   = boxes.x1[idx];
+        kept.y1[num_kept]   = boxes.y1[idx];
+        kept.x2[num_kept]   = boxes.x2[idx];
+        kept.y2[num_kept]   = boxes.y2[idx];
+        kept.area[num_kept] = boxes.area[idx];
+        num_kept++;
+        keep.push_back(idx);
+        if (eta < 1 && threshold > 0.5f) {
+            threshold *= eta;
+        }
+    }
+}
+
+void NMSUtils::NMS(const BoxSoA &boxes, const float *scores, float score_threshold, int top_k, float iou_threshold,
+                   std::vector<int> &keep, int max_keep, float eta) {
+    std::vector<int> candidates;
+    if (max_keep < 0) {
+        TopK(scores, boxes.Size(), score_threshold, top_k, candidates);
+        NMS(boxes, candidates, iou_threshold, keep, max_keep, eta);
+        return;
+    }
+    // the nms of a sorted prefix is the start of the full nms, so the candidates are selected in growing chunks
+    // until max_keep boxes are kept or all candidates are used
+    int chunk = std::max(4 * max_keep, 64);
+    while (true) {
+        const int k = (top_k >= 0 && top_k <= chunk) ? top_k : chunk;
+        TopK(scores, boxes.Size(), score_threshold, k, candidates);
+        NMS(boxes, candidates, iou_threshold, keep, max_keep, eta);
+        if (static_cast<int>(keep.size()) >= max_keep || static_cast<int>(candidates.size()) < k || k == top_k) {
+            break;
+        }
+        chunk *= 2;
+    }
+}
+
+}  // namespace TNN_NS
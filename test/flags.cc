@@ -58,4 +58,10 @@ DEFINE_string(sc, "", scale_message);
 
 DEFINE_string(bi, "", bias_message);
 
+DEFINE_int32(ni, 1, instance_num_message);
+
+DEFINE_string(bj, "", benchmark_json_message);
+
+DEFINE_bool(ti, false, init_profile_message);
+
 }  // namespace TNN_NS
@@ -65,6 +65,15 @@ static const char scale_message[] = "input scale: s0,s1,s2,...)";
 
 static const char bias_message[] = "input bias: b0,b1,b2,...)";
 
+static const char instance_num_message[] =
+    "concurrent instance num, each instance runs on its own thread with -th cpu threads (default 1)";
+
+static const char init_profile_message[] =
+    "print wall time, cpu time and allocated bytes of each init phase, optimizer and layer init (default false)";
+
+static const char benchmark_json_message[] =
+    "write benchmark result (latency percentiles, throughput, cold start, memory) to this json file";
+
 DECLARE_bool(h);
 
 DECLARE_string(mt);
@@ -107,6 +116,12 @@ DECLARE_string(sc);
 
 DECLARE_string(bi);
 
+DECLARE_int32(ni);
+
+DECLARE_string(bj);
+
+DECLARE_bool(ti);
+
 }  // namespace TNN_NS
 
 #endif  // TNN_TEST_FLAGS_H_
@@ -0,0 +1,514 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "test/flags.h"
+#include "test/test_utils.h"
+#include "test/timer.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/core/instance.h"
+#include "tnn/core/macro.h"
+#include "tnn/core/mat.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/interpreter/layer_param.h"
+#include "tnn/interpreter/layer_resource.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/random_data_utils.h"
+
+namespace TNN_NS {
+
+static const char baseline_message[] = "baseline json to compare with, exit with 1 if any case is slower than it";
+
+static const char save_baseline_message[] = "save the results as baseline json to this path";
+
+static const char tolerance_message[] = "allowed slowdown against the baseline, 0.1 means 10% (default 0.1)";
+
+static const char filter_message[] = "only run the cases whose name contains this string";
+
+DEFINE_string(bl, "", baseline_message);
+
+DEFINE_string(sb, "", save_baseline_message);
+
+DEFINE_double(tol, 0.1, tolerance_message);
+
+DEFINE_string(fl, "", filter_message);
+
+namespace test {
+
+    // one layer with fixed shapes, flops and bytes are counted per forward
+    struct LayerBenchmarkCase {
+        std::string name;
+        std::string layer_type;
+        std::vector<DimsVector> input_dims;
+        std::shared_ptr<LayerParam> param;
+        std::shared_ptr<LayerResource> resource;
+        // scale resources of int8 blobs, keyed by blob name
+        std::map<std::string, std::shared_ptr<LayerResource>> blob_scales;
+        double flops = 0;
+        double bytes = 0;
+    };
+
+    struct LayerBenchmarkResult {
+        std::string name;
+        // median of all iterations
+        double time_ms = 0;
+        double gflops  = 0;
+        double gbps    = 0;
+    };
+
+    static RawBuffer CreateRandomBuffer(int count) {
+        RawBuffer buffer(count * sizeof(float));
+        InitRandom(buffer.force_to<float *>(), count, -1.0f, 1.0f);
+        buffer.SetDataType(DATA_TYPE_FLOAT);
+        return buffer;
+    }
+
+    static LayerBenchmarkCase ConvCase(std::string name, int batch, int input_channel, int output_channel, int size,
+                                       int kernel, int stride, int group) {
+        auto param             = std::make_shared<ConvLayerParam>();
+        param->name            = "Conv";
+        param->input_channel   = input_channel;
+        param->output_channel  = output_channel;
+        param->group           = group;
+        param->kernels         = {kernel, kernel};
+        param->dialations      = {1, 1};
+        param->strides         = {stride, stride};
+        param->pads            = {kernel / 2, kernel / 2, kernel / 2, kernel / 2};
+        param->bias            = 1;
+        param->activation_type = ActivationType_ReLU;
+
+        auto resource           = std::make_shared<ConvLayerResource>();
+        const int weight_count  = output_channel * input_channel / group * kernel * kernel;
+        resource->filter_handle = CreateRandomBuffer(weight_count);
+        resource->bias_handle   = CreateRandomBuffer(output_channel);
+
+        const int output_size = (size + 2 * (kernel / 2) - kernel) / stride + 1;
+        const double output_count = (double)batch * output_channel * output_size * output_size;
+
+        LayerBenchmarkCase bench_case;
+        bench_case.name       = name;
+        bench_case.layer_type = "Convolution";
+        bench_case.input_dims = {{batch, input_channel, size, size}};
+        bench_case.param      = param;
+        bench_case.resource   = resource;
+        bench_case.flops      = 2.0 * output_count * input_channel / group * kernel * kernel;
+        bench_case.bytes = 4.0 * ((double)batch * input_channel * size * size + output_count + weight_count);
+        return bench_case;
+    }
+
+    static LayerBenchmarkCase MatMulCase(std::string name, int batch, int m, int k, int n, bool const_weight) {
+        auto param             = std::make_shared<MatMulLayerParam>();
+        param->name            = "MatMul";
+        param->weight_position = const_weight ? 1 : -1;
+
+        LayerBenchmarkCase bench_case;
+        bench_case.name       = name;
+        bench_case.layer_type = "MatMul";
+        bench_case.input_dims = {{batch, m, k}};
+        if (const_weight) {
+            auto resource    = std::make_shared<MatMulLayerResource>();
+            resource->weight = CreateRandomBuffer(k * n);
+            resource->weight.SetBufferDims({k, n});
+            bench_case.resource = resource;
+        } else {
+            bench_case.input_dims.push_back({batch, k, n});
+        }
+        bench_case.param = param;
+        bench_case.flops = 2.0 * batch * m * n * k;
+        bench_case.bytes = 4.0 * ((double)batch * m * k + (const_weight ? 1 : batch) * (double)k * n +
+                                  (double)batch * m * n);
+        return bench_case;
+    }
+
+    static LayerBenchmarkCase PoolingCase(std::string name, int channel, int size, int kernel, int stride,
+                                          int pool_type) {
+        auto param            = std::make_shared<PoolingLayerParam>();
+        param->name           = "Pooling";
+        param->kernels_params = {kernel, kernel};
+        param->kernels        = {kernel, kernel};
+        param->strides        = {stride, stride};
+        param->pads           = {0, 0, 0, 0};
+        param->pad_type       = -1;
+        param->pool_type      = pool_type;
+        param->kernel_indexs  = {-1, -1};
+
+        const int output_size     = (size - kernel + stride - 1) / stride + 1;
+        const double output_count = (double)channel * output_size * output_size;
+
+        LayerBenchmarkCase bench_case;
+        bench_case.name       = name;
+        bench_case.layer_type = "Pooling";
+        bench_case.input_dims = {{1, channel, size, size}};
+        bench_case.param      = param;
+        bench_case.flops      = output_count * kernel * kernel;
+        bench_case.bytes      = 4.0 * ((double)channel * size * size + output_count);
+        return bench_case;
+    }
+
+    static LayerBenchmarkCase SoftmaxCase(std::string name, DimsVector dims, int axis) {
+        auto param  = std::make_shared<SoftmaxLayerParam>();
+        param->name = "Softmax";
+        param->axis = axis;
+
+        const double count = DimsVectorUtils::Count(dims);
+        LayerBenchmarkCase bench_case;
+        bench_case.name       = name;
+        bench_case.layer_type = "Softmax";
+        bench_case.input_dims = {dims};
+        bench_case.param      = param;
+        // max, sub, exp, sum and div
+        bench_case.flops = 5.0 * count;
+        bench_case.bytes = 4.0 * 2 * count;
+        return bench_case;
+    }
+
+    static LayerBenchmarkCase LayerNormCase(std::string name, int batch, int seq_len, int hidden) {
+        auto param              = std::make_shared<LayerNormLayerParam>();
+        param->name             = "LayerNorm";
+        param->reduce_dims_size = 1;
+
+        const double count = (double)batch * seq_len * hidden;
+        LayerBenchmarkCase bench_case;
+        bench_case.name       = name;
+        bench_case.layer_type = "LayerNorm";
+        bench_case.input_dims = {{batch, seq_len, hidden}, {hidden}, {hidden}};
+        bench_case.param      = param;
+        // mean, variance, normalize, scale and bias
+        bench_case.flops = 8.0 * count;
+        bench_case.bytes = 4.0 * (2 * count + 2 * hidden);
+        return bench_case;
+    }
+
+    static LayerBenchmarkCase ReformatCase(std::string name, int channel, int size, bool quantize) {
+        auto param      = std::make_shared<ReformatLayerParam>();
+        param->name     = "Reformat";
+        param->src_type = quantize ? DATA_TYPE_FLOAT : DATA_TYPE_INT8;
+        param->dst_type = quantize ? DATA_TYPE_INT8 : DATA_TYPE_FLOAT;
+
+        const double count = (double)channel * size * size;
+        LayerBenchmarkCase bench_case;
+        bench_case.name       = name;
+        bench_case.layer_type = "Reformat";
+        bench_case.input_dims = {{1, channel, size, size}};
+        bench_case.param      = param;
+        std::string int8_blob = quantize ? "output0" : "input0";
+        bench_case.blob_scales[int8_blob + "_scale_data_"] = std::shared_ptr<LayerResource>(CreateIntScale(channel));
+        bench_case.flops = count;
+        bench_case.bytes = 5.0 * count;
+        return bench_case;
+    }
+
+    static LayerBenchmarkCase GRUCase(std::string name, int seq_len, int batch, int input_size, int hidden_size,
+                                      int direction) {
+        auto param                 = std::make_shared<GRUONNXLayerParam>();
+        param->name                = "GRUONNX";
+        param->hidden_size         = hidden_size;
+        param->direction           = direction;
+        param->linear_before_reset = 1;
+
+        const int num_directions = direction == 2 ? 2 : 1;
+        const double weight_count = (double)num_directions * 3 * hidden_size * (input_size + hidden_size);
+        LayerBenchmarkCase bench_case;
+        bench_case.name       = name;
+        bench_case.layer_type = "GRUONNX";
+        // weights are generated as constants
+        bench_case.input_dims = {{seq_len, batch, input_size},
+                                 {num_directions, 3 * hidden_size, input_size},
+                                 {num_directions, 3 * hidden_size, hidden_size},
+                                 {num_directions, 6 * hidden_size}};
+        bench_case.param      = param;
+        bench_case.flops      = 2.0 * seq_len * batch * weight_count;
+        bench_case.bytes =
+            4.0 * ((double)seq_len * batch * (input_size + num_directions * hidden_size) + weight_count);
+        return bench_case;
+    }
+
+    static LayerBenchmarkCase DetectionOutputCase(std::string name, int num_priors, int num_classes) {
+        auto param                        = std::make_shared<DetectionOutputLayerParam>();
+        param->name                       = "DetectionOutput";
+        param->num_classes                = num_classes;
+        param->share_location             = true;
+        param->background_label_id        = 0;
+        param->variance_encoded_in_target = false;
+        param->code_type                  = 2;
+        param->keep_top_k                 = 200;
+        param->confidence_threshold       = 0.01f;
+        param->nms_param.nms_threshold    = 0.45f;
+        param->nms_param.top_k            = 400;
+        param->eta                        = 1.0f;
+
+        LayerBenchmarkCase bench_case;
+        bench_case.name       = name;
+        bench_case.layer_type = "DetectionOutput";
+        bench_case.input_dims = {
+            {1, num_priors * 4, 1, 1}, {1, num_priors * num_classes, 1, 1}, {1, 2, num_priors * 4, 1}};
+        bench_case.param = param;
+        bench_case.bytes = 4.0 * num_priors * (12 + num_classes);
+        return bench_case;
+    }
+
+    static LayerBenchmarkCase NonMaxSuppressionCase(std::string name, int num_boxes, int num_classes) {
+        auto param                        = std::make_shared<NonMaxSuppressionLayerParam>();
+        param->name                       = "NonMaxSuppression";
+        param->max_output_boxes_per_class = 100;
+        param->iou_threshold              = 0.5f;
+        param->score_threshold            = 0.05f;
+
+        LayerBenchmarkCase bench_case;
+        bench_case.name       = name;
+        bench_case.layer_type = "NonMaxSuppression";
+        bench_case.input_dims = {{1, num_boxes, 4}, {1, num_classes, num_boxes}};
+        bench_case.param      = param;
+        bench_case.bytes      = 4.0 * num_boxes * (4 + num_classes);
+        return bench_case;
+    }
+
+    // representative shapes of the hot ops, conv cases cover each implementation chosen by X86ConvLayerAccFactory
+    static std::vector<LayerBenchmarkCase> GetLayerBenchmarkCases() {
+        std::vector<LayerBenchmarkCase> cases;
+        // X86ConvLayer3x3, winograd
+        cases.push_back(ConvCase("conv3x3_s1_64x56x56", 1, 64, 64, 56, 3, 1, 1));
+        cases.push_back(ConvCase("conv3x3_s1_256x14x14", 1, 256, 256, 14, 3, 1, 1));
+        // X86ConvLayer1x1
+        cases.push_back(ConvCase("conv1x1_256to64x56x56", 1, 256, 64, 56, 1, 1, 1));
+        cases.push_back(ConvCase("conv1x1_512to2048x7x7", 1, 512, 2048, 7, 1, 1, 1));
+        // X86ConvLayerDepthwise
+        cases.push_back(ConvCase("convdw3x3_s1_144x56x56", 1, 144, 144, 56, 3, 1, 144));
+        cases.push_back(ConvCase("convdw3x3_s2_384x28x28", 1, 384, 384, 28, 3, 2, 384));
+        // X86ConvLayerCommon
+        cases.push_back(ConvCase("conv3x3_s2_64x112x112", 1, 64, 128, 112, 3, 2, 1));
+        cases.push_back(ConvCase("conv7x7_s2_3x224x224", 1, 3, 64, 224, 7, 2, 1));
+        cases.push_back(ConvCase("conv3x3_group4_128x28x28", 1, 128, 128, 28, 3, 1, 4));
+
+        cases.push_back(MatMulCase("matmul_const_384x768x768", 1, 384, 768, 768, true));
+        cases.push_back(MatMulCase("matmul_const_128x768x3072", 1, 128, 768, 3072, true));
+        cases.push_back(MatMulCase("matmul_12x384x64x384", 12, 384, 64, 384, false));
+
+        cases.push_back(PoolingCase("maxpool3x3_s2_64x112x112", 64, 112, 3, 2, 0));
+        cases.push_back(PoolingCase("avgpool7x7_2048x7x7", 2048, 7, 7, 1, 1));
+
+        cases.push_back(SoftmaxCase("softmax_32x1000", {32, 1000}, 1));
+        cases.push_back(SoftmaxCase("softmax_12x384x384", {1, 12, 384, 384}, 3));
+
+        cases.push_back(LayerNormCase("layernorm_384x768", 1, 384, 768));
+
+        cases.push_back(ReformatCase("quantize_64x56x56", 64, 56, true));
+        cases.push_back(ReformatCase("dequantize_64x56x56", 64, 56, false));
+
+        // keyword spotting and denoising shapes
+        cases.push_back(GRUCase("gru_100x40x128", 100, 1, 40, 128, 0));
+        cases.push_back(GRUCase("gru_bi_64x257x256", 64, 1, 257, 256, 2));
+
+        // ssd and yolo style post-processing
+        cases.push_back(DetectionOutputCase("detection_output_8732x21", 8732, 21));
+        cases.push_back(NonMaxSuppressionCase("nms_20000x80", 20000, 80));
+        return cases;
+    }
+
+    static Status RunLayerBenchmarkCase(LayerBenchmarkCase &bench_case, LayerBenchmarkResult &result) {
+        auto interpreter = GenerateInterpreter(bench_case.layer_type, bench_case.input_dims, bench_case.param,
+                                               bench_case.resource);
+        if (!interpreter) {
+            return Status(TNNERR_NET_ERR, "generate interpreter failed");
+        }
+        auto default_interpreter = dynamic_cast<DefaultModelInterpreter *>(interpreter.get());
+        for (auto iter : bench_case.blob_scales) {
+            default_interpreter->GetNetResource()->resource_map[iter.first] = iter.second;
+        }
+
+        NetworkConfig network_config;
+        network_config.device_type = ConvertDeviceType(FLAGS_dt);
+        network_config.precision   = ConvertPrecision(FLAGS_pr);
+        if (FLAGS_lp.length() > 0) {
+            network_config.library_path = {FLAGS_lp};
+        }
+        ModelConfig model_config;
+        model_config.model_type = MODEL_TYPE_TNN;
+
+        auto instance = std::make_shared<Instance>(network_config, model_config);
+        auto input_shapes = default_interpreter->GetNetStructure()->inputs_shape_map;
+        RETURN_ON_NEQ(instance->Init(interpreter, input_shapes), TNN_OK);
+        RETURN_ON_NEQ(instance->SetCpuNumThreads(std::max(FLAGS_th, 1)), TNN_OK);
+
+        BlobMap input_blobs;
+        instance->GetAllInputBlobs(input_blobs);
+        for (auto iter : input_blobs) {
+            auto desc = iter.second->GetBlobDesc();
+            if (desc.data_type == DATA_TYPE_INT8) {
+                // int8 inputs keep their zero memory, the content does not matter for timing
+                continue;
+            }
+            auto mat = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT, desc.dims);
+            InitRandom(static_cast<float *>(mat->GetData()), DimsVectorUtils::Count(desc.dims), 0.1f, 1.0f);
+            RETURN_ON_NEQ(instance->SetInputMat(mat, MatConvertParam(), iter.first), TNN_OK);
+        }
+
+        for (int i = 0; i < FLAGS_wc; ++i) {
+            RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+        }
+        Timer timer(bench_case.name);
+        for (int i = 0; i < FLAGS_ic; ++i) {
+            timer.Start();
+            RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+            timer.Stop();
+        }
+
+        result.name    = bench_case.name;
+        result.time_ms = timer.GetPercentile(50.0f);
+        if (result.time_ms > 0) {
+            result.gflops = bench_case.flops / result.time_ms / 1e6;
+            result.gbps   = bench_case.bytes / result.time_ms / 1e6;
+        }
+        return TNN_OK;
+    }
+
+    static void SaveBaseline(const std::string &path, std::vector<LayerBenchmarkResult> &results) {
+        std::ofstream f(path);
+        if (!f.is_open()) {
+            LOGE("open baseline file %s failed\n", path.c_str());
+            return;
+        }
+        f << std::fixed << std::setprecision(4);
+        f << "{" << std::endl;
+        f << "    \"device\": \"" << FLAGS_dt << "\"," << std::endl;
+        f << "    \"threads\": " << std::max(FLAGS_th, 1) << "," << std::endl;
+        f << "    \"cases\": [" << std::endl;
+        for (int i = 0; i < results.size(); ++i) {
+            auto &result = results[i];
+            f << "        {\"name\": \"" << result.name << "\", \"time_ms\": " << result.time_ms
+              << ", \"gflops\": " << result.gflops << ", \"gbps\": " << result.gbps << "}"
+              << (i + 1 < results.size() ? "," : "") << std::endl;
+        }
+        f << "    ]" << std::endl;
+        f << "}" << std::endl;
+    }
+
+    static bool GetJsonValue(const std::string &line, const std::string &key, std::string &value) {
+        auto pos = line.find("\"" + key + "\":");
+        if (pos == std::string::npos) {
+            return false;
+        }
+        pos = line.find_first_not_of(" \"", pos + key.size() + 3);
+        if (pos == std::string::npos) {
+            return false;
+        }
+        auto end = line.find_first_of("\",}", pos);
+        value    = line.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+        return true;
+    }
+
+    // read the baseline written by SaveBaseline, one case per line
+    static std::map<std::string, LayerBenchmarkResult> LoadBaseline(const std::string &path) {
+        std::map<std::string, LayerBenchmarkResult> baseline;
+        std::ifstream f(path);
+        if (!f.is_open()) {
+            LOGE("open baseline file %s failed\n", path.c_str());
+            return baseline;
+        }
+        std::string line;
+        while (std::getline(f, line)) {
+            LayerBenchmarkResult result;
+            std::string value;
+            if (!GetJsonValue(line, "name", result.name) || !GetJsonValue(line, "time_ms", value)) {
+                continue;
+            }
+            result.time_ms = atof(value.c_str());
+            if (GetJsonValue(line, "gflops", value)) {
+                result.gflops = atof(value.c_str());
+            }
+            if (GetJsonValue(line, "gbps", value)) {
+                result.gbps = atof(value.c_str());
+            }
+            baseline[result.name] = result;
+        }
+        return baseline;
+    }
+
+    int RunLayerBenchmark(int argc, char *argv[]) {
+        gflags::ParseCommandLineNonHelpFlags(&argc, &argv, true);
+        if (FLAGS_h || FLAGS_ic < 1) {
+            printf("    -dt \"<device type>\"    \t%s \n", device_type_message);
+            printf("    -th \"<thread number>\"  \t%s \n", cpu_thread_num_message);
+            printf("    -pr \"<precision>\"      \t%s \n", precision_message);
+            printf("    -ic \"<number>\"         \t%s \n", iterations_count_message);
+            printf("    -wc \"<number>\"         \t%s \n", warm_up_count_message);
+            printf("    -fl \"<filter>\"         \t%s \n", filter_message);
+            printf("    -bl \"<baseline path>\"  \t%s \n", baseline_message);
+            printf("    -sb \"<baseline path>\"  \t%s \n", save_baseline_message);
+            printf("    -tol \"<tolerance>\"     \t%s \n", tolerance_message);
+            return FLAGS_h ? 0 : -1;
+        }
+
+        std::map<std::string, LayerBenchmarkResult> baseline;
+        if (!FLAGS_bl.empty()) {
+            baseline = LoadBaseline(FLAGS_bl);
+        }
+
+        printf("%-32s %12s %12s %12s %12s %8s\n", "case", "time(ms)", "GFLOP/s", "GB/s", "base(ms)", "ratio");
+        std::vector<LayerBenchmarkResult> results;
+        int failed_count     = 0;
+        int regression_count = 0;
+        for (auto &bench_case : GetLayerBenchmarkCases()) {
+            if (!FLAGS_fl.empty() && bench_case.name.find(FLAGS_fl) == std::string::npos) {
+                continue;
+            }
+            LayerBenchmarkResult result;
+            Status status = RunLayerBenchmarkCase(bench_case, result);
+            if (status != TNN_OK) {
+                printf("%-32s failed: %s\n", bench_case.name.c_str(), status.description().c_str());
+                failed_count++;
+                continue;
+            }
+            results.push_back(result);
+
+            auto iter = baseline.find(result.name);
+            if (iter == baseline.end() || iter->second.time_ms <= 0) {
+                printf("%-32s %12.4f %12.2f %12.2f %12s %8s\n", result.name.c_str(), result.time_ms, result.gflops,
+                       result.gbps, "-", "-");
+                continue;
+            }
+            double ratio    = result.time_ms / iter->second.time_ms;
+            bool regression = ratio > 1.0 + FLAGS_tol;
+            printf("%-32s %12.4f %12.2f %12.2f %12.4f %8.3f%s\n", result.name.c_str(), result.time_ms, result.gflops,
+                   result.gbps, iter->second.time_ms, ratio, regression ? "  REGRESSION" : "");
+            regression_count += regression ? 1 : 0;
+        }
+
+        if (!FLAGS_sb.empty()) {
+            SaveBaseline(FLAGS_sb, results);
+        }
+        if (failed_count > 0 || regression_count > 0) {
+            printf("%d cases failed, %d cases slower than baseline by more than %.1f%%\n", failed_count,
+                   regression_count, FLAGS_tol * 100);
+            return 1;
+        }
+        return 0;
+    }
+
+}  // namespace test
+
+}  // namespace TNN_NS
+
+int main(int argc, char *argv[]) {
+    return TNN_NS::test::RunLayerBenchmark(argc, argv);
+}
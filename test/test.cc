@@ -18,12 +18,18 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
 #include <cfloat>
 #include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <sstream>
 #include <string>
+#include <thread>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
 
 #include "test/flags.h"
 #include "test/test_utils.h"
@@ -49,6 +55,9 @@ namespace TNN_NS {
 
 namespace test {
 
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
     int Run(int argc, char* argv[]) {
         // parse command line params
         if (!ParseAndCheckCommandLine(argc, argv))
@@ -69,51 +78,32 @@ namespace test {
 
         srand(102);
 
+        Timer init_timer("init");
+        init_timer.Start();
         TNN net;
         Status ret = net.Init(model_config);
         model_config.params.clear();
         if (CheckResult("init tnn", ret)) {
-            auto instance = net.CreateInst(network_config, ret, input_shape);
-            if (!CheckResult("create instance", ret)) {
-                return ret;
-            }
-            instance->SetCpuNumThreads(std::max(FLAGS_th, 1));
-
-            //get blob
-            BlobMap input_blob_map;
-            BlobMap output_blob_map;
-            void* command_queue;
-            instance->GetAllInputBlobs(input_blob_map);
-            instance->GetAllOutputBlobs(output_blob_map);
-            instance->GetCommandQueue(&command_queue);
-
-            //create mat and converter
-            MatMap input_mat_map = CreateBlobMatMap(input_blob_map, FLAGS_it);
-            InitInputMatMap(input_mat_map);
-            auto input_converters_map = CreateBlobConverterMap(input_blob_map);
-            auto input_params_map = CreateConvertParamMap(input_mat_map, true);
-
-            //mat format NCHW_FLOAT
-            MatMap output_mat_map = CreateBlobMatMap(output_blob_map, 0);
-            auto output_converters_map = CreateBlobConverterMap(output_blob_map);
-            auto output_params_map = CreateConvertParamMap(output_mat_map, false);
-
-            for (int i = 0; i < FLAGS_wc; ++i) {
-                for(auto element : input_converters_map) {
-                    auto name = element.first;
-                    auto blob_converter = element.second;
-                    blob_converter->ConvertFromMatAsync(*input_mat_map[name], input_params_map[name], command_queue);
-                }
-                ret = instance->ForwardAsync(nullptr);
-                for(auto element : output_converters_map) {
-                    auto name = element.first;
-                    auto blob_converter = element.second;
-                    blob_converter->ConvertToMat(*output_mat_map[name], output_params_map[name], command_queue);
+            // each instance gets its own mats and converters, so instances can run concurrently
+            const int instance_num = std::max(FLAGS_ni, 1);
+            std::vector<std::shared_ptr<InstanceRunner>> runners;
+            for (int k = 0; k < instance_num; ++k) {
+                auto runner = CreateInstanceRunner(net, network_config, input_shape, ret);
+                if (!CheckResult("create instance", ret)) {
+                    return ret;
                 }
+                runners.push_back(runner);
+            }
+            init_timer.Stop();
+            const long init_peak_memory = GetPeakMemoryKB();
+
+            if (FLAGS_ti) {
+                std::vector<InitProfilingData> init_profile;
+                net.GetInitProfile(init_profile);
+                PrintInitProfile("TNN::Init", init_profile);
+                runners[0]->instance->GetInitProfile(init_profile);
+                PrintInitProfile("TNN::CreateInst", init_profile);
             }
-#if TNN_PROFILE
-            instance->StartProfile();
-#endif
 
             std::string model_name = FLAGS_mp;
             if(FLAGS_mp.find_last_of("/") != -1) {
@@ -122,51 +112,270 @@ namespace test {
  
             Timer timer(model_name + " - " + FLAGS_dt);
 
-            for (int i = 0; i < FLAGS_ic; ++i) {
-                timer.Start();
-                for(auto element : input_converters_map) {
-                    auto name = element.first;
-                    auto blob_converter = element.second;
-                    ret = blob_converter->ConvertFromMatAsync(*input_mat_map[name], input_params_map[name], command_queue);
-                    if (!CheckResult("ConvertFromMat", ret)) {
-                        return ret;
-                    }
+            if (instance_num == 1) {
+                ret = RunInstance(runners[0].get(), nullptr);
+            } else {
+                // warm up all instances first, then start the timed loops together
+                std::atomic<int> ready_count(0);
+                std::vector<std::thread> threads;
+                for (auto runner : runners) {
+                    threads.push_back(std::thread([&ready_count, runner]() {
+                        runner->status = RunInstance(runner.get(), &ready_count);
+                    }));
                 }
-#if (DUMP_INPUT_BLOB || DUMP_OUTPUT_BLOB)
-                ret = instance->Forward();
-#else
-                ret = instance->ForwardAsync(nullptr);
-#endif
-                if (!CheckResult("Forward", ret)) {
-                    return ret;
+                for (auto& thread : threads) {
+                    thread.join();
                 }
-                for(auto element : output_converters_map) {
-                    auto name = element.first;
-                    auto blob_converter = element.second;
-                    ret = blob_converter->ConvertToMat(*output_mat_map[name], output_params_map[name], command_queue);
-                    if (!CheckResult("ConvertToMat", ret)) {
-                        return ret;
+                for (auto runner : runners) {
+                    if (runner->status != TNN_OK) {
+                        ret = runner->status;
                     }
                 }
-                timer.Stop();
             }
-#if TNN_PROFILE
-            instance->FinishProfile(true);
-#endif
+            if (!CheckResult("run instances", ret)) {
+                return ret;
+            }
+
+            auto start_time = runners[0]->start_time;
+            auto stop_time  = runners[0]->stop_time;
+            for (auto runner : runners) {
+                timer.Merge(runner->timer);
+                start_time = std::min(start_time, runner->start_time);
+                stop_time  = std::max(stop_time, runner->stop_time);
+            }
+            float wall_time = duration_cast<microseconds>(stop_time - start_time).count() / 1000.0f;
+            float throughput = wall_time > 0 ? timer.GetCount() * 1000.0f / wall_time : 0;
+
             if (!FLAGS_op.empty()) {
-                WriteOutput(output_mat_map);
+                WriteOutput(runners[0]->output_mat_map);
             }
 
+            float cold_time = 0;
+            for (auto runner : runners) {
+                cold_time = std::max(cold_time, runner->cold_time);
+            }
+            LOGI("%-45s instances = %d  |  threads = %d  |  throughput = %.2f fps  |  cold = %.3f ms  |  init = %.3f ms "
+                 " |  peak memory = %ld KB \n",
+                 model_name.c_str(), instance_num, std::max(FLAGS_th, 1), throughput, cold_time, init_timer.GetAvg(),
+                 GetPeakMemoryKB());
+            timer.PrintPercentile();
             timer.Print();
 
-            FreeMatMapMemory(input_mat_map);
-            FreeMatMapMemory(output_mat_map);
+            if (!FLAGS_bj.empty()) {
+                WriteBenchmarkJson(model_name, runners, timer, init_timer.GetAvg(), init_peak_memory, throughput);
+            }
+
+            for (auto runner : runners) {
+                FreeMatMapMemory(runner->input_mat_map);
+                FreeMatMapMemory(runner->output_mat_map);
+            }
             return 0;
         } else {
             return ret;
         }
     }
 
+    std::shared_ptr<InstanceRunner> CreateInstanceRunner(TNN& net, NetworkConfig& network_config,
+                                                         InputShapesMap& input_shape, Status& status) {
+        auto runner      = std::make_shared<InstanceRunner>();
+        runner->instance = net.CreateInst(network_config, status, input_shape);
+        if (status != TNN_OK) {
+            return nullptr;
+        }
+        auto instance = runner->instance;
+        instance->SetCpuNumThreads(std::max(FLAGS_th, 1));
+        instance->GetForwardMemorySize(runner->forward_memory_size);
+
+        //get blob
+        BlobMap input_blob_map;
+        BlobMap output_blob_map;
+        instance->GetAllInputBlobs(input_blob_map);
+        instance->GetAllOutputBlobs(output_blob_map);
+        instance->GetCommandQueue(&runner->command_queue);
+
+        //create mat and converter
+        runner->input_mat_map = CreateBlobMatMap(input_blob_map, FLAGS_it);
+        InitInputMatMap(runner->input_mat_map);
+        runner->input_converters_map = CreateBlobConverterMap(input_blob_map);
+        runner->input_params_map     = CreateConvertParamMap(runner->input_mat_map, true);
+
+        //mat format NCHW_FLOAT
+        runner->output_mat_map        = CreateBlobMatMap(output_blob_map, 0);
+        runner->output_converters_map = CreateBlobConverterMap(output_blob_map);
+        runner->output_params_map     = CreateConvertParamMap(runner->output_mat_map, false);
+        return runner;
+    }
+
+    Status RunOnce(InstanceRunner* runner) {
+        Status ret;
+        for(auto element : runner->input_converters_map) {
+            auto name = element.first;
+            auto blob_converter = element.second;
+            ret = blob_converter->ConvertFromMatAsync(*runner->input_mat_map[name], runner->input_params_map[name],
+                                                      runner->command_queue);
+            if (!CheckResult("ConvertFromMat", ret)) {
+                return ret;
+            }
+        }
+#if (DUMP_INPUT_BLOB || DUMP_OUTPUT_BLOB)
+        ret = runner->instance->Forward();
+#else
+        ret = runner->instance->ForwardAsync(nullptr);
+#endif
+        if (!CheckResult("Forward", ret)) {
+            return ret;
+        }
+        for(auto element : runner->output_converters_map) {
+            auto name = element.first;
+            auto blob_converter = element.second;
+            ret = blob_converter->ConvertToMat(*runner->output_mat_map[name], runner->output_params_map[name],
+                                               runner->command_queue);
+            if (!CheckResult("ConvertToMat", ret)) {
+                return ret;
+            }
+        }
+        return TNN_OK;
+    }
+
+    Status RunInstance(InstanceRunner* runner, std::atomic<int>* ready_count) {
+        Status ret;
+        // the first forward prepares memory, context, etc. it is reported as the cold start time
+        Timer cold_timer("cold");
+        for (int i = 0; i < FLAGS_wc; ++i) {
+            cold_timer.Start();
+            ret = RunOnce(runner);
+            cold_timer.Stop();
+            if (ret != TNN_OK) {
+                return ret;
+            }
+            if (i == 0) {
+                runner->cold_time = cold_timer.GetAvg();
+            }
+        }
+
+        if (ready_count) {
+            ready_count->fetch_add(1);
+            while (ready_count->load() < FLAGS_ni) {
+                std::this_thread::yield();
+            }
+        }
+#if TNN_PROFILE
+        if (!ready_count) {
+            runner->instance->StartProfile();
+        }
+#endif
+
+        runner->start_time = system_clock::now();
+        for (int i = 0; i < FLAGS_ic; ++i) {
+            runner->timer.Start();
+            ret = RunOnce(runner);
+            if (ret != TNN_OK) {
+                return ret;
+            }
+            runner->timer.Stop();
+            if (i == 0 && FLAGS_wc == 0) {
+                runner->cold_time = runner->timer.GetAvg();
+            }
+        }
+        runner->stop_time = system_clock::now();
+#if TNN_PROFILE
+        if (!ready_count) {
+            runner->instance->FinishProfile(true);
+        }
+#endif
+        return TNN_OK;
+    }
+
+    void PrintInitProfile(const std::string& title, std::vector<InitProfilingData>& data) {
+        const int top_count = 20;
+        printf("%s init profile\n", title.c_str());
+        printf("%-60s %12s %12s %14s\n", "phase", "wall(ms)", "cpu(ms)", "alloc(KB)");
+        std::vector<InitProfilingData> items;
+        for (auto& item : data) {
+            if (item.name.empty()) {
+                printf("%-60s %12.3f %12.3f %14.1f\n", item.phase.c_str(), item.wall_time, item.cpu_time,
+                       item.allocated_bytes / 1024.0);
+            } else {
+                items.push_back(item);
+            }
+        }
+        if (items.empty()) {
+            return;
+        }
+
+        std::sort(items.begin(), items.end(), [](const InitProfilingData& a, const InitProfilingData& b) {
+            return a.wall_time > b.wall_time;
+        });
+        printf("%s slowest %d of %d optimizers and layers\n", title.c_str(),
+               std::min(top_count, (int)items.size()), (int)items.size());
+        printf("%-40s %-40s %12s %12s %14s\n", "phase", "name", "wall(ms)", "cpu(ms)", "alloc(KB)");
+        for (int i = 0; i < std::min(top_count, (int)items.size()); ++i) {
+            auto& item = items[i];
+            printf("%-40s %-40s %12.3f %12.3f %14.1f\n", item.phase.c_str(), item.name.c_str(), item.wall_time,
+                   item.cpu_time, item.allocated_bytes / 1024.0);
+        }
+    }
+
+    long GetPeakMemoryKB() {
+#if defined(__linux__) || defined(__APPLE__)
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return -1;
+        }
+#if defined(__APPLE__)
+        // ru_maxrss is in bytes on mac os
+        return usage.ru_maxrss / 1024;
+#else
+        return usage.ru_maxrss;
+#endif
+#else
+        return -1;
+#endif
+    }
+
+    void WriteBenchmarkJson(std::string model_name, std::vector<std::shared_ptr<InstanceRunner>>& runners,
+                            Timer& timer, float init_time, long init_peak_memory, float throughput) {
+        std::ofstream f(FLAGS_bj);
+        if (!f.is_open()) {
+            LOGE("open benchmark json file %s failed\n", FLAGS_bj.c_str());
+            return;
+        }
+        f << std::fixed << std::setprecision(3);
+        f << "{" << std::endl;
+        f << "    \"model\": \"" << model_name << "\"," << std::endl;
+        f << "    \"device\": \"" << FLAGS_dt << "\"," << std::endl;
+        f << "    \"precision\": \"" << FLAGS_pr << "\"," << std::endl;
+        f << "    \"instances\": " << runners.size() << "," << std::endl;
+        f << "    \"threads\": " << std::max(FLAGS_th, 1) << "," << std::endl;
+        f << "    \"warmup\": " << FLAGS_wc << "," << std::endl;
+        f << "    \"iterations\": " << FLAGS_ic << "," << std::endl;
+        f << "    \"init_ms\": " << init_time << "," << std::endl;
+        f << "    \"cold_ms\": [";
+        for (int k = 0; k < runners.size(); ++k) {
+            f << (k > 0 ? ", " : "") << runners[k]->cold_time;
+        }
+        f << "]," << std::endl;
+        f << "    \"latency_ms\": {" << std::endl;
+        f << "        \"min\": " << timer.GetMin() << "," << std::endl;
+        f << "        \"max\": " << timer.GetMax() << "," << std::endl;
+        f << "        \"avg\": " << timer.GetAvg() << "," << std::endl;
+        f << "        \"p50\": " << timer.GetPercentile(50.0f) << "," << std::endl;
+        f << "        \"p90\": " << timer.GetPercentile(90.0f) << "," << std::endl;
+        f << "        \"p99\": " << timer.GetPercentile(99.0f) << "," << std::endl;
+        f << "        \"p99.9\": " << timer.GetPercentile(99.9f) << std::endl;
+        f << "    }," << std::endl;
+        f << "    \"throughput_fps\": " << throughput << "," << std::endl;
+        f << "    \"forward_memory_bytes\": [";
+        for (int k = 0; k < runners.size(); ++k) {
+            f << (k > 0 ? ", " : "") << runners[k]->forward_memory_size;
+        }
+        f << "]," << std::endl;
+        f << "    \"peak_memory_kb_after_init\": " << init_peak_memory << "," << std::endl;
+        f << "    \"peak_memory_kb\": " << GetPeakMemoryKB() << std::endl;
+        f << "}" << std::endl;
+        f.close();
+    }
+
     bool ParseAndCheckCommandLine(int argc, char* argv[]) {
         gflags::ParseCommandLineNonHelpFlags(&argc, &argv, true);
         if (FLAGS_h) {
@@ -180,6 +389,12 @@ namespace test {
             return false;
         }
 
+        if (FLAGS_ni < 1) {
+            printf("Parameter -ni should be greater than zero (default 1) \n");
+            ShowUsage();
+            return false;
+        }
+
         if (FLAGS_mp.empty()) {
             printf("Parameter -mp is not set \n");
             ShowUsage();
@@ -209,6 +424,9 @@ namespace test {
         printf("    -et \"<enable tune>\t%s \n", enable_tune_message);
         printf("    -sc \"<input scale>\t%s \n", scale_message);
         printf("    -bi \"<input bias>\t%s \n", bias_message);
+        printf("    -ni \"<instance number>\t%s \n", instance_num_message);
+        printf("    -bj \"<benchmark json path>\t%s \n", benchmark_json_message);
+        printf("    -ti \"<print init profile>\t%s \n", init_profile_message);
     }
 
     void SetCpuAffinity() {
@@ -15,17 +15,45 @@
 #ifndef TNN_TEST_TEST_H_
 #define TNN_TEST_TEST_H_
 
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "test/timer.h"
 #include "tnn/core/blob.h"
 #include "tnn/core/common.h"
 #include "tnn/core/instance.h"
 #include "tnn/core/macro.h"
 #include "tnn/core/status.h"
+#include "tnn/core/tnn.h"
 #include "tnn/utils/blob_converter.h"
 
 namespace TNN_NS {
 
 namespace test {
 
+    // one instance with its own mats and converters, several of them can run concurrently
+    struct InstanceRunner {
+        std::shared_ptr<Instance> instance;
+        void* command_queue = nullptr;
+        int forward_memory_size = 0;
+
+        MatMap input_mat_map;
+        MatMap output_mat_map;
+        std::map<std::string, std::shared_ptr<BlobConverter>> input_converters_map;
+        std::map<std::string, std::shared_ptr<BlobConverter>> output_converters_map;
+        std::map<std::string, MatConvertParam> input_params_map;
+        std::map<std::string, MatConvertParam> output_params_map;
+
+        // latency of the first forward, including memory and context preparation
+        float cold_time = 0;
+        Timer timer     = Timer("instance");
+        time_point<system_clock> start_time;
+        time_point<system_clock> stop_time;
+        Status status;
+    };
+
     int Run(int argc, char* argv[]);
 
     bool ParseAndCheckCommandLine(int argc, char* argv[]);
@@ -54,6 +82,23 @@ namespace test {
 
     void FreeMatMapMemory(MatMap& mat_map);
 
+    std::shared_ptr<InstanceRunner> CreateInstanceRunner(TNN& net, NetworkConfig& network_config,
+                                                         InputShapesMap& input_shape, Status& status);
+
+    Status RunOnce(InstanceRunner* runner);
+
+    // run -wc warm up and -ic timed iterations, instances wait on ready_count before the timed loop
+    Status RunInstance(InstanceRunner* runner, std::atomic<int>* ready_count);
+
+    // print the init phases in order, then the slowest items (optimizers, layers) of all phases
+    void PrintInitProfile(const std::string& title, std::vector<InitProfilingData>& data);
+
+    // peak resident memory of the process in KB, -1 if not supported
+    long GetPeakMemoryKB();
+
+    void WriteBenchmarkJson(std::string model_name, std::vector<std::shared_ptr<InstanceRunner>>& runners,
+                            Timer& timer, float init_time, long init_peak_memory, float throughput);
+
 }  // namespace test
 
 }  // namespace TNN_NS
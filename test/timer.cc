@@ -14,6 +14,7 @@
 
 #include "test/timer.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace TNN_NS {
@@ -39,6 +40,7 @@ void Timer::Stop() {
     max_         = static_cast<float>(fmax(max_, delta));
     sum_ += delta;
     count_++;
+    samples_.push_back(delta);
 }
 
 void Timer::Reset() {
@@ -46,6 +48,7 @@ void Timer::Reset() {
     max_ = FLT_MIN;
     sum_ = 0.0f;
     count_ = 0;
+    samples_.clear();
     stop_ = start_ = system_clock::now();
 }
    
@@ -60,6 +63,46 @@ void Timer::Print() {
          min_str, max_str, avg_str);
 }
 
+void Timer::PrintPercentile() {
+    LOGI("%-45s latency percentile: p50 = %-8.3f ms  |  p90 = %-8.3f ms  |  p99 = %-8.3f ms  |  p99.9 = %-8.3f ms \n",
+         timer_info_.c_str(), GetPercentile(50.0f), GetPercentile(90.0f), GetPercentile(99.0f), GetPercentile(99.9f));
+}
+
+void Timer::Merge(const Timer& timer) {
+    min_ = static_cast<float>(fmin(min_, timer.min_));
+    max_ = static_cast<float>(fmax(max_, timer.max_));
+    sum_ += timer.sum_;
+    count_ += timer.count_;
+    samples_.insert(samples_.end(), timer.samples_.begin(), timer.samples_.end());
+}
+
+float Timer::GetPercentile(float percentile) const {
+    if (samples_.empty()) {
+        return 0.0f;
+    }
+    std::vector<float> sorted = samples_;
+    std::sort(sorted.begin(), sorted.end());
+    int rank = static_cast<int>(std::ceil(percentile / 100.0f * sorted.size())) - 1;
+    rank     = std::min(std::max(rank, 0), static_cast<int>(sorted.size()) - 1);
+    return sorted[rank];
+}
+
+float Timer::GetMin() const {
+    return count_ > 0 ? min_ : 0.0f;
+}
+
+float Timer::GetMax() const {
+    return count_ > 0 ? max_ : 0.0f;
+}
+
+float Timer::GetAvg() const {
+    return count_ > 0 ? sum_ / (float)count_ : 0.0f;
+}
+
+int Timer::GetCount() const {
+    return count_;
+}
+
 } // namespace test
 
 } // namespace TNN_NS
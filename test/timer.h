@@ -17,6 +17,7 @@
 
 #include <chrono>
 #include <string>
+#include <vector>
 
 #include "tnn/core/macro.h"
 
@@ -34,6 +35,17 @@ public:
     void Stop();
     void Reset();
     void Print();
+    // print p50/p90/p99/p99.9 of all recorded samples
+    void PrintPercentile();
+    // append the samples of another timer, used to merge the timers of concurrent instances
+    void Merge(const Timer& timer);
+
+    // latency in ms at the given percentile (0 - 100), nearest-rank
+    float GetPercentile(float percentile) const;
+    float GetMin() const;
+    float GetMax() const;
+    float GetAvg() const;
+    int GetCount() const;
 
 private:
     float min_;
@@ -43,6 +55,7 @@ private:
     time_point<system_clock> start_;
     time_point<system_clock> stop_;
     int count_;
+    std::vector<float> samples_;
 };
 
 } // namespace test
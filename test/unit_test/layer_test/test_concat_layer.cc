@@ -15,8 +15,10 @@
 #include "test/unit_test/layer_test/layer_test.h"
 #include "test/unit_test/unit_test_common.h"
 #include "test/unit_test/utils/network_helpers.h"
+#include "tnn/interpreter/default_model_interpreter.h"
 #include "tnn/utils/dims_utils.h"
 #include "tnn/utils/cpu_utils.h"
+#include "tnn/utils/random_data_utils.h"
 
 namespace TNN_NS {
 
@@ -83,4 +85,110 @@ TEST_P(ConcatLayerTest, ConcatLayer) {
     Run(interpreter, precision);
 }
 
+class ConcatRegionTest : public ::testing::TestWithParam<std::tuple<int, int>> {};
+// batch, channel
+INSTANTIATE_TEST_SUITE_P(LayerTest, ConcatRegionTest, ::testing::Combine(testing::Values(1, 2), testing::Values(3, 8)));
+
+// input0 -> Abs and Neg -> Concat on the channel -> output0
+static std::shared_ptr<AbstractModelInterpreter> GenerateConcatChainInterpreter(const std::vector<int> &input_dims) {
+    auto interpreter = std::shared_ptr<AbstractModelInterpreter>(CreateModelInterpreter(MODEL_TYPE_TNN));
+    auto default_interpreter = dynamic_cast<DefaultModelInterpreter *>(interpreter.get());
+    if (!default_interpreter) {
+        return nullptr;
+    }
+    NetStructure *net_structure = default_interpreter->GetNetStructure();
+    net_structure->inputs_shape_map["input0"] = input_dims;
+    net_structure->outputs.insert("output0");
+
+    auto add_layer = [&](std::string type_str, std::vector<std::string> inputs, std::string output,
+                         std::shared_ptr<LayerParam> param) {
+        param->name                           = output;
+        std::shared_ptr<LayerInfo> layer_info = std::make_shared<LayerInfo>();
+        layer_info->type                      = GlobalConvertLayerType(type_str);
+        layer_info->type_str                  = type_str;
+        layer_info->name                      = output;
+        layer_info->inputs                    = inputs;
+        layer_info->outputs                   = {output};
+        layer_info->param                     = param;
+        net_structure->layers.push_back(layer_info);
+        net_structure->blobs.insert(inputs.begin(), inputs.end());
+        net_structure->blobs.insert(output);
+    };
+
+    std::shared_ptr<ConcatLayerParam> concat_param(new ConcatLayerParam());
+    concat_param->axis = 1;
+    add_layer("Abs", {"input0"}, "abs_output", std::make_shared<LayerParam>());
+    add_layer("Neg", {"input0"}, "neg_output", std::make_shared<LayerParam>());
+    add_layer("Concat", {"abs_output", "neg_output"}, "output0", concat_param);
+    return interpreter;
+}
+
+static Status CreateConcatChainInstance(std::shared_ptr<AbstractModelInterpreter> interpreter, ShareMemoryMode mode,
+                                        std::shared_ptr<Instance> &instance) {
+    ModelConfig model_config;
+    model_config.params.push_back("");
+    model_config.params.push_back("");
+
+    NetworkConfig net_config;
+    net_config.device_type       = ConvertDeviceType(FLAGS_dt);
+    net_config.precision         = PRECISION_HIGH;
+    net_config.share_memory_mode = mode;
+
+    instance = std::make_shared<Instance>(net_config, model_config);
+    return instance->Init(interpreter, InputShapesMap());
+}
+
+// with batch 1 the abs and neg write into the concat output, an input is copied if its offset in the
+// output is not aligned
+TEST_P(ConcatRegionTest, ConcatInputRegions) {
+    int batch      = std::get<0>(GetParam());
+    int channel    = std::get<1>(GetParam());
+    DeviceType dev = ConvertDeviceType(FLAGS_dt);
+    // only the x86 concat declares its input regions so far
+    if (dev != DEVICE_X86) {
+        GTEST_SKIP();
+    }
+
+    std::vector<int> input_dims = {batch, channel, 5, 5};
+    const int count             = DimsVectorUtils::Count(input_dims);
+    auto interpreter            = GenerateConcatChainInterpreter(input_dims);
+    ASSERT_TRUE(interpreter != nullptr);
+
+    if (batch == 1) {
+        std::shared_ptr<Instance> external_instance;
+        Status status = CreateConcatChainInstance(interpreter, SHARE_MEMORY_MODE_SET_FROM_EXTERNAL, external_instance);
+        ASSERT_EQ((int)status, TNN_OK);
+        int memory_size = 0;
+        status          = external_instance->GetForwardMemorySize(memory_size);
+        ASSERT_EQ((int)status, TNN_OK);
+        // input, abs, neg and the concat output otherwise
+        EXPECT_LT(memory_size, 5 * count * (int)sizeof(float));
+    }
+
+    std::shared_ptr<Instance> instance;
+    Status status = CreateConcatChainInstance(interpreter, SHARE_MEMORY_MODE_DEFAULT, instance);
+    ASSERT_EQ((int)status, TNN_OK);
+    BlobMap input_blobs, output_blobs;
+    instance->GetAllInputBlobs(input_blobs);
+    instance->GetAllOutputBlobs(output_blobs);
+    auto input_blob  = input_blobs["input0"];
+    auto output_blob = output_blobs["output0"];
+
+    std::vector<float> input(count);
+    InitRandom(input.data(), input.size(), 1.0f);
+    auto input_ptr = (char *)input_blob->GetHandle().base + input_blob->GetHandle().bytes_offset;
+    memcpy(input_ptr, input.data(), count * sizeof(float));
+    status = instance->Forward();
+    ASSERT_EQ((int)status, TNN_OK);
+
+    const int batch_count = count / batch;
+    auto output_ptr = (float *)((char *)output_blob->GetHandle().base + output_blob->GetHandle().bytes_offset);
+    for (int n = 0; n < batch; ++n) {
+        for (int i = 0; i < batch_count; ++i) {
+            EXPECT_FLOAT_EQ(output_ptr[2 * n * batch_count + i], std::fabs(input[n * batch_count + i]));
+            EXPECT_FLOAT_EQ(output_ptr[(2 * n + 1) * batch_count + i], -input[n * batch_count + i]);
+        }
+    }
+}
+
 }  // namespace TNN_NS
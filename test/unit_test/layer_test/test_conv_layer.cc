@@ -17,6 +17,7 @@
 #include "test/unit_test/utils/network_helpers.h"
 #include "tnn/utils/cpu_utils.h"
 #include "tnn/utils/dims_utils.h"
+#include "tnn/utils/random_data_utils.h"
 
 namespace TNN_NS {
 
@@ -105,4 +106,103 @@ TEST_P(ConvLayerTest, ConvLayer) {
     Run(interpreter, precision);
 }
 
+class ConvWorkspaceTest : public ::testing::TestWithParam<std::tuple<int, int, int>> {};
+// channel, kernel, stride
+INSTANTIATE_TEST_SUITE_P(LayerTest, ConvWorkspaceTest,
+                         ::testing::Combine(testing::Values(3, 16),      // channel
+                                            testing::Values(1, 3, 5),    // kernel
+                                            testing::Values(1, 2)));     // stride
+
+static Status CreateConvInstance(std::shared_ptr<AbstractModelInterpreter> interpreter, ShareMemoryMode mode,
+                                 std::shared_ptr<Instance> &instance) {
+    ModelConfig model_config;
+    model_config.params.push_back("");
+    model_config.params.push_back("");
+
+    NetworkConfig net_config;
+    net_config.device_type       = ConvertDeviceType(FLAGS_dt);
+    net_config.precision         = PRECISION_HIGH;
+    net_config.share_memory_mode = mode;
+
+    instance = std::make_shared<Instance>(net_config, model_config);
+    return instance->Init(interpreter, InputShapesMap());
+}
+
+static Status ForwardConv(std::shared_ptr<Instance> instance, const std::vector<float> &input,
+                          std::vector<float> &output) {
+    BlobMap input_blobs, output_blobs;
+    RETURN_ON_NEQ(instance->GetAllInputBlobs(input_blobs), TNN_OK);
+    RETURN_ON_NEQ(instance->GetAllOutputBlobs(output_blobs), TNN_OK);
+
+    auto input_blob = input_blobs.begin()->second;
+    auto input_ptr  = (char *)input_blob->GetHandle().base + input_blob->GetHandle().bytes_offset;
+    memcpy(input_ptr, input.data(), input.size() * sizeof(float));
+
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+
+    auto output_blob = output_blobs.begin()->second;
+    auto output_ptr  = (float *)((char *)output_blob->GetHandle().base + output_blob->GetHandle().bytes_offset);
+    output.assign(output_ptr, output_ptr + DimsVectorUtils::Count(output_blob->GetBlobDesc().dims));
+    return TNN_OK;
+}
+
+// the conv workspace is planned into the forward memory, so a network running in caller memory
+// gives the same result as one with its own memory
+TEST_P(ConvWorkspaceTest, ConvForwardMemory) {
+    int channel    = std::get<0>(GetParam());
+    int kernel     = std::get<1>(GetParam());
+    int stride     = std::get<2>(GetParam());
+    DeviceType dev = ConvertDeviceType(FLAGS_dt);
+    // only the x86 accs declare their workspace so far
+    if (dev != DEVICE_X86) {
+        GTEST_SKIP();
+    }
+
+    std::shared_ptr<ConvLayerParam> param(new ConvLayerParam());
+    param->name           = "Conv";
+    param->input_channel  = channel;
+    param->output_channel = channel;
+    param->group          = 1;
+    param->kernels        = {kernel, kernel};
+    param->dialations     = {1, 1};
+    param->strides        = {stride, stride};
+    param->pads           = {kernel / 2, kernel / 2, kernel / 2, kernel / 2};
+    param->bias           = 1;
+
+    std::vector<int> input_dims = {2, channel, 17, 17};
+    auto interpreter            = GenerateInterpreter("Convolution", {input_dims}, param);
+
+    std::shared_ptr<Instance> own_instance, external_instance;
+    Status status = CreateConvInstance(interpreter, SHARE_MEMORY_MODE_DEFAULT, own_instance);
+    ASSERT_EQ((int)status, TNN_OK);
+    // share the weights generated by the first instance
+    status = CreateConvInstance(own_instance->GetInterpreter(), SHARE_MEMORY_MODE_SET_FROM_EXTERNAL,
+                                external_instance);
+    ASSERT_EQ((int)status, TNN_OK);
+
+    int memory_size = 0;
+    status          = external_instance->GetForwardMemorySize(memory_size);
+    ASSERT_EQ((int)status, TNN_OK);
+    const int output_size = (17 + 2 * (kernel / 2) - kernel) / stride + 1;
+    const int blobs_size =
+        (DimsVectorUtils::Count(input_dims) + 2 * channel * output_size * output_size) * sizeof(float);
+    EXPECT_GT(memory_size, blobs_size);
+    std::vector<char> forward_memory(memory_size);
+    status = external_instance->SetForwardMemory(forward_memory.data());
+    ASSERT_EQ((int)status, TNN_OK);
+
+    std::vector<float> input(DimsVectorUtils::Count(input_dims));
+    InitRandom(input.data(), input.size(), 1.0f);
+    std::vector<float> own_output, external_output;
+    status = ForwardConv(own_instance, input, own_output);
+    ASSERT_EQ((int)status, TNN_OK);
+    status = ForwardConv(external_instance, input, external_output);
+    ASSERT_EQ((int)status, TNN_OK);
+
+    ASSERT_EQ(own_output.size(), external_output.size());
+    for (int i = 0; i < own_output.size(); ++i) {
+        EXPECT_FLOAT_EQ(own_output[i], external_output[i]);
+    }
+}
+
 }  // namespace TNN_NS
@@ -0,0 +1,202 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/interpreter/tnn/objseri.h"
+#include "tnn/utils/dims_utils.h"
+
+namespace TNN_NS {
+
+class ConvQuantReformatTest : public ::testing::TestWithParam<std::tuple<int, int, int, int, int>> {};
+INSTANTIATE_TEST_SUITE_P(LayerTest, ConvQuantReformatTest,
+                         ::testing::Combine(testing::Values(1, 2),     // batch
+                                            testing::Values(3, 8),     // input channel
+                                            testing::Values(8, 12),    // output channel
+                                            testing::Values(8, 9),     // input size
+                                            testing::Values(1, 3)));   // kernel
+
+static std::shared_ptr<IntScaleResource> CreateBlobScale(const std::vector<float> &scales) {
+    std::shared_ptr<IntScaleResource> resource(new IntScaleResource());
+    const int count = (int)scales.size();
+    resource->scale_handle = RawBuffer(count * sizeof(float));
+    memcpy(resource->scale_handle.force_to<float *>(), scales.data(), count * sizeof(float));
+    resource->zero_point_handle = RawBuffer(count * sizeof(int8_t));
+    resource->zero_point_handle.SetDataType(DATA_TYPE_INT8);
+    return resource;
+}
+
+// the scale of the weight equals the output scale, so that the int8 outputs are the accumulators without rounding
+static std::shared_ptr<ConvLayerResource> CreateConvResource(const std::vector<int8_t> &weights,
+                                                             const std::vector<float> &scales) {
+    const int oc = (int)scales.size();
+    std::shared_ptr<ConvLayerResource> resource(new ConvLayerResource());
+    resource->filter_handle = RawBuffer(weights.size() * sizeof(int8_t));
+    resource->filter_handle.SetDataType(DATA_TYPE_INT8);
+    memcpy(resource->filter_handle.force_to<int8_t *>(), weights.data(), weights.size() * sizeof(int8_t));
+    resource->bias_handle = RawBuffer(oc * sizeof(int32_t));
+    resource->bias_handle.SetDataType(DATA_TYPE_INT32);
+    for (int i = 0; i < oc; ++i) {
+        resource->bias_handle.force_to<int32_t *>()[i] = rand() % 17 - 8;
+    }
+    resource->scale_handle = RawBuffer(oc * sizeof(float));
+    memcpy(resource->scale_handle.force_to<float *>(), scales.data(), oc * sizeof(float));
+    resource->zero_point_handle = RawBuffer(oc * sizeof(int8_t));
+    resource->zero_point_handle.SetDataType(DATA_TYPE_INT8);
+    return resource;
+}
+
+// input -> ReLU -> x -> quantized Conv -> y1 -> quantized 1x1 Conv -> y2 -> Abs -> output
+// the quantize reformat of x and the dequantize reformat of y2 are fused into the convs on x86
+static std::shared_ptr<AbstractModelInterpreter> GenerateQuantInterpreter(int batch, int ic, int oc, int size,
+                                                                          int kernel) {
+    auto interpreter = std::shared_ptr<AbstractModelInterpreter>(CreateModelInterpreter(MODEL_TYPE_TNN));
+    auto default_interpreter = dynamic_cast<DefaultModelInterpreter *>(interpreter.get());
+    if (!default_interpreter) {
+        return nullptr;
+    }
+    NetStructure *net_structure               = default_interpreter->GetNetStructure();
+    NetResource *net_resource                 = default_interpreter->GetNetResource();
+    net_structure->inputs_shape_map["input"] = {batch, ic, size, size};
+    net_structure->outputs.insert("output");
+
+    auto add_layer = [&](std::string type_str, std::string input, std::string output,
+                         std::shared_ptr<LayerParam> param, std::shared_ptr<LayerResource> resource) {
+        param->name                           = output;
+        param->type                           = type_str;
+        std::shared_ptr<LayerInfo> layer_info = std::make_shared<LayerInfo>();
+        layer_info->type                      = GlobalConvertLayerType(type_str);
+        layer_info->type_str                  = type_str;
+        layer_info->name                      = output;
+        layer_info->inputs                    = {input};
+        layer_info->outputs                   = {output};
+        layer_info->param                     = param;
+        net_structure->layers.push_back(layer_info);
+        net_structure->blobs.insert(input);
+        net_structure->blobs.insert(output);
+        if (resource) {
+            net_resource->resource_map[output] = resource;
+        }
+    };
+    auto conv_param = [](int ic, int oc, int kernel) {
+        std::shared_ptr<ConvLayerParam> param(new ConvLayerParam());
+        param->input_channel  = ic;
+        param->output_channel = oc;
+        param->group          = 1;
+        param->kernels        = {kernel, kernel};
+        param->dialations     = {1, 1};
+        param->strides        = {1, 1};
+        param->pads           = {kernel / 2, kernel / 2, kernel / 2, kernel / 2};
+        param->bias           = 1;
+        param->quantized      = true;
+        return param;
+    };
+
+    // power of two scales, per channel for the conv outputs
+    std::vector<float> y1_scales(oc), y2_scales(oc);
+    for (int i = 0; i < oc; ++i) {
+        y1_scales[i] = 0.25f * (1 << (i % 3));
+        y2_scales[i] = 0.5f * (1 << (i % 2));
+    }
+    net_resource->resource_map["x" + std::string(BLOB_SCALE_SUFFIX)]  = CreateBlobScale({0.5f});
+    net_resource->resource_map["y1" + std::string(BLOB_SCALE_SUFFIX)] = CreateBlobScale(y1_scales);
+    net_resource->resource_map["y2" + std::string(BLOB_SCALE_SUFFIX)] = CreateBlobScale(y2_scales);
+
+    // weights of -1, 0, 1 for the first conv, a signed permutation for the second one, the accumulators stay
+    // in the int8 range
+    std::vector<int8_t> weights1(oc * ic * kernel * kernel), weights2(oc * oc, 0);
+    for (auto &w : weights1) {
+        w = rand() % 3 - 1;
+    }
+    for (int o = 0; o < oc; ++o) {
+        weights2[o * oc + (o * 5 + 1) % oc] = o % 2 == 0 ? 1 : -1;
+    }
+
+    add_layer("ReLU", "input", "x", std::make_shared<LayerParam>(), nullptr);
+    add_layer("Convolution", "x", "y1", conv_param(ic, oc, kernel), CreateConvResource(weights1, y1_scales));
+    add_layer("Convolution", "y1", "y2", conv_param(oc, oc, 1), CreateConvResource(weights2, y2_scales));
+    add_layer("Abs", "y2", "output", std::make_shared<LayerParam>(), nullptr);
+    return interpreter;
+}
+
+static Status CreateQuantInstance(std::shared_ptr<AbstractModelInterpreter> interpreter, DeviceType device_type,
+                                  std::shared_ptr<Instance> &instance) {
+    ModelConfig model_config;
+    model_config.params.push_back("");
+    model_config.params.push_back("");
+
+    NetworkConfig net_config;
+    net_config.device_type = device_type;
+
+    instance = std::make_shared<Instance>(net_config, model_config);
+    return instance->Init(interpreter, InputShapesMap());
+}
+
+// the fused convs on x86 give the same outputs as the reformats on naive
+TEST_P(ConvQuantReformatTest, FuseReformat) {
+    int batch      = std::get<0>(GetParam());
+    int ic         = std::get<1>(GetParam());
+    int oc         = std::get<2>(GetParam());
+    int size       = std::get<3>(GetParam());
+    int kernel     = std::get<4>(GetParam());
+    DeviceType dev = ConvertDeviceType(FLAGS_dt);
+    if (dev != DEVICE_X86 && dev != DEVICE_NAIVE) {
+        GTEST_SKIP();
+    }
+
+    auto interpreter = GenerateQuantInterpreter(batch, ic, oc, size, kernel);
+    ASSERT_TRUE(interpreter != nullptr);
+    std::shared_ptr<Instance> instance, naive_instance;
+    Status status = CreateQuantInstance(interpreter, dev, instance);
+    ASSERT_EQ((int)status, TNN_OK);
+    status = CreateQuantInstance(interpreter, DEVICE_NAIVE, naive_instance);
+    ASSERT_EQ((int)status, TNN_OK);
+
+    // multiples of the input scale, negative ones are cut by the ReLU
+    const int count = batch * ic * size * size;
+    std::vector<float> input(count);
+    for (auto &value : input) {
+        value = 0.5f * (rand() % 3 - 1);
+    }
+
+    BlobMap input_blobs, naive_input_blobs, output_blobs, naive_output_blobs;
+    instance->GetAllInputBlobs(input_blobs);
+    naive_instance->GetAllInputBlobs(naive_input_blobs);
+    for (auto blob : {input_blobs["input"], naive_input_blobs["input"]}) {
+        ASSERT_EQ((int)blob->GetBlobDesc().data_type, DATA_TYPE_FLOAT);
+        memcpy((char *)blob->GetHandle().base + blob->GetHandle().bytes_offset, input.data(),
+               count * sizeof(float));
+    }
+    status = instance->Forward();
+    ASSERT_EQ((int)status, TNN_OK);
+    status = naive_instance->Forward();
+    ASSERT_EQ((int)status, TNN_OK);
+
+    instance->GetAllOutputBlobs(output_blobs);
+    naive_instance->GetAllOutputBlobs(naive_output_blobs);
+    auto output       = output_blobs["output"];
+    auto naive_output = naive_output_blobs["output"];
+    ASSERT_EQ((int)output->GetBlobDesc().data_type, DATA_TYPE_FLOAT);
+    ASSERT_TRUE(DimsVectorUtils::Equal(output->GetBlobDesc().dims, {batch, oc, size, size}));
+    const float *output_data       = (const float *)((char *)output->GetHandle().base + output->GetHandle().bytes_offset);
+    const float *naive_output_data =
+        (const float *)((char *)naive_output->GetHandle().base + naive_output->GetHandle().bytes_offset);
+    for (int i = 0; i < batch * oc * size * size; ++i) {
+        ASSERT_EQ(output_data[i], naive_output_data[i]) << "index " << i;
+    }
+}
+
+}  // namespace TNN_NS
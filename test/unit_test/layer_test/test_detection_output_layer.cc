@@ -0,0 +1,77 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+static bool TestFilter(DeviceType device_type) {
+    if (device_type == DEVICE_NAIVE || device_type == DEVICE_X86) {
+        return true;
+    }
+    return false;
+}
+
+class DetectionOutputLayerTest : public LayerTest,
+                                 public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, float>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, DetectionOutputLayerTest,
+                         ::testing::Combine(testing::Values(1, 7, 64, 301),  // num_priors
+                                            testing::Values(2, 5, 21),       // num_classes
+                                            testing::Values(1, 2, 3),        // code_type
+                                            testing::Values(-1, 16),         // nms top_k
+                                            testing::Values(8, 200),         // keep_top_k
+                                            testing::Values(1.0f, 0.9f)));   // eta
+
+TEST_P(DetectionOutputLayerTest, DetectionOutputLayer) {
+    // get param
+    int num_priors  = std::get<0>(GetParam());
+    int num_classes = std::get<1>(GetParam());
+    int code_type   = std::get<2>(GetParam());
+    int top_k       = std::get<3>(GetParam());
+    int keep_top_k  = std::get<4>(GetParam());
+    float eta       = std::get<5>(GetParam());
+    DeviceType dev  = ConvertDeviceType(FLAGS_dt);
+
+    if (!TestFilter(dev)) {
+        GTEST_SKIP();
+    }
+
+    // param
+    std::shared_ptr<DetectionOutputLayerParam> param(new DetectionOutputLayerParam());
+    param->name                       = "DetectionOutput";
+    param->num_classes                = num_classes;
+    param->share_location             = true;
+    param->background_label_id        = 0;
+    param->variance_encoded_in_target = false;
+    param->code_type                  = code_type;
+    param->keep_top_k                 = keep_top_k;
+    param->confidence_threshold       = 0.01f;
+    param->nms_param.nms_threshold    = 0.45f;
+    param->nms_param.top_k            = top_k;
+    param->eta                        = eta;
+
+    // generate interpreter, the output holds keep_top_k detections of a single image
+    std::vector<std::vector<int>> input_vec = {
+        {1, num_priors * 4, 1, 1}, {1, num_priors * num_classes, 1, 1}, {1, 2, num_priors * 4, 1}};
+    auto interpreter = GenerateInterpreter("DetectionOutput", input_vec, param);
+
+    Precision precision = SetPrecision(dev, DATA_TYPE_FLOAT);
+    Run(interpreter, precision);
+}
+
+}  // namespace TNN_NS
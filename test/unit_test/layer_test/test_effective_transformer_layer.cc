@@ -0,0 +1,197 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/random_data_utils.h"
+
+namespace TNN_NS {
+
+class EffectiveTransformerTest : public ::testing::TestWithParam<std::tuple<int, int, int>> {};
+INSTANTIATE_TEST_SUITE_P(LayerTest, EffectiveTransformerTest,
+                         ::testing::Combine(testing::Values(1, 3),    // batch
+                                            testing::Values(5, 16),   // seq_len
+                                            testing::Values(8, 20))); // hidden
+
+// input0 + input1 -> LayerNorm -> MatMul -> Add -> Gelu -> Add the LayerNorm -> Permute -> output0
+//                                                                             -> LayerNorm -> output1
+static std::shared_ptr<AbstractModelInterpreter> GenerateEncoderInterpreter(int batch, int seq_len, int hidden) {
+    auto interpreter = std::shared_ptr<AbstractModelInterpreter>(CreateModelInterpreter(MODEL_TYPE_TNN));
+    auto default_interpreter = dynamic_cast<DefaultModelInterpreter *>(interpreter.get());
+    if (!default_interpreter) {
+        return nullptr;
+    }
+    NetStructure *net_structure                 = default_interpreter->GetNetStructure();
+    NetResource *net_resource                   = default_interpreter->GetNetResource();
+    net_structure->inputs_shape_map["input0"]   = {batch, seq_len, hidden};
+    net_structure->inputs_shape_map["input1"]   = {1, seq_len, hidden};
+    net_structure->inputs_shape_map["mask"]     = {batch, seq_len};
+    net_structure->input_data_type_map["mask"] = DATA_TYPE_INT32;
+    net_structure->blobs.insert("mask");
+    net_structure->outputs.insert("output0");
+    net_structure->outputs.insert("output1");
+
+    auto add_layer = [&](std::string type_str, std::vector<std::string> inputs, std::string output,
+                         std::shared_ptr<LayerParam> param, std::shared_ptr<LayerResource> resource) {
+        param->name                           = output;
+        std::shared_ptr<LayerInfo> layer_info = std::make_shared<LayerInfo>();
+        layer_info->type                      = GlobalConvertLayerType(type_str);
+        layer_info->type_str                  = type_str;
+        layer_info->name                      = output;
+        layer_info->inputs                    = inputs;
+        layer_info->outputs                   = {output};
+        layer_info->param                     = param;
+        net_structure->layers.push_back(layer_info);
+        net_structure->blobs.insert(inputs.begin(), inputs.end());
+        net_structure->blobs.insert(output);
+        if (resource) {
+            net_resource->resource_map[output] = resource;
+        }
+    };
+    auto random_buffer = [](DimsVector dims) {
+        int count = DimsVectorUtils::Count(dims);
+        std::shared_ptr<RawBuffer> buffer(new RawBuffer(count * sizeof(float), dims));
+        InitRandom(buffer->force_to<float *>(), count, 1.0f);
+        return buffer;
+    };
+
+    net_resource->constant_map["scale"] = random_buffer({hidden});
+    net_resource->constant_map["bias"]  = random_buffer({hidden});
+
+    std::shared_ptr<LayerNormLayerParam> norm_param(new LayerNormLayerParam());
+    norm_param->reduce_dims_size = 1;
+    std::shared_ptr<MatMulLayerParam> matmul_param(new MatMulLayerParam());
+    matmul_param->weight_position = 1;
+    std::shared_ptr<MatMulLayerResource> matmul_resource(new MatMulLayerResource());
+    matmul_resource->weight = *random_buffer({hidden, hidden});
+    std::shared_ptr<EltwiseLayerResource> add_resource(new EltwiseLayerResource());
+    add_resource->element_handle = *random_buffer({hidden});
+    add_resource->element_shape  = {hidden};
+    std::shared_ptr<PermuteLayerParam> permute_param(new PermuteLayerParam());
+    permute_param->orders = {0, 2, 1};
+
+    add_layer("Add", {"input0", "input1"}, "embedding", std::make_shared<MultidirBroadcastLayerParam>(), nullptr);
+    add_layer("LayerNorm", {"embedding", "scale", "bias"}, "norm0", norm_param, nullptr);
+    add_layer("MatMul", {"norm0"}, "matmul", matmul_param, matmul_resource);
+    add_layer("Add", {"matmul"}, "matmul_bias", std::make_shared<MultidirBroadcastLayerParam>(), add_resource);
+    add_layer("GELU", {"matmul_bias"}, "gelu", std::make_shared<LayerParam>(), nullptr);
+    add_layer("Add", {"gelu", "norm0"}, "residual", std::make_shared<MultidirBroadcastLayerParam>(), nullptr);
+    add_layer("Permute", {"residual"}, "output0", permute_param, nullptr);
+    add_layer("LayerNorm", {"residual", "scale", "bias"}, "output1",
+              std::shared_ptr<LayerParam>(norm_param->Copy()), nullptr);
+    return interpreter;
+}
+
+static Status CreateEncoderInstance(std::shared_ptr<AbstractModelInterpreter> interpreter, std::string mask,
+                                    std::shared_ptr<Instance> &instance) {
+    ModelConfig model_config;
+    model_config.params.push_back("");
+    model_config.params.push_back("");
+
+    NetworkConfig net_config;
+    net_config.device_type       = ConvertDeviceType(FLAGS_dt);
+    net_config.precision         = PRECISION_HIGH;
+    net_config.ragged_batch_mask = mask;
+
+    instance = std::make_shared<Instance>(net_config, model_config);
+    return instance->Init(interpreter, InputShapesMap());
+}
+
+static void SetBlobData(Blob *blob, const void *data, size_t size) {
+    memcpy((char *)blob->GetHandle().base + blob->GetHandle().bytes_offset, data, size);
+}
+
+static const float *GetBlobData(Blob *blob) {
+    return (const float *)((char *)blob->GetHandle().base + blob->GetHandle().bytes_offset);
+}
+
+// the position-wise layers run on the tokens of the mask only, the outputs of the tokens are the same as with
+// the padding and the padding is 0
+TEST_P(EffectiveTransformerTest, RaggedBatch) {
+    int batch      = std::get<0>(GetParam());
+    int seq_len    = std::get<1>(GetParam());
+    int hidden     = std::get<2>(GetParam());
+    DeviceType dev = ConvertDeviceType(FLAGS_dt);
+    if (dev != DEVICE_X86 && dev != DEVICE_NAIVE) {
+        GTEST_SKIP();
+    }
+
+    // the same weights for both instances
+    auto interpreter = GenerateEncoderInterpreter(batch, seq_len, hidden);
+    ASSERT_TRUE(interpreter != nullptr);
+    auto ragged_interpreter = std::shared_ptr<AbstractModelInterpreter>(interpreter->Copy());
+    ASSERT_TRUE(ragged_interpreter != nullptr);
+
+    std::shared_ptr<Instance> instance, ragged_instance;
+    Status status = CreateEncoderInstance(interpreter, "", instance);
+    ASSERT_EQ((int)status, TNN_OK);
+    status = CreateEncoderInstance(ragged_interpreter, "mask", ragged_instance);
+    ASSERT_EQ((int)status, TNN_OK);
+
+    const int count = batch * seq_len * hidden;
+    std::vector<float> input0(count), input1(seq_len * hidden);
+    InitRandom(input0.data(), input0.size(), 1.0f);
+    InitRandom(input1.data(), input1.size(), 1.0f);
+
+    // the lengths change between the forwards, the last one has no padding
+    std::vector<std::vector<int>> lengths_list = {{seq_len, seq_len - 2, 1}, {2, seq_len, seq_len - 1},
+                                                  {seq_len, seq_len, seq_len}};
+    for (const auto &lengths : lengths_list) {
+        std::vector<int> mask(batch * seq_len);
+        for (int b = 0; b < batch; ++b) {
+            for (int s = 0; s < seq_len; ++s) {
+                mask[b * seq_len + s] = s < lengths[b] ? 1 : 0;
+            }
+        }
+
+        BlobMap input_blobs, output_blobs, ragged_input_blobs, ragged_output_blobs;
+        instance->GetAllInputBlobs(input_blobs);
+        instance->GetAllOutputBlobs(output_blobs);
+        ragged_instance->GetAllInputBlobs(ragged_input_blobs);
+        ragged_instance->GetAllOutputBlobs(ragged_output_blobs);
+        for (auto blobs : {input_blobs, ragged_input_blobs}) {
+            SetBlobData(blobs["input0"], input0.data(), input0.size() * sizeof(float));
+            SetBlobData(blobs["input1"], input1.data(), input1.size() * sizeof(float));
+            SetBlobData(blobs["mask"], mask.data(), mask.size() * sizeof(int));
+        }
+        status = instance->Forward();
+        ASSERT_EQ((int)status, TNN_OK);
+        status = ragged_instance->Forward();
+        ASSERT_EQ((int)status, TNN_OK);
+
+        // output0 is [batch, hidden, seq_len], output1 is [batch, seq_len, hidden]
+        ASSERT_TRUE(DimsVectorUtils::Equal(ragged_output_blobs["output1"]->GetBlobDesc().dims,
+                                           {batch, seq_len, hidden}));
+        const float *output0        = GetBlobData(output_blobs["output0"]);
+        const float *output1        = GetBlobData(output_blobs["output1"]);
+        const float *ragged_output0 = GetBlobData(ragged_output_blobs["output0"]);
+        const float *ragged_output1 = GetBlobData(ragged_output_blobs["output1"]);
+        for (int b = 0; b < batch; ++b) {
+            for (int s = 0; s < seq_len; ++s) {
+                bool valid = mask[b * seq_len + s] != 0;
+                for (int h = 0; h < hidden; ++h) {
+                    int index0 = (b * hidden + h) * seq_len + s;
+                    int index1 = (b * seq_len + s) * hidden + h;
+                    EXPECT_NEAR(ragged_output0[index0], valid ? output0[index0] : 0.f, 1e-4);
+                    EXPECT_NEAR(ragged_output1[index1], valid ? output1[index1] : 0.f, 1e-4);
+                }
+            }
+        }
+    }
+}
+
+}  // namespace TNN_NS
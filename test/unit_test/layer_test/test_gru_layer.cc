@@ -0,0 +1,79 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+static bool TestFilter(DeviceType device_type) {
+    if (device_type == DEVICE_NAIVE || device_type == DEVICE_X86) {
+        return true;
+    }
+    return false;
+}
+
+class GRULayerTest : public LayerTest,
+                     public ::testing::WithParamInterface<std::tuple<int, int, int, int, int, int, bool>> {};
+// seq_len, batch, input, output
+// direction: 0, 1, 2
+INSTANTIATE_TEST_SUITE_P(LayerTest, GRULayerTest,
+                         ::testing::Combine(testing::Values(1, 4, 16),   // seq_len
+                                            testing::Values(1, 2, 4),    // batch_size
+                                            testing::Values(1, 8, 33),   // input_size
+                                            testing::Values(1, 7, 32),   // hidden_size
+                                            testing::Values(0, 1, 2),    // direction, 0:forward, 1:backward, 2:bi-direction
+                                            testing::Values(0, 1),       // linear_before_reset
+                                            testing::Values(false, true)));  // initial_h
+
+TEST_P(GRULayerTest, GRUONNXLayer) {
+    // get param
+    int seq_len             = std::get<0>(GetParam());
+    int batch               = std::get<1>(GetParam());
+    int input_size          = std::get<2>(GetParam());
+    int output_size         = std::get<3>(GetParam());
+    int direction           = std::get<4>(GetParam());
+    int linear_before_reset = std::get<5>(GetParam());
+    bool has_initial_h      = std::get<6>(GetParam());
+    DeviceType dev          = ConvertDeviceType(FLAGS_dt);
+
+    if (!TestFilter(dev)) {
+        GTEST_SKIP();
+    }
+
+    // param
+    std::shared_ptr<GRUONNXLayerParam> param(new GRUONNXLayerParam());
+    param->name                = "GRUONNX";
+    param->hidden_size         = output_size;
+    param->direction           = direction;
+    param->linear_before_reset = linear_before_reset;
+
+    // generate interpreter
+    const int num_directions = param->direction == 2 ? 2 : 1;
+    std::vector<std::vector<int>> input_vec = {{seq_len, batch, input_size},
+                                               {num_directions, 3 * output_size, input_size},
+                                               {num_directions, 3 * output_size, output_size},
+                                               {num_directions, 6 * output_size}};
+    if (has_initial_h) {
+        input_vec.push_back({num_directions, batch, output_size});
+    }
+    auto interpreter = GenerateInterpreter("GRUONNX", input_vec, param, nullptr, 2);
+
+    Precision precision = SetPrecision(dev, DATA_TYPE_FLOAT);
+    Run(interpreter, precision);
+}
+
+}  // namespace TNN_NS
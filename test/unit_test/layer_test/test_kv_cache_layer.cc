@@ -0,0 +1,217 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <cmath>
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/utils/dims_utils.h"
+#include "tnn/utils/random_data_utils.h"
+
+namespace TNN_NS {
+
+class KVCacheTest : public ::testing::TestWithParam<std::tuple<int, int>> {};
+INSTANTIATE_TEST_SUITE_P(LayerTest, KVCacheTest,
+                         ::testing::Combine(testing::Values(1, 2),     // batch
+                                            testing::Values(8, 20)));  // hidden
+
+// query, key, value = MatMul(x)
+// present_key = Concat(past_key, key) -> Permute -> MatMul(query, .) -> Softmax -> MatMul(., present_value) -> output
+// present_value = Concat(past_value, value)
+static std::shared_ptr<AbstractModelInterpreter> GenerateDecoderInterpreter(int batch, int seq_len, int hidden,
+                                                                            std::vector<RawBuffer> &weights) {
+    auto interpreter = std::shared_ptr<AbstractModelInterpreter>(CreateModelInterpreter(MODEL_TYPE_TNN));
+    auto default_interpreter = dynamic_cast<DefaultModelInterpreter *>(interpreter.get());
+    if (!default_interpreter) {
+        return nullptr;
+    }
+    NetStructure *net_structure                  = default_interpreter->GetNetStructure();
+    NetResource *net_resource                    = default_interpreter->GetNetResource();
+    net_structure->inputs_shape_map["x"]          = {batch, seq_len, hidden};
+    net_structure->inputs_shape_map["past_key"]   = {batch, 1, hidden};
+    net_structure->inputs_shape_map["past_value"] = {batch, 1, hidden};
+    net_structure->outputs.insert("output");
+    net_structure->outputs.insert("present_key");
+    net_structure->outputs.insert("present_value");
+
+    auto add_layer = [&](std::string type_str, std::vector<std::string> inputs, std::string output,
+                         std::shared_ptr<LayerParam> param, std::shared_ptr<LayerResource> resource) {
+        param->name                           = output;
+        std::shared_ptr<LayerInfo> layer_info = std::make_shared<LayerInfo>();
+        layer_info->type                      = GlobalConvertLayerType(type_str);
+        layer_info->type_str                  = type_str;
+        layer_info->name                      = output;
+        layer_info->inputs                    = inputs;
+        layer_info->outputs                   = {output};
+        layer_info->param                     = param;
+        net_structure->layers.push_back(layer_info);
+        net_structure->blobs.insert(inputs.begin(), inputs.end());
+        net_structure->blobs.insert(output);
+        if (resource) {
+            net_resource->resource_map[output] = resource;
+        }
+    };
+    auto add_projection = [&](std::string output) {
+        std::shared_ptr<MatMulLayerParam> param(new MatMulLayerParam());
+        param->weight_position = 1;
+        std::shared_ptr<MatMulLayerResource> resource(new MatMulLayerResource());
+        resource->weight = RawBuffer(hidden * hidden * sizeof(float), {hidden, hidden});
+        InitRandom(resource->weight.force_to<float *>(), hidden * hidden, 1.0f);
+        weights.push_back(resource->weight);
+        add_layer("MatMul", {"x"}, output, param, resource);
+    };
+    auto concat_param = [](int axis) {
+        std::shared_ptr<ConcatLayerParam> param(new ConcatLayerParam());
+        param->axis = axis;
+        return param;
+    };
+    std::shared_ptr<PermuteLayerParam> permute_param(new PermuteLayerParam());
+    permute_param->orders = {0, 2, 1};
+    std::shared_ptr<SoftmaxLayerParam> softmax_param(new SoftmaxLayerParam());
+    softmax_param->axis = 2;
+
+    add_projection("query");
+    add_projection("key");
+    add_projection("value");
+    add_layer("Concat", {"past_key", "key"}, "present_key", concat_param(1), nullptr);
+    add_layer("Concat", {"past_value", "value"}, "present_value", concat_param(-2), nullptr);
+    add_layer("Permute", {"present_key"}, "key_t", permute_param, nullptr);
+    add_layer("MatMul", {"query", "key_t"}, "scores", std::make_shared<MatMulLayerParam>(), nullptr);
+    add_layer("Softmax", {"scores"}, "probs", softmax_param, nullptr);
+    add_layer("MatMul", {"probs", "present_value"}, "output", std::make_shared<MatMulLayerParam>(), nullptr);
+    return interpreter;
+}
+
+// x [seq_len, hidden] x weight [hidden, hidden]
+static std::vector<float> Project(const float *x, int seq_len, int hidden, const RawBuffer &weight) {
+    const float *w = weight.force_to<float *>();
+    std::vector<float> y(seq_len * hidden, 0.f);
+    for (int s = 0; s < seq_len; ++s) {
+        for (int k = 0; k < hidden; ++k) {
+            for (int n = 0; n < hidden; ++n) {
+                y[s * hidden + n] += x[s * hidden + k] * w[k * hidden + n];
+            }
+        }
+    }
+    return y;
+}
+
+// the attention of each new position over all the keys and values of the sequence so far
+static std::vector<float> Attention(const std::vector<float> &query, const std::vector<float> &keys,
+                                    const std::vector<float> &values, int hidden) {
+    const int seq_len = (int)query.size() / hidden;
+    const int length  = (int)keys.size() / hidden;
+    std::vector<float> output(seq_len * hidden, 0.f);
+    for (int s = 0; s < seq_len; ++s) {
+        std::vector<float> scores(length, 0.f);
+        float max_score = -INFINITY;
+        for (int l = 0; l < length; ++l) {
+            for (int h = 0; h < hidden; ++h) {
+                scores[l] += query[s * hidden + h] * keys[l * hidden + h];
+            }
+            max_score = std::max(max_score, scores[l]);
+        }
+        float sum = 0.f;
+        for (int l = 0; l < length; ++l) {
+            scores[l] = std::exp(scores[l] - max_score);
+            sum += scores[l];
+        }
+        for (int l = 0; l < length; ++l) {
+            for (int h = 0; h < hidden; ++h) {
+                output[s * hidden + h] += scores[l] / sum * values[l * hidden + h];
+            }
+        }
+    }
+    return output;
+}
+
+// a prompt of 3 positions, then one position per forward until the cache is full
+TEST_P(KVCacheTest, IncrementalDecoding) {
+    int batch      = std::get<0>(GetParam());
+    int hidden     = std::get<1>(GetParam());
+    DeviceType dev = ConvertDeviceType(FLAGS_dt);
+    if (dev != DEVICE_X86 && dev != DEVICE_NAIVE) {
+        GTEST_SKIP();
+    }
+    const int prompt_len = 3;
+    const int max_length = 8;
+
+    std::vector<RawBuffer> weights;
+    auto interpreter = GenerateDecoderInterpreter(batch, prompt_len, hidden, weights);
+    ASSERT_TRUE(interpreter != nullptr);
+
+    ModelConfig model_config;
+    model_config.params.push_back("");
+    model_config.params.push_back("");
+    NetworkConfig net_config;
+    net_config.device_type         = dev;
+    net_config.precision           = PRECISION_HIGH;
+    net_config.kv_cache_max_length = max_length;
+    auto instance                  = std::make_shared<Instance>(net_config, model_config);
+    Status status                  = instance->Init(interpreter, InputShapesMap());
+    ASSERT_EQ((int)status, TNN_OK);
+
+    // the past and present are kept by the instance
+    BlobMap input_blobs, output_blobs;
+    instance->GetAllInputBlobs(input_blobs);
+    instance->GetAllOutputBlobs(output_blobs);
+    ASSERT_EQ(input_blobs.size(), 1);
+    ASSERT_EQ(output_blobs.size(), 1);
+
+    for (int sequence = 0; sequence < 2; ++sequence) {
+        std::vector<std::vector<float>> keys(batch), values(batch);
+        int length = 0;
+        while (length < max_length) {
+            int seq_len = length == 0 ? prompt_len : 1;
+            status      = instance->Reshape({{"x", {batch, seq_len, hidden}}});
+            ASSERT_EQ((int)status, TNN_OK);
+            instance->GetAllInputBlobs(input_blobs);
+            instance->GetAllOutputBlobs(output_blobs);
+
+            std::vector<float> x(batch * seq_len * hidden);
+            InitRandom(x.data(), x.size(), 1.0f);
+            auto handle = input_blobs["x"]->GetHandle();
+            memcpy((char *)handle.base + handle.bytes_offset, x.data(), x.size() * sizeof(float));
+            status = instance->Forward();
+            ASSERT_EQ((int)status, TNN_OK);
+            length += seq_len;
+
+            ASSERT_TRUE(DimsVectorUtils::Equal(output_blobs["output"]->GetBlobDesc().dims, {batch, seq_len, hidden}));
+            handle              = output_blobs["output"]->GetHandle();
+            const float *output = (const float *)((char *)handle.base + handle.bytes_offset);
+            for (int b = 0; b < batch; ++b) {
+                const float *x_b = x.data() + b * seq_len * hidden;
+                auto query       = Project(x_b, seq_len, hidden, weights[0]);
+                auto key         = Project(x_b, seq_len, hidden, weights[1]);
+                auto value       = Project(x_b, seq_len, hidden, weights[2]);
+                keys[b].insert(keys[b].end(), key.begin(), key.end());
+                values[b].insert(values[b].end(), value.begin(), value.end());
+                auto expected = Attention(query, keys[b], values[b], hidden);
+                for (int i = 0; i < seq_len * hidden; ++i) {
+                    EXPECT_NEAR(output[b * seq_len * hidden + i], expected[i], 1e-3);
+                }
+            }
+        }
+
+        // the cache is full
+        status = instance->Forward();
+        EXPECT_NE((int)status, TNN_OK);
+        status = instance->ResetState();
+        ASSERT_EQ((int)status, TNN_OK);
+    }
+}
+
+}  // namespace TNN_NS
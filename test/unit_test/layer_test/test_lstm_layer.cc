@@ -15,7 +15,9 @@
 #include "test/unit_test/layer_test/layer_test.h"
 #include "test/unit_test/unit_test_common.h"
 #include "test/unit_test/utils/network_helpers.h"
+#include "tnn/interpreter/default_model_interpreter.h"
 #include "tnn/utils/dims_vector_utils.h"
+#include "tnn/utils/random_data_utils.h"
 
 namespace TNN_NS {
 
@@ -95,4 +97,119 @@ TEST_P(LSTMLayerTest, LSTMONNXLayer) {
     Run(interpreter, precision, format, device_format);
 }
 
+class LSTMStatefulTest : public ::testing::TestWithParam<std::tuple<int, int, int, int>> {};
+// chunk_len, batch, input, output
+INSTANTIATE_TEST_SUITE_P(LayerTest, LSTMStatefulTest,
+                         ::testing::Combine(testing::Values(1, 5),      // chunk_len
+                                            testing::Values(1, 2),      // batch_size
+                                            testing::Values(3, 16),     // input_size
+                                            testing::Values(7, 32)));   // hidden_size
+
+static Status CreateLSTMInstance(std::shared_ptr<AbstractModelInterpreter> interpreter,
+                                 std::shared_ptr<Instance> &instance) {
+    ModelConfig model_config;
+    model_config.params.push_back("");
+    model_config.params.push_back("");
+
+    NetworkConfig net_config;
+    net_config.device_type = ConvertDeviceType(FLAGS_dt);
+    net_config.precision   = PRECISION_HIGH;
+
+    instance = std::make_shared<Instance>(net_config, model_config);
+    return instance->Init(interpreter, InputShapesMap());
+}
+
+static Status ForwardLSTM(std::shared_ptr<Instance> instance, const float *input, std::vector<float> &output) {
+    BlobMap input_blobs, output_blobs;
+    RETURN_ON_NEQ(instance->GetAllInputBlobs(input_blobs), TNN_OK);
+    RETURN_ON_NEQ(instance->GetAllOutputBlobs(output_blobs), TNN_OK);
+
+    auto input_blob = input_blobs["input0"];
+    auto input_ptr  = (char *)input_blob->GetHandle().base + input_blob->GetHandle().bytes_offset;
+    memcpy(input_ptr, input, DimsVectorUtils::Count(input_blob->GetBlobDesc().dims) * sizeof(float));
+
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+
+    auto output_blob = output_blobs["output0"];
+    auto output_ptr  = (float *)((char *)output_blob->GetHandle().base + output_blob->GetHandle().bytes_offset);
+    output.assign(output_ptr, output_ptr + DimsVectorUtils::Count(output_blob->GetBlobDesc().dims));
+    return TNN_OK;
+}
+
+TEST_P(LSTMStatefulTest, LSTMONNXStatefulLayer) {
+    int chunk_len   = std::get<0>(GetParam());
+    int batch       = std::get<1>(GetParam());
+    int input_size  = std::get<2>(GetParam());
+    int output_size = std::get<3>(GetParam());
+    DeviceType dev  = ConvertDeviceType(FLAGS_dt);
+
+    // the stateful mode is implemented on host devices only
+    if (dev != DEVICE_NAIVE && dev != DEVICE_X86) {
+        GTEST_SKIP();
+    }
+
+    std::vector<int> wi_dims   = {1, 4 * output_size, input_size};
+    std::vector<int> wh_dims   = {1, 4 * output_size, output_size};
+    std::vector<int> bias_dims = {1, 8 * output_size};
+
+    // reference: the whole sequence in one forward
+    std::shared_ptr<LSTMONNXLayerParam> param(new LSTMONNXLayerParam());
+    param->name        = "LSTMONNX";
+    param->hidden_size = output_size;
+    param->direction   = 0;
+    auto full_interpreter =
+        GenerateInterpreter("LSTMONNX", {{2 * chunk_len, batch, input_size}, wi_dims, wh_dims, bias_dims}, param,
+                            nullptr, 3);
+    std::shared_ptr<Instance> full_instance;
+    Status status = CreateLSTMInstance(full_interpreter, full_instance);
+    ASSERT_EQ((int)status, TNN_OK);
+
+    // stateful: the sequence in two chunks, sharing the weights generated for the reference
+    std::shared_ptr<LSTMONNXLayerParam> stateful_param(new LSTMONNXLayerParam());
+    stateful_param->name        = "LSTMONNX";
+    stateful_param->hidden_size = output_size;
+    stateful_param->direction   = 0;
+    stateful_param->extra_config.insert("lstm_stateful");
+    auto chunk_interpreter =
+        GenerateInterpreter("LSTMONNX", {{chunk_len, batch, input_size}, wi_dims, wh_dims, bias_dims},
+                            stateful_param, nullptr, 3);
+    auto full_resource =
+        dynamic_cast<DefaultModelInterpreter *>(full_instance->GetInterpreter().get())->GetNetResource();
+    auto chunk_resource = dynamic_cast<DefaultModelInterpreter *>(chunk_interpreter.get())->GetNetResource();
+    chunk_resource->constant_map = full_resource->constant_map;
+    chunk_resource->resource_map = full_resource->resource_map;
+    std::shared_ptr<Instance> chunk_instance;
+    status = CreateLSTMInstance(chunk_interpreter, chunk_instance);
+    ASSERT_EQ((int)status, TNN_OK);
+
+    const int chunk_count = chunk_len * batch * input_size;
+    std::vector<float> input(2 * chunk_count);
+    InitRandom(input.data(), input.size(), 1.0f);
+
+    std::vector<float> full_output, chunk0_output, chunk1_output, reset_output;
+    status = ForwardLSTM(full_instance, input.data(), full_output);
+    ASSERT_EQ((int)status, TNN_OK);
+    status = ForwardLSTM(chunk_instance, input.data(), chunk0_output);
+    ASSERT_EQ((int)status, TNN_OK);
+    status = ForwardLSTM(chunk_instance, input.data() + chunk_count, chunk1_output);
+    ASSERT_EQ((int)status, TNN_OK);
+
+    std::vector<float> chunk_output(chunk0_output);
+    chunk_output.insert(chunk_output.end(), chunk1_output.begin(), chunk1_output.end());
+    ASSERT_EQ(chunk_output.size(), full_output.size());
+    for (int i = 0; i < full_output.size(); ++i) {
+        EXPECT_NEAR(chunk_output[i], full_output[i], 1e-4);
+    }
+
+    // after a reset the next chunk starts from zero state again
+    status = chunk_instance->ResetState();
+    ASSERT_EQ((int)status, TNN_OK);
+    status = ForwardLSTM(chunk_instance, input.data(), reset_output);
+    ASSERT_EQ((int)status, TNN_OK);
+    ASSERT_EQ(reset_output.size(), chunk0_output.size());
+    for (int i = 0; i < reset_output.size(); ++i) {
+        EXPECT_EQ(reset_output[i], chunk0_output[i]);
+    }
+}
+
 }  // namespace TNN_NS
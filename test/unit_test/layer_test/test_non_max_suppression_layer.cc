@@ -0,0 +1,68 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/layer_test/layer_test.h"
+#include "test/unit_test/unit_test_common.h"
+#include "test/unit_test/utils/network_helpers.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+static bool TestFilter(DeviceType device_type) {
+    if (device_type == DEVICE_NAIVE || device_type == DEVICE_X86) {
+        return true;
+    }
+    return false;
+}
+
+class NonMaxSuppressionLayerTest : public LayerTest,
+                                   public ::testing::WithParamInterface<std::tuple<int, int, int, int, int>> {};
+
+INSTANTIATE_TEST_SUITE_P(LayerTest, NonMaxSuppressionLayerTest,
+                         ::testing::Combine(testing::Values(1, 2),             // batch
+                                            testing::Values(1, 9, 130),        // num_boxes
+                                            testing::Values(1, 3, 8),          // num_classes
+                                            testing::Values(0, 1),             // center_point_box
+                                            testing::Values(1, 10, 1000)));    // max_output_boxes_per_class
+
+TEST_P(NonMaxSuppressionLayerTest, NonMaxSuppressionLayer) {
+    // get param
+    int batch            = std::get<0>(GetParam());
+    int num_boxes        = std::get<1>(GetParam());
+    int num_classes      = std::get<2>(GetParam());
+    int center_point_box = std::get<3>(GetParam());
+    int max_output       = std::get<4>(GetParam());
+    DeviceType dev       = ConvertDeviceType(FLAGS_dt);
+
+    if (!TestFilter(dev)) {
+        GTEST_SKIP();
+    }
+
+    // param
+    std::shared_ptr<NonMaxSuppressionLayerParam> param(new NonMaxSuppressionLayerParam());
+    param->name                       = "NonMaxSuppression";
+    param->center_point_box           = center_point_box;
+    param->max_output_boxes_per_class = max_output;
+    param->iou_threshold              = 0.3f;
+    param->score_threshold            = 0.1f;
+
+    // generate interpreter
+    std::vector<std::vector<int>> input_vec = {{batch, num_boxes, 4}, {batch, num_classes, num_boxes}};
+    auto interpreter = GenerateInterpreter("NonMaxSuppression", input_vec, param);
+
+    Precision precision = SetPrecision(dev, DATA_TYPE_FLOAT);
+    Run(interpreter, precision);
+}
+
+}  // namespace TNN_NS
@@ -15,7 +15,9 @@
 #include "test/unit_test/layer_test/layer_test.h"
 #include "test/unit_test/unit_test_common.h"
 #include "test/unit_test/utils/network_helpers.h"
+#include "tnn/interpreter/default_model_interpreter.h"
 #include "tnn/utils/dims_utils.h"
+#include "tnn/utils/random_data_utils.h"
 
 namespace TNN_NS {
 
@@ -87,4 +89,108 @@ TEST_P(ReshapeLayerTest, ReshapeLayer) {
     Run(interpreter, precision);
 }
 
+class ReshapeAliasTest : public ::testing::TestWithParam<int> {};
+// batch
+INSTANTIATE_TEST_SUITE_P(LayerTest, ReshapeAliasTest, testing::Values(1, 2));
+
+// input -> Abs -> Reshape -> Neg -> output0, the reshape output is a view of the abs output and the neg
+// runs in place on it
+static std::shared_ptr<AbstractModelInterpreter> GenerateReshapeChainInterpreter(const std::vector<int> &input_dims) {
+    auto interpreter = std::shared_ptr<AbstractModelInterpreter>(CreateModelInterpreter(MODEL_TYPE_TNN));
+    auto default_interpreter = dynamic_cast<DefaultModelInterpreter *>(interpreter.get());
+    if (!default_interpreter) {
+        return nullptr;
+    }
+    NetStructure *net_structure = default_interpreter->GetNetStructure();
+    net_structure->inputs_shape_map["input0"] = input_dims;
+    net_structure->outputs.insert("output0");
+
+    auto add_layer = [&](std::string type_str, std::string input, std::string output,
+                         std::shared_ptr<LayerParam> param) {
+        param->name                           = type_str;
+        std::shared_ptr<LayerInfo> layer_info = std::make_shared<LayerInfo>();
+        layer_info->type                      = GlobalConvertLayerType(type_str);
+        layer_info->type_str                  = type_str;
+        layer_info->name                      = type_str;
+        layer_info->inputs                    = {input};
+        layer_info->outputs                   = {output};
+        layer_info->param                     = param;
+        net_structure->layers.push_back(layer_info);
+        net_structure->blobs.insert(input);
+        net_structure->blobs.insert(output);
+    };
+
+    std::shared_ptr<ReshapeLayerParam> reshape_param(new ReshapeLayerParam());
+    reshape_param->reshape_type = 0;
+    reshape_param->axis         = 0;
+    reshape_param->num_axes     = 2;
+    reshape_param->shape        = {0, -1};
+    add_layer("Abs", "input0", "abs_output", std::make_shared<LayerParam>());
+    add_layer("Reshape", "abs_output", "reshape_output", reshape_param);
+    add_layer("Neg", "reshape_output", "output0", std::make_shared<LayerParam>());
+    return interpreter;
+}
+
+static Status CreateReshapeChainInstance(std::shared_ptr<AbstractModelInterpreter> interpreter, ShareMemoryMode mode,
+                                         std::shared_ptr<Instance> &instance) {
+    ModelConfig model_config;
+    model_config.params.push_back("");
+    model_config.params.push_back("");
+
+    NetworkConfig net_config;
+    net_config.device_type       = ConvertDeviceType(FLAGS_dt);
+    net_config.precision         = PRECISION_HIGH;
+    net_config.share_memory_mode = mode;
+
+    instance = std::make_shared<Instance>(net_config, model_config);
+    return instance->Init(interpreter, InputShapesMap());
+}
+
+// the reshape and the neg share the memory of the abs output, so the network plans a single blob
+// besides its input
+TEST_P(ReshapeAliasTest, ReshapeViewAndInplace) {
+    int batch      = GetParam();
+    DeviceType dev = ConvertDeviceType(FLAGS_dt);
+    // only the x86 and naive accs declare their output alias so far
+    if (dev != DEVICE_X86 && dev != DEVICE_NAIVE) {
+        GTEST_SKIP();
+    }
+
+    std::vector<int> input_dims = {batch, 8, 6, 6};
+    const int count             = DimsVectorUtils::Count(input_dims);
+    auto interpreter            = GenerateReshapeChainInterpreter(input_dims);
+    ASSERT_TRUE(interpreter != nullptr);
+
+    std::shared_ptr<Instance> external_instance;
+    Status status = CreateReshapeChainInstance(interpreter, SHARE_MEMORY_MODE_SET_FROM_EXTERNAL, external_instance);
+    ASSERT_EQ((int)status, TNN_OK);
+    int memory_size = 0;
+    status          = external_instance->GetForwardMemorySize(memory_size);
+    ASSERT_EQ((int)status, TNN_OK);
+    EXPECT_LT(memory_size, 3 * count * (int)sizeof(float));
+
+    std::shared_ptr<Instance> instance;
+    status = CreateReshapeChainInstance(interpreter, SHARE_MEMORY_MODE_DEFAULT, instance);
+    ASSERT_EQ((int)status, TNN_OK);
+    BlobMap input_blobs, output_blobs;
+    instance->GetAllInputBlobs(input_blobs);
+    instance->GetAllOutputBlobs(output_blobs);
+    auto input_blob  = input_blobs["input0"];
+    auto output_blob = output_blobs["output0"];
+
+    std::vector<float> input(count);
+    InitRandom(input.data(), input.size(), 1.0f);
+    auto input_ptr = (char *)input_blob->GetHandle().base + input_blob->GetHandle().bytes_offset;
+    memcpy(input_ptr, input.data(), count * sizeof(float));
+    status = instance->Forward();
+    ASSERT_EQ((int)status, TNN_OK);
+
+    std::vector<int> output_dims = {batch, count / batch};
+    EXPECT_TRUE(DimsVectorUtils::Equal(output_blob->GetBlobDesc().dims, output_dims));
+    auto output_ptr = (float *)((char *)output_blob->GetHandle().base + output_blob->GetHandle().bytes_offset);
+    for (int i = 0; i < count; ++i) {
+        EXPECT_FLOAT_EQ(output_ptr[i], -std::fabs(input[i]));
+    }
+}
+
 }  // namespace TNN_NS
@@ -169,6 +169,35 @@ bool MatConverterTest::CopyMakeBorderCheck(const DeviceType& device_type, const
     return false;
 }
 
+bool MatConverterTest::PreprocessCheck(const DeviceType& device_type,
+                                       const MatConverterTestParam& mat_converter_test_param,
+                                       const MatConverterType& mat_converter_type, const MatType& mat_type) {
+    if (mat_converter_type == MatConverterType::Preprocess || mat_converter_type == MatConverterType::PreprocessBatch) {
+        if (device_type != DEVICE_X86) {
+            return true;
+        }
+        auto param = mat_converter_test_param.preprocess_param.crop;
+        if (mat_type == NNV12 || mat_type == NNV21) {
+            if (param.top_left_x % 2 || param.top_left_y % 2 || param.height % 2 || param.width % 2) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool MatConverterTest::BatchRoiCheck(const DeviceType& device_type, const MatConverterType& mat_converter_type,
+                                     const int batch) {
+    if (mat_converter_type == MatConverterType::PreprocessBatch ||
+        mat_converter_type == MatConverterType::WarpAffineBatch) {
+        // batch roi apis take a single src image
+        if (device_type != DEVICE_X86 || batch != 1) {
+            return true;
+        }
+    }
+    return false;
+}
+
 bool MatConverterTest::CropYUVCheck(const MatConverterTestParam& mat_converter_test_param,
                                     const MatConverterType& mat_converter_type,
                                     const MatType& mat_type) {
@@ -191,6 +220,9 @@ void MatConverterTest::GetOutputSize(const MatConverterTestParam& mat_converter_
         output_size = int(round(mat_converter_test_param.resize_param.scale_h * input_size));
     } else if (mat_converter_type == MatConverterType::Crop) {
         output_size = mat_converter_test_param.crop_param.width;
+    } else if (mat_converter_type == MatConverterType::Preprocess ||
+               mat_converter_type == MatConverterType::PreprocessBatch) {
+        output_size = mat_converter_test_param.preprocess_output_size;
     } else if (mat_converter_type == MatConverterType::CopyMakeBorder) {
         output_size = input_size + mat_converter_test_param.copy_make_border_param.top +
                       mat_converter_test_param.copy_make_border_param.bottom;
@@ -277,7 +309,26 @@ INSTANTIATE_TEST_SUITE_P(MatConverterTest, MatConverterTest,
                                 MatConverterTestParam(MatConverterType::CopyMakeBorder, 3, 9, 7, 5,
                                                       BORDER_TYPE_CONSTANT, 100.0),
                                 MatConverterTestParam(MatConverterType::CopyMakeBorder, 7, 3, 3, 7,
-                                                      BORDER_TYPE_CONSTANT, 50.0)
+                                                      BORDER_TYPE_CONSTANT, 50.0),
+                                // Preprocess
+                                MatConverterTestParam(MatConverterType::Preprocess, 0, 0, 0, 0, 16,
+                                                      INTERP_TYPE_LINEAR, false),
+                                MatConverterTestParam(MatConverterType::Preprocess, 2, 4, 16, 12, 24,
+                                                      INTERP_TYPE_LINEAR, true),
+                                MatConverterTestParam(MatConverterType::Preprocess, 3, 1, 15, 17, 8,
+                                                      INTERP_TYPE_LINEAR, false),
+                                MatConverterTestParam(MatConverterType::Preprocess, 2, 4, 16, 12, 10,
+                                                      INTERP_TYPE_NEAREST, true),
+                                // PreprocessBatch
+                                MatConverterTestParam(MatConverterType::PreprocessBatch, 0, 0, 0, 0, 16,
+                                                      INTERP_TYPE_LINEAR, false),
+                                MatConverterTestParam(MatConverterType::PreprocessBatch, 2, 4, 16, 12, 10,
+                                                      INTERP_TYPE_NEAREST, true),
+                                // WarpAffineBatch
+                                MatConverterTestParam(MatConverterType::WarpAffineBatch, 1, 0, 5, 0, 1, 3,
+                                                      INTERP_TYPE_LINEAR, BORDER_TYPE_CONSTANT, 0.0),
+                                MatConverterTestParam(MatConverterType::WarpAffineBatch, 0.8, 0.1, 2, -0.1, 0.9, 4,
+                                                      INTERP_TYPE_NEAREST, BORDER_TYPE_CONSTANT, 255)
                                                       )
                             ));
 
@@ -306,6 +357,8 @@ TEST_P(MatConverterTest, MatConverterTest) {
     if (MatChannelCheck(mat_type, channel, input_size) ||
         CvtColorCheck(device_type, mat_type, mat_converter_type, cvt_type, input_size) ||
         CopyMakeBorderCheck(device_type, mat_type, mat_converter_type) ||
+        PreprocessCheck(device_type, mat_converter_test_param, mat_converter_type, mat_type) ||
+        BatchRoiCheck(device_type, mat_converter_type, batch) ||
         CropYUVCheck(mat_converter_test_param, mat_converter_type, mat_type)) {
         GTEST_SKIP();
     }
@@ -461,6 +514,95 @@ TEST_P(MatConverterTest, MatConverterTest) {
             EXPECT_EQ(0, cmp_result);
             break;
         }
+        case MatConverterType::Preprocess:
+        {
+            DimsVector dims_float   = {batch, channel, output_size, output_size};
+            Mat cpu_ref_float_mat   = Mat(DEVICE_NAIVE, NCHW_FLOAT, dims_float);
+            Mat cpu_out_float_mat   = Mat(DEVICE_NAIVE, NCHW_FLOAT, dims_float);
+            Mat device_float_mat    = Mat(device_type, NCHW_FLOAT, dims_float);
+            TNN_NS::Status status = MatUtils::Preprocess(cpu_in_mat, cpu_ref_float_mat,
+                                                         mat_converter_test_param.preprocess_param, NULL);
+            CHECK_STATUS;
+
+            status = MatUtils::Copy(cpu_in_mat, device_in_mat,
+                                           device_command_queue);
+            status = MatUtils::Preprocess(device_in_mat, device_float_mat,
+                                                 mat_converter_test_param.preprocess_param,
+                                                 device_command_queue);
+            CHECK_STATUS;
+
+            MatUtils::Copy(device_float_mat, cpu_out_float_mat, device_command_queue);
+            cmp_result |= CompareData(static_cast<float*>(cpu_ref_float_mat.GetData()),
+                                      static_cast<float*>(cpu_out_float_mat.GetData()),
+                                      DimsVectorUtils::Count(dims_float), 0.001);
+            EXPECT_EQ(0, cmp_result);
+            break;
+        }
+        case MatConverterType::PreprocessBatch:
+        {
+            // rois share the right bottom corner and shrink from left top
+            const int roi_count = 3;
+            std::vector<PreprocessParam> params(roi_count, mat_converter_test_param.preprocess_param);
+            for (int n = 0; n < roi_count; ++n) {
+                auto& crop = params[n].crop;
+                if (crop.width <= 0 || crop.height <= 0) {
+                    crop.width  = input_size;
+                    crop.height = input_size;
+                }
+                crop.top_left_x += 2 * n;
+                crop.top_left_y += 2 * n;
+                crop.width      -= 2 * n;
+                crop.height     -= 2 * n;
+            }
+
+            DimsVector dims_float   = {roi_count, channel, output_size, output_size};
+            Mat cpu_ref_float_mat   = Mat(DEVICE_NAIVE, NCHW_FLOAT, dims_float);
+            Mat cpu_out_float_mat   = Mat(DEVICE_NAIVE, NCHW_FLOAT, dims_float);
+            Mat device_float_mat    = Mat(device_type, NCHW_FLOAT, dims_float);
+            TNN_NS::Status status = MatUtils::PreprocessBatch(cpu_in_mat, cpu_ref_float_mat, params, NULL);
+            CHECK_STATUS;
+
+            status = MatUtils::Copy(cpu_in_mat, device_in_mat,
+                                           device_command_queue);
+            status = MatUtils::PreprocessBatch(device_in_mat, device_float_mat, params, device_command_queue);
+            CHECK_STATUS;
+
+            MatUtils::Copy(device_float_mat, cpu_out_float_mat, device_command_queue);
+            cmp_result |= CompareData(static_cast<float*>(cpu_ref_float_mat.GetData()),
+                                      static_cast<float*>(cpu_out_float_mat.GetData()),
+                                      DimsVectorUtils::Count(dims_float), 0.001);
+            EXPECT_EQ(0, cmp_result);
+            break;
+        }
+        case MatConverterType::WarpAffineBatch:
+        {
+            // shift the translation of every roi
+            const int roi_count = 4;
+            std::vector<WarpAffineParam> params(roi_count, mat_converter_test_param.warp_affine_param);
+            for (int n = 0; n < roi_count; ++n) {
+                params[n].transform[0][2] -= 3 * n;
+                params[n].transform[1][2] -= 2 * n;
+            }
+
+            DimsVector dims_batch   = {roi_count, channel, output_size, output_size};
+            Mat cpu_ref_batch_mat   = Mat(DEVICE_NAIVE, mat_type, dims_batch);
+            Mat cpu_out_batch_mat   = Mat(DEVICE_NAIVE, mat_type, dims_batch);
+            Mat device_batch_mat    = Mat(device_type, mat_type, dims_batch);
+            TNN_NS::Status status = MatUtils::WarpAffineBatch(cpu_in_mat, cpu_ref_batch_mat, params, NULL);
+            CHECK_STATUS;
+
+            status = MatUtils::Copy(cpu_in_mat, device_in_mat,
+                                           device_command_queue);
+            status = MatUtils::WarpAffineBatch(device_in_mat, device_batch_mat, params, device_command_queue);
+            CHECK_STATUS;
+
+            MatUtils::Copy(device_batch_mat, cpu_out_batch_mat, device_command_queue);
+            cmp_result |= CompareData(static_cast<uint8_t*>(cpu_ref_batch_mat.GetData()),
+                                      static_cast<uint8_t*>(cpu_out_batch_mat.GetData()),
+                                      channel, channel, roi_count * out_size_);
+            EXPECT_EQ(0, cmp_result);
+            break;
+        }
     }
     rtn = DestroyTestData();
     EXPECT_EQ(rtn, 0);
@@ -36,7 +36,10 @@ enum class MatConverterType
     Crop = 3,
     WarpAffine = 4,
     CvtColor = 5,
-    CopyMakeBorder = 6
+    CopyMakeBorder = 6,
+    Preprocess = 7,
+    PreprocessBatch = 8,
+    WarpAffineBatch = 9
 };
 
 struct MatConverterTestParam
@@ -52,6 +55,9 @@ struct MatConverterTestParam
     ColorConversionType cvt_type = COLOR_CONVERT_NV12TOBGR;
     // CopyMakeBorder
     CopyMakeBorderParam copy_make_border_param;
+    // Preprocess
+    PreprocessParam preprocess_param;
+    int preprocess_output_size = 0;
 
     // for Copy
     MatConverterTestParam(MatConverterType converter_type) :
@@ -112,6 +118,20 @@ struct MatConverterTestParam
         copy_make_border_param.border_type = border_type;
         copy_make_border_param.border_val  = border_val;
     }
+
+    // for Preprocess
+    MatConverterTestParam(MatConverterType converter_type, int top_left_x, int top_left_y, int width, int height,
+                          int output_size, InterpType interp_type, bool reverse_channel) :
+        mat_converter_type(converter_type), preprocess_output_size(output_size) {
+        preprocess_param.crop.top_left_x = top_left_x;
+        preprocess_param.crop.top_left_y = top_left_y;
+        preprocess_param.crop.width      = width;
+        preprocess_param.crop.height     = height;
+        preprocess_param.interp_type     = interp_type;
+        preprocess_param.scale           = {0.5f, 1.0f / 255, 2.0f, 1.0f};
+        preprocess_param.bias            = {-10.0f, 0.5f, 1.0f, 0.0f};
+        preprocess_param.reverse_channel = reverse_channel;
+    }
 };
 
 class MatConverterTest : public ::testing::TestWithParam<std::tuple<int, int, int, MatType, MatConverterTestParam>> {
@@ -137,6 +157,9 @@ protected:
                        const MatConverterType& mat_converter_type,
                        const ColorConversionType& cvt_type,
                        const int input_size);
+    bool PreprocessCheck(const DeviceType& device_type, const MatConverterTestParam& mat_converter_test_param,
+                         const MatConverterType& mat_converter_type, const MatType& mat_type);
+    bool BatchRoiCheck(const DeviceType& device_type, const MatConverterType& mat_converter_type, const int batch);
     bool CopyMakeBorderCheck(const DeviceType& device_type, const MatType& mat_type,
                              const MatConverterType& mat_converter_type);
     void GetOutputSize(const MatConverterTestParam& mat_converter_test_param,
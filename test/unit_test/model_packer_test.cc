@@ -0,0 +1,227 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "test/unit_test/model_packer_test.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "test/test_utils.h"
+#include "test/unit_test/unit_test_common.h"
+#include "tnn/interpreter/tnn/model_packer.h"
+#include "tnn/utils/random_data_utils.h"
+
+namespace TNN_NS {
+
+static std::string ReadFile(const std::string& path) {
+    std::ifstream stream(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+}
+
+Status ModelPackerTest::PackAndLoad(DefaultModelInterpreter* interpreter, int alignment, bool half,
+                                    std::shared_ptr<AbstractModelInterpreter>& loaded) {
+    const std::string proto_path = "model_packer_test.tnnproto";
+    const std::string model_path = "model_packer_test.tnnmodel";
+
+    ModelPacker packer(interpreter->GetNetStructure(), interpreter->GetNetResource());
+    packer.SetSectionAlignment(alignment);
+    if (half) {
+        packer.SetResourceHandler(
+            [](std::shared_ptr<LayerInfo> layer_info, std::shared_ptr<LayerResource>& resource) -> Status {
+                auto conv_resource = std::dynamic_pointer_cast<ConvLayerResource>(resource);
+                if (conv_resource) {
+                    auto half_resource           = std::make_shared<ConvLayerResource>(*conv_resource);
+                    half_resource->filter_handle = ConvertFloatToFP16(conv_resource->filter_handle);
+                    resource                     = half_resource;
+                }
+                return TNN_OK;
+            });
+    }
+    auto status = packer.Pack(proto_path, model_path);
+    if (status != TNN_OK) {
+        return status;
+    }
+
+    std::vector<std::string> params = {ReadFile(proto_path), ReadFile(model_path)};
+    remove(proto_path.c_str());
+    remove(model_path.c_str());
+
+    if (alignment > 0) {
+        // the header, the sections and the index must still fit in the file
+        EXPECT_GT(params[1].size(), (size_t)alignment);
+    }
+
+    loaded = std::shared_ptr<AbstractModelInterpreter>(CreateModelInterpreter(MODEL_TYPE_TNN));
+    return loaded->Interpret(params);
+}
+
+INSTANTIATE_TEST_SUITE_P(ModelPackerTest, ModelPackerTest,
+                         ::testing::Combine(
+                             // section alignment
+                             testing::Values(0, 64, 4096),
+                             // convert conv weights to half while packing
+                             testing::Values(false, true)));
+
+TEST_P(ModelPackerTest, PackAndInterpretTest) {
+    const int alignment = std::get<0>(GetParam());
+    const bool half     = std::get<1>(GetParam());
+
+    const int channel     = 8;
+    auto param            = std::make_shared<ConvLayerParam>();
+    param->type           = "Convolution";
+    param->name           = "layer_name";
+    param->input_channel  = channel;
+    param->output_channel = channel;
+    param->group          = 1;
+    param->kernels        = {3, 3};
+    param->dialations     = {1, 1};
+    param->strides        = {1, 1};
+    param->pads           = {1, 1, 1, 1};
+    param->bias           = 1;
+
+    auto resource = std::make_shared<ConvLayerResource>();
+    RawBuffer filter(channel * channel * 9 * sizeof(float));
+    RawBuffer bias(channel * sizeof(float));
+    InitRandom(filter.force_to<float*>(), channel * channel * 9, 1.0f);
+    InitRandom(bias.force_to<float*>(), channel, 1.0f);
+    resource->filter_handle = filter;
+    resource->bias_handle   = bias;
+
+    auto interpreter = GenerateInterpreter("Convolution", {{1, channel, 8, 8}}, param, resource);
+    ASSERT_TRUE(interpreter != nullptr);
+    auto default_interpreter = dynamic_cast<DefaultModelInterpreter*>(interpreter.get());
+
+    // a constant, it is located by the index in the indexed layout
+    auto constant = std::make_shared<RawBuffer>(4 * sizeof(float));
+    InitRandom(constant->force_to<float*>(), 4, 1.0f);
+    default_interpreter->GetNetResource()->constant_map["constant"] = constant;
+
+    std::shared_ptr<AbstractModelInterpreter> loaded;
+    Status status = PackAndLoad(default_interpreter, alignment, half, loaded);
+    ASSERT_EQ((int)status, TNN_OK);
+    // the handler replaces the resource only while it is written
+    EXPECT_EQ(resource->filter_handle.GetDataType(), DATA_TYPE_FLOAT);
+
+    auto loaded_resource = dynamic_cast<DefaultModelInterpreter*>(loaded.get())->GetNetResource();
+    ASSERT_EQ(loaded_resource->resource_map.count("layer_name"), 1);
+    auto loaded_conv = std::dynamic_pointer_cast<ConvLayerResource>(loaded_resource->resource_map["layer_name"]);
+    ASSERT_TRUE(loaded_conv != nullptr);
+
+    EXPECT_EQ(loaded_conv->filter_handle.GetDataType(), half ? DATA_TYPE_HALF : DATA_TYPE_FLOAT);
+    RawBuffer loaded_filter = half ? ConvertHalfHandle(loaded_conv->filter_handle) : loaded_conv->filter_handle;
+    ASSERT_EQ(loaded_filter.GetBytesSize(), filter.GetBytesSize());
+    EXPECT_EQ(CompareData(loaded_filter.force_to<float*>(), filter.force_to<float*>(), channel * channel * 9,
+                          half ? 0.01f : 0.0f),
+              0);
+    ASSERT_EQ(loaded_conv->bias_handle.GetBytesSize(), bias.GetBytesSize());
+    EXPECT_EQ(CompareData(loaded_conv->bias_handle.force_to<float*>(), bias.force_to<float*>(), channel, 0.0f), 0);
+
+    auto& loaded_constants = loaded_resource->constant_map;
+    ASSERT_EQ(loaded_constants.count("constant"), 1);
+    EXPECT_EQ(CompareData(loaded_constants["constant"]->force_to<float*>(), constant->force_to<float*>(), 4, 0.0f), 0);
+}
+
+TEST_P(ModelPackerTest, ReleaseResourceTest) {
+    const int alignment = std::get<0>(GetParam());
+
+    auto param        = std::make_shared<PReluLayerParam>();
+    param->type       = "PReLU";
+    param->name       = "layer_name";
+    param->has_filler = 0;
+
+    auto resource = std::make_shared<PReluLayerResource>();
+    RawBuffer slope(4 * sizeof(float));
+    InitRandom(slope.force_to<float*>(), 4, 1.0f);
+    resource->slope_handle = slope;
+
+    auto interpreter = GenerateInterpreter("PReLU", {{1, 4, 2, 2}}, param, resource);
+    ASSERT_TRUE(interpreter != nullptr);
+    auto net_resource = dynamic_cast<DefaultModelInterpreter*>(interpreter.get())->GetNetResource();
+    resource          = nullptr;
+
+    ModelPacker packer(dynamic_cast<DefaultModelInterpreter*>(interpreter.get())->GetNetStructure(), net_resource);
+    packer.SetSectionAlignment(alignment);
+    packer.SetReleaseResource(true);
+    Status status = packer.Pack("model_packer_release.tnnproto", "model_packer_release.tnnmodel");
+    ASSERT_EQ((int)status, TNN_OK);
+    remove("model_packer_release.tnnproto");
+    remove("model_packer_release.tnnmodel");
+    EXPECT_EQ(net_resource->resource_map.count("layer_name"), 0);
+}
+
+TEST_P(ModelPackerTest, ParallelLoadTest) {
+    const int alignment = std::get<0>(GetParam());
+    const int count     = 32;
+
+    auto param        = std::make_shared<PReluLayerParam>();
+    param->type       = "PReLU";
+    param->name       = "layer_name";
+    param->has_filler = 0;
+    auto interpreter  = GenerateInterpreter("PReLU", {{1, 64, 2, 2}}, param, nullptr);
+    ASSERT_TRUE(interpreter != nullptr);
+    auto net_structure = dynamic_cast<DefaultModelInterpreter*>(interpreter.get())->GetNetStructure();
+    auto net_resource  = dynamic_cast<DefaultModelInterpreter*>(interpreter.get())->GetNetResource();
+    net_structure->layers.clear();
+
+    // a chain of layers with slopes of different sizes
+    std::vector<RawBuffer> slopes;
+    for (int i = 0; i < count; ++i) {
+        auto layer_info      = std::make_shared<LayerInfo>();
+        layer_info->type     = LAYER_PRELU;
+        layer_info->type_str = "PReLU";
+        layer_info->name     = "prelu" + std::to_string(i);
+        layer_info->inputs   = {i == 0 ? "input0" : "prelu" + std::to_string(i - 1)};
+        layer_info->outputs  = {i == count - 1 ? "output0" : layer_info->name};
+        layer_info->param    = param;
+        net_structure->blobs.insert(layer_info->outputs[0]);
+        net_structure->layers.push_back(layer_info);
+
+        auto resource = std::make_shared<PReluLayerResource>();
+        RawBuffer slope((i + 1) * 37 * sizeof(float));
+        InitRandom(slope.force_to<float*>(), (i + 1) * 37, 1.0f);
+        resource->slope_handle                       = slope;
+        net_resource->resource_map[layer_info->name] = resource;
+        slopes.push_back(slope);
+    }
+
+    const std::string proto_path = "model_packer_parallel.tnnproto";
+    const std::string model_path = "model_packer_parallel.tnnmodel";
+    ModelPacker packer(net_structure, net_resource);
+    packer.SetSectionAlignment(alignment);
+    Status status = packer.Pack(proto_path, model_path);
+    ASSERT_EQ((int)status, TNN_OK);
+
+    for (int thread_num : {1, 4}) {
+        std::vector<std::string> params = {ReadFile(proto_path), ReadFile(model_path),
+                                           "LoadThreadNum:" + std::to_string(thread_num)};
+        auto loaded = std::shared_ptr<AbstractModelInterpreter>(CreateModelInterpreter(MODEL_TYPE_TNN));
+        status      = loaded->Interpret(params);
+        ASSERT_EQ((int)status, TNN_OK);
+
+        auto& resource_map = dynamic_cast<DefaultModelInterpreter*>(loaded.get())->GetNetResource()->resource_map;
+        ASSERT_EQ(resource_map.size(), count);
+        for (int i = 0; i < count; ++i) {
+            auto resource = std::dynamic_pointer_cast<PReluLayerResource>(resource_map["prelu" + std::to_string(i)]);
+            ASSERT_TRUE(resource != nullptr);
+            ASSERT_EQ(resource->slope_handle.GetBytesSize(), slopes[i].GetBytesSize());
+            EXPECT_EQ(CompareData(resource->slope_handle.force_to<float*>(), slopes[i].force_to<float*>(),
+                                  slopes[i].GetDataCount(), 0.0f),
+                      0);
+        }
+    }
+    remove(proto_path.c_str());
+    remove(model_path.c_str());
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,35 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_TEST_UNIT_TEST_MODEL_PACKER_TEST_H_
+#define TNN_TEST_UNIT_TEST_MODEL_PACKER_TEST_H_
+
+#include <gtest/gtest.h>
+
+#include "tnn/core/common.h"
+#include "tnn/core/status.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+
+namespace TNN_NS {
+
+class ModelPackerTest : public ::testing::TestWithParam<std::tuple<int, bool>> {
+protected:
+    // @brief pack the interpreter into files and interpret them again
+    Status PackAndLoad(DefaultModelInterpreter* interpreter, int alignment, bool half,
+                       std::shared_ptr<AbstractModelInterpreter>& loaded);
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_TEST_UNIT_TEST_MODEL_PACKER_TEST_H_
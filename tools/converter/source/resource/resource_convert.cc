@@ -14,8 +14,14 @@
 
 #include "tools/converter/source/resource/resource_convert.h"
 
+#include <sstream>
+
 #include "tnn/core/common.h"
+#include "tnn/interpreter/tnn/layer_interpreter/abstract_layer_interpreter.h"
+#include "tnn/interpreter/tnn/model_interpreter.h"
+#include "tnn/interpreter/tnn/objseri.h"
 #include "tools/converter/source/resource/reource_base_convert.h"
+#include "tools/converter/source/utils/parallel.h"
 
 namespace TNN_CONVERTER {
 
@@ -23,6 +29,64 @@ TNN_NS::Status ResourceConvert::SetResourceConvertType(ResourceConvertType resou
     this->resource_convert_type_ = resource_convert_type;
     return TNN_NS::TNN_OK;
 }
+void ResourceConvert::SetCache(ConvertCache* cache) {
+    this->cache_ = cache;
+}
+
+TNN_NS::Status ResourceConvert::ConvertLayer(TNN_NS::LayerInfo* layer,
+                                             std::shared_ptr<TNN_NS::LayerResource>& layer_resource) {
+    const auto& convert = ResourceConvertManager::get()->search(layer->type_str);
+    if (convert == nullptr) {
+        LOGE("The ResourceConverter do not support layer:%s \n", layer->name.c_str());
+        LOGE("The unsupported operator type is:%s\n", layer->type_str.c_str());
+        return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
+    }
+    if (cache_ == nullptr || !cache_->Enabled()) {
+        return convert->ConvertToHalfResource(layer->param, layer_resource);
+    }
+
+    auto& layer_interpreter_map = TNN_NS::ModelInterpreter::GetLayerInterpreterMap();
+    auto layer_interpreter      = layer_interpreter_map.find(layer->type);
+    if (layer_interpreter == layer_interpreter_map.end()) {
+        return convert->ConvertToHalfResource(layer->param, layer_resource);
+    }
+    // the key is the serialized source weights, a layer with unchanged weights reuses the converted ones
+    std::stringstream source_stream;
+    TNN_NS::Serializer source_serializer(source_stream);
+    auto status = layer_interpreter->second->SaveResource(source_serializer, layer->param.get(), layer_resource.get());
+    if (status != TNN_NS::TNN_OK) {
+        return status;
+    }
+    auto key = cache_->GetResourceKey(layer->type_str, resource_convert_type_, source_stream.str());
+    source_stream.str("");
+
+    std::string cached_data;
+    if (cache_->LoadResource(key, cached_data)) {
+        std::stringstream cached_stream(cached_data);
+        TNN_NS::Deserializer deserializer(cached_stream);
+        TNN_NS::LayerResource* cached_resource = nullptr;
+        status = layer_interpreter->second->InterpretResource(deserializer, &cached_resource);
+        if (status == TNN_NS::TNN_OK && cached_resource != nullptr) {
+            layer_resource = std::shared_ptr<TNN_NS::LayerResource>(cached_resource);
+            return TNN_NS::TNN_CONVERT_OK;
+        }
+        // a broken cache entry is converted again and overwritten
+        delete cached_resource;
+    }
+
+    status = convert->ConvertToHalfResource(layer->param, layer_resource);
+    if (status != TNN_NS::TNN_CONVERT_OK) {
+        return status;
+    }
+    std::stringstream converted_stream;
+    TNN_NS::Serializer converted_serializer(converted_stream);
+    status = layer_interpreter->second->SaveResource(converted_serializer, layer->param.get(), layer_resource.get());
+    if (status == TNN_NS::TNN_OK) {
+        cache_->SaveResource(key, converted_stream.str());
+    }
+    return TNN_NS::TNN_CONVERT_OK;
+}
+
 TNN_NS::Status ResourceConvert::converter(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource) {
     if (resource_convert_type_ == RESOURCE_KEEP_ORIGINAL) {
         return TNN_NS::TNN_OK;
@@ -33,24 +97,24 @@ TNN_NS::Status ResourceConvert::converter(TNN_NS::NetStructure& net_structure, T
         if (net_structure.layers.empty()) {
             return TNN_NS::TNN_OK;
         }
+        // layers own separate resources, so they are converted in parallel
+        std::vector<std::pair<TNN_NS::LayerInfo*, std::shared_ptr<TNN_NS::LayerResource>*>> convert_layers;
         for (auto& layer : net_structure.layers) {
             const std::string& layer_name = layer->name;
             if (resource_map.find(layer_name) != resource_map.end() &&
                 resource_map.find(layer_name)->second != nullptr) {
-                const auto& convert = ResourceConvertManager::get()->search(layer->type_str);
-                if (convert == nullptr) {
-                    LOGE("The ResourceConverter do not support layer:%s \n", layer->name.c_str());
-                    LOGE("The unsupported operator type is:%s\n", layer->type_str.c_str());
-                    return TNN_NS::TNNERR_CONVERT_UNSUPPORT_LAYER;
-                }
-                std::shared_ptr<TNN_NS::LayerResource> layer_resource = resource_map.find(layer_name)->second;
-                auto status = convert->ConvertToHalfResource(layer->param, layer_resource);
-                if (status != TNN_NS::TNN_CONVERT_OK) {
-                    LOGE("ResourceConvert failed for %s\n", layer->name.c_str());
-                    return status;
-                }
+                convert_layers.push_back({layer.get(), &resource_map.find(layer_name)->second});
             }
         }
+        return ParallelFor((int)convert_layers.size(), [&](int index) {
+            auto layer  = convert_layers[index].first;
+            auto status = ConvertLayer(layer, *convert_layers[index].second);
+            if (status != TNN_NS::TNN_CONVERT_OK) {
+                LOGE("ResourceConvert failed for %s\n", layer->name.c_str());
+                return status;
+            }
+            return TNN_NS::Status(TNN_NS::TNN_OK);
+        });
     }
     return TNN_NS::TNN_OK;
 }
@@ -19,6 +19,7 @@
 #include "tnn/core/status.h"
 #include "tnn/interpreter/net_resource.h"
 #include "tnn/interpreter/net_structure.h"
+#include "tools/converter/source/utils/convert_cache.h"
 
 namespace TNN_CONVERTER {
 
@@ -33,12 +34,17 @@ class ResourceConvert {
 public:
     ResourceConvert() = default;
     TNN_NS::Status SetResourceConvertType(ResourceConvertType resource_convert_type);
+    // @brief reuse the converted weights of unchanged layers, the cache is not owned
+    void SetCache(ConvertCache* cache);
     TNN_NS::Status converter(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource);
 
     ~ResourceConvert() = default;
 
 private:
+    TNN_NS::Status ConvertLayer(TNN_NS::LayerInfo* layer, std::shared_ptr<TNN_NS::LayerResource>& layer_resource);
+
     ResourceConvertType resource_convert_type_ = RESOURCE_KEEP_ORIGINAL;
+    ConvertCache* cache_                       = nullptr;
 };
 }  // namespace TNN_CONVERTER
 
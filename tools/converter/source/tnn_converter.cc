@@ -23,9 +23,11 @@
 #include "tnn/interpreter/net_resource.h"
 #include "tnn/interpreter/net_structure.h"
 #include "utils/command.h"
+#include "utils/convert_cache.h"
 #include "utils/flags.h"
 #include "utils/generate_model.h"
 #include "utils/model_config.h"
+#include "utils/parallel.h"
 
 namespace TNN_CONVERTER {
 int Run(int argc, char* argv[]) {
@@ -38,6 +40,24 @@ int Run(int argc, char* argv[]) {
     TNN_NS::NetResource& net_resource =
         *(dynamic_cast<TNN_NS::DefaultModelInterpreter*>(interpreter.get())->GetNetResource());
     ModelConfig model_config(FLAGS_mt, FLAGS_mp, FLAGS_od);
+    SetConvertThreadNum(FLAGS_th);
+
+    // an unchanged model converted with the same options reuses the cached result
+    ConvertCache cache(FLAGS_cd);
+    std::string file_name  = GetFileName(model_config.model_path_);
+    std::string proto_path = GetProtoPath(model_config.output_dir_, file_name);
+    std::string model_path = GetModelPath(model_config.output_dir_, file_name);
+    std::string model_key;
+    if (cache.Enabled()) {
+        std::string options = FLAGS_mt + (FLAGS_half ? " half " : " float ") + std::to_string(FLAGS_sa);
+        model_key           = cache.GetModelKey(model_config.model_path_, options);
+        if (cache.LoadModel(model_key, proto_path, model_path)) {
+            printf("TNN Converter reuse cached TNN proto path %s\n", proto_path.c_str());
+            printf("TNN Converter reuse cached TNN model path %s\n", model_path.c_str());
+            return 0;
+        }
+    }
+
     TNN_NS::Status status;
     if (model_config.model_type_ == TNN_CONVERTER::MODEL_TYPE_TF_LITE) {
         TFLite2Tnn tf_lite_2_tnn(model_config.model_path_);
@@ -76,14 +96,15 @@ int Run(int argc, char* argv[]) {
     if (FLAGS_half) {
         resource_manager.SetResourceConvertType(RESOURCE_CONVERT_HALF);
     }
+    resource_manager.SetCache(&cache);
     resource_manager.converter(net_structure, net_resource);
     // wright the model
-    std::string file_name = GetFileName(model_config.model_path_);
-    status                = GenerateModel(net_structure, net_resource, model_config.output_dir_, file_name);
+    status = GenerateModel(net_structure, net_resource, model_config.output_dir_, file_name, FLAGS_sa);
     if (status != TNN_NS::TNN_CONVERT_OK) {
         LOGE("Converter: generate tnn model failed!\n");
         return status;
     }
+    cache.SaveModel(model_key, proto_path, model_path);
     return 0;
 }
 
@@ -0,0 +1,177 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "convert_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+#include "parallel.h"
+#include "tnn/core/macro.h"
+#include "tnn/utils/md5.h"
+
+namespace TNN_CONVERTER {
+
+// bump it when the format of converted results changes
+static const char kConvertCacheVersion[] = "tnn_convert_cache_v1";
+
+static const size_t kMd5ChunkSize = 64 * 1024 * 1024;
+
+static bool ReadFile(const std::string& path, std::string& content) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream.is_open() || !stream.good()) {
+        return false;
+    }
+    content = std::string((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+    return stream.good() || stream.eof();
+}
+
+// write to a temporary file first, an interrupted conversion never leaves a broken cache entry
+static bool WriteFile(const std::string& path, const std::string& content) {
+    std::string temp_path = path + ".tmp";
+    {
+        std::ofstream stream(temp_path, std::ios::binary);
+        if (!stream.is_open() || !stream.good()) {
+            return false;
+        }
+        stream.write(content.data(), content.size());
+        if (!stream.good()) {
+            return false;
+        }
+    }
+    return rename(temp_path.c_str(), path.c_str()) == 0;
+}
+
+static bool CopyFile(const std::string& src_path, const std::string& dst_path) {
+    std::string content;
+    if (!ReadFile(src_path, content)) {
+        return false;
+    }
+    std::ofstream stream(dst_path, std::ios::binary);
+    if (!stream.is_open() || !stream.good()) {
+        return false;
+    }
+    stream.write(content.data(), content.size());
+    return stream.good();
+}
+
+std::string GetFileMd5(const std::string& file_path) {
+    std::ifstream stream(file_path, std::ios::binary | std::ios::ate);
+    if (!stream.is_open()) {
+        return "";
+    }
+    const size_t file_size = (size_t)stream.tellg();
+    stream.close();
+
+    const int chunk_count = (int)((file_size + kMd5ChunkSize - 1) / kMd5ChunkSize);
+    std::vector<std::string> chunk_md5(chunk_count);
+    auto status = ParallelFor(chunk_count, [&](int index) {
+        std::ifstream chunk_stream(file_path, std::ios::binary);
+        size_t offset = index * kMd5ChunkSize;
+        size_t size   = std::min(kMd5ChunkSize, file_size - offset);
+        std::vector<char> buffer(size);
+        chunk_stream.seekg(offset);
+        chunk_stream.read(buffer.data(), size);
+        if (!chunk_stream.good()) {
+            return TNN_NS::Status(TNN_NS::TNNERR_INVALID_MODEL, "read model file failed");
+        }
+        TNN_NS::MD5 md5;
+        md5.update(buffer.data(), (TNN_NS::MD5::size_type)size);
+        chunk_md5[index] = md5.finalize().hexdigest();
+        return TNN_NS::Status(TNN_NS::TNN_OK);
+    });
+    if (status != TNN_NS::TNN_OK) {
+        return "";
+    }
+
+    std::string digests = std::to_string(file_size);
+    for (const auto& item : chunk_md5) {
+        digests += item;
+    }
+    return TNN_NS::MD5(digests).hexdigest();
+}
+
+ConvertCache::ConvertCache(const std::string& cache_dir) : cache_dir_(cache_dir) {
+    if (!cache_dir_.empty() && cache_dir_.back() != '/') {
+        cache_dir_ += "/";
+    }
+}
+
+bool ConvertCache::Enabled() const {
+    return !cache_dir_.empty();
+}
+
+std::string ConvertCache::GetModelKey(const std::string& model_path, const std::string& options) const {
+    auto file_md5 = GetFileMd5(model_path);
+    if (file_md5.empty()) {
+        return "";
+    }
+    return TNN_NS::MD5(std::string(kConvertCacheVersion) + file_md5 + options).hexdigest();
+}
+
+bool ConvertCache::LoadModel(const std::string& key, const std::string& proto_path,
+                             const std::string& model_path) const {
+    if (!Enabled() || key.empty()) {
+        return false;
+    }
+    return CopyFile(cache_dir_ + key + ".tnnproto", proto_path) &&
+           CopyFile(cache_dir_ + key + ".tnnmodel", model_path);
+}
+
+void ConvertCache::SaveModel(const std::string& key, const std::string& proto_path,
+                             const std::string& model_path) const {
+    if (!Enabled() || key.empty()) {
+        return;
+    }
+    std::string proto, model;
+    if (!ReadFile(proto_path, proto) || !ReadFile(model_path, model)) {
+        return;
+    }
+    // the model goes first, LoadModel only sees the entry after the proto exists
+    if (!WriteFile(cache_dir_ + key + ".tnnmodel", model) || !WriteFile(cache_dir_ + key + ".tnnproto", proto)) {
+        LOGE("Converter: write convert cache to %s failed\n", cache_dir_.c_str());
+    }
+}
+
+std::string ConvertCache::GetResourceKey(const std::string& type_str, int convert_type,
+                                         const std::string& resource_data) const {
+    TNN_NS::MD5 md5;
+    std::string header = std::string(kConvertCacheVersion) + type_str + " " + std::to_string(convert_type) + " ";
+    md5.update(header.data(), (TNN_NS::MD5::size_type)header.size());
+    for (size_t offset = 0; offset < resource_data.size(); offset += kMd5ChunkSize) {
+        size_t size = std::min(kMd5ChunkSize, resource_data.size() - offset);
+        md5.update(resource_data.data() + offset, (TNN_NS::MD5::size_type)size);
+    }
+    return md5.finalize().hexdigest();
+}
+
+bool ConvertCache::LoadResource(const std::string& key, std::string& resource_data) const {
+    if (!Enabled()) {
+        return false;
+    }
+    return ReadFile(cache_dir_ + key + ".res", resource_data);
+}
+
+void ConvertCache::SaveResource(const std::string& key, const std::string& resource_data) const {
+    if (!Enabled()) {
+        return;
+    }
+    if (!WriteFile(cache_dir_ + key + ".res", resource_data)) {
+        LOGE("Converter: write convert cache to %s failed\n", cache_dir_.c_str());
+    }
+}
+
+}  // namespace TNN_CONVERTER
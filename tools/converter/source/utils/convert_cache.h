@@ -0,0 +1,55 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_TOOLS_CONVERTER_SOURCE_UTILS_CONVERT_CACHE_H_
+#define TNN_TOOLS_CONVERTER_SOURCE_UTILS_CONVERT_CACHE_H_
+#include <string>
+
+namespace TNN_CONVERTER {
+
+// @brief md5 of a file, big files are hashed in chunks on the converter threads
+std::string GetFileMd5(const std::string& file_path);
+
+// ConvertCache keeps converted results in a directory, keyed by the content hash of their inputs.
+// An unchanged model reuses the whole converted model, a changed model reuses the converted weights of
+// the layers whose weights did not change.
+class ConvertCache {
+public:
+    // @brief an empty cache_dir disables the cache
+    explicit ConvertCache(const std::string& cache_dir);
+
+    bool Enabled() const;
+
+    // @brief key of the whole conversion, from the source model content and the converter options
+    std::string GetModelKey(const std::string& model_path, const std::string& options) const;
+
+    // @brief copy the cached model to proto_path and model_path, return false if not cached
+    bool LoadModel(const std::string& key, const std::string& proto_path, const std::string& model_path) const;
+
+    void SaveModel(const std::string& key, const std::string& proto_path, const std::string& model_path) const;
+
+    // @brief key of a converted layer resource, from the layer type, the convert type and the source resource
+    std::string GetResourceKey(const std::string& type_str, int convert_type, const std::string& resource_data) const;
+
+    bool LoadResource(const std::string& key, std::string& resource_data) const;
+
+    void SaveResource(const std::string& key, const std::string& resource_data) const;
+
+private:
+    std::string cache_dir_;
+};
+
+}  // namespace TNN_CONVERTER
+
+#endif  // TNN_TOOLS_CONVERTER_SOURCE_UTILS_CONVERT_CACHE_H_
@@ -28,4 +28,10 @@ DEFINE_string(sp, "", save_path_message);
 
 DEFINE_bool(half, false, half_message);
 
+DEFINE_int32(th, 0, thread_num_message);
+
+DEFINE_string(cd, "", cache_dir_message);
+
+DEFINE_int32(sa, 0, section_align_message);
+
 }  // namespace TNN_CONVERTER
@@ -31,6 +31,15 @@ static const char save_path_message[] = "Specify the save path of the results af
 
 static const char half_message[] = "Convert float model to half";
 
+static const char thread_num_message[] = "The number of threads used by the converter, 0 means the number of cpu cores";
+
+static const char section_align_message[] =
+    "Align the layer sections of the tnnmodel to the given bytes and append a section index, so the model can be "
+    "loaded on multiple threads. 0 keeps the sequential layout readable by older TNN.";
+
+static const char cache_dir_message[] =
+    "Specify the cache directory, unchanged models and weights reuse the cached results: <the>/<path>/<to>/<directory>.";
+
 DECLARE_bool(h);
 
 DECLARE_string(mp);
@@ -43,6 +52,12 @@ DECLARE_string(sp);
 
 DECLARE_bool(half);
 
+DECLARE_int32(th);
+
+DECLARE_string(cd);
+
+DECLARE_int32(sa);
+
 }  // namespace TNN_CONVERTER
 
 #endif  // TNNCONVERTER_SRC_FLAGS_H_
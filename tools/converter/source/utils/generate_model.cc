@@ -33,13 +33,24 @@ std::string GetFileName(std::string& file_path) {
     return file_path.substr(pos_s, len);
 }
 
+std::string GetProtoPath(const std::string& output_dir, const std::string& file_name) {
+    return output_dir + file_name + PROTO_SUFFIX;
+}
+
+std::string GetModelPath(const std::string& output_dir, const std::string& file_name) {
+    return output_dir + file_name + MODEL_SUFFIX;
+}
+
 TNN_NS::Status GenerateModel(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
-                             std::string& output_dir, std::string& file_name) {
-    std::string proto_path = output_dir + file_name + PROTO_SUFFIX;
-    std::string model_path = output_dir + file_name + MODEL_SUFFIX;
+                             std::string& output_dir, std::string& file_name, int section_alignment) {
+    std::string proto_path = GetProtoPath(output_dir, file_name);
+    std::string model_path = GetModelPath(output_dir, file_name);
     printf("TNN Converter generate TNN proto path %s\n", proto_path.c_str());
     printf("TNN Converter generate TNN model path %s\n", model_path.c_str());
     TNN_NS::ModelPacker model_packer(&net_structure, &net_resource);
+    // the resources are not used after packing, free them as they are written
+    model_packer.SetReleaseResource(true);
+    model_packer.SetSectionAlignment(section_alignment);
     Status status = model_packer.Pack(proto_path, model_path);
     if (status != TNN_OK) {
         LOGE("generate tnn model failed!\n");
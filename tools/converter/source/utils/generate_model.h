@@ -22,8 +22,12 @@ namespace TNN_CONVERTER {
 
 std::string GetFileName(std::string& file_path);
 
+std::string GetProtoPath(const std::string& output_dir, const std::string& file_name);
+
+std::string GetModelPath(const std::string& output_dir, const std::string& file_name);
+
 TNN_NS::Status GenerateModel(TNN_NS::NetStructure& net_structure, TNN_NS::NetResource& net_resource,
-                             std::string& output_dir, std::string& file_name);
+                             std::string& output_dir, std::string& file_name, int section_alignment = 0);
 
 }  // namespace TNN_CONVERTER
 
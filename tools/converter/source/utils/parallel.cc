@@ -0,0 +1,82 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TNN_CONVERTER {
+
+static int g_convert_thread_num = 1;
+
+void SetConvertThreadNum(int thread_num) {
+    if (thread_num <= 0) {
+        thread_num = std::max((int)std::thread::hardware_concurrency(), 1);
+    }
+    g_convert_thread_num = thread_num;
+}
+
+int GetConvertThreadNum() {
+    return g_convert_thread_num;
+}
+
+TNN_NS::Status ParallelFor(int count, std::function<TNN_NS::Status(int)> func) {
+    const int thread_num = std::min(g_convert_thread_num, count);
+    if (thread_num <= 1) {
+        for (int i = 0; i < count; ++i) {
+            auto status = func(i);
+            if (status != TNN_NS::TNN_OK) {
+                return status;
+            }
+        }
+        return TNN_NS::TNN_OK;
+    }
+
+    // the items are pulled from a shared cursor, so big and small items balance between threads
+    std::atomic<int> cursor(0);
+    std::mutex status_mutex;
+    TNN_NS::Status result = TNN_NS::TNN_OK;
+    auto worker_func      = [&]() {
+        while (true) {
+            int index = cursor++;
+            if (index >= count) {
+                return;
+            }
+            auto status = func(index);
+            if (status != TNN_NS::TNN_OK) {
+                std::lock_guard<std::mutex> guard(status_mutex);
+                if (result == TNN_NS::TNN_OK) {
+                    result = status;
+                }
+                cursor = count;
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < thread_num; ++i) {
+        threads.push_back(std::thread(worker_func));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return result;
+}
+
+}  // namespace TNN_CONVERTER
@@ -0,0 +1,33 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_TOOLS_CONVERTER_SOURCE_UTILS_PARALLEL_H_
+#define TNN_TOOLS_CONVERTER_SOURCE_UTILS_PARALLEL_H_
+#include <functional>
+
+#include "tnn/core/status.h"
+
+namespace TNN_CONVERTER {
+
+// @brief set the number of threads used by the converter, 0 means the number of cpu cores
+void SetConvertThreadNum(int thread_num);
+
+int GetConvertThreadNum();
+
+// @brief run func(0) ... func(count - 1) on the converter threads, the first failed status is returned
+TNN_NS::Status ParallelFor(int count, std::function<TNN_NS::Status(int)> func);
+
+}  // namespace TNN_CONVERTER
+
+#endif  // TNN_TOOLS_CONVERTER_SOURCE_UTILS_PARALLEL_H_
@@ -44,4 +44,14 @@ DEFINE_string(sp, "", set_precision_message);
 
 DEFINE_string(du, "", dump_unaligned_layer_path_message);
 
+DEFINE_string(qp, "", quantized_proto_path_message);
+
+DEFINE_string(qm, "", quantized_model_path_message);
+
+DEFINE_double(te, 0.01, target_error_message);
+
+DEFINE_int32(si, 10, search_iterations_message);
+
+DEFINE_string(so, "", search_output_message);
+
 }  // namespace TNN_NS
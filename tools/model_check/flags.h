@@ -48,6 +48,16 @@ static const char set_precision_message[] = "(optional) specify tnn precision ty
 
 static const char dump_unaligned_layer_path_message[] = "(optional) specify the path for dump unaligned layer";
 
+static const char quantized_proto_path_message[] = "(optional) quantized tnn proto file path, search the int8 layers of it";
+
+static const char quantized_model_path_message[] = "(optional) quantized tnn model file path, required with -qp";
+
+static const char target_error_message[] = "(optional) max relative l2 error of outputs in precision search, default 0.01";
+
+static const char search_iterations_message[] = "(optional) forward count to measure latency in precision search, default 10";
+
+static const char search_output_message[] = "(optional) path prefix to save the mixed precision model, ie, ./model_mixed";
+
 DECLARE_bool(h);
 
 DECLARE_string(p);
@@ -75,6 +85,16 @@ DECLARE_string(sp);
 DECLARE_string(do);
 
 DECLARE_string(du);
+
+DECLARE_string(qp);
+
+DECLARE_string(qm);
+
+DECLARE_double(te);
+
+DECLARE_int32(si);
+
+DECLARE_string(so);
 }  // namespace TNN_NS
 
 #endif  // TNN_TOOLS_MODEL_CHECK_FLAGS_H_
@@ -20,6 +20,7 @@
 #include "file_reader.h"
 #include "model_checker.h"
 #include "flags.h"
+#include "precision_searcher.h"
 #include "tnn/utils/split_utils.h"
 
 #include <stdio.h>
@@ -164,6 +165,11 @@ void ShowUsage() {
     printf("\t-do, <dir path>   \t%s\n", dump_output_path_message);
     printf("\t-du, <dir path>   \t%s\n", dump_unaligned_layer_path_message);
     printf("\t-sp, <set precision>\t%s\n", set_precision_message);
+    printf("\t-qp, <quantized proto>\t%s\n", quantized_proto_path_message);
+    printf("\t-qm, <quantized model>\t%s\n", quantized_model_path_message);
+    printf("\t-te, <target error>\t%s\n", target_error_message);
+    printf("\t-si, <iterations>\t%s\n", search_iterations_message);
+    printf("\t-so, <path prefix>\t%s\n", search_output_message);
 }
 
 bool ParseAndCheckCommandLine(int argc, char* argv[]) {
@@ -179,9 +185,44 @@ bool ParseAndCheckCommandLine(int argc, char* argv[]) {
         return false;
     }
 
+    if (!FLAGS_qp.empty() && FLAGS_qm.empty()) {
+        printf("Parameter -qm is not set \n");
+        ShowUsage();
+        return false;
+    }
+
     return true;
 }
 
+int RunPrecisionSearch(NetworkConfig& net_config, ModelConfig& model_config, ModelCheckerParam& model_checker_param) {
+    ModelConfig quantized_config;
+    int ret = InitModelConfig(quantized_config, FLAGS_qp, FLAGS_qm);
+    if (CheckResult("init quantized model config", ret) != true)
+        return -1;
+
+    PrecisionSearchParam search_param;
+    search_param.input_file   = model_checker_param.input_file;
+    search_param.input_bias   = model_checker_param.input_bias;
+    search_param.input_scale  = model_checker_param.input_scale;
+    search_param.target_error = FLAGS_te;
+    search_param.iterations   = FLAGS_si;
+    search_param.save_path    = FLAGS_so;
+
+    PrecisionSearcher searcher;
+    auto status = searcher.Init(net_config, model_config, quantized_config, search_param);
+    if (status != TNN_OK) {
+        LOGE("precision searcher init failed! (error: %s)\n", status.description().c_str());
+        return -1;
+    }
+    status = searcher.Run();
+    if (status != TNN_OK) {
+        LOGE("precision search failed! (error: %s)\n", status.description().c_str());
+        return -1;
+    }
+    printf("precision search done!\n");
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     // parse command line params
     if (!ParseAndCheckCommandLine(argc, argv))
@@ -286,6 +327,11 @@ int main(int argc, char* argv[]) {
     if (CheckResult("init model config", ret) != true)
         return -1;
 
+    // search the int8 layers of the quantized model instead of checking
+    if (!FLAGS_qp.empty()) {
+        return RunPrecisionSearch(net_config, model_config, model_checker_param);
+    }
+
     ModelChecker model_checker;
     auto status = model_checker.SetModelCheckerParams(model_checker_param);
     if (status != TNN_OK) {
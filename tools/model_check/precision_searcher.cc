@@ -0,0 +1,396 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "precision_searcher.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+#include "tnn/core/macro.h"
+#include "tnn/interpreter/default_model_interpreter.h"
+#include "tnn/interpreter/tnn/model_packer.h"
+#include "tnn/utils/dims_vector_utils.h"
+
+namespace TNN_NS {
+
+static double GetElapsedMs(std::chrono::time_point<std::chrono::steady_clock> start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static std::shared_ptr<AbstractModelInterpreter> InterpretModel(ModelConfig& model_config, Status& status) {
+    std::shared_ptr<AbstractModelInterpreter> interpreter(CreateModelInterpreter(model_config.model_type));
+    if (!interpreter) {
+        status = Status(TNNERR_NET_ERR, "create model interpreter failed");
+        return nullptr;
+    }
+    status = interpreter->Interpret(model_config.params);
+    return interpreter;
+}
+
+Status PrecisionSearcher::Init(NetworkConfig& net_config, ModelConfig& float_config, ModelConfig& quantized_config,
+                               PrecisionSearchParam param) {
+    net_config_ = net_config;
+    param_      = param;
+    if (net_config_.device_type == DEVICE_CUDA) {
+        net_config_.network_type = NETWORK_TYPE_TENSORRT;
+    }
+
+    Status status;
+    float_interpreter_ = InterpretModel(float_config, status);
+    if (status != TNN_OK) {
+        LOGE("interpret float model failed: %s\n", status.description().c_str());
+        return status;
+    }
+    quantized_interpreter_ = InterpretModel(quantized_config, status);
+    if (status != TNN_OK) {
+        LOGE("interpret quantized model failed: %s\n", status.description().c_str());
+        return status;
+    }
+
+    auto float_default     = dynamic_cast<DefaultModelInterpreter*>(float_interpreter_.get());
+    auto quantized_default = dynamic_cast<DefaultModelInterpreter*>(quantized_interpreter_.get());
+    if (!float_default || !quantized_default) {
+        return Status(TNNERR_INVALID_MODEL, "precision search only supports tnn models");
+    }
+
+    // a quantized layer can switch back to float if it has no weights or the float model has its weights
+    auto& float_resource     = float_default->GetNetResource()->resource_map;
+    auto& quantized_resource = quantized_default->GetNetResource()->resource_map;
+    layers_.clear();
+    for (auto layer_info : quantized_default->GetNetStructure()->layers) {
+        if (!layer_info->param->quantized) {
+            continue;
+        }
+        LayerPrecisionInfo info;
+        info.name       = layer_info->name;
+        info.type       = layer_info->type_str;
+        info.revertible = quantized_resource.count(info.name) == 0 || float_resource.count(info.name) != 0;
+        info.use_int8   = !info.revertible;
+        layers_.push_back(info);
+    }
+    if (layers_.empty()) {
+        return Status(TNNERR_INVALID_MODEL, "there is no quantized layer in the quantized model");
+    }
+
+    return TNN_OK;
+}
+
+std::shared_ptr<AbstractModelInterpreter> PrecisionSearcher::CreateMixedInterpreter(
+    const std::set<std::string>& int8_layers) {
+    auto interpreter       = quantized_interpreter_->Copy();
+    auto default_interp    = dynamic_cast<DefaultModelInterpreter*>(interpreter.get());
+    auto float_default     = dynamic_cast<DefaultModelInterpreter*>(float_interpreter_.get());
+    auto& float_resource   = float_default->GetNetResource()->resource_map;
+    auto& resource_map     = default_interp->GetNetResource()->resource_map;
+    auto structure         = default_interp->GetNetStructure();
+
+    for (auto& info : layers_) {
+        if (!info.revertible || int8_layers.count(info.name) != 0) {
+            continue;
+        }
+        // the quantized structure is kept, fused activations of int8 layers are also supported in float
+        auto layer_info = GetLayerInfoFromName(structure, info.name);
+        if (!layer_info) {
+            continue;
+        }
+        layer_info->param->quantized = false;
+        if (layer_info->type_str.compare(0, 9, "Quantized") == 0) {
+            layer_info->type_str    = layer_info->type_str.substr(9);
+            layer_info->param->type = layer_info->type_str;
+        }
+        if (float_resource.count(info.name) != 0) {
+            resource_map[info.name] = float_resource[info.name];
+        }
+    }
+    return interpreter;
+}
+
+Status PrecisionSearcher::CreateInstance(std::shared_ptr<AbstractModelInterpreter> interpreter, Precision precision,
+                                         std::shared_ptr<Instance>& instance) {
+    NetworkConfig net_config = net_config_;
+    net_config.precision     = precision;
+    ModelConfig model_config;
+    model_config.model_type = MODEL_TYPE_TNN;
+
+    instance = std::make_shared<Instance>(net_config, model_config);
+    RETURN_ON_NEQ(instance->Init(interpreter, InputShapesMap()), TNN_OK);
+    RETURN_ON_NEQ(PrepareInputData(instance.get()), TNN_OK);
+    return FeedInputData(instance.get());
+}
+
+Status PrecisionSearcher::PrepareInputData(Instance* instance) {
+    if (!input_mats_.empty()) {
+        return TNN_OK;
+    }
+
+    if (!param_.input_file.first.empty()) {
+        FileReader file_reader;
+        file_reader.SetBiasValue(param_.input_bias);
+        file_reader.SetScaleValue(param_.input_scale);
+        auto status = file_reader.Read(input_mats_, param_.input_file.first, param_.input_file.second);
+        if (status != TNN_OK) {
+            LOGE("read input file (%s) failed!\n", param_.input_file.first.c_str());
+            return Status(TNNERR_COMMON_ERROR, "read input failed");
+        }
+        return TNN_OK;
+    }
+
+    // fixed seed, every candidate must see the same input
+    std::mt19937 generator(2021);
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+    BlobMap input_blobs;
+    RETURN_ON_NEQ(instance->GetAllInputBlobs(input_blobs), TNN_OK);
+    for (auto item : input_blobs) {
+        auto dims      = item.second->GetBlobDesc().dims;
+        auto data_type = item.second->GetBlobDesc().data_type;
+        int data_count = DimsVectorUtils::Count(dims);
+        std::shared_ptr<Mat> mat;
+        if (DATA_TYPE_INT32 == data_type) {
+            mat           = std::make_shared<Mat>(DEVICE_NAIVE, NC_INT32, dims);
+            int* data_ptr = reinterpret_cast<int*>(mat->GetData());
+            for (int i = 0; i < data_count; i++) {
+                data_ptr[i] = generator() % 2;
+            }
+        } else {
+            mat             = std::make_shared<Mat>(DEVICE_NAIVE, NCHW_FLOAT, dims);
+            float* data_ptr = reinterpret_cast<float*>(mat->GetData());
+            for (int i = 0; i < data_count; i++) {
+                data_ptr[i] = distribution(generator);
+            }
+        }
+        input_mats_[item.first] = mat;
+    }
+    return TNN_OK;
+}
+
+Status PrecisionSearcher::FeedInputData(Instance* instance) {
+    BlobMap input_blobs;
+    RETURN_ON_NEQ(instance->GetAllInputBlobs(input_blobs), TNN_OK);
+    for (auto item : input_blobs) {
+        if (input_mats_.count(item.first) == 0) {
+            LOGE("input mat map not found blob data (name: %s)\n", item.first.c_str());
+            return Status(TNNERR_COMMON_ERROR, "input mat not match with blobs");
+        }
+        RETURN_ON_NEQ(instance->SetInputMat(input_mats_[item.first], MatConvertParam(), item.first), TNN_OK);
+    }
+    return TNN_OK;
+}
+
+Status PrecisionSearcher::GetOutputData(Instance* instance, std::map<std::string, std::vector<float>>& outputs) {
+    BlobMap output_blobs;
+    RETURN_ON_NEQ(instance->GetAllOutputBlobs(output_blobs), TNN_OK);
+    outputs.clear();
+    for (auto item : output_blobs) {
+        // integer outputs such as indices are not used to measure the error
+        if (item.second->GetBlobDesc().data_type == DATA_TYPE_INT32) {
+            continue;
+        }
+        std::shared_ptr<Mat> mat;
+        RETURN_ON_NEQ(instance->GetOutputMat(mat, MatConvertParam(), item.first, DEVICE_NAIVE, NCHW_FLOAT), TNN_OK);
+        float* data_ptr = reinterpret_cast<float*>(mat->GetData());
+        outputs[item.first].assign(data_ptr, data_ptr + DimsVectorUtils::Count(mat->GetDims()));
+    }
+    return TNN_OK;
+}
+
+float PrecisionSearcher::ComputeError(std::map<std::string, std::vector<float>>& outputs) {
+    float max_error = 0;
+    for (auto& item : reference_outputs_) {
+        auto& reference = item.second;
+        auto& output    = outputs[item.first];
+        if (output.size() != reference.size()) {
+            return INFINITY;
+        }
+        double diff_sum = 0, ref_sum = 0;
+        for (size_t i = 0; i < reference.size(); ++i) {
+            double diff = (double)output[i] - reference[i];
+            diff_sum += diff * diff;
+            ref_sum += (double)reference[i] * reference[i];
+        }
+        float error = (float)(std::sqrt(diff_sum) / std::max(std::sqrt(ref_sum), 1e-12));
+        if (std::isnan(error)) {
+            return INFINITY;
+        }
+        max_error = std::max(max_error, error);
+    }
+    return max_error;
+}
+
+Status PrecisionSearcher::Measure(std::shared_ptr<AbstractModelInterpreter> interpreter, Precision precision,
+                                  int iterations, float& error, double& latency) {
+    std::shared_ptr<Instance> instance;
+    RETURN_ON_NEQ(CreateInstance(interpreter, precision, instance), TNN_OK);
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+
+    std::map<std::string, std::vector<float>> outputs;
+    RETURN_ON_NEQ(GetOutputData(instance.get(), outputs), TNN_OK);
+    if (reference_outputs_.empty()) {
+        reference_outputs_ = outputs;
+    }
+    error = ComputeError(outputs);
+
+    latency = 0;
+    if (iterations > 0) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+        }
+        latency = GetElapsedMs(start) / iterations;
+    }
+    return TNN_OK;
+}
+
+Status PrecisionSearcher::ProfileLayers(std::shared_ptr<AbstractModelInterpreter> interpreter,
+                                        std::map<std::string, double>& times) {
+    std::shared_ptr<Instance> instance;
+    RETURN_ON_NEQ(CreateInstance(interpreter, PRECISION_HIGH, instance), TNN_OK);
+    RETURN_ON_NEQ(instance->Forward(), TNN_OK);
+
+    std::chrono::time_point<std::chrono::steady_clock> start;
+    BlobStatisticCallback func_before = [&](std::vector<Blob*>& blobs, LayerInfo* info) {
+        start = std::chrono::steady_clock::now();
+    };
+    BlobStatisticCallback func_after = [&](std::vector<Blob*>& blobs, LayerInfo* info) {
+        times[info->name] += GetElapsedMs(start);
+    };
+
+    times.clear();
+    const int iterations = std::max(param_.iterations, 1);
+    for (int i = 0; i < iterations; ++i) {
+        RETURN_ON_NEQ(instance->ForwardWithCallback(func_before, func_after), TNN_OK);
+    }
+    for (auto& item : times) {
+        item.second /= iterations;
+    }
+    return TNN_OK;
+}
+
+Status PrecisionSearcher::Run() {
+    // the float model in high precision is the reference of all candidates
+    float error = 0;
+    double float_latency = 0;
+    reference_outputs_.clear();
+    RETURN_ON_NEQ(Measure(float_interpreter_, PRECISION_HIGH, param_.iterations, error, float_latency), TNN_OK);
+    printf("float model:        latency %8.3f ms\n", float_latency);
+
+    // low precision is network wide, e.g. fp16 or bf16 on arm, only reported for reference
+    double low_latency = 0;
+    float low_error    = 0;
+    if (Measure(float_interpreter_, PRECISION_LOW, param_.iterations, low_error, low_latency) == TNN_OK) {
+        printf("low precision:      latency %8.3f ms  error %.6f\n", low_latency, low_error);
+    }
+
+    std::set<std::string> all_int8_layers;
+    for (auto& info : layers_) {
+        all_int8_layers.insert(info.name);
+    }
+    auto int8_interpreter = CreateMixedInterpreter(all_int8_layers);
+    float int8_error      = 0;
+    double int8_latency   = 0;
+    RETURN_ON_NEQ(Measure(int8_interpreter, PRECISION_HIGH, param_.iterations, int8_error, int8_latency), TNN_OK);
+    printf("quantized model:    latency %8.3f ms  error %.6f\n", int8_latency, int8_error);
+
+    // speed of each layer in float and in int8
+    std::map<std::string, double> float_times, int8_times;
+    RETURN_ON_NEQ(ProfileLayers(CreateMixedInterpreter(std::set<std::string>()), float_times), TNN_OK);
+    RETURN_ON_NEQ(ProfileLayers(int8_interpreter, int8_times), TNN_OK);
+
+    // error contribution of each layer when it is the only int8 layer
+    double latency = 0;
+    for (auto& info : layers_) {
+        info.float_time = float_times[info.name];
+        info.int8_time  = int8_times[info.name];
+        if (info.revertible) {
+            std::set<std::string> int8_layers = {info.name};
+            RETURN_ON_NEQ(Measure(CreateMixedInterpreter(int8_layers), PRECISION_HIGH, 0, info.error, latency),
+                          TNN_OK);
+        }
+    }
+
+    // greedy search, try the layers with the best speedup per error first
+    std::vector<LayerPrecisionInfo*> candidates;
+    std::set<std::string> selected;
+    for (auto& info : layers_) {
+        if (!info.revertible) {
+            selected.insert(info.name);
+        } else if (info.int8_time < info.float_time) {
+            candidates.push_back(&info);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](LayerPrecisionInfo* a, LayerPrecisionInfo* b) {
+        return (a->float_time - a->int8_time) / (a->error + 1e-6f) >
+               (b->float_time - b->int8_time) / (b->error + 1e-6f);
+    });
+    float mixed_error = 0;
+    for (auto info : candidates) {
+        auto trial = selected;
+        trial.insert(info->name);
+        float trial_error = 0;
+        RETURN_ON_NEQ(Measure(CreateMixedInterpreter(trial), PRECISION_HIGH, 0, trial_error, latency), TNN_OK);
+        if (trial_error <= param_.target_error) {
+            selected    = trial;
+            mixed_error = trial_error;
+        }
+    }
+
+    auto mixed_interpreter = CreateMixedInterpreter(selected);
+    double mixed_latency   = 0;
+    RETURN_ON_NEQ(Measure(mixed_interpreter, PRECISION_HIGH, param_.iterations, mixed_error, mixed_latency),
+                  TNN_OK);
+    printf("mixed model:        latency %8.3f ms  error %.6f\n", mixed_latency, mixed_error);
+
+    // the fully quantized model may still be the fastest one under the target
+    auto best_interpreter = mixed_interpreter;
+    if (int8_error <= param_.target_error && int8_latency < mixed_latency) {
+        best_interpreter = int8_interpreter;
+        selected         = all_int8_layers;
+        mixed_latency    = int8_latency;
+        mixed_error      = int8_error;
+    }
+    for (auto& info : layers_) {
+        info.use_int8 = selected.count(info.name) != 0;
+    }
+
+    printf("\n%-32s %-24s %10s %10s %10s %6s\n", "layer", "type", "fp32(ms)", "int8(ms)", "error", "int8");
+    for (auto& info : layers_) {
+        printf("%-32s %-24s %10.4f %10.4f %10.6f %6s\n", info.name.c_str(), info.type.c_str(), info.float_time,
+               info.int8_time, info.error, info.use_int8 ? "yes" : "no");
+    }
+    printf("\n%d of %d quantized layers run in int8, error %.6f (target %.6f), latency %.3f ms (float %.3f ms)\n",
+           (int)selected.size(), (int)layers_.size(), mixed_error, param_.target_error, mixed_latency, float_latency);
+    if (mixed_error > param_.target_error || mixed_latency >= float_latency) {
+        printf("int8 does not help under the target, the float model is recommended\n");
+    }
+
+    if (!param_.save_path.empty()) {
+        auto default_interp = dynamic_cast<DefaultModelInterpreter*>(best_interpreter.get());
+        ModelPacker packer(default_interp->GetNetStructure(), default_interp->GetNetResource());
+        std::string proto_path = param_.save_path + ".tnnproto";
+        std::string model_path = param_.save_path + ".tnnmodel";
+        auto status            = packer.Pack(proto_path, model_path);
+        if (status != TNN_OK) {
+            LOGE("pack the mixed precision model failed!\n");
+            return status;
+        }
+        printf("mixed precision model saved to %s and %s\n", proto_path.c_str(), model_path.c_str());
+    }
+
+    return TNN_OK;
+}
+
+}  // namespace TNN_NS
@@ -0,0 +1,97 @@
+// Tencent is pleased to support the open source community by making TNN available.
+//
+// Copyright (C) 2020 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef TNN_TOOLS_MODEL_CHECK_PRECISION_SEARCHER_H_
+#define TNN_TOOLS_MODEL_CHECK_PRECISION_SEARCHER_H_
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "file_reader.h"
+#include "tnn/core/instance.h"
+#include "tnn/core/status.h"
+#include "tnn/interpreter/abstract_model_interpreter.h"
+
+namespace TNN_NS {
+
+struct PrecisionSearchParam {
+    std::pair<std::string, FileFormat> input_file;
+    std::vector<float> input_bias;
+    std::vector<float> input_scale;
+    // max relative l2 error of the outputs against the float model
+    float target_error = 0.01f;
+    // forward count to measure latency
+    int iterations = 10;
+    // path prefix to save the searched model, <prefix>.tnnproto and <prefix>.tnnmodel
+    std::string save_path;
+};
+
+struct LayerPrecisionInfo {
+    std::string name;
+    std::string type;
+    // per layer time in ms, measured in the all float and all int8 networks
+    double float_time = 0;
+    double int8_time  = 0;
+    // output error when only this layer runs in int8
+    float error = 0;
+    // the layer can be switched back to float
+    bool revertible = true;
+    bool use_int8   = false;
+};
+
+// PrecisionSearcher picks the layers of a quantized model that run in int8, the others are switched back to
+// float. It measures the error and speed of every layer, then greedily adds int8 layers with the best speedup per
+// error until the output error reaches the target.
+class PrecisionSearcher {
+public:
+    // @brief init with the float model and the quantized model generated from it by the quantization tool
+    Status Init(NetworkConfig& net_config, ModelConfig& float_config, ModelConfig& quantized_config,
+                PrecisionSearchParam param);
+
+    // @brief run the search and save the mixed precision model if save_path is set
+    Status Run();
+
+private:
+    // @brief build a copy of the quantized model in which only int8_layers stay quantized
+    std::shared_ptr<AbstractModelInterpreter> CreateMixedInterpreter(const std::set<std::string>& int8_layers);
+    // @brief create an instance on the target device
+    Status CreateInstance(std::shared_ptr<AbstractModelInterpreter> interpreter, Precision precision,
+                          std::shared_ptr<Instance>& instance);
+    // @brief generate or read the input mats, shared by all instances
+    Status PrepareInputData(Instance* instance);
+    Status FeedInputData(Instance* instance);
+    Status GetOutputData(Instance* instance, std::map<std::string, std::vector<float>>& outputs);
+    // @brief max relative l2 error of all outputs against the reference
+    float ComputeError(std::map<std::string, std::vector<float>>& outputs);
+    // @brief run the network, get the output error and the average latency if iterations > 0
+    Status Measure(std::shared_ptr<AbstractModelInterpreter> interpreter, Precision precision, int iterations,
+                   float& error, double& latency);
+    // @brief accumulate the time of each layer
+    Status ProfileLayers(std::shared_ptr<AbstractModelInterpreter> interpreter, std::map<std::string, double>& times);
+
+    NetworkConfig net_config_;
+    PrecisionSearchParam param_;
+    std::shared_ptr<AbstractModelInterpreter> float_interpreter_;
+    std::shared_ptr<AbstractModelInterpreter> quantized_interpreter_;
+    std::map<std::string, std::shared_ptr<Mat>> input_mats_;
+    std::map<std::string, std::vector<float>> reference_outputs_;
+    std::vector<LayerPrecisionInfo> layers_;
+};
+
+}  // namespace TNN_NS
+
+#endif  // TNN_TOOLS_MODEL_CHECK_PRECISION_SEARCHER_H_
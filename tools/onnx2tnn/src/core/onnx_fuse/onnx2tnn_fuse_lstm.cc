@@ -26,9 +26,9 @@ int Onnx2TNN::FuseLSTM(onnx::GraphProto* mutable_graph,
     for (int i = 0; i < node_count; i++) {
         auto node = index_nodes[i].node;
 
-        // LSTM <= LSTM(direction=forward) - Squeeze(axis = 1)
+        // LSTM <= LSTM(direction=forward) - Squeeze(axis = 1), the same for GRU
         do {
-            if (node->op_type() == "LSTM" && i + 1 < node_count) {
+            if ((node->op_type() == "LSTM" || node->op_type() == "GRU") && i + 1 < node_count) {
                 onnx::NodeProto* node_lstm = node;
                 auto direction = get_node_attr_s(*node_lstm, "direction", "forward");
                 if (direction != "forward" && direction != "reverse") {
@@ -59,9 +59,9 @@ int Onnx2TNN::FuseLSTM(onnx::GraphProto* mutable_graph,
                 i += 1;
             }
         } while (0);
-        // LSTM <= LSTM(direction=bidirectional) - Transpose - Reshape
+        // LSTM <= LSTM(direction=bidirectional) - Transpose - Reshape, the same for GRU
         do {
-            if (node->op_type() == "LSTM" && i + 2 < node_count) {
+            if ((node->op_type() == "LSTM" || node->op_type() == "GRU") && i + 2 < node_count) {
                 onnx::NodeProto* node_lstm = node;
                 auto direction = get_node_attr_s(*node_lstm, "direction", "forward");
                 if (direction != "bidirectional") {
@@ -14,8 +14,10 @@
 
 #include "calibration.h"
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <random>
+#include <thread>
 #include "file_reader.h"
 #include "tnn/core/macro.h"
 #include "tnn/core/tnn.h"
@@ -30,6 +32,9 @@ static const std::set<LayerType> kQuantizedLayerTypeStr = {LAYER_CONVOLUTION, LA
 
 static const std::set<LayerType> kBlobScaleMergeLayerTypeStr = {LAYER_RELU, LAYER_POOLING};
 
+// quantized only if CalibrationParam::quantize_matmul_lstm is set
+static const std::set<LayerType> kMatMulQuantizedLayerTypeStr = {LAYER_MATMUL};
+
 static void InitWeightScaleADMM(const float* weights, const int size, const int output_channel, bool merge_channel,
                                 float* weight_scale, const int quantize_bits) {
     int weight_scale_count = merge_channel ? 1 : output_channel;
@@ -98,13 +103,13 @@ Calibration::Calibration() {}
 Calibration::~Calibration() {}
 
 Status Calibration::Init(NetworkConfig& net_config, ModelConfig& model_config, InputShapesMap inputs_shape) {
-    TNN tnn;
-    Status status = tnn.Init(model_config);
+    Status status = tnn_.Init(model_config);
     if (status != TNN_OK) {
         LOGE("tnn init failed!\n");
         return TNNERR_INVALID_MODEL;
     }
-    instance_ = tnn.CreateInst(net_config, status);
+    net_config_ = net_config;
+    instance_   = tnn_.CreateInst(net_config, status);
     if (status != TNN_OK) {
         LOGE("tnn create instance failed!\n");
         return TNNERR_INST_ERR;
@@ -122,6 +127,12 @@ Status Calibration::Init(NetworkConfig& net_config, ModelConfig& model_config, I
 int Calibration::SetCalibrationParams(CalibrationParam params) {
     cali_params_ = params;
 
+    if (cali_params_.num_instances < 1) {
+        LOGE("invalid num_instances (%d), use 1 instance!\n", cali_params_.num_instances);
+        cali_params_.num_instances = 1;
+        return -1;
+    }
+
     if (cali_params_.blob_quantize_method == ADMM) {
         LOGE("Not support ADMM in quantizing blobs!\n");
         cali_params_.blob_quantize_method = MIN_MAX;
@@ -184,7 +195,6 @@ Status Calibration::Serialize(std::string proto_path, std::string model_path) {
 
 int Calibration::CalBlobScale(DataSet& dataset) {
     printf("Start to calculate blob scale ...\n");
-    NetResource* net_resource = interpreter_->GetNetResource();
 
     Status status = instance_->Reshape(dataset.input_shape);
     if (status != TNN_OK) {
@@ -200,6 +210,13 @@ int Calibration::CalBlobScale(DataSet& dataset) {
     }
     printf("\tInit Feature Map done!\n");
 
+    ret = InitWorkers(dataset);
+    if (ret != 0) {
+        LOGE("init calibration workers failed!\n");
+        return ret;
+    }
+    printf("\tInit %d Calibration Workers done!\n", (int)worker_instances_.size());
+
     // Collect the Range of Feature map
     ret = UpdateBlobRange(dataset);
     if (ret != 0) {
@@ -216,19 +233,47 @@ int Calibration::CalBlobScale(DataSet& dataset) {
     }
     printf("\tCollect Blob Distribution done!\n");
 
+    // the other instances are not needed any more
+    worker_instances_.clear();
+    worker_feature_maps_.clear();
+
     // Compute Scale of Feature map and save to resource map
-    for (auto& item : feature_map_) {
-        std::vector<float> scale_vec;
-        std::vector<int8_t> zero_point_vec;
+    return CalculateFeatureMapScale();
+}
 
-        std::string input_scale_name = item.first->GetBlobDesc().name + BLOB_SCALE_SUFFIX;
-        int ret = item.second->CalculateScale(scale_vec, zero_point_vec);
-        if (ret != 0) {
+int Calibration::CalculateFeatureMapScale() {
+    NetResource* net_resource = interpreter_->GetNetResource();
+
+    std::vector<std::pair<Blob*, std::shared_ptr<ScaleCalculator>>> items(feature_map_.begin(), feature_map_.end());
+    std::vector<std::vector<float>> scale_vecs(items.size());
+    std::vector<std::vector<int8_t>> zero_point_vecs(items.size());
+    std::vector<int> rets(items.size(), 0);
+
+    // the kl divergence search of each blob is independent
+    std::atomic<int> next_item(0);
+    auto calculate_func = [&]() {
+        for (int i = next_item++; i < (int)items.size(); i = next_item++) {
+            rets[i] = items[i].second->CalculateScale(scale_vecs[i], zero_point_vecs[i]);
+        }
+    };
+    int num_threads = std::min(cali_params_.num_instances, (int)items.size());
+    std::vector<std::thread> threads;
+    for (int t = 1; t < num_threads; ++t) {
+        threads.push_back(std::thread(calculate_func));
+    }
+    calculate_func();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (int i = 0; i < (int)items.size(); ++i) {
+        std::string input_scale_name = items[i].first->GetBlobDesc().name + BLOB_SCALE_SUFFIX;
+        if (rets[i] != 0) {
             LOGE("CalculateScale (%s) failed\n", input_scale_name.c_str());
-            return ret;
+            return rets[i];
         }
         LayerResource* blob_scale_res;
-        blob_scale_res = CreateIntScale(scale_vec, zero_point_vec);
+        blob_scale_res = CreateIntScale(scale_vecs[i], zero_point_vecs[i]);
         net_resource->resource_map[input_scale_name] = std::shared_ptr<LayerResource>(blob_scale_res);
         printf("\t====> Calculate (%s) done!\n", input_scale_name.c_str());
     }
@@ -241,7 +286,7 @@ int Calibration::InitFeatureMap() {
 
     BlobStatisticCallback func = [&](std::vector<Blob*>& blobs, LayerInfo* info) {
         LayerType layer_type = info->type;
-        if (kQuantizedLayerTypeStr.find(layer_type) != kQuantizedLayerTypeStr.end() ||
+        if (IsQuantizedLayerType(layer_type) ||
             kBlobScaleMergeLayerTypeStr.find(layer_type) != kBlobScaleMergeLayerTypeStr.end()) {
             for (auto blob : blobs) {
                 if (feature_map_.find(blob) == feature_map_.end()) {
@@ -252,8 +297,8 @@ int Calibration::InitFeatureMap() {
                     }
                 }
 
-                // set FC layer input and output blob to merge channel
-                if (layer_type == LAYER_INNER_PRODUCT) {
+                // set FC and MatMul layer input and output blob to merge channel
+                if (layer_type == LAYER_INNER_PRODUCT || layer_type == LAYER_MATMUL) {
                     if (feature_map_.find(blob) != feature_map_.end()) {
                         feature_map_[blob]->SetMergeChannel(true);
                     }
@@ -280,38 +325,168 @@ int Calibration::InitFeatureMap() {
     return 0;
 }
 
-int Calibration::UpdateBlobRange(DataSet& dataset) {
-    BlobMap input_blobs;
-    Status status = instance_->GetAllInputBlobs(input_blobs);
-    if (status != TNN_OK) {
-        LOGE("instance get input blobs failed!\n");
-        return -1;
+int Calibration::InitWorkers(DataSet& dataset) {
+    worker_instances_.clear();
+    worker_feature_maps_.clear();
+
+    std::map<std::string, std::shared_ptr<ScaleCalculator>> name_feature_map;
+    for (auto& item : feature_map_) {
+        name_feature_map[item.first->GetBlobDesc().name] = item.second;
     }
-    Blob* input_blob = input_blobs.begin()->second;
 
-    BlobStatisticCallback func = [&](std::vector<Blob*>& blobs, LayerInfo* info) {
-        for (auto blob : blobs) {
-            if (feature_map_.find(blob) != feature_map_.end()) {
-                feature_map_[blob]->UpdateRange();
+    for (int i = 0; i < cali_params_.num_instances; ++i) {
+        std::shared_ptr<Instance> instance = instance_;
+        if (i > 0) {
+            Status status;
+            instance = tnn_.CreateInst(net_config_, status);
+            if (status != TNN_OK || instance == nullptr) {
+                LOGE("tnn create instance (%d) failed!\n", i);
+                return -1;
+            }
+            status = instance->Reshape(dataset.input_shape);
+            if (status != TNN_OK) {
+                LOGE("instance (%d) reshape failed!\n", i);
+                return -1;
             }
         }
-    };
 
-    FileReader file_reader;
-    file_reader.SetBiasValue(cali_params_.input_bias);
-    file_reader.SetScaleValue(cali_params_.input_scale);
-    file_reader.SetReverseChannel(cali_params_.reverse_channel);
-    for (auto file_pack : dataset.file_list) {
-        for (auto item : feature_map_) {
-            item.second->ClearRangeFlag();
+        // blobs of each instance are different, find them by name
+        std::map<Blob*, std::shared_ptr<ScaleCalculator>> worker_feature_map;
+        bool clone_failed          = false;
+        BlobStatisticCallback func = [&](std::vector<Blob*>& blobs, LayerInfo* info) {
+            for (auto blob : blobs) {
+                auto iter = name_feature_map.find(blob->GetBlobDesc().name);
+                if (iter == name_feature_map.end() || worker_feature_map.find(blob) != worker_feature_map.end()) {
+                    continue;
+                }
+                auto scale_cal = iter->second->Clone(blob);
+                if (scale_cal == nullptr) {
+                    clone_failed = true;
+                    continue;
+                }
+                worker_feature_map[blob] = scale_cal;
+            }
+        };
+        instance->ForwardWithCallback(func, func);
+        if (clone_failed || worker_feature_map.size() != feature_map_.size()) {
+            LOGE("init feature map of instance (%d) failed!\n", i);
+            return -1;
         }
 
-        status = file_reader.Read(input_blob, file_pack.first, file_pack.second);
+        worker_instances_.push_back(instance);
+        worker_feature_maps_.push_back(worker_feature_map);
+    }
+
+    return 0;
+}
+
+bool Calibration::NextInput(DataSet& dataset, std::pair<std::string, FileFormat>& file) {
+    std::unique_lock<std::mutex> lock(input_mutex_);
+    if (dataset.file_stream) {
+        return dataset.file_stream->Next(file);
+    }
+    if (input_index_ >= dataset.file_list.size()) {
+        return false;
+    }
+    file = dataset.file_list[input_index_++];
+    return true;
+}
+
+int Calibration::ForwardDataSet(DataSet& dataset, bool update_distribute) {
+    input_index_ = 0;
+    if (dataset.file_stream) {
+        Status status = dataset.file_stream->Reset();
         if (status != TNN_OK) {
-            LOGE("read input file (%s) failed!\n", file_pack.first.c_str());
-            continue;
+            LOGE("reset input file stream failed! (%s)\n", status.description().c_str());
+            return -1;
+        }
+    }
+
+    std::atomic<int> num_inputs(0);
+    std::atomic<int> num_errors(0);
+    auto worker_func = [&](int worker_index) {
+        auto instance     = worker_instances_[worker_index];
+        auto& feature_map = worker_feature_maps_[worker_index];
+
+        BlobMap input_blobs;
+        Status status = instance->GetAllInputBlobs(input_blobs);
+        if (status != TNN_OK) {
+            LOGE("instance get input blobs failed!\n");
+            num_errors++;
+            return;
+        }
+        Blob* input_blob = input_blobs.begin()->second;
+
+        BlobStatisticCallback func = [&](std::vector<Blob*>& blobs, LayerInfo* info) {
+            for (auto blob : blobs) {
+                auto iter = feature_map.find(blob);
+                if (iter == feature_map.end()) {
+                    continue;
+                }
+                if (update_distribute) {
+                    iter->second->UpdateDistribute();
+                } else {
+                    iter->second->UpdateRange();
+                }
+            }
+        };
+
+        FileReader file_reader;
+        file_reader.SetBiasValue(cali_params_.input_bias);
+        file_reader.SetScaleValue(cali_params_.input_scale);
+        file_reader.SetReverseChannel(cali_params_.reverse_channel);
+        std::pair<std::string, FileFormat> file_pack;
+        while (NextInput(dataset, file_pack)) {
+            for (auto& item : feature_map) {
+                if (update_distribute) {
+                    item.second->ClearDistributeFlag();
+                } else {
+                    item.second->ClearRangeFlag();
+                }
+            }
+
+            status = file_reader.Read(input_blob, file_pack.first, file_pack.second);
+            if (status != TNN_OK) {
+                LOGE("read input file (%s) failed!\n", file_pack.first.c_str());
+                continue;
+            }
+            instance->ForwardWithCallback(func, func);
+            num_inputs++;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 1; i < (int)worker_instances_.size(); ++i) {
+        threads.push_back(std::thread(worker_func, i));
+    }
+    worker_func(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    printf("\t\t%d inputs on %d instances\n", (int)num_inputs, (int)worker_instances_.size());
+
+    return num_errors > 0 ? -1 : 0;
+}
+
+int Calibration::UpdateBlobRange(DataSet& dataset) {
+    int ret = ForwardDataSet(dataset, false);
+    if (ret != 0) {
+        return ret;
+    }
+
+    // merge the range of all threads
+    std::map<std::string, std::shared_ptr<ScaleCalculator>> name_feature_map;
+    for (auto& item : feature_map_) {
+        name_feature_map[item.first->GetBlobDesc().name] = item.second;
+    }
+    for (auto& worker_feature_map : worker_feature_maps_) {
+        for (auto& item : worker_feature_map) {
+            ret = name_feature_map[item.first->GetBlobDesc().name]->MergeRange(*item.second);
+            if (ret != 0) {
+                LOGE("merge range of blob (%s) failed!\n", item.first->GetBlobDesc().name.c_str());
+                return ret;
+            }
         }
-        instance_->ForwardWithCallback(func, func);
     }
 
     return 0;
@@ -322,37 +497,30 @@ int Calibration::UpdateBlobDistribute(DataSet& dataset) {
         item.second->ResetDistribute();
     }
 
-    BlobMap input_blobs;
-    Status status = instance_->GetAllInputBlobs(input_blobs);
-    if (status != TNN_OK) {
-        LOGE("instance get input blobs failed!\n");
-        return -1;
+    std::map<std::string, std::shared_ptr<ScaleCalculator>> name_feature_map;
+    for (auto& item : feature_map_) {
+        name_feature_map[item.first->GetBlobDesc().name] = item.second;
     }
-    Blob* input_blob = input_blobs.begin()->second;
-
-    BlobStatisticCallback func = [&](std::vector<Blob*>& blobs, LayerInfo* info) {
-        for (auto blob : blobs) {
-            if (feature_map_.find(blob) != feature_map_.end()) {
-                feature_map_[blob]->UpdateDistribute();
-            }
+    for (auto& worker_feature_map : worker_feature_maps_) {
+        for (auto& item : worker_feature_map) {
+            item.second->SyncDistribute(*name_feature_map[item.first->GetBlobDesc().name]);
         }
-    };
+    }
 
-    FileReader file_reader;
-    file_reader.SetBiasValue(cali_params_.input_bias);
-    file_reader.SetScaleValue(cali_params_.input_scale);
-    file_reader.SetReverseChannel(cali_params_.reverse_channel);
-    for (auto file_pack : dataset.file_list) {
-        for (auto& item : feature_map_) {
-            item.second->ClearDistributeFlag();
-        }
+    int ret = ForwardDataSet(dataset, true);
+    if (ret != 0) {
+        return ret;
+    }
 
-        status = file_reader.Read(input_blob, file_pack.first, file_pack.second);
-        if (status != TNN_OK) {
-            LOGE("read input file (%s) failed!\n", file_pack.first.c_str());
-            continue;
+    // merge the histogram of all threads
+    for (auto& worker_feature_map : worker_feature_maps_) {
+        for (auto& item : worker_feature_map) {
+            ret = name_feature_map[item.first->GetBlobDesc().name]->MergeDistribute(*item.second);
+            if (ret != 0) {
+                LOGE("merge distribute of blob (%s) failed!\n", item.first->GetBlobDesc().name.c_str());
+                return ret;
+            }
         }
-        instance_->ForwardWithCallback(func, func);
     }
 
     return 0;
@@ -413,7 +581,16 @@ int Calibration::QuantizeParams() {
             continue;
         }
 
-        if (kQuantizedLayerTypeStr.find(layer_type) != kQuantizedLayerTypeStr.end()) {
+        if (cali_params_.quantize_matmul_lstm && layer_type == LAYER_LSTMONNX) {
+            printf("\tQuantize LSTM parameters...\n");
+            if (QuantizeLSTMParams(item.get(), net_resource) != 0) {
+                LOGE("Quantize LSTM weights failed! (layer name: %s)\n", item->name.c_str());
+                return -1;
+            }
+            printf("\t====> done!\n");
+        }
+
+        if (IsQuantizedLayerType(layer_type)) {
             // assign NetStructure
             item->param->quantized = true;
 
@@ -471,6 +648,29 @@ int Calibration::QuantizeParams() {
                     return -1;
                 }
                 printf("\t====> done!\n");
+            } else if (layer_type == LAYER_MATMUL) {
+                // constant inputs have no blob scale, keep such layers in float
+                for (auto& name : item->inputs) {
+                    if (net_resource->constant_map.find(name) != net_resource->constant_map.end()) {
+                        item->param->quantized = false;
+                    }
+                }
+                if (!item->param->quantized || item->inputs.size() == 2) {
+                    continue;
+                }
+
+                printf("\tQuantize MatMul parameters...\n");
+                if (net_resource->resource_map.find(item->name) == net_resource->resource_map.end()) {
+                    LOGE("MatMul resource not found (name: %s)", item->name.c_str());
+                    return -1;
+                }
+                MatMulLayerResource* matmul_res =
+                    dynamic_cast<MatMulLayerResource*>(net_resource->resource_map[item->name].get());
+                if (QuantizeMatMulParams(matmul_res) != 0) {
+                    LOGE("Quantize MatMul weights failed! (layer name: %s)\n", item->name.c_str());
+                    return -1;
+                }
+                printf("\t====> done!\n");
             } else if (layer_type == LAYER_ADD) {
                 // if one of the input of add layer is in layer resource, then this layer will not be quantized
                 if (net_resource->resource_map.find(item->name) != net_resource->resource_map.end()) {
@@ -674,6 +874,90 @@ int Calibration::QuantizeFcParams(InnerProductLayerResource* resource, InnerProd
     return 0;
 }
 
+int Calibration::QuantizeMatMulParams(MatMulLayerResource* resource) {
+    RawBuffer weight_quantized;
+    RawBuffer weight_scale;
+    int ret = QuantizeWeightsPerTensor(resource->weight, weight_quantized, weight_scale);
+    if (ret != 0) {
+        return ret;
+    }
+
+    // the scale is not multiplied by the input scale, the acc combines the scales of both operands
+    resource->weight       = weight_quantized;
+    resource->scale_handle = weight_scale;
+    return 0;
+}
+
+int Calibration::QuantizeLSTMParams(LayerInfo* layer_info, NetResource* net_resource) {
+    if (layer_info->inputs.size() < 3) {
+        LOGE("invalid lstm inputs!\n");
+        return -1;
+    }
+
+    // the gates keep float inputs and outputs, W and R are stored like a dynamic range quantized model
+    auto& constant_map = net_resource->constant_map;
+    std::vector<std::string> weight_names = {layer_info->inputs[1], layer_info->inputs[2]};
+    std::vector<std::shared_ptr<RawBuffer>> quantized_buffers;
+    std::vector<std::shared_ptr<RawBuffer>> scale_buffers;
+    for (auto& name : weight_names) {
+        if (constant_map.find(name) == constant_map.end() || constant_map[name] == nullptr) {
+            LOGE("LSTM weight not found in constant map (name: %s)\n", name.c_str());
+            return -1;
+        }
+        std::shared_ptr<RawBuffer> weight_quantized = std::make_shared<RawBuffer>();
+        std::shared_ptr<RawBuffer> weight_scale     = std::make_shared<RawBuffer>();
+        int ret = QuantizeWeightsPerTensor(*constant_map[name], *weight_quantized, *weight_scale);
+        if (ret != 0) {
+            return ret;
+        }
+        quantized_buffers.push_back(weight_quantized);
+        scale_buffers.push_back(weight_scale);
+    }
+
+    for (size_t i = 0; i < weight_names.size(); ++i) {
+        constant_map[weight_names[i]]                                = quantized_buffers[i];
+        constant_map[weight_names[i] + DynamicRangeQuantScaleSuffix] = scale_buffers[i];
+    }
+    layer_info->param->dynamic_range_quantized = true;
+    return 0;
+}
+
+int Calibration::QuantizeWeightsPerTensor(RawBuffer& weight, RawBuffer& weight_quantized, RawBuffer& weight_scale) {
+    if (cali_params_.weights_quantize_method == ASY_MIN_MAX) {
+        LOGE("ASY_MIN_MAX is not supported for MatMul and LSTM weights\n");
+        return -1;
+    }
+
+    auto weight_handle = weight;
+    if (weight.GetDataType() == DATA_TYPE_HALF) {
+        LOGI("Fp16 model is used to quantize, precision may be lower than fp32 model!");
+        weight_handle = ConvertHalfHandle(weight);
+    }
+    if (weight_handle.GetDataType() != DATA_TYPE_FLOAT) {
+        LOGE("invalid weight data type!\n");
+        return -1;
+    }
+
+    int size         = weight_handle.GetDataCount();
+    weight_quantized = RawBuffer(size * sizeof(char));
+    weight_quantized.SetDataType(DATA_TYPE_INT8);
+    weight_quantized.SetBufferDims(weight.GetBufferDims());
+    weight_scale = RawBuffer(sizeof(float));
+    weight_scale.SetBufferDims({1});
+    int8_t weight_zero_point = 0;
+
+    return CalQuantizedWeights(weight_handle.force_to<float*>(), size, 1, true, weight_quantized.force_to<int8_t*>(),
+                               weight_scale.force_to<float*>(), &weight_zero_point);
+}
+
+bool Calibration::IsQuantizedLayerType(LayerType layer_type) {
+    if (kQuantizedLayerTypeStr.find(layer_type) != kQuantizedLayerTypeStr.end()) {
+        return true;
+    }
+    return cali_params_.quantize_matmul_lstm &&
+           kMatMulQuantizedLayerTypeStr.find(layer_type) != kMatMulQuantizedLayerTypeStr.end();
+}
+
 int Calibration::CalQuantizedWeights(const float* weights, const int size, const int output_channel, bool merge_channel,
                                      int8_t* quantized_weights, float* weight_scale, int8_t* weight_zero_point) {
     ASSERT(size % output_channel == 0);
@@ -793,6 +1077,12 @@ void Calibration::MergeBlobScaleRecursion(LayerInfo* layer_info, NetStructure* n
             std::string output_scale_name = layer_info->outputs[0] + +BLOB_SCALE_SUFFIX;
             if (net_resource->resource_map.find(input_scale_name) != net_resource->resource_map.end() &&
                 net_resource->resource_map.find(output_scale_name) != net_resource->resource_map.end()) {
+                // int8 MatMul only supports per-tensor scale
+                auto output_scale =
+                    dynamic_cast<IntScaleResource*>(net_resource->resource_map[output_scale_name].get());
+                if (pre_layer_info->type == LAYER_MATMUL && output_scale->scale_handle.GetDataCount() != 1) {
+                    return;
+                }
                 net_resource->resource_map[input_scale_name] = net_resource->resource_map[output_scale_name];
                 layer_info->param->quantized                 = true;
             }
@@ -16,10 +16,12 @@
 #define TNN_TOOLS_QUANTIZATION_CALIBRATION_H_
 
 #include <memory>
+#include <mutex>
 #include "tnn/core/blob.h"
 #include "tnn/core/instance.h"
 #include "tnn/core/layer_type.h"
 #include "tnn/core/status.h"
+#include "tnn/core/tnn.h"
 #include "tnn/interpreter/default_model_interpreter.h"
 
 #include "calibration_common.h"
@@ -58,8 +60,13 @@ public:
 private:
     int CalBlobScale(DataSet& dataset);
     int InitFeatureMap();
+    int InitWorkers(DataSet& dataset);
     int UpdateBlobRange(DataSet& dataset);
     int UpdateBlobDistribute(DataSet& dataset);
+    // run the dataset on all the instances, each thread updates the feature map of its own instance
+    int ForwardDataSet(DataSet& dataset, bool update_distribute);
+    bool NextInput(DataSet& dataset, std::pair<std::string, FileFormat>& file);
+    int CalculateFeatureMapScale();
     IntScaleResource* CreateIntScale(std::vector<float> scale_vec);
     IntScaleResource* CreateIntScale(std::vector<float> scale_vec, std::vector<int8_t> zero_point_vec);
 
@@ -67,6 +74,11 @@ private:
     int QuantizeConvParams(ConvLayerResource* resource, ConvLayerParam* param, IntScaleResource* input_scale);
     int QuantizeFcParams(InnerProductLayerResource* resource, InnerProductLayerParam* param,
                          IntScaleResource* input_scale);
+    int QuantizeMatMulParams(MatMulLayerResource* resource);
+    int QuantizeLSTMParams(LayerInfo* layer_info, NetResource* net_resource);
+    // symmetric per tensor quantization of the weights of MatMul and LSTM
+    int QuantizeWeightsPerTensor(RawBuffer& weight, RawBuffer& weight_quantized, RawBuffer& weight_scale);
+    bool IsQuantizedLayerType(LayerType layer_type);
     // int CalQuantizedWeights(const float* weights, const int size, const int output_channel, bool merge_channel,
     //                         int8_t* quantized_weight, float* weight_scale);
     int CalQuantizedWeights(const float* weights, const int size, const int output_channel, bool merge_channel,
@@ -76,9 +88,18 @@ private:
     void MergeBlobScaleRecursion(LayerInfo* layer_info, NetStructure* net_struct, NetResource* net_resource);
     LayerInfo* GetLayerInfoFromOutpubBlobName(std::string blob_name, NetStructure* net_struct);
 
+    TNN tnn_;
+    NetworkConfig net_config_;
     std::shared_ptr<DefaultModelInterpreter> interpreter_;
     std::shared_ptr<Instance> instance_;
     std::map<Blob*, std::shared_ptr<ScaleCalculator>> feature_map_;
+
+    // instances of the calibration threads, the first one is instance_
+    std::vector<std::shared_ptr<Instance>> worker_instances_;
+    // feature map of each thread, keyed by the blob of its instance
+    std::vector<std::map<Blob*, std::shared_ptr<ScaleCalculator>>> worker_feature_maps_;
+    std::mutex input_mutex_;
+    size_t input_index_ = 0;
     CalibrationParam cali_params_;
 };
 
@@ -16,6 +16,7 @@
 #define TNN_TOOLS_QUANTIZATION_CALIBRATION_COMMON_H_
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -38,10 +39,24 @@ typedef enum {
     ACIQ_LAPLACE = 5,
 } CalibrationMethod;
 
+class DataSetStream {
+public:
+    virtual ~DataSetStream() {}
+
+    // @brief go back to the first file, the dataset is read once for range and once for distribute
+    virtual Status Reset() = 0;
+
+    // @brief get the next input file path and format, return false at the end
+    virtual bool Next(std::pair<std::string, FileFormat>& file) = 0;
+};
+
 struct DataSet {
     /* list of input file path and format */
     std::vector<std::pair<std::string, FileFormat>> file_list;
 
+    /* optional, read the input files one by one instead of file_list */
+    std::shared_ptr<DataSetStream> file_stream = nullptr;
+
     /* input shape of the input files* */
     InputShapesMap input_shape;
 };
@@ -54,6 +69,10 @@ struct CalibrationParam {
     std::vector<float> input_bias             = {0, 0, 0, 0};
     std::vector<float> input_scale            = {1.0f, 1.0f, 1.0f, 1.0f};
     bool reverse_channel                      = false;
+    /* instances to run the dataset, one thread for each */
+    int num_instances                         = 1;
+    /* quantize MatMul (int8 blobs) and LSTMONNX (int8 weights) too, only x86 and cpu run int8 MatMul */
+    bool quantize_matmul_lstm                 = false;
 };
 
 }  // namespace TNN_NS
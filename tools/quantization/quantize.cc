@@ -153,6 +153,65 @@ int ImportDataSet(DataSet& dataset, std::string folder_path) {
     return 0;
 }
 
+// list the input folder file by file, so a large dataset is not listed up front
+class FolderDataSetStream : public DataSetStream {
+public:
+    explicit FolderDataSetStream(std::string folder_path) : folder_path_(folder_path) {}
+
+    virtual ~FolderDataSetStream() {
+        if (dp_ != NULL) {
+            closedir(dp_);
+        }
+    }
+
+    virtual Status Reset() {
+        if (dp_ != NULL) {
+            closedir(dp_);
+        }
+        if ((dp_ = opendir(folder_path_.c_str())) == NULL) {
+            return Status(TNNERR_OPEN_FILE, "Can't open " + folder_path_);
+        }
+        return TNN_OK;
+    }
+
+    virtual bool Next(std::pair<std::string, FileFormat>& file) {
+        if (dp_ == NULL) {
+            return false;
+        }
+        struct dirent* dirp;
+        while ((dirp = readdir(dp_)) != NULL) {
+            FileFormat format = NOTSUPPORT;
+            if (dirp->d_type == DT_REG && GetInputType(dirp->d_name, format)) {
+                file = std::make_pair(folder_path_ + "/" + dirp->d_name, format);
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    std::string folder_path_;
+    DIR* dp_ = NULL;
+};
+
+int ImportDataSetStream(DataSet& dataset, std::string folder_path) {
+    dataset.file_list.clear();
+    dataset.file_stream = std::make_shared<FolderDataSetStream>(folder_path);
+
+    Status status = dataset.file_stream->Reset();
+    if (status != TNN_OK) {
+        printf("%s\n", status.description().c_str());
+        return -1;
+    }
+    std::pair<std::string, FileFormat> file;
+    if (!dataset.file_stream->Next(file)) {
+        printf("no valid input file found!\n");
+        return -1;
+    }
+    printf("stream input files from %s\n", folder_path.c_str());
+    return 0;
+}
+
 bool CheckNumberString(std::string num_str) {
     const char* num_char = num_str.c_str();
 
@@ -178,7 +237,7 @@ bool CheckFileName(std::string name) {
 void PrintConfig() {
     printf(
         "usage:\n./quantization_cmd [-h] [-p] <proto file> [-m] <model file> [-i] <input folder> [-b] <val> [-w] <val> "
-        "[-n] <val> [-s] <val> [-t] <val> [-o] <output_name>\n"
+        "[-n] <val> [-s] <val> [-t] <val> [-j] <val> [-l] [-q] [-o] <output_name>\n"
         "\t-h, --help        \t show this message\n"
         "\t-p, --proto       \t(require) tnn proto file name\n"
         "\t-m, --model       \t(require) tnn model file name\n"
@@ -207,6 +266,11 @@ void PrintConfig() {
         "\t\t0: per-channel mode  (default)\n"
         "\t\t1: mix mode          weight: per-channel  blob: per-tensor\n"
         "\t\t2: per-tensor mode\n"
+        "\t-j, --num_instances\t(optional) instances to run the input files in parallel, one thread for each, "
+        "default 1\n"
+        "\t-l, --stream_input \t(optional) read the input folder file by file instead of listing it up front\n"
+        "\t-q, --matmul_lstm  \t(optional) quantize MatMul and LSTM layers too, the model then only runs on x86 "
+        "and cpu\n"
         "\t-o, --output       \t(optional) specify the name of output\n");
 }
 
@@ -216,6 +280,7 @@ int main(int argc, char* argv[]) {
     std::string model_file_name;
     std::string input_path;
     std::string output_name = "model";
+    bool stream_input       = false;
 
     CalibrationParam cali_params;
 
@@ -228,11 +293,14 @@ int main(int argc, char* argv[]) {
                                     {"bias", required_argument, 0, 'n'},
                                     {"scale", required_argument, 0, 's'},
                                     {"merge_type", required_argument, 0, 't'},
+                                    {"num_instances", required_argument, 0, 'j'},
+                                    {"stream_input", no_argument, 0, 'l'},
+                                    {"matmul_lstm", no_argument, 0, 'q'},
                                     {"output", required_argument, 0, 'o'},
                                     {"help", no_argument, 0, 'h'},
                                     {0, 0, 0, 0}};
 
-    const char* optstring = "p:m:i:b:w:r:n:s:t:o:h";
+    const char* optstring = "p:m:i:b:w:r:n:s:t:j:lqo:h";
 
     if (argc == 1) {
         PrintConfig();
@@ -317,6 +385,18 @@ int main(int argc, char* argv[]) {
                     cali_params.merge_weights_channel = false;
                 }
             } break;
+            case 'j':
+                printf("num instances: %s\n", optarg);
+                cali_params.num_instances = atoi(optarg);
+                break;
+            case 'l':
+                printf("stream input: on\n");
+                stream_input = true;
+                break;
+            case 'q':
+                printf("quantize matmul and lstm: on\n");
+                cali_params.quantize_matmul_lstm = true;
+                break;
             case 'o':
                 printf("output name: %s\n", optarg);
                 output_name = optarg;
@@ -343,7 +423,11 @@ int main(int argc, char* argv[]) {
     NetworkConfig net_config;
     net_config.device_type = DEVICE_NAIVE;    
     DataSet dataset;
-    ret = ImportDataSet(dataset, input_path);
+    if (stream_input) {
+        ret = ImportDataSetStream(dataset, input_path);
+    } else {
+        ret = ImportDataSet(dataset, input_path);
+    }
     if (CheckResult("import data set", ret) != true)
         return -1;
 
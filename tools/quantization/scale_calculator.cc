@@ -20,6 +20,12 @@
 #include <algorithm>
 #include <cmath>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace TNN_NS {
 
 // Given distribution P and Q, KL-Divergence is
@@ -41,6 +47,98 @@ static float KlDivergence(const std::vector<float>& dis_ref, const std::vector<f
     return result;
 }
 
+// update min_val and max_val with len values
+static void UpdateMinMax(const float* p, int len, float& min_val, float& max_val) {
+    int i = 0;
+#if defined(__SSE2__)
+    if (len >= 4) {
+        __m128 v_min = _mm_set1_ps(min_val);
+        __m128 v_max = _mm_set1_ps(max_val);
+        for (; i + 4 <= len; i += 4) {
+            __m128 v = _mm_loadu_ps(p + i);
+            v_min    = _mm_min_ps(v_min, v);
+            v_max    = _mm_max_ps(v_max, v);
+        }
+        float min_lanes[4], max_lanes[4];
+        _mm_storeu_ps(min_lanes, v_min);
+        _mm_storeu_ps(max_lanes, v_max);
+        for (int j = 0; j < 4; ++j) {
+            min_val = std::min(min_val, min_lanes[j]);
+            max_val = std::max(max_val, max_lanes[j]);
+        }
+    }
+#elif defined(__ARM_NEON)
+    if (len >= 4) {
+        float32x4_t v_min = vdupq_n_f32(min_val);
+        float32x4_t v_max = vdupq_n_f32(max_val);
+        for (; i + 4 <= len; i += 4) {
+            float32x4_t v = vld1q_f32(p + i);
+            v_min         = vminq_f32(v_min, v);
+            v_max         = vmaxq_f32(v_max, v);
+        }
+        float min_lanes[4], max_lanes[4];
+        vst1q_f32(min_lanes, v_min);
+        vst1q_f32(max_lanes, v_max);
+        for (int j = 0; j < 4; ++j) {
+            min_val = std::min(min_val, min_lanes[j]);
+            max_val = std::max(max_val, max_lanes[j]);
+        }
+    }
+#endif
+    for (; i < len; ++i) {
+        min_val = std::min(min_val, p[i]);
+        max_val = std::max(max_val, p[i]);
+    }
+}
+
+// count the bin of abs(val) * interval for each nonzero val, bins above bin_nums - 1 go to the last one
+static void UpdateHistogram(const float* p, int len, float interval, int bin_nums, int64_t* histogram) {
+    int i = 0;
+#if defined(__SSE2__)
+    const __m128 v_interval = _mm_set1_ps(interval);
+    const __m128 v_last     = _mm_set1_ps((float)(bin_nums - 1));
+    const __m128 v_abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 v_zero     = _mm_setzero_ps();
+    int index[4];
+    for (; i + 4 <= len; i += 4) {
+        __m128 v  = _mm_loadu_ps(p + i);
+        int valid = ~_mm_movemask_ps(_mm_cmpeq_ps(v, v_zero)) & 0xf;
+        if (valid == 0) {
+            continue;
+        }
+        __m128 v_pos = _mm_min_ps(_mm_mul_ps(_mm_and_ps(v, v_abs_mask), v_interval), v_last);
+        _mm_storeu_si128((__m128i*)index, _mm_cvttps_epi32(v_pos));
+        for (int j = 0; j < 4; ++j) {
+            if (valid & (1 << j)) {
+                histogram[index[j]]++;
+            }
+        }
+    }
+#elif defined(__ARM_NEON)
+    const float32x4_t v_interval = vdupq_n_f32(interval);
+    const float32x4_t v_last     = vdupq_n_f32((float)(bin_nums - 1));
+    int index[4];
+    for (; i + 4 <= len; i += 4) {
+        float32x4_t v     = vld1q_f32(p + i);
+        float32x4_t v_pos = vminq_f32(vmulq_f32(vabsq_f32(v), v_interval), v_last);
+        vst1q_s32(index, vcvtq_s32_f32(v_pos));
+        for (int j = 0; j < 4; ++j) {
+            if (p[i + j] != 0) {
+                histogram[index[j]]++;
+            }
+        }
+    }
+#endif
+    for (; i < len; ++i) {
+        float val = p[i];
+        if (val == 0) {
+            continue;
+        }
+        int index = static_cast<int>(std::min(std::abs(val) * interval, (float)(bin_nums - 1)));
+        histogram[index]++;
+    }
+}
+
 ScaleCalculator::ScaleCalculator() {
     origin_blob_          = nullptr;
     range_done_flag_      = false;
@@ -80,6 +178,10 @@ int ScaleCalculator::Init(Blob* blob, bool merge_channel, CalibrationMethod meth
         for (auto& item : distribute_per_channel_) {
             item.resize(bin_nums_);
         }
+        histogram_per_channel_.resize(channel);
+        for (auto& item : histogram_per_channel_) {
+            item.resize(bin_nums_);
+        }
 
         if (height * width < 100 && cali_method_ != ASY_MIN_MAX) {
             // the data num is too small, use minmax
@@ -151,16 +253,7 @@ int ScaleCalculator::UpdateRange() {
                 index_image_per_channel_[channel_idx] = index + 1;
             }
 
-            for (int i = 0; i < hxw; ++i) {
-                float val = p[i];
-
-                if (val < range_per_channel_[channel_idx].first) {
-                    range_per_channel_[channel_idx].first = val;
-                }
-                if (val > range_per_channel_[channel_idx].second) {
-                    range_per_channel_[channel_idx].second = val;
-                }
-            }
+            UpdateMinMax(p, hxw, range_per_channel_[channel_idx].first, range_per_channel_[channel_idx].second);
         }
     }
     
@@ -180,8 +273,8 @@ int ScaleCalculator::ResetDistribute() {
             break;
     }
 
-    for (auto& item : distribute_per_channel_) {
-        std::fill(item.begin(), item.end(), 1.0e-7);
+    for (auto& item : histogram_per_channel_) {
+        std::fill(item.begin(), item.end(), 0);
     }
 
     return 0;
@@ -208,18 +301,9 @@ int ScaleCalculator::UpdateDistribute() {
                 continue;
             }
 
-            float* p               = data_ptr + b * channel * hxw + c * hxw;
-            float* distribute_data = distribute_per_channel_[channel_idx].data();
-            for (int i = 0; i < hxw; ++i) {
-                float val = p[i];
-                if (val == 0) {
-                    continue;
-                }
-
-                int index = static_cast<int>(std::abs(val) * interval_per_channel_[channel_idx]);
-                index     = std::min(index, bin_nums_ - 1);
-                distribute_data[index] += 1.0;
-            }
+            float* p = data_ptr + b * channel * hxw + c * hxw;
+            UpdateHistogram(p, hxw, interval_per_channel_[channel_idx], bin_nums_,
+                            histogram_per_channel_[channel_idx].data());
         }
     }
 
@@ -227,9 +311,88 @@ int ScaleCalculator::UpdateDistribute() {
     return 0;
 }
 
+std::shared_ptr<ScaleCalculator> ScaleCalculator::Clone(Blob* blob) {
+    std::shared_ptr<ScaleCalculator> scale_cal(new ScaleCalculator());
+    scale_cal->bin_nums_ = bin_nums_;
+    if (scale_cal->Init(blob, merge_channel_, cali_method_) != 0) {
+        return nullptr;
+    }
+    if (scale_cal->range_per_channel_.size() != range_per_channel_.size()) {
+        LOGE("Clone ScaleCalculator with blob of different channel!\n");
+        return nullptr;
+    }
+    // Init may change the method for small blobs, keep the one of this calculator
+    scale_cal->cali_method_ = cali_method_;
+    return scale_cal;
+}
+
+int ScaleCalculator::MergeRange(const ScaleCalculator& other) {
+    if (other.range_per_channel_.size() != range_per_channel_.size()) {
+        LOGE("MergeRange with calculator of different channel!\n");
+        return -1;
+    }
+
+    for (unsigned int c = 0; c < range_per_channel_.size(); ++c) {
+        range_per_channel_[c].first  = std::min(range_per_channel_[c].first, other.range_per_channel_[c].first);
+        range_per_channel_[c].second = std::max(range_per_channel_[c].second, other.range_per_channel_[c].second);
+
+        int index       = index_image_per_channel_[c];
+        int other_index = other.index_image_per_channel_[c];
+        if (other_index > 0) {
+            mean_per_channel_[c] =
+                (mean_per_channel_[c] * index + other.mean_per_channel_[c] * other_index) / (index + other_index);
+            mean_abs_per_channel_[c] =
+                (mean_abs_per_channel_[c] * index + other.mean_abs_per_channel_[c] * other_index) /
+                (index + other_index);
+            index_image_per_channel_[c] = index + other_index;
+        }
+    }
+
+    return 0;
+}
+
+int ScaleCalculator::SyncDistribute(const ScaleCalculator& other) {
+    if (other.interval_per_channel_.size() != interval_per_channel_.size()) {
+        LOGE("SyncDistribute with calculator of different channel!\n");
+        return -1;
+    }
+
+    range_per_channel_    = other.range_per_channel_;
+    interval_per_channel_ = other.interval_per_channel_;
+    valid_channel_        = other.valid_channel_;
+    for (auto& item : histogram_per_channel_) {
+        std::fill(item.begin(), item.end(), 0);
+    }
+
+    return 0;
+}
+
+int ScaleCalculator::MergeDistribute(const ScaleCalculator& other) {
+    if (other.histogram_per_channel_.size() != histogram_per_channel_.size()) {
+        LOGE("MergeDistribute with calculator of different channel!\n");
+        return -1;
+    }
+
+    for (unsigned int c = 0; c < histogram_per_channel_.size(); ++c) {
+        int64_t* dst       = histogram_per_channel_[c].data();
+        const int64_t* src = other.histogram_per_channel_[c].data();
+        for (int i = 0; i < bin_nums_; ++i) {
+            dst[i] += src[i];
+        }
+    }
+
+    return 0;
+}
+
 int ScaleCalculator::CalculateScale(std::vector<float>& val, std::vector<int8_t>& bias) {
     val.clear();
     bias.clear();
+
+    for (unsigned int c = 0; c < histogram_per_channel_.size(); ++c) {
+        for (int i = 0; i < bin_nums_; ++i) {
+            distribute_per_channel_[c][i] = 1.0e-7f + (float)histogram_per_channel_[c][i];
+        }
+    }
     if (merge_channel_) {
         val.push_back(0.0f);
         bias.push_back(0);
@@ -16,6 +16,7 @@
 #define TNN_TOOLS_QUANTIZATION_SCALE_CALCULATOR_H_
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -64,6 +65,19 @@ public:
     // @brief: update distribute.
     int UpdateDistribute();
 
+    // @brief: create a calculator with the same settings for the same blob of another instance.
+    // the range and distribute of the new one are empty, it collects the data of one calibration thread.
+    std::shared_ptr<ScaleCalculator> Clone(Blob* blob);
+
+    // @brief: merge the range collected by the calculator of another thread.
+    int MergeRange(const ScaleCalculator& other);
+
+    // @brief: take the distribute interval of the merged range, and clear the histogram.
+    int SyncDistribute(const ScaleCalculator& other);
+
+    // @brief: merge the histogram collected by the calculator of another thread.
+    int MergeDistribute(const ScaleCalculator& other);
+
     // @brief: get the per-channel scale of the given blob
     int CalculateScale(std::vector<float>& val);
     int CalculateScale(std::vector<float>& val, std::vector<int8_t>& bias);
@@ -87,6 +101,8 @@ private:
     std::vector<int> index_image_per_channel_;
     std::vector<bool> valid_channel_;
     std::vector<std::vector<float>> distribute_per_channel_;
+    // counts of each bin, float distribute can not count more than 2^24 in a bin
+    std::vector<std::vector<int64_t>> histogram_per_channel_;
 };
 
 }  // namespace TNN_NS